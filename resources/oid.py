@@ -139,6 +139,10 @@ def main():
 
         debugger.register_event_handlers(event_handler)
 
+        # With OID_PERSISTENT_VIEWER, the window starts up while the
+        # debuggee does
+        window.prespawn()
+
         if os.environ.get('OID_AGENT') == '1':
             from oidscripts import agentendpoint
             agentendpoint.start(debugger, window)
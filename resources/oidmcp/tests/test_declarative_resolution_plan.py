@@ -0,0 +1,289 @@
+"""
+Resolution plans: the C subset compile_expression() accepts and how it
+evaluates against fake layouts and memory, and the declarative inspector's
+use of plans -- checked against the debugger on a type's first plot, then
+reading memory instead of evaluating expressions.
+"""
+
+import struct
+
+import pytest
+
+from oidscripts import symbols
+from oidscripts.debuggers.interfaces import ObjectLayout, TypeLayout
+from oidscripts.debuggers.template_args import TemplateTypeName
+from oidscripts.oidtypes import declarative
+from oidscripts.oidtypes import resolution_plan
+
+
+class FakeScalar(TypeLayout):
+    def __init__(self, kind, size, signed=False):
+        self.kind = kind
+        self.size = size
+        self.signed = signed
+
+
+class FakePointer(TypeLayout):
+    kind = 'pointer'
+    size = 8
+
+    def __init__(self, target):
+        self._target = target
+
+    def target(self):
+        return self._target
+
+
+class FakeArray(TypeLayout):
+    kind = 'array'
+
+    def __init__(self, element, count):
+        self._element = element
+        self.size = element.size * count
+
+    def target(self):
+        return self._element
+
+
+class FakeStruct(TypeLayout):
+    kind = 'struct'
+
+    def __init__(self, size, members):
+        self.size = size
+        self._members = members
+
+    def member(self, name):
+        return self._members.get(name)
+
+
+INT = FakeScalar('int', 4, signed=True)
+UINT = FakeScalar('int', 4)
+SIZE_T = FakeScalar('int', 8)
+UCHAR = FakeScalar('int', 1)
+
+# cv::Mat of OpenCV 4 on a 64-bit target, as far as the built-in entry
+# reads it.
+MAT_STEP = FakeStruct(24, {
+    'p': (0, FakePointer(SIZE_T)),
+    'buf': (8, FakeArray(SIZE_T, 2)),
+})
+MAT = FakeStruct(96, {
+    'flags': (0, INT),
+    'dims': (4, INT),
+    'rows': (8, INT),
+    'cols': (12, INT),
+    'data': (16, FakePointer(UCHAR)),
+    'step': (72, MAT_STEP),
+})
+MAT_ADDRESS = 0x1000
+PIXELS_ADDRESS = 0x200000
+CV_8UC3_FLAGS = 0x42FF0000 | 16
+
+
+def mat_memory(rows=480, cols=640, step=1920, flags=CV_8UC3_FLAGS):
+    header = bytearray(96)
+    struct.pack_into('<iiii', header, 0, flags, 2, rows, cols)
+    struct.pack_into('<Q', header, 16, PIXELS_ADDRESS)
+    # step.p points at step.buf, inside the header itself
+    struct.pack_into('<QQQ', header, 72, MAT_ADDRESS + 80, step, 3)
+    return {MAT_ADDRESS: bytes(header)}
+
+
+class LayoutBridge:
+    """
+    Fake bridge with the optional layout half of the contract: scripted
+    expression results for the debugger path, and memory the plans read.
+    """
+
+    def __init__(self, results, memory, layout=MAT, generation=0):
+        self.results = dict(results)
+        self.memory = memory
+        self.layout = layout
+        self.generation = generation
+        self.requests = []
+        self.reads = []
+
+    def evaluate_expression(self, expression):
+        self.requests.append(expression)
+        if expression not in self.results:
+            raise RuntimeError(f'Expression "{expression}" failed')
+        return self.results[expression]
+
+    def get_casted_pointer(self, typename, obj):
+        return obj
+
+    def get_object_layout(self, debugger_object):
+        return ObjectLayout(MAT_ADDRESS, self.layout, 'little',
+                            self.generation)
+
+    def read_memory(self, address, size):
+        self.reads.append((address, size))
+        for base, data in self.memory.items():
+            if base <= address and address + size <= base + len(data):
+                return data[address - base:address - base + size]
+        raise RuntimeError(f'cannot access memory at {address:#x}')
+
+
+class FakeSymbol:
+    def __init__(self, type_obj):
+        self.type = type_obj
+
+
+def evaluate(template, memory=None, layout=MAT, placeholders=None,
+             targs=None):
+    compiled = resolution_plan.compile_expression(
+        template, layout, lambda token: targs[token])
+    bridge = LayoutBridge({}, memory or mat_memory(), layout)
+    reader = resolution_plan.MemoryReader(
+        bridge, bridge.get_object_layout(None))
+    return compiled.evaluate(reader, placeholders or {})
+
+
+def test_members_and_derived_placeholders():
+    assert evaluate('{sym}.cols') == 640
+    assert evaluate('{sym}.step.p[0] / {channels} / {elemsize}',
+                    placeholders={'channels': '3', 'elemsize': '1'}) == 640
+    assert evaluate('{sym}.data') == PIXELS_ADDRESS
+    assert evaluate('{sym}.step.buf') == MAT_ADDRESS + 80
+
+
+def test_c_integer_semantics():
+    assert evaluate('(({sym}.flags & 4088) >> 3) + 1') == 3
+    assert evaluate('-7 / 2') == -3
+    assert evaluate('-7 % 2') == -1
+    # int converts to unsigned against an unsigned int operand
+    assert evaluate('-1 < 1u') == 0
+    assert evaluate('0u - 1') == 0xFFFFFFFF
+    assert evaluate('{sym}.step.p[0] - 1921') == 2 ** 64 - 1
+    assert evaluate('!{sym}.data || {sym}.rows > 0 && 0x10') == 1
+
+
+def test_sizeof_is_static():
+    assert evaluate('sizeof({sym}.step.p) == sizeof({sym}.step.p[0])') == 1
+    assert evaluate('sizeof({sym}.step.buf)') == 16
+    assert evaluate('sizeof({sym}.flags)') == 4
+
+
+def test_value_template_arguments_are_constants():
+    assert evaluate('{targ:1} * {sym}.rows',
+                    targs={'targ:1': '-1'}) == -480
+
+
+def test_missing_member_fails_when_evaluated():
+    with pytest.raises(resolution_plan.PlanEvaluationError):
+        evaluate('{sym}.step.p[0] + {sym}.nonexistent')
+
+
+def test_division_by_zero_fails_when_evaluated():
+    with pytest.raises(resolution_plan.PlanEvaluationError):
+        evaluate('{sym}.cols / ({sym}.rows - 480)')
+
+
+@pytest.mark.parametrize('template', [
+    '(int){sym}.cols',
+    'some_global',
+    '{sym}.cols * 1.5',
+    '{sym}.step',
+    '{sym}.data + 4',
+    '{targ:0}',
+    '{sym}.cols ?',
+])
+def test_outside_the_subset_does_not_compile(template):
+    with pytest.raises(resolution_plan.PlanCompileError):
+        resolution_plan.compile_expression(template, MAT,
+                                           lambda token: 'float')
+
+
+def test_header_is_read_once():
+    bridge = LayoutBridge({}, mat_memory())
+    reader = resolution_plan.MemoryReader(
+        bridge, bridge.get_object_layout(None))
+    for template in ('{sym}.rows', '{sym}.cols', '{sym}.step.p[0]'):
+        resolution_plan.compile_expression(
+            template, MAT, None).evaluate(reader, {})
+    assert bridge.reads == [(MAT_ADDRESS, 96)]
+
+
+MAT_RESULTS = {
+    'sizeof((img).step.p) == sizeof((img).step.p[0])': 1,
+    '(img).flags & 7': 0,
+    '(img).cols': 640,
+    '(img).rows': 480,
+    '(((img).flags & 4088) >> 3) + 1': 3,
+    '(img).data': PIXELS_ADDRESS,
+    '(img).step.p[0] / 3 / 1': 640,
+    '3 >= 3': 1,
+}
+MAT_METADATA = {
+    'display_name': 'img (cv::Mat)',
+    'pointer': PIXELS_ADDRESS,
+    'width': 640,
+    'height': 480,
+    'channels': 3,
+    'type': symbols.OID_TYPES_UINT8,
+    'row_stride': 640,
+    'pixel_layout': 'bgra',
+    'transpose_buffer': False,
+}
+
+
+def mat_inspector():
+    return declarative.load_builtin_inspectors()[0]
+
+
+def test_plan_is_checked_against_the_debugger_then_used():
+    inspector = mat_inspector()
+    symbol = FakeSymbol(TemplateTypeName('cv::Mat'))
+    bridge = LayoutBridge(MAT_RESULTS, mat_memory())
+
+    assert inspector.get_buffer_metadata('img', symbol, bridge) == \
+        MAT_METADATA
+    assert bridge.requests
+
+    bridge.requests.clear()
+    bridge.memory = mat_memory(rows=10, cols=20, step=60)
+    metadata = inspector.get_buffer_metadata('img', symbol, bridge)
+    assert bridge.requests == []
+    assert (metadata['width'], metadata['height'],
+            metadata['row_stride']) == (20, 10, 20)
+
+
+def test_plan_differing_from_the_debugger_is_dropped():
+    inspector = mat_inspector()
+    symbol = FakeSymbol(TemplateTypeName('cv::Mat'))
+    results = dict(MAT_RESULTS)
+    results['(img).cols'] = 641
+    bridge = LayoutBridge(results, mat_memory())
+
+    assert inspector.get_buffer_metadata('img', symbol, bridge)['width'] == \
+        641
+    bridge.requests.clear()
+    bridge.reads.clear()
+    assert inspector.get_buffer_metadata('img', symbol, bridge)['width'] == \
+        641
+    assert '(img).cols' in bridge.requests
+    assert bridge.reads == []
+
+
+def test_plan_failure_falls_back_to_the_debugger():
+    inspector = mat_inspector()
+    symbol = FakeSymbol(TemplateTypeName('cv::Mat'))
+    bridge = LayoutBridge(MAT_RESULTS, mat_memory())
+    inspector.get_buffer_metadata('img', symbol, bridge)
+
+    bridge.memory = {}
+    assert inspector.get_buffer_metadata('img', symbol, bridge) == \
+        MAT_METADATA
+    assert '(img).cols' in bridge.requests
+
+
+def test_new_layout_generation_checks_the_plan_again():
+    inspector = mat_inspector()
+    symbol = FakeSymbol(TemplateTypeName('cv::Mat'))
+    bridge = LayoutBridge(MAT_RESULTS, mat_memory())
+    inspector.get_buffer_metadata('img', symbol, bridge)
+
+    bridge.requests.clear()
+    bridge.generation += 1
+    inspector.get_buffer_metadata('img', symbol, bridge)
+    assert '(img).cols' in bridge.requests
@@ -4,16 +4,19 @@
 Code responsible with directly interacting with GDB
 """
 
+import collections
 import gdb
-import time
-import threading
 
 from oidscripts import sysinfo
 from oidscripts.debuggers.interfaces import BridgeInterface, \
-    raise_if_too_large
+    ObjectLayout, TypeLayout, raise_if_too_large
 from oidscripts.events import BridgeEventHandlerInterface
 from oidscripts.logger import log
 
+# Scopes whose observable symbols get_available_symbols() remembers
+SYMBOL_SCAN_CACHE_SIZE = 64
+
+
 class GdbBridge(BridgeInterface):
     """
     GDB Bridge class, exposing the common expected interface for the OpenImageDebugger
@@ -24,37 +27,26 @@ class GdbBridge(BridgeInterface):
         self._commands = {"plot": PlotterCommand(self)}
         self._event_handler = None  # type: BridgeEventHandlerInterface
 
-        self._pending_requests = []
-        self._lock = threading.Lock()
+        # Observable symbols by scope, least recently used first
+        self._symbol_scans = collections.OrderedDict()
+        # See get_object_layout()
+        self._layout_generation = 0
+        self._target_byteorder = None
 
         gdb.events.stop.connect(self._event_stop_handler)
         gdb.events.exited.connect(self._event_exit_handler)
-
-        event_loop_thread = threading.Thread(target=self.event_loop)
-        event_loop_thread.daemon = True
-        event_loop_thread.start()
-
-    def event_loop(self):
-        while True:
-            requests_to_process = []
-            with self._lock:
-                requests_to_process = self._pending_requests
-                self._pending_requests = []
-
-            while requests_to_process:
-                callback = requests_to_process.pop(0)
-                gdb.post_event(callback)
-
-            time.sleep(0.1)
+        gdb.events.new_objfile.connect(self._event_new_objfile_handler)
 
     def queue_request(self, callable_request):
-        with self._lock:
-            self._pending_requests.append(callable_request)
+        # gdb.post_event() may be called from any thread, and runs the request
+        # on gdb's as soon as its event loop gets to it
+        gdb.post_event(callable_request)
 
     def get_backend_name(self):
         return 'gdb'
 
-    def get_buffer_metadata(self, variable, max_bytes=None):
+    def get_buffer_metadata(self, variable, max_bytes=None,
+                            lazy_min_bytes=None, process_id=None):
         picked_obj = gdb.parse_and_eval(variable)
 
         buffer_metadata = self._type_bridge.get_buffer_metadata(
@@ -76,28 +68,62 @@ class GdbBridge(BridgeInterface):
             raise RuntimeError('Invalid null buffer pointer')
         if bufsize == 0:
             raise ValueError('Invalid buffer of zero bytes')
-        elif bufsize >= sysinfo.get_available_memory() / 10:
+
+        lazy = lazy_min_bytes is not None and bufsize >= lazy_min_bytes
+        if not lazy and bufsize >= sysinfo.get_available_memory() / 10:
             raise MemoryError('Invalid buffer size larger than available memory')
 
         raise_if_too_large(bufsize, max_bytes)
 
         # Check if buffer is valid. If it isn't, this function will throw an
         # exception
-        gdb.execute('x ' + str(int(buffer_metadata['pointer'].cast(gdb.lookup_type('long')))))
+        address = int(buffer_metadata['pointer'].cast(gdb.lookup_type('long')))
+        gdb.execute('x ' + str(address))
 
-        inferior = gdb.selected_inferior()
         buffer_metadata['variable_name'] = variable
+        if lazy:
+            # Read region by region through read_memory() instead
+            buffer_metadata['address'] = address
+            buffer_metadata['pointer'] = None
+            return buffer_metadata
+        if process_id is not None:
+            # Read by liboidbridge itself, straight from the inferior
+            buffer_metadata['address'] = address
+            buffer_metadata['pid'] = process_id
+            buffer_metadata['pointer'] = None
+            return buffer_metadata
+
+        inferior = gdb.selected_inferior()
         buffer_metadata['pointer'] = inferior.read_memory(
             buffer_metadata['pointer'], bufsize)
 
         return buffer_metadata
 
+    def read_memory(self, address, size):
+        return gdb.selected_inferior().read_memory(address, size).tobytes()
+
+    def get_process_id(self):
+        inferior = gdb.selected_inferior()
+        # Only a process gdb runs natively, not one behind gdbserver nor a
+        # core file (Inferior.connection needs gdb 11 or later)
+        connection = getattr(inferior, 'connection', None)
+        if inferior.pid <= 0 or connection is None or \
+                getattr(connection, 'type', None) != 'native':
+            return None
+        return inferior.pid
+
     def _event_stop_handler(self, event):
         self._event_handler.stop_handler()
 
     def _event_exit_handler(self, event):
         self._event_handler.exit_handler()
 
+    def _event_new_objfile_handler(self, event):
+        # A rebuilt program may lay out the same type names differently
+        self._symbol_scans.clear()
+        self._layout_generation += 1
+        self._target_byteorder = None
+
     def register_event_handlers(self, event_handler):
         self._event_handler = event_handler
         self._commands['plot'].set_command_listener(event_handler.plot_handler)
@@ -105,8 +131,34 @@ class GdbBridge(BridgeInterface):
     def get_casted_pointer(self, typename, gdb_object):
         typename_obj = gdb.lookup_type(typename)
         typename_pointer_obj = typename_obj.pointer()
+        if isinstance(gdb_object, int):
+            # An address read by a resolution plan
+            gdb_object = gdb.Value(gdb_object)
         return gdb_object.cast(typename_pointer_obj)
 
+    def get_object_layout(self, debugger_object):
+        value = debugger_object
+        value_type = value.type.strip_typedefs()
+        if value_type.code in _REFERENCE_TYPE_CODES:
+            value = value.referenced_value()
+            value_type = value.type.strip_typedefs()
+        if value_type.code == gdb.TYPE_CODE_PTR:
+            address = int(value)
+            layout = GdbTypeLayout(value_type.target())
+        elif value.address is not None:
+            address = int(value.address)
+            layout = GdbTypeLayout(value_type)
+        else:
+            # Held in registers
+            return None
+
+        if self._target_byteorder is None:
+            endian = gdb.execute('show endian', to_string=True)
+            self._target_byteorder = \
+                'big' if 'big endian' in endian else 'little'
+        return ObjectLayout(address, layout, self._target_byteorder,
+                            self._layout_generation)
+
     def evaluate_expression(self, expression):
         # The interface contract is to raise RuntimeError on any failure so
         # the declarative engine can treat evaluation errors uniformly, so
@@ -150,17 +202,93 @@ class GdbBridge(BridgeInterface):
     def get_available_symbols(self):
         frame = gdb.selected_frame()
         block = frame.block()
-        observable_symbols = set()
+        ranges = []
+        symbols = []
         while block is not None:
+            ranges.append((block.start, block.end))
             for symbol in block:
                 if symbol.is_argument or symbol.is_variable:
-                    self._add_observable_symbol(symbol, symbol.name, observable_symbols)
+                    symbols.append(symbol)
 
             block = block.superblock
 
+        # Which symbols are observable only depends on the scope and on the
+        # types in it, so a stop in a scope seen before skips the walk
+        # through their fields
+        function = frame.function()
+        key = (function.name if function is not None else None,
+               tuple(ranges),
+               tuple((symbol.name, str(symbol.type)) for symbol in symbols))
+        cached = self._symbol_scans.get(key)
+        if cached is not None:
+            self._symbol_scans.move_to_end(key)
+            return set(cached)
+
+        observable_symbols = set()
+        for symbol in symbols:
+            self._add_observable_symbol(symbol, symbol.name, observable_symbols)
+
+        self._symbol_scans[key] = frozenset(observable_symbols)
+        if len(self._symbol_scans) > SYMBOL_SCAN_CACHE_SIZE:
+            self._symbol_scans.popitem(last=False)
+
         return observable_symbols
 
 
+_REFERENCE_TYPE_CODES = tuple(
+    getattr(gdb, name) for name in ('TYPE_CODE_REF', 'TYPE_CODE_RVALUE_REF')
+    if hasattr(gdb, name))
+_INT_TYPE_CODES = (gdb.TYPE_CODE_INT, gdb.TYPE_CODE_CHAR, gdb.TYPE_CODE_ENUM,
+                   gdb.TYPE_CODE_BOOL)
+
+
+class GdbTypeLayout(TypeLayout):
+    """
+    TypeLayout of a gdb.Type, whose members are looked up as the resolution
+    plans compiled against it need them.
+    """
+    def __init__(self, gdb_type):
+        self._type = gdb_type.strip_typedefs()
+        code = self._type.code
+        self.size = self._type.sizeof
+        if code in _INT_TYPE_CODES:
+            self.kind = 'int'
+            self.signed = _is_signed(self._type)
+        elif code == gdb.TYPE_CODE_FLT:
+            self.kind = 'float'
+        elif code == gdb.TYPE_CODE_PTR:
+            self.kind = 'pointer'
+        elif code == gdb.TYPE_CODE_ARRAY:
+            self.kind = 'array'
+        elif code in (gdb.TYPE_CODE_STRUCT, gdb.TYPE_CODE_UNION):
+            self.kind = 'struct'
+
+    def member(self, name):
+        for field in self._type.fields():
+            bitpos = getattr(field, 'bitpos', None)
+            if field.name == name:
+                if bitpos is None or field.bitsize:
+                    # Static members and bit fields
+                    return 0, TypeLayout()
+                return bitpos // 8, GdbTypeLayout(field.type)
+            if bitpos is not None and (field.is_base_class or not field.name):
+                found = GdbTypeLayout(field.type).member(name)
+                if found is not None:
+                    return bitpos // 8 + found[0], found[1]
+        return None
+
+    def target(self):
+        return GdbTypeLayout(self._type.target())
+
+
+def _is_signed(gdb_type):
+    try:
+        # gdb 12 and later
+        return gdb_type.is_signed
+    except AttributeError:
+        return int(gdb.Value(-1).cast(gdb_type)) < 0
+
+
 class PlotterCommand(gdb.Command):
     """
     Implements the 'plot' command for the GDB command line mode
@@ -44,9 +44,50 @@ class BridgeInterface(object):
             row_stride:int,
             pixel_layout:str,
         }
+
+        Bridges that implement read_memory also take a lazy_min_bytes keyword:
+        a buffer at least that large is not read, and is returned with
+        pointer=None and its address:int in the debuggee instead.
+
+        Bridges that implement get_process_id also take a process_id keyword:
+        given one, no buffer is read, and each is returned with pointer=None,
+        its address:int and pid=process_id, for liboidbridge to read itself.
+        """
+        raise __not_implemented_error
+
+    def get_process_id(self):
+        # type: () -> int
+        """
+        Id of the process being debugged if it runs on this machine and its
+        memory can be read directly, as liboidbridge does where it can; None
+        for a remote target or a core file. Optional: a bridge without it
+        has every buffer read through the debugger.
+        """
+        return None
+
+    def read_memory(self, address, size):
+        # type: (int, int) -> bytes
+        """
+        Read 'size' bytes at 'address' in the debuggee, raising on failure.
+        Optional: a bridge without it never gets lazy plots (see
+        get_buffer_metadata).
         """
         raise __not_implemented_error
 
+    def get_object_layout(self, debugger_object):
+        # type: (DebuggerSymbolReference) -> Optional[ObjectLayout]
+        """
+        Where the object 'debugger_object' refers to (what it points to, for
+        a pointer) lies in the debuggee and how its type is laid out, so that
+        declarative types can read its members from memory rather than
+        through expressions (see oidtypes/resolution_plan.py). None if it
+        has no address. Optional: a bridge without it has every field of a
+        declarative type evaluated by the debugger on every plot. A bridge
+        with it also implements read_memory, and takes an int address in
+        get_casted_pointer.
+        """
+        return None
+
     @abc.abstractmethod
     def get_backend_name(self):
         # type: () -> str
@@ -170,6 +211,56 @@ class DebuggerSymbolReference(object):
         raise __not_implemented_error
 
 
+class TypeLayout(object):
+    """
+    How the debuggee lays out values of one type, as far as resolution plans
+    read them (see BridgeInterface.get_object_layout).
+
+    kind: 'int' (enums, bools and characters included), 'float',
+    'pointer', 'array', 'struct' (classes and unions too), or None for a
+    type plans cannot read.
+    size: bytes one value takes.
+    signed: for an 'int', whether it is signed.
+    """
+    kind = None
+    size = 0
+    signed = False
+
+    def member(self, name):
+        # type: (str) -> Optional[Tuple[int, TypeLayout]]
+        """
+        For a 'struct', the offset and layout of its data member 'name',
+        looked up through base classes and anonymous members the way the
+        debugger does; a layout of kind None for a member that is not plain
+        bytes of the object (a bit field, a static member). None if the type
+        has no member by that name.
+        """
+        return None
+
+    def target(self):
+        # type: () -> TypeLayout
+        """
+        For a 'pointer', the layout of what it points to; for an 'array',
+        that of its elements.
+        """
+        raise NotImplementedError("Method is not implemented")
+
+
+class ObjectLayout(object):
+    """
+    One object in the debuggee: its address, its type's TypeLayout, the
+    byte order of the target ('little' or 'big'), and the generation of
+    layouts it belongs to, which the bridge changes whenever layouts handed
+    out before may no longer hold (say, the program was rebuilt).
+    """
+
+    def __init__(self, address, layout, byteorder, generation):
+        self.address = address
+        self.layout = layout
+        self.byteorder = byteorder
+        self.generation = generation
+
+
 class BufferTooLargeError(RuntimeError):
     """
     Raised by get_buffer_metadata when the buffer exceeds the caller's
@@ -6,7 +6,6 @@ Code responsible with directly interacting with LLDB
 
 import lldb
 import re
-import time
 import threading
 
 from oidscripts import sysinfo
@@ -22,6 +21,9 @@ instance = None
 # JIT and its trouble resolving heavy templated types (e.g. Eigen).
 _PLAIN_IDENTIFIER_RE = re.compile(r'^[A-Za-z_]\w*$')
 
+# Process plugins of core files, which have no live process to read from.
+_CORE_FILE_PLUGINS = ('elf-core', 'mach-o-core', 'minidump')
+
 def _member_bearing_type_classes():
     # type: () -> int
     """The type classes whose children are the type's own declared members.
@@ -201,6 +203,9 @@ class LldbBridge(BridgeInterface):
         self._type_bridge = type_bridge
         self._pending_requests = []
         self._lock = threading.Lock()
+        # Set by queue_request() to run requests without waiting for the next
+        # frame check
+        self._requests_queued = threading.Event()
         self._event_queue = []
         self._event_handler = None
         self._last_thread_id = 0
@@ -262,12 +267,16 @@ class LldbBridge(BridgeInterface):
                 callback = requests_to_process.pop(0)
                 callback()
 
-            time.sleep(0.1)
+            # LLDB raises no stop event to scripts, so frames are still
+            # checked every 0.1 s
+            self._requests_queued.wait(0.1)
+            self._requests_queued.clear()
 
     def queue_request(self, callable_request):
         # type: (Callable[[None],None]) -> None
         with self._lock:
             self._pending_requests.append(callable_request)
+        self._requests_queued.set()
 
     def _get_process(self, debugger):
         # type: (lldb.SBDebugger) -> lldb.SBProcess
@@ -287,7 +296,8 @@ class LldbBridge(BridgeInterface):
             return None
         return thread.GetSelectedFrame()
 
-    def get_buffer_metadata(self, variable, max_bytes=None):
+    def get_buffer_metadata(self, variable, max_bytes=None,
+                            lazy_min_bytes=None, process_id=None):
         # type: (str) -> dict
         process = self._get_process(self.get_lldb_backend())
         thread = self._get_thread(process)
@@ -326,12 +336,25 @@ class LldbBridge(BridgeInterface):
             raise RuntimeError('Invalid null buffer pointer')
         if bufsize == 0:
             raise ValueError('Invalid buffer of zero bytes')
-        elif bufsize >= sysinfo.get_available_memory() / 10:
+
+        lazy = lazy_min_bytes is not None and bufsize >= lazy_min_bytes
+        if not lazy and bufsize >= sysinfo.get_available_memory() / 10:
             raise MemoryError('Invalid buffer size larger than available memory')
 
         raise_if_too_large(bufsize, max_bytes)
 
         buffer_metadata['variable_name'] = variable
+        if lazy:
+            # Read region by region through read_memory() instead
+            buffer_metadata['address'] = int(buffer_metadata['pointer'])
+            buffer_metadata['pointer'] = None
+            return buffer_metadata
+        if process_id is not None:
+            # Read by liboidbridge itself, straight from the process
+            buffer_metadata['address'] = int(buffer_metadata['pointer'])
+            buffer_metadata['pid'] = process_id
+            buffer_metadata['pointer'] = None
+            return buffer_metadata
 
         # ReadMemory returns None on failure (e.g. the address went stale
         # after the frame changed); surface a descriptive error instead of
@@ -349,6 +372,28 @@ class LldbBridge(BridgeInterface):
 
         return buffer_metadata
 
+    def read_memory(self, address, size):
+        process = self._get_process(self.get_lldb_backend())
+        read_error = lldb.SBError()
+        contents = process.ReadMemory(address, size, read_error)
+        if read_error.Fail() or contents is None:
+            raise RuntimeError(
+                'Could not read {} bytes at address {}: {}'.format(
+                    size, address, read_error.GetCString() or 'unknown error'))
+        return contents
+
+    def get_process_id(self):
+        target = self.get_lldb_backend().GetSelectedTarget()
+        process = target.process
+        # Only a process on this machine, not one on a remote platform nor a
+        # core file
+        if not process.IsValid() or \
+                target.GetPlatform().GetName() != 'host' or \
+                process.GetPluginName() in _CORE_FILE_PLUGINS:
+            return None
+        pid = process.GetProcessID()
+        return pid if pid > 0 else None
+
     def register_event_handlers(self, event_handler):
         self._event_handler = event_handler
 
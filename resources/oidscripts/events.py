@@ -4,8 +4,6 @@
 Implementation of handlers for events raised by the debugger
 """
 
-import time
-
 from oidscripts.debuggers.interfaces import BridgeEventHandlerInterface
 
 from oidscripts import agentendpoint
@@ -30,26 +28,25 @@ class OpenImageDebuggerEvents(BridgeEventHandlerInterface):
 
     def exit_handler(self):
         agentendpoint.shutdown()
-        self._window.terminate()
+        self._window.end_session()
 
     def stop_handler(self):
         """
         The debugger has stopped (e.g. a breakpoint was hit). We must list all
         available buffers and pass it to the Open Image Debugger window.
         """
-        # Block until the window is up and running
+        # Launches the window, or adopts a pre-spawned one, and returns once
+        # it is up and running or failed to start
         if not self._window.is_ready():
             self._window.initialize_window()
-            while not self._window.is_ready():
-                time.sleep(0.1)
 
-        # Update buffers being visualized
-        observed_buffers = self._window.get_observed_buffers()
-        for buffer_name in observed_buffers:
-            self._window.plot_variable(buffer_name)
+        if self._window.is_ready():
+            # Update buffers being visualized
+            observed_buffers = self._window.get_observed_buffers()
+            self._window.plot_variables(observed_buffers)
 
-        # Set list of available symbols
-        self._set_symbol_complete_list()
+            # Set list of available symbols
+            self._set_symbol_complete_list()
 
         # Let agent clients know the world may have changed
         agentendpoint.notify_stop()
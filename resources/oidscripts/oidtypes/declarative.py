@@ -10,6 +10,12 @@ expressions: this module only substitutes placeholders and hands the
 resulting strings to the debugger bridge for evaluation — it never
 interprets expression semantics itself, so the debugger remains the single
 source of expression meaning on every backend.
+
+On a bridge that reports object layouts, the expressions of an entry are
+also compiled into a resolution plan per concrete type (see
+resolution_plan.py), which reads the fields from memory instead. A plan is
+checked against the debugger's results on its first plot and dropped if
+they differ.
 """
 
 import difflib
@@ -19,7 +25,7 @@ import re
 
 from oidscripts import symbols
 from oidscripts.logger import log
-from oidscripts.oidtypes import interface
+from oidscripts.oidtypes import interface, resolution_plan
 
 OID_TYPES_PATH_ENV = 'OID_TYPES_PATH'
 BUILTIN_TYPES_FILENAME = 'builtin_types.json'
@@ -79,6 +85,9 @@ FIELD_DEFAULTS = {
     'transpose': False,
     'display_name': '{name} ({type})',
 }
+# Resolution plans an inspector keeps, one per concrete type it has plotted;
+# past this many they are all dropped and compiled again as needed.
+PLAN_CACHE_SIZE = 64
 
 # Fields resolve in this fixed order; each stage may reference the derived
 # placeholders of every earlier stage (checked statically at load time).
@@ -335,6 +344,41 @@ class _Resolution:
         return self._evaluate_via_bridge(self.substitute(text))
 
 
+class _PlannedResolution(_Resolution):
+    """
+    _Resolution that evaluates the templates its plan compiled from memory,
+    through 'reader', and only the others through the debugger. A compiled
+    pointer expression yields the address as an int, which bridges that
+    report layouts accept in get_casted_pointer.
+    """
+
+    def __init__(self, entry_name, obj_name, symbol_obj, bridge, plan,
+                 reader):
+        super().__init__(entry_name, obj_name, symbol_obj, bridge)
+        self._plan = plan
+        self._reader = reader
+
+    def _evaluate_compiled(self, compiled, text):
+        try:
+            return compiled.evaluate(self._reader, self.placeholders)
+        except resolution_plan.PlanEvaluationError as error:
+            raise EntryEvaluationError(
+                self.entry_name, self.field,
+                f'{self.substitute(text)!r} failed: {error}') from error
+
+    def evaluate(self, text):
+        compiled = self._plan.expressions.get(text)
+        if compiled is None:
+            return super().evaluate(text)
+        return self._evaluate_compiled(compiled, text)
+
+    def evaluate_pointer(self, text):
+        compiled = self._plan.expressions.get(text)
+        if compiled is None:
+            return super().evaluate_pointer(text)
+        return self._evaluate_compiled(compiled, text)
+
+
 def _condition_bool(resolution, expr):
     """
     Evaluate an 'if' condition and interpret the result as a boolean,
@@ -439,15 +483,16 @@ def _leaf_bool(resolution, node):
             f'{value!r} is not a boolean: {error}')
 
 
-def _dtype_code_from_name_or_expr(resolution, text):
+def _dtype_code_from_name_or_expr(resolution, node):
     """
-    Resolve a substituted dtype string: a known dtype name via the table,
-    otherwise a debugger expression whose integer result is the code.
+    Resolve a dtype string: a known dtype name (after substitution) via the
+    table, otherwise an expression whose integer result is the code.
     """
+    text = resolution.substitute(node).strip()
     if text in DTYPE_NAMES:
         return DTYPE_NAMES[text]
     try:
-        return _to_int(resolution.evaluate_text(text))
+        return _to_int(resolution.evaluate(node))
     except (EntryEvaluationError, TypeError, ValueError) as error:
         close = difflib.get_close_matches(text, DTYPE_NAMES, 1)
         if close:
@@ -470,8 +515,7 @@ def _leaf_dtype(resolution, node):
     must be a valid OID pixel type code.
     """
     if isinstance(node, str):
-        code = _dtype_code_from_name_or_expr(
-            resolution, resolution.substitute(node).strip())
+        code = _dtype_code_from_name_or_expr(resolution, node)
     elif isinstance(node, (bool, float)):
         # A JSON bool/float literal would be silently coerced by int()
         # (True -> 1, 5.9 -> 5) into a different pixel type code.
@@ -788,6 +832,56 @@ def _resolve_display_name(template, obj_name, symbol_obj):
         return f'{obj_name} ({symbol_obj.type})'
 
 
+def _expression_templates(node):
+    """
+    Every string in a value node that may be evaluated: leaves, 'if'
+    conditions, map and min-wrapper 'expr's. Literal leaves (dtype names,
+    pixel layouts) come along too and simply fail to compile.
+    """
+    if isinstance(node, str):
+        yield node
+    elif isinstance(node, list):
+        for candidate in node:
+            yield from _expression_templates(candidate)
+    elif isinstance(node, dict):
+        for key, value in node.items():
+            if key == 'map':
+                for branch in value.values():
+                    yield from _expression_templates(branch)
+            elif key != 'min':
+                yield from _expression_templates(value)
+
+
+class _Plan:
+    """
+    An entry's expressions compiled for one concrete type, by template.
+    'verified' once a plot resolved the same through it as through the
+    debugger.
+    """
+
+    def __init__(self, expressions):
+        self.expressions = expressions
+        self.verified = False
+
+
+def _same_metadata(expected, planned):
+    """
+    Whether a planned resolution matched the debugger's. The buffers are
+    compared by address: one is cast from a debugger value, the other from
+    the address the plan read.
+    """
+    for key, value in expected.items():
+        if key == 'pointer':
+            try:
+                if int(value) != int(planned[key]):
+                    return False
+            except (TypeError, ValueError):
+                return False
+        elif value != planned[key]:
+            return False
+    return True
+
+
 class DeclarativeInspector(interface.TypeInspectorInterface):
     """
     One declarative JSON entry, exposed through the same interface as a
@@ -801,6 +895,12 @@ class DeclarativeInspector(interface.TypeInspectorInterface):
         self._name = entry.get('name', entry['match'])
         self._source = source
         self._match_re = re.compile(entry['match'])
+        # Resolution plans by declared plus canonical type strings; None
+        # for a type whose expressions do not compile or whose plan did not
+        # match the debugger. All compiled against layouts of one
+        # generation (see ObjectLayout).
+        self._plans = {}
+        self._plan_generation = None
 
     @property
     def name(self):
@@ -814,10 +914,88 @@ class DeclarativeInspector(interface.TypeInspectorInterface):
         entry = self._entry
         return entry[field] if field in entry else FIELD_DEFAULTS[field]
 
-    def get_buffer_metadata(self, obj_name, picked_obj, debugger_bridge):
-        resolution = _Resolution(self._name, obj_name, picked_obj,
-                                 debugger_bridge)
+    def _compile_plan(self, picked_obj, layout):
+        expressions = {}
+        for field in RESOLUTION_ORDER:
+            for template in _expression_templates(self._field_node(field)):
+                if template in expressions:
+                    continue
+                try:
+                    expressions[template] = \
+                        resolution_plan.compile_expression(
+                            template, layout,
+                            lambda token: _resolve_targ_token(picked_obj,
+                                                              token))
+                except Exception:
+                    # PlanCompileError, or the debugger failing to describe
+                    # a member: the debugger evaluates this one
+                    continue
+        return _Plan(expressions) if expressions else None
+
+    def _plan_for(self, picked_obj, debugger_bridge):
+        """
+        The plan for the type of 'picked_obj' and a reader for the object,
+        compiling the plan on first sight of the type; (None, None) if
+        plots of it go through the debugger alone.
+        """
+        get_object_layout = getattr(debugger_bridge, 'get_object_layout',
+                                    None)
+        if get_object_layout is None:
+            return None, None
+        try:
+            object_layout = get_object_layout(picked_obj)
+        except Exception as error:
+            log.debug(f'{self._name}: no object layout: {error}')
+            return None, None
+        if object_layout is None:
+            return None, None
+
+        key = tuple(_type_strings(picked_obj))
+        if object_layout.generation != self._plan_generation or \
+                (key not in self._plans and
+                 len(self._plans) >= PLAN_CACHE_SIZE):
+            self._plans.clear()
+            self._plan_generation = object_layout.generation
+        if key not in self._plans:
+            self._plans[key] = self._compile_plan(picked_obj,
+                                                  object_layout.layout)
+        plan = self._plans[key]
+        if plan is None:
+            return None, None
+        return plan, resolution_plan.MemoryReader(debugger_bridge,
+                                                  object_layout)
 
+    def get_buffer_metadata(self, obj_name, picked_obj, debugger_bridge):
+        plan, reader = self._plan_for(picked_obj, debugger_bridge)
+        if plan is not None:
+            planned = _PlannedResolution(self._name, obj_name, picked_obj,
+                                         debugger_bridge, plan, reader)
+            if plan.verified:
+                try:
+                    return self._resolve(planned, obj_name, picked_obj,
+                                         debugger_bridge)
+                except Exception as error:
+                    # The debugger has the last word, on failures too
+                    log.debug(f'{self._name}: plan failed: {error}')
+
+        metadata = self._resolve(
+            _Resolution(self._name, obj_name, picked_obj, debugger_bridge),
+            obj_name, picked_obj, debugger_bridge)
+
+        if plan is not None and not plan.verified:
+            try:
+                plan.verified = _same_metadata(
+                    metadata, self._resolve(planned, obj_name, picked_obj,
+                                            debugger_bridge))
+            except Exception:
+                pass
+            if not plan.verified:
+                log.debug(f'{self._name}: plan for {picked_obj.type} does '
+                          'not match the debugger; not using it')
+                self._plans[tuple(_type_strings(picked_obj))] = None
+        return metadata
+
+    def _resolve(self, resolution, obj_name, picked_obj, debugger_bridge):
         resolution.field = 'dtype'
         dtype = _resolve_node(resolution, self._field_node('dtype'),
                               _leaf_dtype)
@@ -0,0 +1,527 @@
+# -*- coding: utf-8 -*-
+
+"""
+Resolution plans for declarative types.
+
+A plan is the expressions of one types.json entry compiled, once per
+concrete type, against the layout the debugger bridge reports for that type
+(see BridgeInterface.get_object_layout): member accesses become offsets into
+the object, '[i]' on a pointer a hop to the memory it points to, sizeof a
+constant. A plot of a type with a plan reads the object's header straight
+from memory instead of handing the debugger one expression per field.
+
+Only a small C subset compiles: integer literals, placeholders, member
+access, indexing, sizeof of an expression, and the unary and binary integer
+operators with C's conversions and truncating division. Anything else (a
+cast, an identifier, a floating-point member, a bit field) leaves that one
+expression to the debugger. The declarative engine checks a new plan's
+results against the debugger's before it uses the plan, so the debugger
+stays the reference for what every expression means.
+"""
+
+import re
+
+# Objects up to this size are read whole on a plot's first member access;
+# members of larger ones (a fixed-size matrix holding its pixels inline) are
+# read one by one instead.
+HEADER_READ_MAX_BYTES = 4096
+
+_TOKEN_RE = re.compile(
+    r'\s*(?:'
+    r'(?P<number>0[xX][0-9a-fA-F]+|\d+)(?P<suffix>[uUlL]*)'
+    r'|(?P<placeholder>\{[^{}]*\})'
+    r'|(?P<identifier>[A-Za-z_]\w*)'
+    r'|(?P<operator>->|<<|>>|<=|>=|==|!=|&&|\|\||[-+*/%&|^~!<>()\[\].])'
+    r')')
+
+# Binding strength of the binary operators, loosest first.
+_BINARY_PRECEDENCE = {
+    '||': 1, '&&': 2, '|': 3, '^': 4, '&': 5,
+    '==': 6, '!=': 6, '<': 7, '<=': 7, '>': 7, '>=': 7,
+    '<<': 8, '>>': 8, '+': 9, '-': 9, '*': 10, '/': 10, '%': 10,
+}
+
+
+class PlanCompileError(Exception):
+    """The expression is outside what a plan reads; the debugger keeps it."""
+
+
+class PlanEvaluationError(RuntimeError):
+    """
+    A compiled expression failed on this object, as the debugger would
+    have: a member its type does not have, unreadable memory, a division by
+    zero.
+    """
+
+
+class _Int(object):
+    """Static type of an integer value: width in bits and signedness."""
+
+    __slots__ = ('bits', 'unsigned')
+
+    def __init__(self, bits, unsigned):
+        self.bits = bits
+        self.unsigned = unsigned
+
+
+_INT = _Int(32, False)
+_SIZE_T = _Int(64, True)
+
+
+def _promote(int_type):
+    return _INT if int_type.bits < 32 else int_type
+
+
+def _common_type(left, right):
+    """C's usual arithmetic conversions, for integer operands."""
+    left, right = _promote(left), _promote(right)
+    if left.unsigned == right.unsigned:
+        return left if left.bits >= right.bits else right
+    unsigned, signed = (left, right) if left.unsigned else (right, left)
+    return unsigned if unsigned.bits >= signed.bits else signed
+
+
+def _wrap(value, int_type):
+    """'value' converted to 'int_type', two's complement as in C."""
+    value &= (1 << int_type.bits) - 1
+    if not int_type.unsigned and value >> (int_type.bits - 1):
+        value -= 1 << int_type.bits
+    return value
+
+
+def _divide(left, right):
+    if right == 0:
+        raise PlanEvaluationError('division by zero')
+    quotient = abs(left) // abs(right)
+    return -quotient if (left < 0) != (right < 0) else quotient
+
+
+_ARITHMETIC = {
+    '+': lambda left, right: left + right,
+    '-': lambda left, right: left - right,
+    '*': lambda left, right: left * right,
+    '/': _divide,
+    '%': lambda left, right: left - right * _divide(left, right),
+    '&': lambda left, right: left & right,
+    '|': lambda left, right: left | right,
+    '^': lambda left, right: left ^ right,
+}
+_COMPARISONS = {
+    '==': lambda left, right: left == right,
+    '!=': lambda left, right: left != right,
+    '<': lambda left, right: left < right,
+    '<=': lambda left, right: left <= right,
+    '>': lambda left, right: left > right,
+    '>=': lambda left, right: left >= right,
+}
+
+
+class _Node(object):
+    """
+    One compiled subexpression: 'run' computes its value from a
+    MemoryReader and the placeholder texts. An lvalue (an object in the
+    debuggee) has a 'layout' and runs to its address; an integer has an
+    'int_type'; a pointer rvalue has the 'target' layout it points to and
+    runs to the address it holds.
+    """
+
+    __slots__ = ('run', 'layout', 'int_type', 'target')
+
+    def __init__(self, run, layout=None, int_type=None, target=None):
+        self.run = run
+        self.layout = layout
+        self.int_type = int_type
+        self.target = target
+
+
+def _failing(message):
+    """
+    An expression the debugger rejects for every object of the type: it
+    fails when run, and has no type for anything built on it to go by.
+    """
+    def run(reader, placeholders):
+        raise PlanEvaluationError(message)
+
+    return _Node(run)
+
+
+def _is_failing(node):
+    return node.layout is None and node.int_type is None and \
+        node.target is None
+
+
+def _rvalue(node):
+    """
+    The value of 'node': an integer or pointer member read from memory, an
+    array decayed to a pointer to its first element. Raises PlanCompileError
+    for anything else.
+    """
+    layout = node.layout
+    if layout is None:
+        return node
+    address = node.run
+    if layout.kind == 'int':
+        size, signed = layout.size, layout.signed
+        int_type = _Int(size * 8, not signed)
+        return _Node(lambda reader, placeholders: reader.read_int(
+            address(reader, placeholders), size, signed), int_type=int_type)
+    if layout.kind == 'pointer':
+        size = layout.size
+        return _Node(lambda reader, placeholders: reader.read_int(
+            address(reader, placeholders), size, False),
+            target=layout.target())
+    if layout.kind == 'array':
+        return _Node(address, target=layout.target())
+    raise PlanCompileError(f'cannot read a {layout.kind or "opaque"} value')
+
+
+def _integer(node):
+    """'node' as an integer operand; pointers are only ever truth values."""
+    node = _rvalue(node)
+    if node.int_type is None:
+        raise PlanCompileError('pointer arithmetic is left to the debugger')
+    return node
+
+
+def _truth(node):
+    """Runs to whether 'node' is nonzero: an integer or a pointer."""
+    run = _rvalue(node).run
+    return lambda reader, placeholders: run(reader, placeholders) != 0
+
+
+def _member(node, name):
+    """node.name, through a pointer as the debugger allows."""
+    layout = node.layout
+    if layout is None or layout.kind == 'pointer':
+        pointer = _rvalue(node)
+        if pointer.target is None:
+            return _failing(f"there is no member named '{name}'")
+        return _member(_Node(pointer.run, layout=pointer.target), name)
+    if layout.kind != 'struct':
+        if layout.kind is None:
+            raise PlanCompileError(f"cannot tell if there is a member "
+                                   f"named '{name}'")
+        return _failing(f"there is no member named '{name}'")
+    found = layout.member(name)
+    if found is None:
+        return _failing(f"there is no member named '{name}'")
+    offset, member_layout = found
+    base = node.run
+    return _Node(lambda reader, placeholders:
+                 base(reader, placeholders) + offset,
+                 layout=member_layout)
+
+
+def _index(node, index):
+    """node[index] on a pointer or an array."""
+    pointer = _rvalue(node)
+    if _is_failing(pointer) or _is_failing(index):
+        return _failing_like(pointer, index)
+    if pointer.target is None:
+        raise PlanCompileError('only pointers and arrays are indexed')
+    element = pointer.target
+    if element.size <= 0:
+        raise PlanCompileError('cannot index a pointer to an incomplete type')
+    base, offset = pointer.run, _integer(index).run
+    size = element.size
+    return _Node(lambda reader, placeholders:
+                 base(reader, placeholders) +
+                 offset(reader, placeholders) * size,
+                 layout=element)
+
+
+def _literal(text, suffix):
+    if len(text) > 1 and text[0] == '0' and text[1] not in 'xX':
+        value = int(text, 8)
+    else:
+        value = int(text, 0)
+    # The first of these the value fits, as C types an integer literal:
+    # decimal ones stay signed unless suffixed 'u', octal and hexadecimal
+    # ones may turn unsigned.
+    suffix = suffix.lower()
+    candidates = [_INT, _Int(32, True), _Int(64, False), _SIZE_T]
+    if 'l' in suffix:
+        candidates = candidates[2:]
+    if 'u' in suffix:
+        candidates = [candidate for candidate in candidates
+                      if candidate.unsigned]
+    elif text[0] != '0':
+        candidates = [candidate for candidate in candidates
+                      if not candidate.unsigned]
+    for int_type in candidates:
+        if value < 1 << (int_type.bits - (0 if int_type.unsigned else 1)):
+            return _Node(lambda reader, placeholders: value,
+                         int_type=int_type)
+    raise PlanCompileError(f'integer literal {text} is too large')
+
+
+class _Parser(object):
+    """Precedence-climbing parser that compiles as it goes."""
+
+    def __init__(self, template, layout, targ_resolver):
+        self._tokens = _tokenize(template)
+        self._position = 0
+        self._layout = layout
+        self._targ_resolver = targ_resolver
+
+    def parse(self):
+        node = self._binary(1)
+        if self._peek() is not None:
+            raise PlanCompileError(f'unexpected {self._peek()[1]!r}')
+        return node
+
+    def _peek(self):
+        if self._position < len(self._tokens):
+            return self._tokens[self._position]
+        return None
+
+    def _take(self, expected=None):
+        token = self._peek()
+        if token is None or (expected is not None and token[1] != expected):
+            raise PlanCompileError(f'expected {expected or "more"}')
+        self._position += 1
+        return token
+
+    def _binary(self, min_precedence):
+        left = self._unary()
+        while True:
+            token = self._peek()
+            if token is None or token[0] != 'operator':
+                return left
+            precedence = _BINARY_PRECEDENCE.get(token[1])
+            if precedence is None or precedence < min_precedence:
+                return left
+            self._take()
+            right = self._binary(precedence + 1)
+            left = _binary_node(token[1], left, right)
+
+    def _unary(self):
+        token = self._peek()
+        if token is not None and token[0] == 'operator' and \
+                token[1] in ('-', '+', '~', '!'):
+            self._take()
+            return _unary_node(token[1], self._unary())
+        if token is not None and token == ('identifier', 'sizeof'):
+            self._take()
+            self._take('(')
+            operand = self._binary(1)
+            self._take(')')
+            size = _static_size(operand)
+            return _Node(lambda reader, placeholders: size, int_type=_SIZE_T)
+        return self._postfix(self._primary())
+
+    def _postfix(self, node):
+        while True:
+            token = self._peek()
+            if token is None or token[0] != 'operator':
+                return node
+            if token[1] == '.':
+                self._take()
+                node = _member(node, self._take_identifier())
+            elif token[1] == '->':
+                self._take()
+                if node.layout is not None and node.layout.kind == 'struct':
+                    raise PlanCompileError("'->' on a structure")
+                node = _member(node, self._take_identifier())
+            elif token[1] == '[':
+                self._take()
+                index = self._binary(1)
+                self._take(']')
+                node = _index(node, index)
+            else:
+                return node
+
+    def _take_identifier(self):
+        kind, text = self._take()
+        if kind != 'identifier':
+            raise PlanCompileError(f'expected a member name, not {text!r}')
+        return text
+
+    def _primary(self):
+        kind, text = self._take()
+        if kind == 'number':
+            return _literal(*text)
+        if kind == 'placeholder':
+            return self._placeholder(text[1:-1])
+        if text == '(':
+            node = self._binary(1)
+            self._take(')')
+            return node
+        raise PlanCompileError(f'{text!r} is left to the debugger')
+
+    def _placeholder(self, token):
+        if token == 'sym':
+            return _Node(lambda reader, placeholders: reader.address,
+                         layout=self._layout)
+        if token.startswith('targ:'):
+            try:
+                value = int(self._targ_resolver(token))
+            except Exception as error:
+                raise PlanCompileError(
+                    f'{{{token}}} is not a value argument: {error}')
+            return _Node(lambda reader, placeholders: value, int_type=_INT)
+        return _Node(lambda reader, placeholders: int(placeholders[token]),
+                     int_type=_INT)
+
+
+def _tokenize(template):
+    tokens = []
+    position = 0
+    while position < len(template):
+        match = _TOKEN_RE.match(template, position)
+        if match is None or match.end() == position:
+            if template[position:].strip():
+                raise PlanCompileError(
+                    f'unexpected {template[position:].strip()[0]!r}')
+            break
+        position = match.end()
+        if match.group('number') is not None:
+            tokens.append(('number', (match.group('number'),
+                                      match.group('suffix'))))
+        else:
+            kind = match.lastgroup
+            tokens.append((kind, match.group(kind)))
+    return tokens
+
+
+def _static_size(node):
+    if node.layout is not None:
+        if node.layout.size <= 0:
+            raise PlanCompileError('sizeof an incomplete type')
+        return node.layout.size
+    if node.int_type is not None:
+        return node.int_type.bits // 8
+    raise PlanCompileError('this sizeof is left to the debugger')
+
+
+def _failing_like(*operands):
+    """The first failing operand: the expression fails as it does."""
+    return next(operand for operand in operands if _is_failing(operand))
+
+
+def _unary_node(operator, operand):
+    if _is_failing(operand):
+        return operand
+    if operator == '!':
+        truth = _truth(operand)
+        return _Node(lambda reader, placeholders:
+                     0 if truth(reader, placeholders) else 1, int_type=_INT)
+    operand = _integer(operand)
+    int_type = _promote(operand.int_type)
+    run = operand.run
+    if operator == '-':
+        return _Node(lambda reader, placeholders:
+                     _wrap(-run(reader, placeholders), int_type),
+                     int_type=int_type)
+    if operator == '~':
+        return _Node(lambda reader, placeholders:
+                     _wrap(~run(reader, placeholders), int_type),
+                     int_type=int_type)
+    return _Node(lambda reader, placeholders:
+                 _wrap(run(reader, placeholders), int_type),
+                 int_type=int_type)
+
+
+def _binary_node(operator, left, right):
+    if _is_failing(left) or _is_failing(right):
+        return _failing_like(left, right)
+    if operator in ('&&', '||'):
+        left_truth, right_truth = _truth(left), _truth(right)
+        if operator == '&&':
+            return _Node(lambda reader, placeholders:
+                         1 if left_truth(reader, placeholders) and
+                         right_truth(reader, placeholders) else 0,
+                         int_type=_INT)
+        return _Node(lambda reader, placeholders:
+                     1 if left_truth(reader, placeholders) or
+                     right_truth(reader, placeholders) else 0,
+                     int_type=_INT)
+
+    left, right = _integer(left), _integer(right)
+    left_run, right_run = left.run, right.run
+    if operator in ('<<', '>>'):
+        int_type = _promote(left.int_type)
+
+        def shift(reader, placeholders):
+            value = _wrap(left_run(reader, placeholders), int_type)
+            count = right_run(reader, placeholders)
+            if count < 0 or count >= int_type.bits:
+                raise PlanEvaluationError(f'shift by {count}')
+            shifted = value << count if operator == '<<' else value >> count
+            return _wrap(shifted, int_type)
+
+        return _Node(shift, int_type=int_type)
+
+    int_type = _common_type(left.int_type, right.int_type)
+    if operator in _COMPARISONS:
+        compare = _COMPARISONS[operator]
+        return _Node(lambda reader, placeholders: 1 if compare(
+            _wrap(left_run(reader, placeholders), int_type),
+            _wrap(right_run(reader, placeholders), int_type)) else 0,
+            int_type=_INT)
+    apply = _ARITHMETIC[operator]
+    return _Node(lambda reader, placeholders: _wrap(apply(
+        _wrap(left_run(reader, placeholders), int_type),
+        _wrap(right_run(reader, placeholders), int_type)), int_type),
+        int_type=int_type)
+
+
+class CompiledExpression(object):
+    """One expression template of an entry, compiled for one type."""
+
+    def __init__(self, node):
+        self._run = node.run
+
+    def evaluate(self, reader, placeholders):
+        # type: (MemoryReader, dict) -> int
+        """
+        The integer (or address) the expression has for the object
+        'reader' reads, given the derived placeholders' texts. Raises
+        PlanEvaluationError where the debugger would fail.
+        """
+        return self._run(reader, placeholders)
+
+
+def compile_expression(template, layout, targ_resolver):
+    # type: (str, TypeLayout, Callable[[str], str]) -> CompiledExpression
+    """
+    Compile 'template' for objects laid out as 'layout', resolving
+    {targ:…} tokens through 'targ_resolver'. Raises PlanCompileError if
+    the expression is outside what plans read.
+    """
+    node = _rvalue(_Parser(template, layout, targ_resolver).parse())
+    return CompiledExpression(node)
+
+
+class MemoryReader(object):
+    """
+    Reads one object's members for the compiled expressions of one plot:
+    the object itself at most once, and what its pointers lead to as they
+    are followed.
+    """
+
+    def __init__(self, bridge, object_layout):
+        self.address = object_layout.address
+        self._bridge = bridge
+        self._byteorder = object_layout.byteorder
+        self._size = object_layout.layout.size
+        self._header = None
+
+    def read_int(self, address, size, signed):
+        offset = address - self.address
+        if 0 <= offset and offset + size <= self._size <= \
+                HEADER_READ_MAX_BYTES:
+            if self._header is None:
+                self._header = self._read(self.address, self._size)
+            data = self._header[offset:offset + size]
+        else:
+            data = self._read(address, size)
+        return int.from_bytes(data, self._byteorder, signed=signed)
+
+    def _read(self, address, size):
+        try:
+            return bytes(self._bridge.read_memory(address, size))
+        except Exception as error:
+            raise PlanEvaluationError(
+                f'cannot read {size} bytes at {address:#x}: {error}') \
+                from error
@@ -4,21 +4,85 @@
 Classes related to exposing an interface to the OpenImageDebugger window
 """
 
+import atexit
 import ctypes
 import ctypes.util
 import os
 import platform
 import sys
-import time
 
+from oidscripts.debuggers.interfaces import BridgeInterface
 from oidscripts.logger import log
 
 FETCH_BUFFER_CBK_TYPE = ctypes.CFUNCTYPE(ctypes.c_int,
                                          ctypes.c_char_p)
 
+READ_MEMORY_CBK_TYPE = ctypes.CFUNCTYPE(ctypes.c_int,
+                                        ctypes.c_ulonglong,
+                                        ctypes.c_size_t,
+                                        ctypes.c_void_p)
+
+REQUEST_NOTIFIER_CBK_TYPE = ctypes.CFUNCTYPE(None)
+
 
 PLATFORM_NAME = platform.system().lower()
 
+
+def _plot_chunk_bytes():
+    """
+    Row-strip size the native bridge streams plots in, from
+    OID_PLOT_CHUNK_BYTES (0 sends each buffer as one message). None keeps the
+    bridge's default; a non-integer value is ignored rather than breaking
+    window start-up.
+    """
+    raw = os.environ.get('OID_PLOT_CHUNK_BYTES')
+    if raw:
+        try:
+            return int(raw)
+        except ValueError:
+            log.warning('ignoring non-integer OID_PLOT_CHUNK_BYTES=%r', raw)
+    return None
+
+
+def _plot_compression():
+    """
+    Whether the native bridge may compress plot strips for a window that
+    supports it, from OID_PLOT_COMPRESSION ('0' turns it off). None keeps the
+    bridge's default, which is on.
+    """
+    raw = os.environ.get('OID_PLOT_COMPRESSION')
+    if raw:
+        return raw.strip() not in ('0', 'false', 'off', 'no')
+    return None
+
+
+def _quick_look_factor():
+    """
+    Decimation factor of quick-look plots, from OID_QUICK_LOOK: buffers of
+    16 MiB and more are first shown as every N-th row and column, and
+    plotted in full on request. None (or 1) keeps every plot exact; a
+    non-integer value is ignored rather than breaking window start-up.
+    """
+    raw = os.environ.get('OID_QUICK_LOOK')
+    if raw:
+        try:
+            return int(raw)
+        except ValueError:
+            log.warning('ignoring non-integer OID_QUICK_LOOK=%r', raw)
+    return None
+
+
+def _persistent_viewer():
+    """
+    Whether to launch the window as soon as the scripts load and keep it
+    open from one debug session to the next, from OID_PERSISTENT_VIEWER
+    ('1' turns it on). The first stop then finds the window up instead of
+    waiting for it to start.
+    """
+    raw = os.environ.get('OID_PERSISTENT_VIEWER')
+    return bool(raw) and raw.strip() not in ('0', 'false', 'off', 'no')
+
+
 class OpenImageDebuggerWindow(object):
     """
     Python interface for the OpenImageDebugger window, which is implemented as a
@@ -52,6 +116,12 @@ class OpenImageDebuggerWindow(object):
         self._lib.oid_exec.argtypes = [ctypes.c_void_p]
         self._lib.oid_exec.restype = None
 
+        self._lib.oid_launch.argtypes = [ctypes.c_void_p]
+        self._lib.oid_launch.restype = None
+
+        self._lib.oid_end_session.argtypes = [ctypes.c_void_p]
+        self._lib.oid_end_session.restype = None
+
         self._lib.oid_is_window_ready.argtypes = [ctypes.c_void_p]
         self._lib.oid_is_window_ready.restype = ctypes.c_bool
 
@@ -73,16 +143,34 @@ class OpenImageDebuggerWindow(object):
         ]
         self._lib.oid_plot_buffer.restype = None
 
+        self._lib.oid_plot_buffers.argtypes = [
+            ctypes.c_void_p,
+            ctypes.py_object
+        ]
+        self._lib.oid_plot_buffers.restype = None
+
+        self._lib.oid_set_memory_reader.argtypes = [
+            ctypes.c_void_p,
+            READ_MEMORY_CBK_TYPE
+        ]
+        self._lib.oid_set_memory_reader.restype = None
+
+        self._lib.oid_region_fetch_min_bytes.argtypes = [ctypes.c_void_p]
+        self._lib.oid_region_fetch_min_bytes.restype = ctypes.c_size_t
+
+        self._lib.oid_set_request_notifier.argtypes = [
+            ctypes.c_void_p,
+            REQUEST_NOTIFIER_CBK_TYPE
+        ]
+        self._lib.oid_set_request_notifier.restype = None
+
         # UI handler
         self._native_handler = None
-        self._event_loop_wait_time = 1.0/30.0
-        self._previous_evloop_time = OpenImageDebuggerWindow.__get_time_ms()
+        self._persistent = _persistent_viewer()
         self._plot_variable_c_callback = FETCH_BUFFER_CBK_TYPE(self.plot_variable)
-
-
-    @staticmethod
-    def __get_time_ms():
-        return int(time.time() * 1000.0)
+        self._read_memory_c_callback = READ_MEMORY_CBK_TYPE(self.read_memory)
+        self._request_notifier_c_callback = REQUEST_NOTIFIER_CBK_TYPE(
+            self.request_event_loop)
 
     @staticmethod
     def __get_library_name():
@@ -105,17 +193,26 @@ class OpenImageDebuggerWindow(object):
         will be executed. This object will be given to the debugger bridge so
         that it can schedule its execution in a thread safe context.
         """
+        return self.plot_variables([requested_symbol])
+
+    def plot_variables(self, requested_symbols):
+        """
+        Plot every variable named in 'requested_symbols' with a single
+        DeferredVariablePlotter, so that they reach the window together: one
+        debugger hop and one batch instead of one of each per variable.
+        """
         if self._bridge is None:
-            log.info(f"Could not plot symbol {requested_symbol}: Not a debugging session")
+            log.info(f"Could not plot symbols {requested_symbols}: Not a debugging session")
             return 0
 
         try:
-            if not isinstance(requested_symbol, str):
-                variable = requested_symbol.decode('utf-8')
-            else:
-                variable = requested_symbol
+            variables = [symbol if isinstance(symbol, str)
+                         else symbol.decode('utf-8')
+                         for symbol in requested_symbols]
+            if not variables:
+                return 1
 
-            plot_callable = DeferredVariablePlotter(variable,
+            plot_callable = DeferredVariablePlotter(variables,
                                                     self._lib,
                                                     self._bridge,
                                                     self._native_handler)
@@ -127,6 +224,23 @@ class OpenImageDebuggerWindow(object):
 
         return 0
 
+    def read_memory(self, address, size, destination):
+        """
+        Copy 'size' bytes at 'address' in the debuggee to 'destination', for
+        the regions of lazily plotted buffers. Returns 1 on success, 0 if the
+        memory could not be read.
+        """
+        try:
+            contents = self._bridge.read_memory(address, size)
+            if len(contents) != size:
+                return 0
+            ctypes.memmove(destination, contents, size)
+            return 1
+        except Exception as err:
+            log.warning('could not read %d bytes at %#x: %s',
+                        size, address, err)
+        return 0
+
     def is_ready(self):
         """
         Returns True if the OpenImageDebugger window has been loaded; False otherwise.
@@ -140,7 +254,34 @@ class OpenImageDebuggerWindow(object):
         """
         Request OID to terminate application and close all windows
         """
+        if self._native_handler is None:
+            return
         self._lib.oid_cleanup(self._native_handler)
+        self._native_handler = None
+
+    def end_session(self):
+        """
+        The debuggee has exited: close the window, or keep a persistent one
+        open for the next debug session.
+        """
+        if not self._persistent:
+            self.terminate()
+        elif self._native_handler is not None:
+            self._lib.oid_end_session(self._native_handler)
+
+    def prespawn(self):
+        """
+        With a persistent viewer, launch the window now, without waiting for
+        it, so that it is up by the first stop. The scripts call this as
+        they load.
+        """
+        if not self._persistent:
+            return
+        self.__create_native_handler()
+        self._lib.oid_launch(self._native_handler)
+        # gdb quits without raising 'exited' when the debuggee is still
+        # alive; the window goes with it either way
+        atexit.register(self.terminate)
 
     def set_available_symbols(self, observable_symbols):
         """
@@ -159,16 +300,18 @@ class OpenImageDebuggerWindow(object):
 
     def run_event_loop(self):
         """
-        Run the debugger-side event loop, which consists of checking for new
-        user requests coming from the UI
+        Run the debugger-side event loop, which acts on the user requests
+        that came from the UI since it last ran
         """
-        current_time = OpenImageDebuggerWindow.__get_time_ms()
-        dt = current_time - self._previous_evloop_time
-        if dt > self._event_loop_wait_time:
+        if self._native_handler is not None:
             self._lib.oid_run_event_loop(self._native_handler)
-            self._previous_evloop_time = current_time
 
-        # Schedule next run of the event loop
+    def request_event_loop(self):
+        """
+        Called by the native bridge, from a thread of its own, whenever the UI
+        sent requests: the debugger runs the event loop as soon as it can,
+        and never polls for them.
+        """
         self._bridge.queue_request(self.run_event_loop)
 
     def get_observed_buffers(self):
@@ -178,40 +321,98 @@ class OpenImageDebuggerWindow(object):
         return self._lib.oid_get_observed_buffers(self._native_handler)
 
     def initialize_window(self):
-        # Initialize OID lib
+        self.__create_native_handler()
+
+        # Launch UI, or adopt the window prespawn() launched
+        self._lib.oid_exec(self._native_handler)
+
+    def __create_native_handler(self):
+        """
+        Initialize OID lib, unless done before: a window closed by the user
+        is launched again by the same handler.
+        """
+        if self._native_handler is not None:
+            return
+
+        optional_parameters = {'oid_path': self._script_path}
+        plot_chunk_bytes = _plot_chunk_bytes()
+        if plot_chunk_bytes is not None:
+            optional_parameters['plot_chunk_bytes'] = plot_chunk_bytes
+        plot_compression = _plot_compression()
+        if plot_compression is not None:
+            optional_parameters['plot_compression'] = plot_compression
+        quick_look_factor = _quick_look_factor()
+        if quick_look_factor is not None:
+            optional_parameters['quick_look_factor'] = quick_look_factor
         self._native_handler = self._lib.oid_initialize(
             self._plot_variable_c_callback,
-            {'oid_path': self._script_path})
+            optional_parameters)
 
-        # Launch UI
-        self._lib.oid_exec(self._native_handler)
+        # Lazy plots of huge buffers need a bridge that can read debuggee
+        # memory on demand
+        if type(self._bridge).read_memory is not BridgeInterface.read_memory:
+            self._lib.oid_set_memory_reader(self._native_handler,
+                                            self._read_memory_c_callback)
 
-        # Schedule event loop
-        self._bridge.queue_request(self.run_event_loop)
+        # UI requests reach the debugger through the event loop
+        self._lib.oid_set_request_notifier(self._native_handler,
+                                           self._request_notifier_c_callback)
 
 
 class DeferredVariablePlotter(object):
     """
     Instances of this class are callable objects whose __call__ method triggers
-    a buffer plot command. Useful for deferring the plot command to a safe
-    thread.
+    a plot command for a list of buffers. Useful for deferring the plot command
+    to a safe thread.
     """
-    def __init__(self, variable, lib, bridge, native_handler):
-        self._variable = variable
+    def __init__(self, variables, lib, bridge, native_handler):
+        self._variables = variables
         self._lib = lib
         self._bridge = bridge
         self._native_handler = native_handler
 
+    def _buffers_metadata(self, lazy_min_bytes):
+        """
+        Yield the metadata of each variable as the native side asks for it,
+        so that reading one buffer overlaps with sending the one before.
+        Variables that cannot be plotted are logged and skipped.
+        """
+        # Only the keywords the bridge takes (see BridgeInterface)
+        options = {}
+        if lazy_min_bytes > 0:
+            options['lazy_min_bytes'] = lazy_min_bytes
+        process_id = self._bridge.get_process_id()
+        if process_id is not None:
+            options['process_id'] = process_id
+        for variable in self._variables:
+            try:
+                buffer_metadata = self._bridge.get_buffer_metadata(
+                    variable, **options)
+            except Exception as err:
+                import traceback
+                log.error("Could not plot variable")
+                log.error(err)
+                traceback.print_exc()
+                continue
+
+            if buffer_metadata is not None:
+                yield buffer_metadata
+
     def __call__(self):
         try:
-            buffer_metadata = self._bridge.get_buffer_metadata(self._variable)
-
-            if buffer_metadata is None:
-                return
-
-            self._lib.oid_plot_buffer(
-                self._native_handler,
-                buffer_metadata)
+            lazy_min_bytes = self._lib.oid_region_fetch_min_bytes(
+                self._native_handler)
+            buffers_metadata = self._buffers_metadata(lazy_min_bytes)
+
+            if len(self._variables) == 1:
+                for buffer_metadata in buffers_metadata:
+                    self._lib.oid_plot_buffer(
+                        self._native_handler,
+                        buffer_metadata)
+            else:
+                self._lib.oid_plot_buffers(
+                    self._native_handler,
+                    buffers_metadata)
 
         except Exception as err:
             import traceback
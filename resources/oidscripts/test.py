@@ -32,8 +32,7 @@ def oidtest(script_path):
 
         window.set_available_symbols(dummy_debugger.get_available_symbols())
 
-        for buffer in dummy_debugger.get_available_symbols():
-            window.plot_variable(buffer)
+        window.plot_variables(dummy_debugger.get_available_symbols())
 
         while window.is_ready():
             dummy_debugger.run_event_loop()
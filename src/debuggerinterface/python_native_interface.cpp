@@ -56,13 +56,17 @@ int check_py_string_type(PyObject* obj) {
     return PyUnicode_Check(obj) == 1 ? 1 : PyBytes_Check(obj);
 }
 
-void get_c_ptr_from_py_buffer(PyObject* obj,
-                              uint8_t*& buffer_ptr,
-                              size_t& buffer_size) {
-    assert(PyMemoryView_Check(obj));
-    const auto py_buff = PyMemoryView_GET_BUFFER(obj);
-    buffer_ptr = static_cast<uint8_t*>(py_buff->buf);
-    buffer_size = static_cast<size_t>(py_buff->len);
+void PyBufferRelease::operator()(Py_buffer* view) const noexcept {
+    PyBuffer_Release(view);
+    delete view;
+}
+
+PyBufferView get_py_buffer(PyObject* obj) {
+    auto view = std::make_unique<Py_buffer>();
+    if (PyObject_GetBuffer(obj, view.get(), PyBUF_SIMPLE) != 0) {
+        return nullptr;
+    }
+    return PyBufferView{view.release()};
 }
 
 } // namespace oid
@@ -26,6 +26,7 @@
 #ifndef PYTHON_NATIVE_INTERFACE_H_
 #define PYTHON_NATIVE_INTERFACE_H_
 
+#include <memory>
 #include <string>
 
 #include <Python.h>
@@ -42,9 +43,18 @@ long get_py_int(PyObject* obj);
 
 int check_py_string_type(PyObject* obj);
 
-void get_c_ptr_from_py_buffer(PyObject* obj,
-                              uint8_t*& buffer_ptr,
-                              size_t& buffer_size);
+// Releases a view taken by get_py_buffer(). Needs the GIL.
+struct PyBufferRelease {
+    void operator()(Py_buffer* view) const noexcept;
+};
+
+using PyBufferView = std::unique_ptr<Py_buffer, PyBufferRelease>;
+
+// Exports the contiguous bytes of a buffer-protocol object (such as the
+// memoryview a debugger returns for inferior memory) without copying them.
+// The exporter keeps them in place until the view is released. Returns
+// nullptr, with a Python exception set, if it cannot.
+PyBufferView get_py_buffer(PyObject* obj);
 
 uint8_t* get_c_ptr_from_py_tuple(PyObject* obj, int tuple_index);
 
@@ -117,7 +117,8 @@ bool NativeViewModel::read_pixels(const std::string_view name,
     if (!idx.has_value()) {
         return false;
     }
-    out = model_.at(*idx).bytes;
+    const auto& bytes = model_.at(*idx).bytes;
+    out.assign(bytes.begin(), bytes.end());
     return true;
 }
 
@@ -109,6 +109,15 @@ CliOptions parse_cli(const int argc, const char* const* argv) {
         } else if (matches(arg, {"--agent-debugger-pid"}) && value != nullptr) {
             options.agent_debugger_pid = parse_positive_int(value);
             i += 2;
+        } else if (matches(arg, {"--shm"}) && value != nullptr) {
+            options.shm_name = value;
+            i += 2;
+        } else if (matches(arg, {"--socket"}) && value != nullptr) {
+            options.socket_path = value;
+            i += 2;
+        } else if (matches(arg, {"--lanes"}) && value != nullptr) {
+            options.data_lanes = parse_positive_int(value).value_or(0);
+            i += 2;
         } else {
             // Bare/unknown flags, and value-taking flags with no following
             // token, are ignored.
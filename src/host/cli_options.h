@@ -38,15 +38,24 @@ struct CliOptions {
     int port{9588};
     std::vector<std::string> open_files;
     std::optional<int> agent_debugger_pid;
+    // Shared-memory ring offered by the launching bridge; empty for none.
+    std::string shm_name;
+    // Unix-domain socket the launching bridge listens on, used instead of
+    // hostname/port; empty for none.
+    std::string socket_path;
+    // Data lanes the launching bridge asked for besides the control
+    // connection (see ipc/plot_buffer_sender.h); 0 for none.
+    int data_lanes{};
 };
 
 // Parses argv into CliOptions. Recognized flags: `--host H`; `--port N` /
 // `-p N` (via std::atoi -- invalid or non-positive input leaves the
 // default); repeatable `-o PATH` / `--open PATH` (each occurrence appends to
 // open_files); `--agent-debugger-pid PID` (invalid input leaves
-// agent_debugger_pid unset). Unknown arguments are ignored; a trailing
-// `-o`/`--open`/`--host`/`--port`/`-p`/`--agent-debugger-pid` with no
-// following value is ignored.
+// agent_debugger_pid unset); `--shm NAME`; `--socket PATH`; `--lanes N`
+// (invalid or non-positive input leaves 0). Unknown arguments are ignored;
+// a trailing `-o`/`--open`/`--host`/`--port`/`-p`/`--agent-debugger-pid`/
+// `--shm`/`--socket`/`--lanes` with no following value is ignored.
 [[nodiscard]] CliOptions parse_cli(int argc, const char* const* argv);
 
 } // namespace oid::host
@@ -31,6 +31,7 @@
 #include <format>
 #include <fstream>
 #include <new>
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -99,14 +100,12 @@ element_count(const int width, const int height, const int channels) {
            static_cast<std::size_t>(channels);
 }
 
-// Copies `count` elements of type T (as returned by stb) into a byte vector.
-// The end pointer is computed in T-space (pixels + count) and only then cast to
-// bytes, so element size never enters the pointer arithmetic.
+// Copies `count` elements of type T (as returned by stb) into pixel storage.
+// The span is sized in T-space and only then viewed as bytes, so element size
+// never enters the pointer arithmetic.
 template <typename T>
-std::vector<std::byte> pixels_to_bytes(const T* pixels, std::size_t count) {
-    const auto* first = reinterpret_cast<const std::byte*>(pixels);
-    const auto* last = reinterpret_cast<const std::byte*>(pixels + count);
-    return std::vector(first, last);
+PayloadBytes pixels_to_bytes(const T* pixels, std::size_t count) {
+    return PayloadBytes{std::as_bytes(std::span{pixels, count})};
 }
 
 // Decodes stb-supported image bytes into BufferRecordParams.
@@ -29,6 +29,7 @@
 #include <charconv>
 #include <cstdint>
 #include <string_view>
+#include <vector>
 
 namespace oid {
 
@@ -326,8 +327,8 @@ Expected<NpyArray> decode_npy(std::span<const std::byte> data) {
         return make_error("npy: payload size mismatch");
     }
 
-    const std::byte* payload = data.data() + parsed->payload_offset;
-    out.bytes.assign(payload, payload + expected_bytes);
+    out.bytes =
+        PayloadBytes{data.subspan(parsed->payload_offset, expected_bytes)};
     return out;
 }
 
@@ -28,9 +28,9 @@
 
 #include <cstddef>
 #include <span>
-#include <vector>
 
 #include "host/io/expected.h"
+#include "ipc/payload_bytes.h"
 #include "ipc/raw_data_decode.h"
 
 namespace oid {
@@ -42,7 +42,7 @@ struct NpyArray {
     int channels{1};
     int step{0};
     bool transpose{false};
-    std::vector<std::byte> bytes;
+    PayloadBytes bytes;
 };
 
 // Decode a NumPy .npy byte buffer (v1/v2/v3, little-endian dtypes,
@@ -41,10 +41,11 @@ BufferRecord make_buffer_record(BufferRecordParams params) {
     record.step = params.stride;
     record.type = params.type;
 
-    if (params.type == BufferType::FLOAT64) {
-        record.bytes = make_float_buffer_from_double(params.bytes);
-    } else {
-        record.bytes = std::move(params.bytes);
+    record.bytes = std::move(params.bytes);
+    if (params.type == BufferType::FLOAT64 && !params.narrowed) {
+        // In the received block itself: no second, float-sized one.
+        record.bytes.shrink(
+            narrow_doubles_to_floats_in_place(record.bytes).size());
     }
 
     return record;
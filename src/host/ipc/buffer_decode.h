@@ -28,9 +28,9 @@
 
 #include <cstddef>
 #include <string>
-#include <vector>
 
 #include "host/ui/buffer_model.h"
+#include "ipc/payload_bytes.h"
 #include "ipc/raw_data_decode.h"
 
 namespace oid::host {
@@ -49,7 +49,10 @@ struct BufferRecordParams {
     int channels;
     int stride;
     BufferType type;
-    std::vector<std::byte> bytes;
+    PayloadBytes bytes;
+    // FLOAT64 bytes already narrowed to float32 as they arrived (see
+    // BufferAssembler::Float64Rows::NARROWED); `type` still says FLOAT64.
+    bool narrowed{false};
 };
 
 // Builds a BufferRecord from already-decoded wire fields. This is the
@@ -57,9 +60,10 @@ struct BufferRecordParams {
 // chunked (PLOT_BUFFER_END) decode paths both call, mirroring the Qt
 // window's MessageHandler::plot_buffer_from_fields exactly: fields are
 // assigned straight across, `stride` becomes BufferRecord::step, and
-// FLOAT64 payloads are converted to float bytes via
-// oid::make_float_buffer_from_double() (BufferRecord::type is left as
-// FLOAT64, unchanged, matching the Qt path).
+// FLOAT64 payloads are narrowed to float bytes in place via
+// oid::narrow_doubles_to_floats_in_place(), unless `narrowed` says that
+// happened already (BufferRecord::type is left as FLOAT64, unchanged,
+// matching the Qt path).
 BufferRecord make_buffer_record(BufferRecordParams params);
 
 } // namespace oid::host
@@ -0,0 +1,221 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "host/ipc/data_lane_reader.h"
+
+#include <algorithm>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "ipc/message_exchange.h"
+#include "ipc/payload_bytes.h"
+
+namespace oid::host {
+
+namespace {
+
+// How long a lane reader sleeps when its lane has nothing for it yet, as
+// IpcClient's receiver thread does.
+constexpr auto LANE_IDLE_WAIT = std::chrono::milliseconds{1};
+
+} // namespace
+
+ReceivedChunk receive_chunk(ITransport& transport,
+                            BufferAssembler& assembler,
+                            const bool compressed) {
+    ReceivedChunk chunk;
+    MessageDecoder decoder{transport};
+    decoder.read(chunk.name).read(chunk.row_offset).read(chunk.row_count);
+    chunk.size = decoder.read_length();
+    if (compressed) {
+        auto block = PayloadBytes::uninitialized(chunk.size);
+        decoder.read_payload(block);
+        chunk.taken = assembler.compressed_chunk(
+            chunk.name, chunk.row_offset, chunk.row_count, block);
+        return chunk;
+    }
+    auto pending =
+        assembler.chunk_rows(chunk.name, chunk.row_offset, chunk.row_count);
+    if (pending.has_value() && pending->rows().size() == chunk.size) {
+        decoder.read_payload(pending->rows());
+        chunk.taken = assembler.commit_rows(std::move(*pending));
+    } else {
+        auto refused = PayloadBytes::uninitialized(chunk.size);
+        decoder.read_payload(refused);
+    }
+    return chunk;
+}
+
+DataLaneReader::DataLaneReader(std::vector<std::unique_ptr<ITransport>> lanes,
+                               BufferAssembler& assembler)
+    : assembler_(assembler) {
+    lanes_.reserve(lanes.size());
+    for (auto& transport : lanes) {
+        lanes_.push_back({.transport = std::move(transport)});
+    }
+    readers_.reserve(lanes_.size());
+    for (auto& lane : lanes_) {
+        readers_.emplace_back(
+            [this, &lane](const std::stop_token& stop) {
+                read_lane(stop, lane);
+            });
+    }
+}
+
+DataLaneReader::~DataLaneReader() {
+    // The readers go before the lanes they read.
+    for (auto& reader : readers_) {
+        reader.request_stop();
+    }
+    readers_.clear();
+}
+
+std::size_t DataLaneReader::size() const {
+    return lanes_.size();
+}
+
+void DataLaneReader::expect(const std::uint64_t fence,
+                            const std::size_t count) {
+    {
+        const std::scoped_lock lock(mutex_);
+        fence_ = fence;
+        count_ = std::min(count, lanes_.size());
+        reading_ = true;
+        awaited_ = true;
+    }
+    changed_.notify_all();
+}
+
+bool DataLaneReader::wait_for_fence(const std::chrono::milliseconds timeout) {
+    std::unique_lock lock(mutex_);
+    if (!awaited_) {
+        return true;
+    }
+    changed_.wait_for(lock, timeout, [this] { return settled(); });
+    awaited_ = false;
+    if (!passed()) {
+        return false;
+    }
+    // Lanes the bridge did not use need not be watched any longer.
+    reading_ = false;
+    return true;
+}
+
+bool DataLaneReader::passed() const {
+    return static_cast<std::size_t>(std::ranges::count_if(
+               lanes_, [this](const Lane& lane) {
+                   return lane.passed >= fence_;
+               })) >= count_;
+}
+
+bool DataLaneReader::settled() const {
+    return passed() || std::ranges::all_of(lanes_, [this](const Lane& lane) {
+               return lane.broken || lane.passed >= fence_;
+           });
+}
+
+void DataLaneReader::read_lane(const std::stop_token& stop, Lane& lane) {
+    while (!stop.stop_requested()) {
+        {
+            std::unique_lock lock(mutex_);
+            if (!changed_.wait(lock, stop, [this, &lane] {
+                    return reading_ && lane.passed < fence_;
+                })) {
+                return;
+            }
+        }
+        if (!lane.transport->has_data()) {
+            std::this_thread::sleep_for(LANE_IDLE_WAIT);
+            continue;
+        }
+        if (!read_message(lane)) {
+            {
+                const std::scoped_lock lock(mutex_);
+                lane.broken = true;
+            }
+            changed_.notify_all();
+            return;
+        }
+    }
+}
+
+bool DataLaneReader::read_message(Lane& lane) {
+    // Unlike the control stream, a lane carries nothing but strips, so a
+    // message cut short leaves nothing worth reading after it.
+    try {
+        auto header = MessageType{};
+        MessageDecoder{*lane.transport}.read(header);
+        switch (header) {
+        case MessageType::PLOT_BUFFER_CHUNK:
+        case MessageType::PLOT_BUFFER_CHUNK_COMPRESSED: {
+            const auto compressed =
+                header == MessageType::PLOT_BUFFER_CHUNK_COMPRESSED;
+            const auto chunk =
+                receive_chunk(*lane.transport, assembler_, compressed);
+            // Left in place for PLOT_BUFFER_END to refuse as incomplete,
+            // which also has the bridge resend one already previewed.
+            if (!chunk.taken) {
+                std::cerr << "[OID] rejected "
+                          << (compressed ? "PLOT_BUFFER_CHUNK_COMPRESSED"
+                                         : "PLOT_BUFFER_CHUNK")
+                          << " for '" << chunk.name << "' on a data lane: "
+                          << "row_offset " << chunk.row_offset
+                          << ", row_count " << chunk.row_count << ", "
+                          << chunk.size << " bytes received\n";
+            }
+            return true;
+        }
+        case MessageType::PLOT_BUFFER_LANE_FENCE: {
+            std::uint64_t fence{};
+            MessageDecoder{*lane.transport}.read(fence);
+            {
+                const std::scoped_lock lock(mutex_);
+                lane.passed = fence;
+            }
+            changed_.notify_all();
+            return true;
+        }
+        default:
+            std::cerr << "[OID] unexpected message type "
+                      << static_cast<int>(header)
+                      << " on a data lane; lane dropped\n";
+            return false;
+        }
+    } catch (const std::runtime_error&) { // see IpcClient::read_message()
+        std::cerr << "[OID] data lane broke mid-message; lane dropped\n";
+        return false;
+    } catch (const std::length_error&) {
+        std::cerr << "[OID] container limit exceeded on a data lane; "
+                     "lane dropped\n";
+        return false;
+    } catch (const std::bad_alloc&) {
+        std::cerr << "[OID] out of memory on a data lane; lane dropped\n";
+        return false;
+    }
+}
+
+} // namespace oid::host
@@ -0,0 +1,120 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef HOST_IPC_DATA_LANE_READER_H_
+#define HOST_IPC_DATA_LANE_READER_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ipc/buffer_assembler.h"
+#include "ipc/transport.h"
+
+namespace oid::host {
+
+// What receive_chunk() read, and whether the assembler took it.
+struct ReceivedChunk {
+    std::string name;
+    std::size_t row_offset{};
+    std::size_t row_count{};
+    // Bytes on the wire, compressed or not.
+    std::size_t size{};
+    bool taken{};
+};
+
+// Reads the rest of a PLOT_BUFFER_CHUNK (or, with `compressed`,
+// PLOT_BUFFER_CHUNK_COMPRESSED) off `transport` into `assembler`. An
+// uncompressed chunk is read straight into its rows' place when it is the
+// size they take; a chunk the assembler refuses is still read whole, so
+// the stream stays in step. Throws whatever MessageDecoder throws.
+ReceivedChunk receive_chunk(ITransport& transport,
+                            BufferAssembler& assembler,
+                            bool compressed);
+
+// Reads the row strips a bridge spreads over the data lanes (see
+// oid::DataLanes) into `assembler`, one thread per lane. A lane is only
+// read from expect() until it passes the fence expected, so no strip is
+// taken before the control stream has begun the transfer it belongs to.
+// A lane whose stream breaks is read no more.
+class DataLaneReader {
+  public:
+    DataLaneReader(std::vector<std::unique_ptr<ITransport>> lanes,
+                   BufferAssembler& assembler);
+    ~DataLaneReader();
+
+    DataLaneReader(const DataLaneReader&) = delete;
+    DataLaneReader& operator=(const DataLaneReader&) = delete;
+
+    [[nodiscard]] std::size_t size() const;
+
+    // The control stream announced (PLOT_BUFFER_LANES) a transfer whose
+    // strips arrive over `count` of the lanes, each closed by `fence`.
+    void expect(std::uint64_t fence, std::size_t count);
+
+    // Blocks until the lanes announced by the last expect() have all passed
+    // its fence, or every lane short of it has broken, or `timeout` is up.
+    // Returns true at once if nothing is expected. Returns false if lanes
+    // fell short; those are still read, so a late transfer drains.
+    [[nodiscard]] bool wait_for_fence(std::chrono::milliseconds timeout);
+
+  private:
+    struct Lane {
+        std::unique_ptr<ITransport> transport;
+        std::uint64_t passed{};
+        bool broken{};
+    };
+
+    void read_lane(const std::stop_token& stop, Lane& lane);
+    // Reads one message off `lane`; false if it broke the stream.
+    bool read_message(Lane& lane);
+    // True once `count_` lanes passed `fence_`, or no lane short of it is
+    // left to pass it.
+    [[nodiscard]] bool passed() const;
+    [[nodiscard]] bool settled() const;
+
+    BufferAssembler& assembler_;
+    mutable std::mutex mutex_{};
+    std::condition_variable_any changed_{};
+    // Guarded by mutex_, as are the lanes' `passed` and `broken`. Lanes
+    // are read while `reading_`; wait_for_fence() waits while `awaited_`.
+    std::uint64_t fence_{};
+    std::size_t count_{};
+    bool reading_{};
+    bool awaited_{};
+    std::vector<Lane> lanes_{};
+    std::vector<std::jthread> readers_{};
+};
+
+} // namespace oid::host
+
+#endif // HOST_IPC_DATA_LANE_READER_H_
@@ -29,91 +29,363 @@
 #include <deque>
 #include <iostream>
 #include <new>
+#include <iterator>
 #include <set>
+#include <span>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
 #include "host/ipc/buffer_decode.h"
 #include "host/settings/app_settings.h"
 #include "host/util/log_preview.h"
+#include "ipc/payload_bytes.h"
 #include "ipc/raw_data_decode.h"
 
 namespace oid::host {
 
-IpcClient::IpcClient(ITransport& transport, IpcBufferModel& model)
-    : transport_(transport), model_(model) {}
+namespace {
+
+// Queue depths for the receiver thread. Inbound entries can be whole
+// buffers, so that side is kept shallow: a full queue just leaves the rest
+// in the socket until the UI thread catches up. Outbound messages are small
+// requests, and only a viewer that stopped polling could queue this many.
+constexpr std::size_t INBOUND_QUEUE_DEPTH = 16;
+constexpr std::size_t OUTBOUND_QUEUE_DEPTH = 256;
+
+// How long the receiver thread sleeps when the transport has nothing for it
+// (or the inbound queue is full). Well under a frame, so it adds no visible
+// latency, and long enough that an idle viewer does not spin a core.
+constexpr auto RECEIVER_IDLE_WAIT = std::chrono::milliseconds{1};
+
+// Most plots a batch holds back. A stop with more observed buffers than this
+// reaches the model in several goes rather than piling up whole buffers past
+// the inbound queue's backpressure.
+constexpr std::size_t MAX_BATCHED_MESSAGES = INBOUND_QUEUE_DEPTH;
+
+// How long PLOT_BUFFER_END waits for the data lanes to pass the transfer's
+// fence. The bridge sends END only once every lane has sent its share, so
+// all that is left by then is reading what is in flight.
+constexpr auto LANE_FENCE_TIMEOUT = std::chrono::seconds{10};
+
+// The record a reassembled transfer -- or a preview of one -- becomes.
+BufferRecord record_from(AssembledBuffer assembled) {
+    auto record = make_buffer_record(
+        {.variable_name = std::move(assembled.variable_name),
+         .display_name = std::move(assembled.display_name),
+         .pixel_layout = std::move(assembled.pixel_layout),
+         .transpose = assembled.transpose,
+         .width = assembled.width,
+         .height = assembled.height,
+         .channels = assembled.channels,
+         .stride = assembled.stride,
+         .type = static_cast<BufferType>(assembled.type),
+         .bytes = std::move(assembled.bytes),
+         .narrowed = assembled.narrowed});
+    record.decimation = assembled.decimation;
+    record.source_width = assembled.source_width;
+    record.source_height = assembled.source_height;
+    return record;
+}
+
+} // namespace
+
+IpcClient::IpcClient(ITransport& transport,
+                     IpcBufferModel& model,
+                     std::vector<std::unique_ptr<ITransport>> lanes)
+    : transport_(transport), model_(model), inbound_(INBOUND_QUEUE_DEPTH),
+      outbound_(OUTBOUND_QUEUE_DEPTH) {
+    if (!lanes.empty()) {
+        lanes_ = std::make_unique<DataLaneReader>(std::move(lanes), assembler_);
+    }
+}
+
+IpcClient::~IpcClient() {
+    stop_receiver();
+}
 
 void IpcClient::poll() {
+    while (auto message = inbound_.try_pop()) {
+        apply(std::move(*message));
+    }
+    if (receiver_.joinable()) {
+        return;
+    }
     while (transport_.has_data()) {
+        std::optional<Inbound> message;
+        if (!read_message(message)) {
+            break;
+        }
+        if (message.has_value()) {
+            apply(std::move(*message));
+        }
+    }
+    if (auto progress = decode_progress()) {
+        apply(std::move(*progress));
+    }
+}
+
+void IpcClient::set_progress_interval(
+    const std::chrono::milliseconds interval) {
+    progress_interval_ = interval;
+}
+
+void IpcClient::start_receiver() {
+    if (receiver_.joinable()) {
+        return;
+    }
+    receiver_stop_ = false;
+    receiver_ = std::thread([this] { receive_loop(); }); // NOSONAR
+}
+
+void IpcClient::stop_receiver() {
+    if (!receiver_.joinable()) {
+        return;
+    }
+    receiver_stop_ = true;
+    receiver_.join();
+    flush_outbound();
+}
+
+void IpcClient::receive_loop() {
+    while (!receiver_stop_) {
+        flush_outbound();
+        // Checked while idle too: strips on the data lanes land meanwhile.
+        auto message = decode_progress();
+        if (!message.has_value()) {
+            if (!transport_.has_data()) {
+                std::this_thread::sleep_for(RECEIVER_IDLE_WAIT);
+                continue;
+            }
+            if (!read_message(message)) {
+                // The rest of the message is late or the peer is gone;
+                // either way there is nothing to read for now.
+                std::this_thread::sleep_for(RECEIVER_IDLE_WAIT);
+                continue;
+            }
+            if (!message.has_value()) {
+                continue;
+            }
+        }
+        // Waiting here is the backpressure: the socket fills up behind us
+        // and the bridge's sends slow down, instead of decoded buffers
+        // piling up in memory. Outbound messages keep flowing meanwhile.
+        while (!inbound_.try_push(std::move(*message))) {
+            if (receiver_stop_) {
+                return; // dropped: the client is going away
+            }
+            flush_outbound();
+            std::this_thread::sleep_for(RECEIVER_IDLE_WAIT);
+        }
+    }
+}
+
+void IpcClient::flush_outbound() {
+    while (auto frame = outbound_.try_pop()) {
         try {
-            auto header = MessageType{};
-            MessageDecoder{transport_}.read(header);
-            dispatch(header);
-        } catch (const std::runtime_error&) { // SocketTimeoutError, base catch
-            return; // cross-shared-lib RTTI-safe; drop the partial message
-        } catch (const std::length_error&) {
-            // MessageDecoder's own size guards keep resize() from throwing
-            // this, but other allocations driven by peer-supplied sizes and
-            // reachable from dispatch() (e.g. BufferAssembler::begin(), on a
-            // 32-bit size_t) are not guarded that way. Only length_error is
-            // caught, not its logic_error base: the siblings of that base
-            // signal bugs here rather than hostile input, and swallowing
-            // them would hide them. Its type_info is a single shared symbol
-            // like std::runtime_error's above, so this is RTTI-safe across
-            // the same shared-lib boundary.
-            std::cerr << "[OID] container limit exceeded decoding a message; "
-                         "dropped\n";
-            return;
-        } catch (const std::bad_alloc&) {
-            // A buffer's size comes from the peer. Sizes are capped before
-            // any allocation, but the cap is generous enough that the request
-            // can still fail on a loaded machine: drop the message rather
-            // than take the viewer down with it.
-            std::cerr << "[OID] out of memory decoding a message; dropped\n";
-            return;
+            transport_.send(*frame);
+        } catch (const std::runtime_error&) {
+            // Same tolerance as send_guarded().
         }
     }
 }
 
-void IpcClient::dispatch(const MessageType header) {
+bool IpcClient::read_message(std::optional<Inbound>& message) {
+    try {
+        auto header = MessageType{};
+        MessageDecoder{transport_}.read(header);
+        message = decode(header);
+        hold_for_batch(message);
+        return true;
+    } catch (const std::runtime_error&) { // SocketTimeoutError, base catch
+        return false; // cross-shared-lib RTTI-safe; drop the partial message
+    } catch (const std::length_error&) {
+        // MessageDecoder's own size guards keep resize() from throwing
+        // this, but other allocations driven by peer-supplied sizes and
+        // reachable from decode() (e.g. BufferAssembler::begin(), on a
+        // 32-bit size_t) are not guarded that way. Only length_error is
+        // caught, not its logic_error base: the siblings of that base
+        // signal bugs here rather than hostile input, and swallowing
+        // them would hide them. Its type_info is a single shared symbol
+        // like std::runtime_error's above, so this is RTTI-safe across
+        // the same shared-lib boundary.
+        std::cerr << "[OID] container limit exceeded decoding a message; "
+                     "dropped\n";
+        return false;
+    } catch (const std::bad_alloc&) {
+        // A buffer's size comes from the peer. Sizes are capped before
+        // any allocation, but the cap is generous enough that the request
+        // can still fail on a loaded machine: drop the message rather
+        // than take the viewer down with it.
+        std::cerr << "[OID] out of memory decoding a message; dropped\n";
+        return false;
+    }
+}
+
+std::optional<IpcClient::Inbound> IpcClient::decode(const MessageType header) {
     using enum MessageType;
     switch (header) {
     case SET_AVAILABLE_SYMBOLS:
-        handle_set_available_symbols();
-        break;
+        return decode_set_available_symbols();
+    case SET_AVAILABLE_SYMBOLS_DELTA:
+        return decode_set_available_symbols_delta();
     case GET_OBSERVED_SYMBOLS:
-        handle_get_observed_symbols();
-        break;
+        return ObservedSymbolsQuery{};
     case PLOT_BUFFER_CONTENTS:
-        handle_plot_buffer_contents();
-        break;
+        return decode_plot_buffer_contents();
     case PLOT_BUFFER_BEGIN:
-        handle_plot_buffer_begin();
-        break;
+        decode_plot_buffer_begin();
+        return std::nullopt;
+    case PLOT_BUFFER_PATCH_BEGIN:
+        return decode_plot_buffer_patch_begin();
     case PLOT_BUFFER_CHUNK:
-        handle_plot_buffer_chunk();
-        break;
+        return decode_plot_buffer_chunk(false);
+    case PLOT_BUFFER_CHUNK_COMPRESSED:
+        return decode_plot_buffer_chunk(true);
+    case PLOT_BUFFER_PREVIEW:
+        return decode_plot_buffer_preview();
+    case PLOT_BUFFER_LANES:
+        decode_plot_buffer_lanes();
+        return std::nullopt;
     case PLOT_BUFFER_END:
-        handle_plot_buffer_end();
-        break;
+        return decode_plot_buffer_end();
+    case PLOT_BUFFER_UNCHANGED:
+        return decode_plot_buffer_unchanged();
+    case PLOT_BUFFER_OVERVIEW:
+        return decode_plot_buffer_overview();
+    case PLOT_BUFFER_REGION:
+        return decode_plot_buffer_region();
+    case PLOT_BUFFER_BATCH_BEGIN:
+        return decode_plot_batch_begin();
+    case PLOT_BUFFER_BATCH_END:
+        return decode_plot_batch_end();
     case APPLY_SESSION_STATE:
-        handle_apply_session_state();
-        break;
+        return decode_apply_session_state();
     case EXPORT_SELECTED_BUFFER:
-        handle_export_selected_buffer();
-        break;
+        // No payload on the wire (mirrors the Qt side, which just emits
+        // exportSelectedBufferRequested() with no arguments) -- nothing to
+        // decode beyond the header already consumed by read_message().
+        return ExportSelected{};
     default:
         // Remaining message types (e.g. BUFFER_REMOVED) are only sent, never
         // received, by this side; ignore.
-        break;
+        return std::nullopt;
+    }
+}
+
+void IpcClient::apply(Inbound message) {
+    std::visit(
+        [this](auto&& decoded) {
+            using M = std::remove_cvref_t<decltype(decoded)>;
+            if constexpr (std::is_same_v<M, AvailableSymbols>) {
+                apply_available_symbols(std::move(decoded.symbols));
+            } else if constexpr (std::is_same_v<M, AvailableSymbolsDelta>) {
+                apply_available_symbols_delta(decoded.delta);
+            } else if constexpr (std::is_same_v<M, ObservedSymbolsQuery>) {
+                answer_observed_symbols();
+            } else if constexpr (std::is_same_v<M, DecodedBuffer>) {
+                apply_buffer(std::move(decoded));
+            } else if constexpr (std::is_same_v<M, UnchangedBuffer>) {
+                apply_unchanged_buffer(decoded.variable_name);
+            } else if constexpr (std::is_same_v<M, DecodedPatch>) {
+                apply_patch(decoded.patch);
+            } else if constexpr (std::is_same_v<M, ArrivedRows>) {
+                apply_arrived_rows(decoded.rows);
+            } else if constexpr (std::is_same_v<M, DecodedRegion>) {
+                apply_region(std::move(decoded));
+            } else if constexpr (std::is_same_v<M, StaleBuffer>) {
+                request_plot(decoded.variable_name);
+            } else if constexpr (std::is_same_v<M, SessionState>) {
+                apply_session_state(decoded.json);
+            } else if constexpr (std::is_same_v<M, Batch>) {
+                for (auto& held : decoded.messages) {
+                    apply(std::move(held));
+                }
+            } else {
+                apply_export_selected();
+            }
+        },
+        std::move(message));
+}
+
+void IpcClient::hold_for_batch(std::optional<Inbound>& message) {
+    if (!batch_.has_value() || !message.has_value() ||
+        std::holds_alternative<Batch>(*message)) {
+        return;
+    }
+    // A preview is there to show while the rest is in flight.
+    if (const auto* buffer = std::get_if<DecodedBuffer>(&*message);
+        (buffer != nullptr && buffer->record.provisional) ||
+        std::holds_alternative<ArrivedRows>(*message)) {
+        return;
+    }
+    batch_->push_back(std::move(*message));
+    message.reset();
+    if (batch_->size() >= MAX_BATCHED_MESSAGES) {
+        message = Batch{std::exchange(*batch_, {})};
+    }
+}
+
+std::optional<IpcClient::Inbound> IpcClient::decode_plot_batch_begin() {
+    // A batch still open lost its end (the bridge went away mid-stop): what
+    // it holds is still good.
+    auto unfinished = decode_plot_batch_end();
+    batch_.emplace();
+    return unfinished;
+}
+
+std::optional<IpcClient::Inbound> IpcClient::decode_plot_batch_end() {
+    if (!batch_.has_value()) {
+        return std::nullopt;
+    }
+    auto held = std::move(*batch_);
+    batch_.reset();
+    if (held.empty()) {
+        return std::nullopt;
     }
+    return Batch{std::move(held)};
 }
 
-void IpcClient::handle_set_available_symbols() {
+IpcClient::AvailableSymbols IpcClient::decode_set_available_symbols() const {
     std::deque<std::string> symbols;
     MessageDecoder{transport_}.read<std::deque<std::string>, std::string>(
         symbols);
-    available_symbols_.assign(symbols.begin(), symbols.end());
+    return {{std::make_move_iterator(symbols.begin()),
+             std::make_move_iterator(symbols.end())}};
+}
+
+IpcClient::AvailableSymbolsDelta
+IpcClient::decode_set_available_symbols_delta() const {
+    AvailableSymbolsDelta decoded;
+    MessageDecoder decoder{transport_};
+    std::deque<std::string> removed;
+    decoder.read<std::deque<std::string>, std::string>(removed);
+    decoded.delta.removed.assign(std::make_move_iterator(removed.begin()),
+                                 std::make_move_iterator(removed.end()));
+    auto added = std::size_t{};
+    decoder.read(added);
+    for (std::size_t i = 0; i < added; ++i) {
+        auto index = std::size_t{};
+        auto symbol = std::string{};
+        decoder.read(index).read(symbol);
+        decoded.delta.added.emplace_back(index, std::move(symbol));
+    }
+    return decoded;
+}
+
+void IpcClient::apply_available_symbols_delta(const SymbolListDelta& delta) {
+    // The bridge edits the list it last sent, which is the one held here;
+    // a delta that does not fit it is malformed, and leaves it as it is.
+    auto symbols = available_symbols_;
+    if (!apply_symbol_list_delta(symbols, delta)) {
+        std::cerr << "[OID] symbol list delta does not fit; dropped\n";
+        return;
+    }
+    apply_available_symbols(std::move(symbols));
+}
+
+void IpcClient::apply_available_symbols(std::vector<std::string> symbols) {
+    available_symbols_ = std::move(symbols);
 
     const auto now = std::chrono::duration_cast<std::chrono::seconds>(
                          std::chrono::system_clock::now().time_since_epoch())
@@ -138,7 +410,7 @@ void IpcClient::handle_set_available_symbols() {
     }
 }
 
-void IpcClient::handle_get_observed_symbols() const {
+void IpcClient::answer_observed_symbols() const {
     // LOCAL_FILE-tagged buffers were opened directly from a local file and
     // are never owned by the debugger, so they must never be advertised
     // back via GET_OBSERVED_SYMBOLS_RESPONSE (re-plotting one would be
@@ -159,7 +431,8 @@ void IpcClient::handle_get_observed_symbols() const {
     send_guarded(composer);
 }
 
-void IpcClient::handle_plot_buffer_contents() const {
+std::optional<IpcClient::Inbound>
+IpcClient::decode_plot_buffer_contents() const {
     std::string variable_name;
     std::string display_name;
     std::string pixel_layout;
@@ -169,7 +442,7 @@ void IpcClient::handle_plot_buffer_contents() const {
     int channels{};
     int stride{};
     auto type = BufferType{};
-    std::vector<std::byte> bytes;
+    PayloadBytes bytes;
     MessageDecoder{transport_}
         .read(variable_name)
         .read(display_name)
@@ -185,7 +458,7 @@ void IpcClient::handle_plot_buffer_contents() const {
         std::cerr << "[OID] rejected PLOT_BUFFER_CONTENTS for '"
                   << variable_name << "': unknown buffer type "
                   << static_cast<int>(type) << "\n";
-        return;
+        return std::nullopt;
     }
     if (!within_display_limits(width, height, channels)) {
         std::cerr << "[OID] rejected PLOT_BUFFER_CONTENTS for '"
@@ -193,31 +466,31 @@ void IpcClient::handle_plot_buffer_contents() const {
                   << "': geometry exceeds the display limits (max dimension "
                   << MAX_BUFFER_DIMENSION << ", max " << MAX_CHANNEL_COUNT
                   << " channels)\n";
-        return;
+        return std::nullopt;
     }
     if (!geometry_fits_payload(
             width, height, channels, stride, type, bytes.size())) {
         std::cerr << "[OID] rejected PLOT_BUFFER_CONTENTS for '"
                   << variable_name << "': payload too small for geometry\n";
-        return;
+        return std::nullopt;
     }
-    pixel_layout = resolve_pixel_layout("PLOT_BUFFER_CONTENTS",
-                                        variable_name,
-                                        std::move(pixel_layout),
-                                        channels);
-    model_.upsert(make_buffer_record({.variable_name = std::move(variable_name),
-                                      .display_name = std::move(display_name),
-                                      .pixel_layout = std::move(pixel_layout),
-                                      .transpose = transpose,
-                                      .width = width,
-                                      .height = height,
-                                      .channels = channels,
-                                      .stride = stride,
-                                      .type = type,
-                                      .bytes = std::move(bytes)}));
-}
-
-void IpcClient::handle_plot_buffer_begin() {
+    // The layout is resolved against the model when applied; the record
+    // carries it as declared until then.
+    return DecodedBuffer{
+        "PLOT_BUFFER_CONTENTS",
+        make_buffer_record({.variable_name = std::move(variable_name),
+                            .display_name = std::move(display_name),
+                            .pixel_layout = std::move(pixel_layout),
+                            .transpose = transpose,
+                            .width = width,
+                            .height = height,
+                            .channels = channels,
+                            .stride = stride,
+                            .type = type,
+                            .bytes = std::move(bytes)})};
+}
+
+void IpcClient::decode_plot_buffer_begin() {
     BufferAssembler::BeginParams params;
     MessageDecoder decoder{transport_};
     decoder.read(params.variable_name)
@@ -273,22 +546,49 @@ void IpcClient::handle_plot_buffer_begin() {
             std::cerr << "geometry is not renderable (width, height and "
                          "channels must be positive, and stride >= width)\n";
         }
+        return;
     }
+    progress_ =
+        Progress{name, std::chrono::steady_clock::now() + progress_interval_};
 }
 
-void IpcClient::handle_plot_buffer_chunk() {
-    std::string name;
-    std::size_t row_offset{};
-    std::size_t row_count{};
-    std::vector<std::byte> bytes;
-    MessageDecoder{transport_}
-        .read(name)
-        .read(row_offset)
-        .read(row_count)
-        .read(bytes);
-    if (assembler_.chunk(name, row_offset, row_count, bytes)) {
-        return;
+std::optional<IpcClient::Inbound> IpcClient::decode_plot_buffer_patch_begin() {
+    BufferAssembler::PatchParams params;
+    MessageDecoder decoder{transport_};
+    decoder.read(params.variable_name)
+        .read(params.width)
+        .read(params.height)
+        .read(params.channels)
+        .read(params.stride)
+        .read(params.type)
+        .read(params.total_byte_size);
+    std::string name = params.variable_name;
+    const auto received = params.total_byte_size;
+    if (assembler_.begin_patch(std::move(params))) {
+        return std::nullopt;
     }
+    // The bridge already counts the rows this patch would have carried as
+    // delivered, so dropping it silently would leave them stale for good.
+    // The geometry was checked when the full buffer was accepted; a patch
+    // that fails the same check is malformed, and the whole plot is refetched.
+    std::cerr << "[OID] rejected PLOT_BUFFER_PATCH_BEGIN for '" << name
+              << "': geometry does not describe a displayable buffer of "
+              << received << " bytes\n";
+    return StaleBuffer{std::move(name)};
+}
+
+std::optional<IpcClient::Inbound>
+IpcClient::decode_plot_buffer_chunk(const bool compressed) {
+    auto [name, row_offset, row_count, size, taken] =
+        receive_chunk(transport_, assembler_, compressed);
+    if (taken) {
+        return std::nullopt;
+    }
+    // Captured before abort() erases the entry: a lost patch has to be made
+    // good by a full refetch (see decode_plot_buffer_patch_begin()), as does
+    // a transfer whose preview is already on show.
+    const bool refetch = assembler_.has_patch_in_progress(name) ||
+                         assembler_.has_preview(name);
     // Already unusable: holding the allocation until PLOT_BUFFER_END would
     // only waste memory. Gating the report on abort() having dropped
     // something is what collapses the flood: the first bad chunk reports and
@@ -300,58 +600,353 @@ void IpcClient::handle_plot_buffer_chunk() {
         // std::size_t addition, and a peer sending huge values -- already
         // rejected for the transfer itself -- would wrap it into an end row
         // smaller than the start row.
-        std::cerr << "[OID] rejected PLOT_BUFFER_CHUNK for '" << name
-                  << "': row_offset " << row_offset << ", row_count "
-                  << row_count << ", " << bytes.size() << " bytes received\n";
+        std::cerr << "[OID] rejected "
+                  << (compressed ? "PLOT_BUFFER_CHUNK_COMPRESSED"
+                                 : "PLOT_BUFFER_CHUNK")
+                  << " for '" << name << "': row_offset " << row_offset
+                  << ", row_count " << row_count << ", " << size
+                  << " bytes received\n";
+        if (refetch) {
+            return StaleBuffer{std::move(name)};
+        }
+    }
+    return std::nullopt;
+}
+
+void IpcClient::decode_plot_buffer_lanes() {
+    std::string name;
+    std::uint64_t fence{};
+    std::size_t count{};
+    MessageDecoder{transport_}.read(name).read(fence).read(count);
+    // Strips on lanes this side does not have can never arrive; END then
+    // refuses the transfer as incomplete.
+    if (lanes_ == nullptr || count > lanes_->size()) {
+        std::cerr << "[OID] rejected PLOT_BUFFER_LANES for '" << name
+                  << "': " << count << " lanes, "
+                  << (lanes_ == nullptr ? 0 : lanes_->size())
+                  << " connected\n";
+    }
+    if (lanes_ != nullptr) {
+        lanes_->expect(fence, count);
     }
 }
 
-void IpcClient::handle_plot_buffer_end() {
+std::optional<IpcClient::Inbound> IpcClient::decode_plot_buffer_end() {
     std::string name;
     MessageDecoder{transport_}.read(name);
+    if (progress_.has_value() && progress_->variable_name == name) {
+        progress_.reset();
+    }
+    // Strips on the data lanes may still be landing.
+    if (lanes_ != nullptr && !lanes_->wait_for_fence(LANE_FENCE_TIMEOUT)) {
+        std::cerr << "[OID] data lanes fell short of PLOT_BUFFER_END for '"
+                  << name << "'\n";
+    }
     // Captured before end() (which erases the entry): an END for a name
     // with nothing in flight is a stray, not a genuine incomplete transfer.
     const bool was_in_progress = assembler_.has_in_progress(name);
+    if (assembler_.has_patch_in_progress(name)) {
+        // FLOAT64 strips arrive narrowed already (see assembler_), matching
+        // the float32 bytes of the record being patched.
+        return DecodedPatch{std::move(*assembler_.end_patch(name))};
+    }
+    const bool was_previewed = assembler_.has_preview(name);
     if (auto assembled = assembler_.end(name)) {
-        assembled->pixel_layout =
-            resolve_pixel_layout("PLOT_BUFFER_END",
-                                 assembled->variable_name,
-                                 std::move(assembled->pixel_layout),
-                                 assembled->channels);
-        model_.upsert(make_buffer_record(
-            {.variable_name = std::move(assembled->variable_name),
-             .display_name = std::move(assembled->display_name),
-             .pixel_layout = std::move(assembled->pixel_layout),
-             .transpose = assembled->transpose,
-             .width = assembled->width,
-             .height = assembled->height,
-             .channels = assembled->channels,
-             .stride = assembled->stride,
-             .type = static_cast<BufferType>(assembled->type),
-             .bytes = std::move(assembled->bytes)}));
-    } else if (was_in_progress) {
+        return DecodedBuffer{"PLOT_BUFFER_END",
+                             record_from(std::move(*assembled))};
+    }
+    if (was_in_progress) {
         std::cerr << "[OID] rejected PLOT_BUFFER_END for '" << name
                   << "': incomplete transfer\n";
     }
+    // The preview shown for it must not pass for the real buffer.
+    if (was_previewed) {
+        return StaleBuffer{std::move(name)};
+    }
+    return std::nullopt;
+}
+
+std::optional<IpcClient::Inbound> IpcClient::decode_plot_buffer_preview() {
+    std::string name;
+    int factor{};
+    PayloadBytes bytes;
+    MessageDecoder{transport_}.read(name).read(factor).read(bytes);
+    const auto received = bytes.size();
+    if (auto preview = assembler_.preview(name, factor, std::move(bytes))) {
+        auto record = record_from(std::move(*preview));
+        record.provisional = true;
+        return DecodedBuffer{"PLOT_BUFFER_PREVIEW", std::move(record)};
+    }
+    // Only a head start: the transfer it belongs to carries on regardless.
+    if (assembler_.has_in_progress(name)) {
+        std::cerr << "[OID] rejected PLOT_BUFFER_PREVIEW for '" << name
+                  << "': factor " << factor << ", " << received
+                  << " bytes received\n";
+    }
+    return std::nullopt;
+}
+
+std::optional<IpcClient::Inbound> IpcClient::decode_progress() {
+    const auto now = std::chrono::steady_clock::now();
+    if (!progress_.has_value() || now < progress_->due) {
+        return std::nullopt;
+    }
+    const auto& name = progress_->variable_name;
+    // Dropped (a bad chunk), or replaced by a patch of the same name.
+    if (!assembler_.has_in_progress(name) ||
+        assembler_.has_patch_in_progress(name)) {
+        progress_.reset();
+        return std::nullopt;
+    }
+    progress_->due = now + progress_interval_;
+    // Something already on show is only ever patched: a partial() by the
+    // rows since, a decimated preview by nothing (see arrived_rows()).
+    if (assembler_.has_preview(name)) {
+        auto rows = assembler_.arrived_rows(name);
+        if (!rows.has_value() || rows->strips.empty()) {
+            return std::nullopt;
+        }
+        return ArrivedRows{std::move(*rows)};
+    }
+    auto partial = assembler_.partial(name);
+    if (!partial.has_value()) {
+        return std::nullopt; // no rows yet
+    }
+    auto record = record_from(std::move(*partial));
+    record.provisional = true;
+    return DecodedBuffer{"PLOT_BUFFER_BEGIN", std::move(record)};
+}
+
+std::optional<IpcClient::Inbound>
+IpcClient::decode_plot_buffer_overview() const {
+    std::string variable_name;
+    std::string display_name;
+    std::string pixel_layout;
+    bool transpose{};
+    int width{};
+    int height{};
+    int channels{};
+    int stride{};
+    int type_int{};
+    int factor{};
+    bool quick_look{};
+    PayloadBytes bytes;
+    MessageDecoder{transport_}
+        .read(variable_name)
+        .read(display_name)
+        .read(pixel_layout)
+        .read(transpose)
+        .read(width)
+        .read(height)
+        .read(channels)
+        .read(stride)
+        .read(type_int)
+        .read(factor)
+        .read(quick_look)
+        .read(bytes);
+    const auto type = static_cast<BufferType>(type_int);
+    // The overview is packed, one pixel per factor x factor block; its
+    // geometry follows from the source's and nothing else.
+    const bool valid = is_known_buffer_type(type) && factor >= 1 &&
+                       within_display_limits(width, height, channels) &&
+                       stride >= width;
+    const int overview_width = valid ? (width + factor - 1) / factor : 0;
+    const int overview_height = valid ? (height + factor - 1) / factor : 0;
+    if (!valid || padded_payload_size(overview_width,
+                                      overview_height,
+                                      channels,
+                                      overview_width,
+                                      type) != bytes.size()) {
+        std::cerr << "[OID] rejected PLOT_BUFFER_OVERVIEW for '"
+                  << variable_name << "': factor " << factor << ", "
+                  << bytes.size() << " bytes for a " << width << "x" << height
+                  << " buffer\n";
+        return std::nullopt;
+    }
+    auto record =
+        make_buffer_record({.variable_name = std::move(variable_name),
+                            .display_name = std::move(display_name),
+                            .pixel_layout = std::move(pixel_layout),
+                            .transpose = transpose,
+                            .width = overview_width,
+                            .height = overview_height,
+                            .channels = channels,
+                            .stride = overview_width,
+                            .type = type,
+                            .bytes = std::move(bytes)});
+    record.decimation = factor;
+    record.source_width = width;
+    record.source_height = height;
+    record.quick_look = quick_look;
+    return DecodedBuffer{"PLOT_BUFFER_OVERVIEW", std::move(record)};
+}
+
+std::optional<IpcClient::Inbound> IpcClient::decode_plot_buffer_region() const {
+    DecodedRegion decoded;
+    auto& region = decoded.tile.region;
+    std::vector<std::byte> bytes;
+    MessageDecoder{transport_}
+        .read(decoded.variable_name)
+        .read(region.row)
+        .read(region.col)
+        .read(region.rows)
+        .read(region.cols)
+        .read(decoded.channels)
+        .read(decoded.type)
+        .read(bytes);
+    const auto type = static_cast<BufferType>(decoded.type);
+    if (!is_known_buffer_type(type) ||
+        !within_display_limits(region.cols, region.rows, decoded.channels) ||
+        padded_payload_size(region.cols,
+                            region.rows,
+                            decoded.channels,
+                            region.cols,
+                            type) != bytes.size()) {
+        std::cerr << "[OID] rejected PLOT_BUFFER_REGION for '"
+                  << decoded.variable_name << "': " << bytes.size()
+                  << " bytes for " << region.cols << "x" << region.rows
+                  << " pixels\n";
+        return std::nullopt;
+    }
+    // Narrowed like the overview, whose texture format the tile must share.
+    decoded.tile.bytes = type == BufferType::FLOAT64
+                             ? make_float_buffer_from_double(bytes)
+                             : std::move(bytes);
+    return decoded;
+}
+
+void IpcClient::apply_buffer(DecodedBuffer buffer) {
+    BufferRecord& record = buffer.record;
+    record.pixel_layout = resolve_pixel_layout(buffer.context,
+                                               record.variable_name,
+                                               std::move(record.pixel_layout),
+                                               record.channels);
+    model_.upsert(std::move(record));
+}
+
+IpcClient::UnchangedBuffer IpcClient::decode_plot_buffer_unchanged() const {
+    std::string name;
+    MessageDecoder{transport_}.read(name);
+    return {std::move(name)};
+}
+
+void IpcClient::apply_unchanged_buffer(const std::string& variable_name) const {
+    // The record on hand is already exactly this plot, so nothing happens:
+    // no upsert, hence no revision bump, texture upload or contrast pass.
+    if (model_has(variable_name)) {
+        return;
+    }
+    // The bridge believed this side still held the buffer, but it is gone
+    // (e.g. removed while the notice was in flight). A request makes the
+    // bridge forget its fingerprint and send the pixels again.
+    request_plot(variable_name);
+}
+
+void IpcClient::apply_patch(const AssembledPatch& patch) {
+    const auto& name = patch.variable_name;
+    const BufferRecord* held = nullptr;
+    for (std::size_t i = 0; i < model_.size(); ++i) {
+        if (model_.at(i).variable_name == name) {
+            held = &model_.at(i);
+            break;
+        }
+    }
+    // The bridge patched against the last plot it sent. If this side no
+    // longer holds that plot in that shape (removed, or replaced while the
+    // patch was in flight), the rows cannot be placed and the plot is
+    // refetched whole instead.
+    const bool same_shape =
+        held != nullptr && held->width == patch.width &&
+        held->height == patch.height && held->channels == patch.channels &&
+        held->step == patch.stride &&
+        static_cast<int>(held->type) == patch.type;
+    std::vector<IpcBufferModel::RowPatch> rows;
+    rows.reserve(patch.strips.size());
+    for (const auto& strip : patch.strips) {
+        rows.push_back({strip.row_offset, strip.bytes});
+    }
+    if (same_shape && model_.patch_rows(name, rows)) {
+        return;
+    }
+    std::cerr << "[OID] PLOT_BUFFER_PATCH_BEGIN for '" << name
+              << "' does not match the buffer held; requesting it again\n";
+    request_plot(name);
+}
+
+void IpcClient::apply_arrived_rows(const AssembledPatch& rows) {
+    const auto& name = rows.variable_name;
+    for (std::size_t i = 0; i < model_.size(); ++i) {
+        const auto& held = model_.at(i);
+        if (held.variable_name != name) {
+            continue;
+        }
+        // Only onto the stand-in they belong to: one removed, or already
+        // replaced by the finished buffer, is left as it is.
+        std::vector<IpcBufferModel::RowPatch> patches;
+        patches.reserve(rows.strips.size());
+        for (const auto& strip : rows.strips) {
+            patches.push_back({strip.row_offset, strip.bytes});
+        }
+        if (held.provisional && held.width == rows.width &&
+            held.height == rows.height && held.channels == rows.channels &&
+            held.step == rows.stride &&
+            static_cast<int>(held.type) == rows.type) {
+            // Rows the stand-in's own shape admits, so this cannot refuse.
+            static_cast<void>(model_.patch_rows(name, patches));
+        }
+        return;
+    }
+}
+
+void IpcClient::apply_region(DecodedRegion region) {
+    const auto& name = region.variable_name;
+    const BufferRecord* held = nullptr;
+    for (std::size_t i = 0; i < model_.size(); ++i) {
+        if (model_.at(i).variable_name == name) {
+            held = &model_.at(i);
+            break;
+        }
+    }
+    // Answers to requests made for an earlier plot of the name, or for one
+    // since removed, have nowhere to go.
+    if (held == nullptr || held->decimation <= 1 ||
+        held->channels != region.channels ||
+        static_cast<int>(held->type) != region.type ||
+        !region_within(
+            region.tile.region, held->source_width, held->source_height)) {
+        return;
+    }
+    model_.region_tiles().insert(name, std::move(region.tile));
 }
 
-void IpcClient::handle_apply_session_state() const {
+IpcClient::SessionState IpcClient::decode_apply_session_state() const {
     std::string json;
     MessageDecoder{transport_}.read(json);
+    return {std::move(json)};
+}
+
+void IpcClient::apply_session_state(const std::string& json) const {
     if (session_state_callback_) {
         session_state_callback_(json);
     }
 }
 
-void IpcClient::handle_export_selected_buffer() const {
-    // No payload on the wire (mirrors the Qt side, which just emits
-    // exportSelectedBufferRequested() with no arguments) -- nothing to
-    // decode beyond the header already consumed by poll().
+void IpcClient::apply_export_selected() const {
     if (export_selected_callback_) {
         export_selected_callback_();
     }
 }
 
+void IpcClient::announce_capabilities() const {
+    MessageComposer composer;
+    composer.push(MessageType::VIEWER_CAPABILITIES)
+        .push(CAPABILITY_COMPRESSED_CHUNKS | CAPABILITY_PROGRESSIVE_PREVIEW |
+              CAPABILITY_REGION_FETCH | CAPABILITY_PLOT_BATCHES |
+              CAPABILITY_QUICK_LOOK | CAPABILITY_SYMBOL_DELTAS |
+              (lanes_ != nullptr ? CAPABILITY_DATA_LANES : 0));
+    send_guarded(composer);
+}
+
 void IpcClient::request_plot(const std::string& variable_name) const {
     MessageComposer composer;
     composer.push(MessageType::PLOT_BUFFER_REQUEST).push(variable_name);
@@ -364,6 +959,24 @@ void IpcClient::notify_removed(const std::string& variable_name) const {
     send_guarded(composer);
 }
 
+void IpcClient::request_region(const std::string& variable_name,
+                               const PixelRegion& region) const {
+    MessageComposer composer;
+    composer.push(MessageType::PLOT_BUFFER_REGION_REQUEST)
+        .push(variable_name)
+        .push(region.row)
+        .push(region.col)
+        .push(region.rows)
+        .push(region.cols);
+    send_guarded(composer);
+}
+
+void IpcClient::request_full_plot(const std::string& variable_name) const {
+    MessageComposer composer;
+    composer.push(MessageType::PLOT_BUFFER_FULL_REQUEST).push(variable_name);
+    send_guarded(composer);
+}
+
 void IpcClient::send_session_state_changed(const std::string& json) const {
     MessageComposer composer;
     composer.push(MessageType::SESSION_STATE_CHANGED).push(json);
@@ -465,6 +1078,16 @@ bool IpcClient::model_has(const std::string_view variable_name) const {
 }
 
 void IpcClient::send_guarded(const MessageComposer& composer) const {
+    if (receiver_.joinable()) {
+        // The receiver thread owns the transport now; it sends the frame
+        // on its next pass.
+        FrameCapture capture;
+        composer.send(capture);
+        if (!outbound_.try_push(std::move(capture.frame))) {
+            std::cerr << "[OID] outbound IPC queue full; message dropped\n";
+        }
+        return;
+    }
     try {
         composer.send(transport_);
     } catch (const std::runtime_error&) {
@@ -26,43 +26,110 @@
 #ifndef HOST_IPC_IPC_CLIENT_H_
 #define HOST_IPC_IPC_CLIENT_H_
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <functional>
+#include <memory>
+#include <optional>
 #include <set>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <variant>
 #include <vector>
 
+#include "host/ipc/data_lane_reader.h"
 #include "host/settings/app_settings.h"
 #include "host/ui/ipc_buffer_model.h"
+#include "host/util/spsc_queue.h"
 #include "ipc/buffer_assembler.h"
 #include "ipc/message_exchange.h"
+#include "ipc/pixel_region.h"
+#include "ipc/symbol_list_delta.h"
 #include "ipc/transport.h"
 
 namespace oid::host {
 
 // Qt-free port of the window-side of the Qt MessageHandler: decodes inbound
-// messages (SET_AVAILABLE_SYMBOLS, GET_OBSERVED_SYMBOLS, PLOT_BUFFER_CONTENTS,
-// PLOT_BUFFER_BEGIN/Chunk/End) into the IpcBufferModel + symbol list, and
-// sends outbound requests (PLOT_BUFFER_REQUEST, BUFFER_REMOVED). The transport
-// is injected as oid::ITransport& so this is unit-testable against a fake
-// transport with no live socket.
+// messages (SET_AVAILABLE_SYMBOLS and its _DELTA, GET_OBSERVED_SYMBOLS,
+// PLOT_BUFFER_CONTENTS, PLOT_BUFFER_BEGIN/PATCH_BEGIN/Preview/Lanes/Chunk/End,
+// PLOT_BUFFER_UNCHANGED, PLOT_BUFFER_OVERVIEW/REGION,
+// PLOT_BUFFER_BATCH_BEGIN/END) into the IpcBufferModel + symbol list, and
+// sends outbound requests (PLOT_BUFFER_REQUEST, PLOT_BUFFER_REGION_REQUEST,
+// PLOT_BUFFER_FULL_REQUEST, BUFFER_REMOVED). The transport is injected as
+// oid::ITransport& so this is unit-testable against a fake transport with no
+// live socket. Any `lanes` are data lanes connected to the same bridge (see
+// oid::DataLanes), read on threads of their own from construction on.
 class IpcClient {
   public:
-    IpcClient(ITransport& transport, IpcBufferModel& model);
+    IpcClient(ITransport& transport,
+              IpcBufferModel& model,
+              std::vector<std::unique_ptr<ITransport>> lanes = {});
+    ~IpcClient();
+
+    IpcClient(const IpcClient&) = delete;
+    IpcClient& operator=(const IpcClient&) = delete;
 
     // Drains all currently-available inbound messages into the model /
-    // symbol list. Called once per frame. Never blocks the caller beyond
-    // the transport's own bounded reads; catches std::runtime_error
-    // (SocketTimeoutError) if a message header/body isn't fully available
-    // yet.
+    // symbol list. Called once per frame. With the receiver thread running
+    // (see start_receiver()) it only applies what that thread has already
+    // decoded, so it never touches the transport. Otherwise it decodes them
+    // itself and never blocks the caller beyond the transport's own bounded
+    // reads; catches std::runtime_error (SocketTimeoutError) if a message
+    // header/body isn't fully available yet.
     void poll();
 
+    // Moves all transport I/O onto a dedicated receiver thread. It decodes
+    // inbound messages -- assembling chunked transfers and converting whole
+    // BufferRecords included -- and hands them to poll() through a
+    // lock-free queue, and it sends whatever the outbound methods below
+    // queue for it, so the transport is only ever used from that thread.
+    // The model, symbol list and callbacks stay with the thread calling
+    // poll(). No-op if already running.
+    void start_receiver();
+
+    // How often a full transfer still arriving is shown as far as it has
+    // got: once it has taken this long, its rows so far stand in for it as
+    // a provisional record (see BufferRecord::provisional), and again at
+    // most this often the rows that arrived since are patched in, until
+    // PLOT_BUFFER_END replaces it. Zero shows it on every poll (or every
+    // message the receiver thread reads). Set before start_receiver().
+    static constexpr auto DEFAULT_PROGRESS_INTERVAL =
+        std::chrono::milliseconds{100};
+    void set_progress_interval(std::chrono::milliseconds interval);
+
+    // Stops and joins the receiver thread (the destructor does too).
+    // Messages it already decoded stay queued for poll(), and outbound
+    // messages it had not sent yet are sent here. Later polls decode on the
+    // calling thread again.
+    void stop_receiver();
+
+    // Sends VIEWER_CAPABILITIES: the optional protocol features this side
+    // decodes (see CAPABILITY_COMPRESSED_CHUNKS,
+    // CAPABILITY_PROGRESSIVE_PREVIEW, CAPABILITY_REGION_FETCH,
+    // CAPABILITY_PLOT_BATCHES, CAPABILITY_QUICK_LOOK, and
+    // CAPABILITY_DATA_LANES when constructed with lanes). Once, right after
+    // connecting; until the bridge has read it, it sends only the baseline
+    // protocol.
+    void announce_capabilities() const;
+
     // Outbound (from the chrome):
     void
     request_plot(const std::string& variable_name) const; // PLOT_BUFFER_REQUEST
     void
     notify_removed(const std::string& variable_name) const; // BUFFER_REMOVED
 
+    // Sends PLOT_BUFFER_REGION_REQUEST for `region` of the lazy plot
+    // `variable_name` (see BufferRecord::decimation). The answer lands in
+    // the model's region_tiles() if it still fits the record held by then.
+    void request_region(const std::string& variable_name,
+                        const PixelRegion& region) const;
+
+    // Sends PLOT_BUFFER_FULL_REQUEST for the quick look `variable_name` (see
+    // is_quick_look()). The buffer in full replaces it as any re-plot does.
+    void request_full_plot(const std::string& variable_name) const;
+
     // Sends SESSION_STATE_CHANGED (type 7): a single JSON string, verbatim
     // (no parsing/validation here -- the caller owns the JSON shape).
     void send_session_state_changed(const std::string& json) const;
@@ -90,8 +157,8 @@ class IpcClient {
     // with no arguments). Not required to be set.
     void set_export_selected_callback(std::function<void()> cb);
 
-    // Latest available-symbols list (from SET_AVAILABLE_SYMBOLS); UiState
-    // reads it.
+    // Latest available-symbols list (from SET_AVAILABLE_SYMBOLS, as edited
+    // by any SET_AVAILABLE_SYMBOLS_DELTA since); UiState reads it.
     [[nodiscard]] const std::vector<std::string>& available_symbols() const;
 
     // Seed the previous-session buffers to auto-restore. On the next
@@ -101,18 +168,124 @@ class IpcClient {
     void set_restore_buffers(std::vector<PreviousBuffer> buffers);
 
   private:
-    void dispatch(MessageType header);
-
-    // Per-message-type handlers: each decodes (or applies) exactly one
-    // oid::MessageType and fully consumes its wire payload.
-    void handle_set_available_symbols();
-    void handle_get_observed_symbols() const;
-    void handle_plot_buffer_contents() const;
-    void handle_plot_buffer_begin();
-    void handle_plot_buffer_chunk();
-    void handle_plot_buffer_end();
-    void handle_apply_session_state() const;
-    void handle_export_selected_buffer() const;
+    // Inbound messages as decoded off the transport, waiting to be applied
+    // to the model / symbol list / callbacks on the polling thread.
+    struct AvailableSymbols {
+        std::vector<std::string> symbols;
+    };
+    struct AvailableSymbolsDelta {
+        SymbolListDelta delta;
+    };
+    struct ObservedSymbolsQuery {};
+    // A complete buffer, FLOAT64 payloads already converted. `context`
+    // names the message it arrived in, for resolve_pixel_layout()'s log.
+    struct DecodedBuffer {
+        std::string_view context;
+        BufferRecord record;
+    };
+    // The bridge's copy of a plot matches what it last sent in full.
+    struct UnchangedBuffer {
+        std::string variable_name;
+    };
+    // Changed rows for a buffer held here, FLOAT64 strips already converted.
+    struct DecodedPatch {
+        AssembledPatch patch;
+    };
+    // Rows of a transfer still arriving, for the provisional record showing
+    // it so far.
+    struct ArrivedRows {
+        AssembledPatch rows;
+    };
+    // Full-resolution pixels of a lazy plot, FLOAT64 already converted.
+    // `channels` and `type` are the source's, to check against the record.
+    struct DecodedRegion {
+        std::string variable_name;
+        int channels{};
+        int type{};
+        RegionTile tile;
+    };
+    // A patch for this buffer was lost, or the transfer behind the preview
+    // shown for it failed, so the copy held here is out of date and has to
+    // be fetched whole.
+    struct StaleBuffer {
+        std::string variable_name;
+    };
+    struct SessionState {
+        std::string json;
+    };
+    struct ExportSelected {};
+    struct Batch;
+    using Inbound = std::variant<AvailableSymbols,
+                                 AvailableSymbolsDelta,
+                                 ObservedSymbolsQuery,
+                                 DecodedBuffer,
+                                 UnchangedBuffer,
+                                 DecodedPatch,
+                                 ArrivedRows,
+                                 DecodedRegion,
+                                 StaleBuffer,
+                                 SessionState,
+                                 ExportSelected,
+                                 Batch>;
+    // The plots completed between PLOT_BUFFER_BATCH_BEGIN and _END, applied
+    // in one go.
+    struct Batch {
+        std::vector<Inbound> messages;
+    };
+
+    // Reads and decodes one message. Returns false if the transport gave
+    // out mid-message (the partial message is dropped); `message` is left
+    // empty for messages fully handled while decoding (chunks, rejects).
+    bool read_message(std::optional<Inbound>& message);
+    std::optional<Inbound> decode(MessageType header);
+    void apply(Inbound message);
+
+    // While a batch is open, moves a decoded plot into it, leaving
+    // `message` empty -- or, once the batch holds MAX_BATCHED_MESSAGES,
+    // the batch so far.
+    void hold_for_batch(std::optional<Inbound>& message);
+    [[nodiscard]] std::optional<Inbound> decode_plot_batch_begin();
+    [[nodiscard]] std::optional<Inbound> decode_plot_batch_end();
+
+    // Decode side, one per oid::MessageType: each fully consumes its wire
+    // payload and touches nothing the polling thread owns, so it can run
+    // on the receiver thread.
+    [[nodiscard]] AvailableSymbols decode_set_available_symbols() const;
+    [[nodiscard]] AvailableSymbolsDelta
+    decode_set_available_symbols_delta() const;
+    [[nodiscard]] std::optional<Inbound> decode_plot_buffer_contents() const;
+    void decode_plot_buffer_begin();
+    [[nodiscard]] std::optional<Inbound> decode_plot_buffer_patch_begin();
+    [[nodiscard]] std::optional<Inbound>
+    decode_plot_buffer_chunk(bool compressed);
+    [[nodiscard]] std::optional<Inbound> decode_plot_buffer_preview();
+    void decode_plot_buffer_lanes();
+    [[nodiscard]] std::optional<Inbound> decode_plot_buffer_end();
+    [[nodiscard]] std::optional<Inbound> decode_plot_buffer_overview() const;
+    [[nodiscard]] std::optional<Inbound> decode_plot_buffer_region() const;
+    [[nodiscard]] UnchangedBuffer decode_plot_buffer_unchanged() const;
+    [[nodiscard]] SessionState decode_apply_session_state() const;
+
+    // What the full transfer in flight has to show since last time, once
+    // the progress interval is up: its rows so far as a provisional record
+    // at first, then the rows that arrived since.
+    [[nodiscard]] std::optional<Inbound> decode_progress();
+
+    // Apply side: always on the polling thread.
+    void apply_available_symbols(std::vector<std::string> symbols);
+    void apply_available_symbols_delta(const SymbolListDelta& delta);
+    void answer_observed_symbols() const;
+    void apply_buffer(DecodedBuffer buffer);
+    void apply_unchanged_buffer(const std::string& variable_name) const;
+    void apply_patch(const AssembledPatch& patch);
+    void apply_arrived_rows(const AssembledPatch& rows);
+    void apply_region(DecodedRegion region);
+    void apply_session_state(const std::string& json) const;
+    void apply_export_selected() const;
+
+    // Receiver thread body, and its outbound half.
+    void receive_loop();
+    void flush_outbound();
 
     [[nodiscard]] bool model_has(std::string_view variable_name) const;
 
@@ -136,16 +309,40 @@ class IpcClient {
     // std::runtime_error. Mirrors poll()'s tolerance of transport errors on
     // the inbound side: if the peer is gone (e.g. viewer opened with no
     // debugger attached), an outbound send must not crash the viewer.
+    // While the receiver thread runs, the message is queued for it instead.
     void send_guarded(const MessageComposer& composer) const;
 
     ITransport& transport_;
     IpcBufferModel& model_;
-    BufferAssembler assembler_;
+    // FLOAT64 strips are narrowed on the receiver thread as they arrive,
+    // not in one pass over the whole buffer after PLOT_BUFFER_END.
+    BufferAssembler assembler_{BufferAssembler::Float64Rows::NARROWED};
+    // Fills assembler_ from the data lanes, if any; declared after it so it
+    // stops first.
+    std::unique_ptr<DataLaneReader> lanes_;
+    // Decode side, like assembler_: the open batch, if any.
+    std::optional<std::vector<Inbound>> batch_;
+    // Decode side too: the full transfer last begun, while in flight, and
+    // when it is next due to show its progress.
+    struct Progress {
+        std::string variable_name;
+        std::chrono::steady_clock::time_point due;
+    };
+    std::optional<Progress> progress_;
+    std::chrono::milliseconds progress_interval_{DEFAULT_PROGRESS_INTERVAL};
     std::vector<std::string> available_symbols_;
     std::vector<PreviousBuffer> restore_buffers_;
     std::set<std::string, std::less<>> restore_requested_;
     std::function<void(const std::string& json)> session_state_callback_;
     std::function<void()> export_selected_callback_;
+
+    // Receiver thread (see start_receiver()). inbound_ is filled by it and
+    // drained by poll(); outbound_ the other way round. outbound_ is
+    // mutable because the const outbound methods queue into it.
+    SpscQueue<Inbound> inbound_;
+    mutable SpscQueue<std::vector<std::byte>> outbound_;
+    std::atomic<bool> receiver_stop_{false};
+    std::thread receiver_; // NOSONAR
 };
 
 } // namespace oid::host
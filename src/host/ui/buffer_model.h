@@ -31,12 +31,15 @@
 #include <cstdint>
 #include <format>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
 
+#include "ipc/payload_bytes.h"
 #include "ipc/raw_data_decode.h"
+#include "ipc/row_intervals.h"
 
 namespace oid::host {
 
@@ -64,10 +67,33 @@ struct BufferRecord {
     int channels{};
     int step{};
     BufferType type{BufferType::UNSIGNED_BYTE};
-    std::vector<std::byte> bytes;
+    PayloadBytes bytes;
     BufferKind kind{BufferKind::DEBUGGER_SYMBOL};
+    // A PLOT_BUFFER_PREVIEW, decimated, or the rows of a large transfer
+    // that have arrived so far, standing in while the real pixels are still
+    // in transfer; replaced once they have arrived.
+    bool provisional{false};
+    // A PLOT_BUFFER_OVERVIEW of a lazy plot (see ipc/pixel_region.h): every
+    // `decimation`-th pixel of a source_width x source_height buffer that
+    // never crosses the wire whole. Full-resolution tiles of it are fetched
+    // as they come into view (see IpcBufferModel::region_tiles()), unless it
+    // is a provisional preview, whose source is on its way whole. 1 for an
+    // ordinary record, whose source is itself.
+    int decimation{1};
+    int source_width{};
+    int source_height{};
+    // The overview is of a quick look, as its PLOT_BUFFER_OVERVIEW said.
+    bool quick_look{false};
 };
 
+// Whether `record` is the overview of a quick look (see ipc/pixel_region.h)
+// rather than of a lazy plot: the bridge can plot its source in full on
+// request (see IpcClient::request_full_plot()). Taken from the bridge, which
+// alone knows the source's row stride and which threshold it applied.
+[[nodiscard]] inline bool is_quick_look(const BufferRecord& record) {
+    return record.decimation > 1 && record.quick_look;
+}
+
 // A pixel_layout naming an actual channel order: exactly four characters,
 // each one of 'r', 'g', 'b' or 'a'. This is the mechanical floor
 // Buffer::set_pixel_layout() enforces before copying the string (it writes
@@ -92,6 +118,24 @@ is_valid_pixel_layout(const std::string_view layout) {
 // instead). Every caller that applies this default says so on stderr.
 constexpr std::string_view DEFAULT_PIXEL_LAYOUT = "rgba";
 
+// Rows [first, first + count) of a buffer.
+struct RowRange {
+    std::size_t first{};
+    std::size_t count{};
+
+    bool operator==(const RowRange&) const = default;
+};
+
+// The runs of `rows`, in row order.
+inline std::vector<RowRange> row_ranges_of(const RowIntervals& rows) {
+    std::vector<RowRange> ranges;
+    ranges.reserve(rows.runs());
+    for (const auto& [begin, end] : rows.intervals()) {
+        ranges.push_back({begin, end - begin});
+    }
+    return ranges;
+}
+
 // Read-only view over the set of buffers the chrome should list.
 // IpcBufferModel is backed by live IPC state; MockBufferModel below is the
 // deterministic stand-in consumed by UiState and StageManager.
@@ -113,6 +157,18 @@ class BufferModel {
     // the revision it last observed to decide whether to rebuild the
     // Stage's GL buffer via Stage::buffer_update() rather than reuse it.
     virtual std::uint64_t revision_of(std::size_t i) const = 0;
+
+    // Rows of the record at slot `i` that were rewritten in place since the
+    // slot was at `revision` (a value revision_of(i) returned earlier), as
+    // disjoint runs in row order; empty if none. nullopt when
+    // the record may have changed as a whole since then -- replaced, or
+    // patched further back than the model remembers -- so StageManager
+    // knows whether re-uploading those rows is enough. Models that never
+    // patch in place (MockBufferModel) keep this default.
+    virtual std::optional<std::vector<RowRange>>
+    changed_rows_since(std::size_t /*i*/, std::uint64_t /*revision*/) const {
+        return std::nullopt;
+    }
 };
 
 // Deterministic, IPC-free BufferModel: holds a fixed vector<BufferRecord>
@@ -226,7 +282,7 @@ inline MockBufferModel make_default_mock_model() {
             .channels = channels,
             .step = w,
             .type = BufferType::UNSIGNED_BYTE,
-            .bytes = std::move(pixels),
+            .bytes = PayloadBytes{pixels},
         }));
     }
 
@@ -259,7 +315,7 @@ inline MockBufferModel make_default_mock_model() {
             .channels = channels,
             .step = w,
             .type = BufferType::UNSIGNED_BYTE,
-            .bytes = std::move(pixels),
+            .bytes = PayloadBytes{pixels},
         }));
     }
 
@@ -287,7 +343,7 @@ inline MockBufferModel make_default_mock_model() {
             .channels = channels,
             .step = w,
             .type = BufferType::FLOAT32,
-            .bytes = std::move(pixels),
+            .bytes = PayloadBytes{pixels},
         }));
     }
 
@@ -25,8 +25,11 @@
 
 #include "host/ui/ipc_buffer_model.h"
 
+#include <algorithm>
 #include <utility>
 
+#include "ipc/payload_bytes.h"
+
 namespace oid::host {
 
 std::size_t IpcBufferModel::size() const {
@@ -38,26 +41,79 @@ const BufferRecord& IpcBufferModel::at(const std::size_t i) const {
 }
 
 void IpcBufferModel::upsert(BufferRecord record) {
+    // Whatever was fetched for the old record describes the old pixels.
+    region_tiles_.drop(record.variable_name);
     for (std::size_t i = 0; i < storage_.size(); ++i) {
         if (storage_[i]->variable_name == record.variable_name) {
             storage_[i] = std::make_unique<BufferRecord>(std::move(record));
             slot_revision_[i] = next_slot_rev_++;
+            history_[i] = PatchHistory{.complete_since = slot_revision_[i]};
             ++revision_;
             return;
         }
     }
     storage_.push_back(std::make_unique<BufferRecord>(std::move(record)));
     slot_revision_.push_back(next_slot_rev_++);
+    history_.push_back(PatchHistory{.complete_since = slot_revision_.back()});
     ++revision_;
 }
 
+bool IpcBufferModel::patch_rows(const std::string_view variable_name,
+                                const std::span<const RowPatch> patches) {
+    std::size_t i = 0;
+    while (i < storage_.size() && storage_[i]->variable_name != variable_name) {
+        ++i;
+    }
+    if (i == storage_.size()) {
+        return false;
+    }
+    BufferRecord& record = *storage_[i];
+    const auto height = static_cast<std::size_t>(record.height);
+    if (height == 0 || record.bytes.size() % height != 0) {
+        return false;
+    }
+    const auto row_bytes = record.bytes.size() / height;
+    // Validated in full before anything is written, so a bad patch never
+    // leaves the record half-updated.
+    RowIntervals touched;
+    for (const auto& [row_offset, bytes] : patches) {
+        if (row_bytes == 0 || bytes.size() % row_bytes != 0) {
+            return false;
+        }
+        const auto rows = bytes.size() / row_bytes;
+        if (row_offset > height || rows > height - row_offset) {
+            return false;
+        }
+        touched.insert(row_offset, row_offset + rows);
+    }
+    for (const auto& [row_offset, bytes] : patches) {
+        std::ranges::copy(bytes, record.bytes.begin() +
+                                     static_cast<std::ptrdiff_t>(
+                                         row_offset * row_bytes));
+    }
+
+    slot_revision_[i] = next_slot_rev_++;
+    ++revision_;
+    auto& history = history_[i];
+    history.patches.emplace_back(slot_revision_[i], row_ranges_of(touched));
+    if (history.patches.size() > MAX_PATCH_HISTORY) {
+        history.complete_since = history.patches.front().first;
+        history.patches.erase(history.patches.begin());
+    }
+    return true;
+}
+
 void IpcBufferModel::remove(const std::string_view variable_name) {
+    region_tiles_.drop(variable_name);
     for (std::size_t i = 0; i < storage_.size(); ++i) {
         if (storage_[i]->variable_name == variable_name) {
             storage_.erase(storage_.begin() + static_cast<std::ptrdiff_t>(i));
             slot_revision_.erase(slot_revision_.begin() +
                                  static_cast<std::ptrdiff_t>(i));
+            history_.erase(history_.begin() + static_cast<std::ptrdiff_t>(i));
             ++revision_;
+            // Nothing will re-plot it into the block it leaves behind.
+            trim_payload_pool();
             return;
         }
     }
@@ -67,6 +123,25 @@ std::uint64_t IpcBufferModel::revision_of(const std::size_t i) const {
     return slot_revision_.at(i);
 }
 
+std::optional<std::vector<RowRange>>
+IpcBufferModel::changed_rows_since(const std::size_t i,
+                                   const std::uint64_t revision) const {
+    const auto& history = history_.at(i);
+    if (revision < history.complete_since) {
+        return std::nullopt;
+    }
+    RowIntervals changed;
+    for (const auto& [patch_revision, runs] : history.patches) {
+        if (patch_revision <= revision) {
+            continue;
+        }
+        for (const auto& run : runs) {
+            changed.insert(run.first, run.first + run.count);
+        }
+    }
+    return row_ranges_of(changed);
+}
+
 const std::string& IpcBufferModel::variable_name_of(const std::size_t i) const {
     return storage_.at(i)->variable_name;
 }
@@ -29,11 +29,15 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include "host/ui/buffer_model.h"
+#include "host/ui/region_tile_cache.h"
 
 namespace oid::host {
 
@@ -51,9 +55,18 @@ namespace oid::host {
 // slot, so a consumer holding a reference from at(i) across an upsert must
 // re-fetch. A monotonic model-wide revision() plus a per-slot
 // revision_of(i) let a consumer detect "something changed" and "which slot
-// changed" cheaply, without diffing bytes.
+// changed" cheaply, without diffing bytes. The one in-place mutation is
+// patch_rows(), which rewrites rows without moving the bytes, so spans into
+// them stay valid.
 class IpcBufferModel final : public BufferModel {
   public:
+    // New contents for whole rows of a record, starting at `row_offset`;
+    // bytes.size() must be a multiple of the record's row size.
+    struct RowPatch {
+        std::size_t row_offset{};
+        std::span<const std::byte> bytes;
+    };
+
     std::size_t size() const override;
     const BufferRecord& at(std::size_t i) const override;
 
@@ -69,7 +82,17 @@ class IpcBufferModel final : public BufferModel {
     // does not bump revision()) if no buffer with that name is present.
     void remove(std::string_view variable_name);
 
-    // Monotonic counter bumped on every upsert/remove, for cheap
+    // Rewrites rows of the buffer matched by `variable_name` in place. The
+    // row size is the record's own, bytes.size() / height (after any
+    // FLOAT64 narrowing). Returns false without changing anything if no
+    // such buffer exists, its size is not a whole number of rows, or a
+    // patch does not land on whole rows inside it. Otherwise advances the
+    // slot's revision and the model-wide revision(), and
+    // changed_rows_since() reports the rows touched.
+    [[nodiscard]] bool patch_rows(std::string_view variable_name,
+                                  std::span<const RowPatch> patches);
+
+    // Monotonic counter bumped on every upsert/remove/patch_rows, for cheap
     // model-wide change detection.
     [[nodiscard]] std::uint64_t revision() const {
         return revision_;
@@ -80,14 +103,43 @@ class IpcBufferModel final : public BufferModel {
     // buffer i from an unrelated change elsewhere in the model.
     [[nodiscard]] std::uint64_t revision_of(std::size_t i) const override;
 
+    [[nodiscard]] std::optional<std::vector<RowRange>>
+    changed_rows_since(std::size_t i, std::uint64_t revision) const override;
+
     [[nodiscard]] const std::string&
     variable_name_of(std::size_t i) const override;
 
+    // Full-resolution tiles fetched for the lazy plots among the records
+    // (see BufferRecord::decimation). upsert() and remove() drop a name's
+    // tiles along with its record; adding tiles leaves every revision here
+    // alone, since the record itself is unchanged.
+    [[nodiscard]] RegionTileCache& region_tiles() {
+        return region_tiles_;
+    }
+    [[nodiscard]] const RegionTileCache& region_tiles() const {
+        return region_tiles_;
+    }
+
   private:
+    // How many in-place patches a slot remembers. A consumer further behind
+    // than that just rebuilds from the whole record.
+    static constexpr std::size_t MAX_PATCH_HISTORY = 64;
+
+    // The rows each patch since `complete_since` (a slot revision) touched,
+    // as disjoint runs, oldest patch first, tagged with the revision it
+    // produced.
+    struct PatchHistory {
+        std::uint64_t complete_since{};
+        std::vector<std::pair<std::uint64_t, std::vector<RowRange>>>
+            patches{};
+    };
+
     std::vector<std::unique_ptr<BufferRecord>> storage_;
     std::vector<std::uint64_t> slot_revision_; // parallel to storage_
+    std::vector<PatchHistory> history_;        // parallel to storage_
     std::uint64_t revision_{0};
     std::uint64_t next_slot_rev_{1};
+    RegionTileCache region_tiles_;
 };
 
 } // namespace oid::host
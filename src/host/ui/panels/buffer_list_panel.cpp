@@ -47,10 +47,11 @@ namespace oid::host {
 namespace {
 
 std::string row_label(const BufferRecord& rec) {
-    return std::format("{}\n[{}x{}]\n{}",
+    return std::format("{}\n[{}x{}]{}\n{}",
                        rec.display_name,
                        rec.width,
                        rec.height,
+                       rec.provisional ? " loading..." : "",
                        type_label(rec.type, rec.channels));
 }
 
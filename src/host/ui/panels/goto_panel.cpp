@@ -51,7 +51,7 @@ void prefill_goto_fields_on_open(bool& was_open, Stage* sel, int& x, int& y) {
         was_open = true;
         if (sel != nullptr) {
             if (const Camera* cam = camera_of(*sel); cam != nullptr) {
-                const vec4 p = cam->get_position();
+                const vec4 p = cam->get_source_position();
                 x = static_cast<int>(std::lround(p.x() - 0.5f));
                 y = static_cast<int>(std::lround(p.y() - 0.5f));
             }
@@ -44,6 +44,8 @@ class SvgIconCache;
 // `y = round(camera.get_position().y() - 0.5)`. Camera::get_position()
 // returns a buffer-space centered coordinate, so subtracting 0.5 and
 // rounding recovers the integer pixel index the camera is centered on.
+// Both ends use Camera::get_source_position() and Stage::go_to_pixel(),
+// which count in pixels of the buffer a decimated overview stands for.
 // Prefill only happens on that transition (not every frame) so it doesn't
 // clobber in-progress typing.
 //
@@ -109,16 +109,36 @@ std::optional<oid::vec4> stage_coordinates(Stage& stage,
 
 // Negative sentinel: the Stage failed to initialize, or its camera
 // GameObject/component isn't set up yet, so zoom isn't known this frame.
+// Relative to the pixels of the buffer a decimated overview stands for, so
+// it reads the same before and after a quick look is plotted in full.
 float compute_zoom_pct(Stage* stage) {
     float zoom_pct = -1.0f;
     if (stage != nullptr) {
         if (const Camera* cam = camera_of(*stage); cam != nullptr) {
-            zoom_pct = cam->compute_zoom() * 100.0f;
+            const Buffer* buffer = buffer_of(*stage);
+            const auto decimation =
+                buffer != nullptr ? buffer->decimation() : 1;
+            zoom_pct = cam->compute_zoom() * 100.0f /
+                       static_cast<float>(decimation);
         }
     }
     return zoom_pct;
 }
 
+// "[WxH]" of the buffer `rec` shows, and for an overview of a larger one
+// how much it is decimated, and how to get a quick look in full.
+std::string geometry_text(const BufferRecord& rec) {
+    if (rec.decimation <= 1) {
+        return std::format("[{}x{}]", rec.width, rec.height);
+    }
+    return std::format("[{}x{}, 1:{}{}]",
+                       rec.source_width,
+                       rec.source_height,
+                       rec.decimation,
+                       is_quick_look(rec) ? " quick look, Ctrl+R for full"
+                                          : "");
+}
+
 // Formats the hovered pixel's value text (coordinates + per-channel
 // values, plus float precision when applicable) — Qt parity with
 // MainWindow::update_status_bar in the legacy Qt frontend (see tag
@@ -170,8 +190,10 @@ std::optional<std::string> format_hovered_pixel_text(Stage* stage,
         return std::nullopt;
     }
 
-    const auto px = static_cast<int>(std::floor(coords->x()));
-    const auto py = static_cast<int>(std::floor(coords->y()));
+    // In pixels of the buffer an overview stands for.
+    const auto decimation = static_cast<float>(buffer->decimation());
+    const auto px = static_cast<int>(std::floor(coords->x() * decimation));
+    const auto py = static_cast<int>(std::floor(coords->y() * decimation));
     return format_pixel_value_text(*buffer, *stage, px, py);
 }
 
@@ -191,10 +213,9 @@ void draw_status_bar(const UiState& ui,
         Stage* stage = stages.selected_stage(sel);
         const float zoom_pct = compute_zoom_pct(stage);
 
-        line = std::format("{}   [{}x{}]   {}",
+        line = std::format("{}   {}   {}",
                            rec.display_name,
-                           rec.width,
-                           rec.height,
+                           geometry_text(rec),
                            type_label(rec.type, rec.channels));
         if (zoom_pct >= 0.0f) {
             line +=
@@ -34,7 +34,8 @@ class StageManager;
 class GlfwCanvas;
 
 // Draws a single-line status bar (parity with the Qt app's QStatusBar):
-// the selected buffer's display name, "WxH", its type/channel label, and
+// the selected buffer's display name, "WxH" (of the buffer a decimated
+// overview stands for, with its decimation), its type/channel label, and
 // the current zoom read off the selected Stage's Camera, when one is
 // available. Falls back to a neutral "no buffer" line when the model is
 // empty or the Stage hasn't initialized yet. When a stage/buffer/camera are
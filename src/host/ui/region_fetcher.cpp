@@ -0,0 +1,123 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "host/ui/region_fetcher.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "host/ipc/ipc_client.h"
+#include "host/ui/ipc_buffer_model.h"
+#include "host/ui/panels/panel_accessors.h"
+#include "host/ui/region_plan.h"
+
+namespace oid::host {
+
+namespace {
+
+// What of the buffer the camera shows. The half-extent is taken from the
+// canvas's longer side on both axes so a rotated view is still covered.
+VisibleRect visible_rect(const Camera& camera) {
+    const auto zoom = camera.compute_zoom();
+    const auto centre = camera.get_position();
+    const auto half =
+        static_cast<float>(
+            (std::max)(camera.canvas_width(), camera.canvas_height())) /
+        (2.0f * zoom);
+    return {.left = centre.x() - half,
+            .top = centre.y() - half,
+            .right = centre.x() + half,
+            .bottom = centre.y() + half};
+}
+
+} // namespace
+
+void RegionFetcher::update(IpcClient& ipc,
+                           IpcBufferModel& model,
+                           const std::size_t selected,
+                           Stage& stage) {
+    if (selected >= model.size()) {
+        return;
+    }
+    Buffer* buffer = buffer_of(stage);
+    const Camera* camera = camera_of(stage);
+    if (buffer == nullptr || camera == nullptr) {
+        return;
+    }
+    const BufferRecord& record = model.at(selected);
+    if (auto shown = std::pair{record.variable_name,
+                               model.revision_of(selected)};
+        shown != shown_) {
+        // Answers still due for what was shown before are not waited for.
+        shown_ = std::move(shown);
+        pending_.clear();
+        uploaded_ = false;
+    }
+    // A decimated preview's source is on its way whole, not to be fetched.
+    if (record.decimation <= 1 || record.provisional) {
+        return;
+    }
+
+    auto& tiles = model.region_tiles();
+    const auto now = std::chrono::steady_clock::now();
+    std::erase_if(pending_, [&](const auto& entry) {
+        const auto& [corner, asked] = entry;
+        return now - asked > REQUEST_TIMEOUT ||
+               tiles.find(record.variable_name, corner.first, corner.second) !=
+                   nullptr;
+    });
+    for (const auto& region :
+         tiles_in_view(record, visible_rect(*camera), camera->compute_zoom())) {
+        // Held tiles in view are marked used so panning elsewhere evicts
+        // others first.
+        if (tiles.find(record.variable_name, region.row, region.col) !=
+                nullptr ||
+            pending_.contains({region.row, region.col})) {
+            continue;
+        }
+        if (pending_.size() >= MAX_PENDING_REGIONS) {
+            break;
+        }
+        ipc.request_region(record.variable_name, region);
+        pending_.emplace(std::pair{region.row, region.col}, now);
+    }
+
+    if (uploaded_ && uploaded_revision_ == tiles.revision()) {
+        return;
+    }
+    std::vector<Buffer::DetailTile> detail;
+    for (const RegionTile* tile : tiles.tiles_of(record.variable_name)) {
+        detail.push_back({.row = tile->region.row,
+                          .col = tile->region.col,
+                          .rows = tile->region.rows,
+                          .cols = tile->region.cols,
+                          .bytes = tile->bytes});
+    }
+    buffer->set_detail_tiles(detail);
+    uploaded_revision_ = tiles.revision();
+    uploaded_ = true;
+}
+
+} // namespace oid::host
@@ -0,0 +1,80 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef HOST_UI_REGION_FETCHER_H_
+#define HOST_UI_REGION_FETCHER_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+
+namespace oid {
+class Stage;
+} // namespace oid
+
+namespace oid::host {
+
+class IpcBufferModel;
+class IpcClient;
+
+// Drives on-demand region fetching for the selected buffer when it is the
+// overview of a lazy plot (see BufferRecord::decimation): each frame it
+// asks for the full-resolution tiles the camera shows that are neither held
+// in the model's region_tiles() nor already asked for, and hands the tiles
+// held to the Stage's Buffer to draw over the overview.
+class RegionFetcher {
+  public:
+    // Most requests left unanswered at once; the rest wait for a later
+    // frame, by when the view may well have moved on.
+    static constexpr std::size_t MAX_PENDING_REGIONS = 8;
+
+    // A request not answered by then (the bridge could not read the
+    // region, say) counts as lost and may be made again.
+    static constexpr auto REQUEST_TIMEOUT = std::chrono::seconds{2};
+
+    // Call once per frame after IpcClient::poll(), with the selected buffer
+    // index and its Stage.
+    void update(IpcClient& ipc,
+                IpcBufferModel& model,
+                std::size_t selected,
+                Stage& stage);
+
+  private:
+    // The buffer (name and slot revision) the state below is about.
+    std::pair<std::string, std::uint64_t> shown_{};
+    // Corners (row, col) of the tiles asked for, and when.
+    std::map<std::pair<int, int>, std::chrono::steady_clock::time_point>
+        pending_{};
+    // RegionTileCache::revision() when the Buffer's tiles were last set.
+    std::uint64_t uploaded_revision_{0};
+    bool uploaded_{false};
+};
+
+} // namespace oid::host
+
+#endif // HOST_UI_REGION_FETCHER_H_
@@ -0,0 +1,90 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "host/ui/region_plan.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace oid::host {
+
+std::vector<PixelRegion> tiles_in_view(const BufferRecord& record,
+                                       const VisibleRect& visible,
+                                       const float zoom) {
+    if (record.decimation <= 1 || !(zoom > 1.0f)) {
+        return {};
+    }
+    const auto factor = static_cast<float>(record.decimation);
+    const auto width = record.source_width;
+    const auto height = record.source_height;
+    const auto in_source = [factor](const float v, const int limit) {
+        return std::clamp(v * factor, 0.0f, static_cast<float>(limit));
+    };
+    const auto left = in_source(visible.left, width);
+    const auto right = in_source(visible.right, width);
+    const auto top = in_source(visible.top, height);
+    const auto bottom = in_source(visible.bottom, height);
+    if (!(left < right) || !(top < bottom)) {
+        return {};
+    }
+
+    const auto first_col = static_cast<int>(left) / REGION_TILE_SIZE;
+    const auto first_row = static_cast<int>(top) / REGION_TILE_SIZE;
+    const auto end_col =
+        (static_cast<int>(std::ceil(right)) + REGION_TILE_SIZE - 1) /
+        REGION_TILE_SIZE;
+    const auto end_row =
+        (static_cast<int>(std::ceil(bottom)) + REGION_TILE_SIZE - 1) /
+        REGION_TILE_SIZE;
+    if ((end_col - first_col) * (end_row - first_row) > MAX_TILES_IN_VIEW) {
+        return {};
+    }
+
+    std::vector<PixelRegion> tiles;
+    for (int r = first_row; r < end_row; ++r) {
+        for (int c = first_col; c < end_col; ++c) {
+            const auto row = r * REGION_TILE_SIZE;
+            const auto col = c * REGION_TILE_SIZE;
+            const auto rows = (std::min)(REGION_TILE_SIZE, height - row);
+            const auto cols = (std::min)(REGION_TILE_SIZE, width - col);
+            tiles.push_back(
+                {.row = row, .col = col, .rows = rows, .cols = cols});
+        }
+    }
+
+    const auto middle_x = (left + right) / 2.0f;
+    const auto middle_y = (top + bottom) / 2.0f;
+    const auto distance = [&](const PixelRegion& tile) {
+        const auto dx = static_cast<float>(tile.col) +
+                        static_cast<float>(tile.cols) / 2.0f - middle_x;
+        const auto dy = static_cast<float>(tile.row) +
+                        static_cast<float>(tile.rows) / 2.0f - middle_y;
+        return dx * dx + dy * dy;
+    };
+    std::ranges::stable_sort(tiles, {}, distance);
+    return tiles;
+}
+
+} // namespace oid::host
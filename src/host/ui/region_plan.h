@@ -0,0 +1,61 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef HOST_UI_REGION_PLAN_H_
+#define HOST_UI_REGION_PLAN_H_
+
+#include <vector>
+
+#include "host/ui/buffer_model.h"
+#include "ipc/pixel_region.h"
+
+namespace oid::host {
+
+// The part of a record on screen, in the record's own pixels: columns
+// [left, right) and rows [top, bottom). May reach past the record.
+struct VisibleRect {
+    float left{};
+    float top{};
+    float right{};
+    float bottom{};
+};
+
+// Ceiling on the tiles fetched for one view. A view needing more is too
+// far out for full resolution to show, and the overview stands in.
+constexpr int MAX_TILES_IN_VIEW = 16;
+
+// The REGION_TILE_SIZE-aligned tiles of `record`'s source buffer that
+// `visible` covers, clipped to the source, those nearest the middle of the
+// view first. Empty unless `record` is an overview (decimation above 1)
+// shown magnified -- `zoom`, screen pixels per record pixel, above 1 --
+// and the view needs no more than MAX_TILES_IN_VIEW tiles.
+[[nodiscard]] std::vector<PixelRegion>
+tiles_in_view(const BufferRecord& record,
+              const VisibleRect& visible,
+              float zoom);
+
+} // namespace oid::host
+
+#endif // HOST_UI_REGION_PLAN_H_
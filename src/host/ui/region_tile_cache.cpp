@@ -0,0 +1,107 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "host/ui/region_tile_cache.h"
+
+#include <limits>
+#include <utility>
+
+namespace oid::host {
+
+namespace {
+
+// The smallest key of `variable_name`: where its tiles start in the index.
+std::tuple<std::string_view, int, int>
+first_key_of(const std::string_view variable_name) {
+    return {variable_name,
+            (std::numeric_limits<int>::min)(),
+            (std::numeric_limits<int>::min)()};
+}
+
+} // namespace
+
+RegionTileCache::RegionTileCache(const std::size_t byte_budget)
+    : byte_budget_(byte_budget) {}
+
+void RegionTileCache::insert(const std::string& variable_name,
+                             RegionTile tile) {
+    auto key = Key{variable_name, tile.region.row, tile.region.col};
+    if (const auto it = index_.find(key); it != index_.end()) {
+        erase(it->second);
+    }
+    if (tile.bytes.size() > byte_budget_) {
+        return;
+    }
+    bytes_ += tile.bytes.size();
+    lru_.push_front({key, std::move(tile)});
+    index_.emplace(std::move(key), lru_.begin());
+    while (bytes_ > byte_budget_) {
+        erase(std::prev(lru_.end()));
+    }
+    ++revision_;
+}
+
+const RegionTile* RegionTileCache::find(const std::string& variable_name,
+                                        const int row,
+                                        const int col) {
+    const auto it = index_.find(Key{variable_name, row, col});
+    if (it == index_.end()) {
+        return nullptr;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return &it->second->tile;
+}
+
+std::vector<const RegionTile*>
+RegionTileCache::tiles_of(const std::string_view variable_name) const {
+    std::vector<const RegionTile*> tiles;
+    for (auto it = index_.lower_bound(first_key_of(variable_name));
+         it != index_.end() && std::get<0>(it->first) == variable_name;
+         ++it) {
+        tiles.push_back(&it->second->tile);
+    }
+    return tiles;
+}
+
+void RegionTileCache::drop(const std::string_view variable_name) {
+    auto it = index_.lower_bound(first_key_of(variable_name));
+    if (it == index_.end() || std::get<0>(it->first) != variable_name) {
+        return;
+    }
+    while (it != index_.end() && std::get<0>(it->first) == variable_name) {
+        bytes_ -= it->second->tile.bytes.size();
+        lru_.erase(it->second);
+        it = index_.erase(it);
+    }
+    ++revision_;
+}
+
+void RegionTileCache::erase(const std::list<Entry>::iterator it) {
+    bytes_ -= it->tile.bytes.size();
+    index_.erase(it->key);
+    lru_.erase(it);
+}
+
+} // namespace oid::host
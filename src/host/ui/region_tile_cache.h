@@ -0,0 +1,107 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef HOST_UI_REGION_TILE_CACHE_H_
+#define HOST_UI_REGION_TILE_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "ipc/pixel_region.h"
+
+namespace oid::host {
+
+// Full-resolution pixels of part of a lazy plot (see ipc/pixel_region.h),
+// packed rows in the same format as the overview's BufferRecord::bytes.
+struct RegionTile {
+    PixelRegion region;
+    std::vector<std::byte> bytes;
+};
+
+// The region tiles fetched so far for every lazy plot, within a byte budget
+// shared by all of them: once over it, the least recently used tiles go
+// first, so panning back over a region already seen costs nothing while
+// its tiles last. Tiles are keyed by buffer name and the region's top-left
+// corner, which REGION_TILE_SIZE alignment makes unique.
+class RegionTileCache {
+  public:
+    static constexpr std::size_t DEFAULT_BYTE_BUDGET =
+        512ULL * 1024ULL * 1024ULL;
+
+    explicit RegionTileCache(std::size_t byte_budget = DEFAULT_BYTE_BUDGET);
+
+    // Stores `tile` for `variable_name`, replacing any held for the same
+    // corner, then evicts least recently used tiles until within budget.
+    // A tile larger than the whole budget is not kept.
+    void insert(const std::string& variable_name, RegionTile tile);
+
+    // The tile of `variable_name` whose corner is (`row`, `col`), marking it
+    // recently used; nullptr if not held.
+    [[nodiscard]] const RegionTile*
+    find(const std::string& variable_name, int row, int col);
+
+    // Every tile held for `variable_name`, by corner, without marking them.
+    [[nodiscard]] std::vector<const RegionTile*>
+    tiles_of(std::string_view variable_name) const;
+
+    // Drops every tile of `variable_name` (re-plotted or removed).
+    void drop(std::string_view variable_name);
+
+    [[nodiscard]] std::size_t byte_size() const {
+        return bytes_;
+    }
+
+    // Bumped whenever the set of tiles changes, so a renderer can tell when
+    // it has to look again.
+    [[nodiscard]] std::uint64_t revision() const {
+        return revision_;
+    }
+
+  private:
+    using Key = std::tuple<std::string, int, int>;
+    struct Entry {
+        Key key;
+        RegionTile tile;
+    };
+
+    void erase(std::list<Entry>::iterator it);
+
+    // Most recently used first.
+    std::list<Entry> lru_;
+    std::map<Key, std::list<Entry>::iterator, std::less<>> index_;
+    std::size_t byte_budget_;
+    std::size_t bytes_{0};
+    std::uint64_t revision_{0};
+};
+
+} // namespace oid::host
+
+#endif // HOST_UI_REGION_TILE_CACHE_H_
@@ -25,6 +25,7 @@
 
 #include "host/ui/stage_manager.h"
 
+#include <algorithm>
 #include <iostream>
 #include <span>
 #include <unordered_set>
@@ -46,9 +47,23 @@ BufferParams params_from(const BufferRecord& rec) {
         .step = rec.step,
         .pixel_layout = rec.pixel_layout,
         .transpose_buffer = rec.transpose,
+        .decimation = rec.decimation,
     };
 }
 
+// Adds `rows` to `pending`, both disjoint runs in row order, keeping it so.
+void add_rows(std::vector<RowRange>& pending,
+              const std::vector<RowRange>& rows) {
+    RowIntervals all;
+    for (const auto& run : pending) {
+        all.insert(run.first, run.first + run.count);
+    }
+    for (const auto& run : rows) {
+        all.insert(run.first, run.first + run.count);
+    }
+    pending = row_ranges_of(all);
+}
+
 } // namespace
 
 StageManager::StageManager(std::shared_ptr<RenderCanvas> canvas,
@@ -71,6 +86,12 @@ Stage* StageManager::stage_for(const std::size_t i) {
 }
 
 void StageManager::sync() {
+    if (const auto now = std::chrono::steady_clock::now();
+        now - upload_window_ >= UPLOAD_WINDOW) {
+        upload_window_ = now;
+        upload_budget_ = MAX_ROW_UPLOAD_BYTES;
+    }
+
     std::unordered_set<std::string, TransparentStringHash, std::equal_to<>>
         live_names;
     live_names.reserve(model_.size());
@@ -98,15 +119,34 @@ void StageManager::sync() {
                 std::cerr << "[Error] failed to initialize Stage for buffer '"
                           << name << "'\n";
             }
-        } else if (it->second.revision != rev) {
+        } else if (it->second.revision != rev ||
+                   !it->second.pending.empty()) {
             // Re-plot: rebuild the Stage's GL buffer from the record's
             // current bytes while preserving the Stage's camera/zoom, then
             // record the new revision so this isn't repeated next sync().
-            if (!it->second.stage->buffer_update(params_from(model_.at(i)))) {
+            // When the record was only patched in place since, re-uploading
+            // the rows that changed is enough, as the budget allows.
+            auto& entry = it->second;
+            bool updated = true;
+            if (entry.revision != rev) {
+                const auto rows = model_.changed_rows_since(i, entry.revision);
+                if (!rows.has_value()) {
+                    entry.pending.clear();
+                    updated =
+                        entry.stage->buffer_update(params_from(model_.at(i)));
+                } else {
+                    add_rows(entry.pending, *rows);
+                }
+                entry.revision = rev;
+            }
+            if (updated && !entry.pending.empty()) {
+                updated = upload_pending(entry, model_.at(i));
+            }
+            if (!updated) {
+                entry.pending.clear();
                 std::cerr << "[Error] failed to update Stage for buffer '"
                           << name << "'\n";
             }
-            it->second.revision = rev;
         }
     }
 
@@ -118,4 +158,41 @@ void StageManager::sync() {
     });
 }
 
+bool StageManager::upload_pending(Entry& entry, const BufferRecord& record) {
+    auto& pending = entry.pending;
+    const auto height = static_cast<std::size_t>(record.height);
+    const auto row_bytes = height == 0 ? 0 : record.bytes.size() / height;
+    bool updated = true;
+    std::size_t done = 0; // runs uploaded in full
+    while (updated && done < pending.size() && upload_budget_ > 0) {
+        auto& run = pending[done];
+        const auto rows =
+            row_bytes == 0
+                ? run.count
+                : std::clamp<std::size_t>(upload_budget_ / row_bytes,
+                                          1,
+                                          run.count);
+        upload_budget_ -= (std::min)(upload_budget_, rows * row_bytes);
+        // A stand-in only ever gains rows, and a part of a larger update is
+        // followed by the rest, so neither needs a rescan of the whole
+        // buffer: the last part of a patch does it once.
+        const bool last = rows == run.count && done + 1 == pending.size();
+        const auto range = record.provisional || !last
+                               ? Buffer::RangeUpdate::WIDEN
+                               : Buffer::RangeUpdate::RESCAN;
+        updated = entry.stage->update_buffer_rows(params_from(record),
+                                                  static_cast<int>(run.first),
+                                                  static_cast<int>(rows),
+                                                  range);
+        run.first += rows;
+        run.count -= rows;
+        if (run.count == 0) {
+            ++done;
+        }
+    }
+    pending.erase(pending.begin(),
+                  pending.begin() + static_cast<std::ptrdiff_t>(done));
+    return updated;
+}
+
 } // namespace oid::host
@@ -26,11 +26,13 @@
 #ifndef HOST_UI_STAGE_MANAGER_H_
 #define HOST_UI_STAGE_MANAGER_H_
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "host/ui/buffer_model.h"
 #include "host/util/transparent_string_hash.h"
@@ -71,11 +73,25 @@ class StageManager {
     // A Stage plus the model-slot revision it was last built/updated from,
     // so sync() can tell an untouched buffer from a re-plotted one without
     // diffing bytes.
+    // `pending` holds rows changed by then but not uploaded yet, for want of
+    // upload budget, as disjoint runs in row order.
     struct Entry {
         std::unique_ptr<Stage> stage;
         std::uint64_t revision;
+        std::vector<RowRange> pending{};
     };
 
+    // Row uploads share this many bytes per UPLOAD_WINDOW (about a frame)
+    // across every Stage, so a buffer patched faster than that -- one still
+    // streaming in -- fills in over several frames rather than stalling one.
+    // Whole-buffer rebuilds are not held back.
+    static constexpr std::size_t MAX_ROW_UPLOAD_BYTES = std::size_t{16} << 20;
+    static constexpr auto UPLOAD_WINDOW = std::chrono::milliseconds{16};
+
+    // Uploads as much of `entry.pending` as the budget left allows (at
+    // least a row while any is left), run by run from the top down.
+    [[nodiscard]] bool upload_pending(Entry& entry, const BufferRecord& record);
+
     // Reconciles by_name_ against the model's current contents: creates a
     // Stage for a name not yet present, calls Stage::buffer_update() for a
     // name whose revision advanced (re-plot), and erases any name no longer
@@ -91,6 +107,8 @@ class StageManager {
                        TransparentStringHash,
                        std::equal_to<>>
         by_name_;
+    std::size_t upload_budget_{};
+    std::chrono::steady_clock::time_point upload_window_{};
 };
 
 } // namespace oid::host
@@ -0,0 +1,88 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef HOST_UTIL_SPSC_QUEUE_H_
+#define HOST_UTIL_SPSC_QUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace oid::host {
+
+// Bounded lock-free queue for exactly one producer thread and one consumer
+// thread. Neither side ever blocks or allocates: try_push() reports a full
+// queue and try_pop() an empty one, and the caller decides whether to wait.
+// One slot is kept empty to tell full from empty, so the ring holds
+// capacity + 1 slots.
+template <typename T> class SpscQueue {
+  public:
+    explicit SpscQueue(const std::size_t capacity) : slots_(capacity + 1) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer only. Moves from `value` only when it returns true, so a
+    // caller can retry with the same object after a full queue.
+    [[nodiscard]] bool try_push(T&& value) {
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        const auto next = advance(tail);
+        if (next == head_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        slots_[tail].emplace(std::move(value));
+        tail_.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only.
+    [[nodiscard]] std::optional<T> try_pop() {
+        const auto head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return std::nullopt;
+        }
+        std::optional<T> value{std::move(*slots_[head])};
+        slots_[head].reset();
+        head_.store(advance(head), std::memory_order_release);
+        return value;
+    }
+
+  private:
+    [[nodiscard]] std::size_t advance(const std::size_t index) const {
+        return index + 1 == slots_.size() ? 0 : index + 1;
+    }
+
+    std::vector<std::optional<T>> slots_;
+    // Each index is written by one side only; separate cache lines keep the
+    // producer and consumer from invalidating each other's.
+    alignas(64) std::atomic<std::size_t> head_{0}; // next slot to pop
+    alignas(64) std::atomic<std::size_t> tail_{0}; // next slot to fill
+};
+
+} // namespace oid::host
+
+#endif // HOST_UTIL_SPSC_QUEUE_H_
@@ -25,6 +25,13 @@
 
 #include "asio_transport.h"
 
+#if defined(OID_HAS_LOCAL_SOCKET_TRANSPORT)
+#include <cerrno>
+#include <cstdlib>
+#include <filesystem>
+#include <system_error>
+#endif
+
 #include "message_exchange.h" // throw_socket_timeout_error
 
 namespace oid {
@@ -53,6 +60,48 @@ bool run_until(asio::io_context& ctx,
     }
     return false;
 }
+
+// Bounded accept shared by both acceptors; the peer's socket, whatever its
+// protocol, is handed to the transport as a generic stream socket.
+template <typename Acceptor>
+AsioTransport accept_on(asio::io_context& ctx,
+                        Acceptor& acceptor,
+                        const std::chrono::milliseconds timeout) {
+    typename Acceptor::protocol_type::socket sock{ctx};
+
+    bool done = false;
+    asio::error_code op_ec;
+    acceptor.async_accept(sock, [&op_ec, &done](const asio::error_code& e) {
+        op_ec = e;
+        done = true;
+    });
+    if (run_until(ctx, acceptor, done, timeout) || op_ec) {
+        throw_socket_timeout_error("accept");
+    }
+
+    return AsioTransport{
+        ctx, asio::generic::stream_protocol::socket{std::move(sock)}, timeout};
+}
+
+#if defined(OID_HAS_LOCAL_SOCKET_TRANSPORT)
+// The socket goes in a fresh directory only its owner may enter: bind()
+// derives the socket file's own mode from the process umask, so the
+// directory is what keeps other users from connecting.
+std::string make_socket_path() {
+    auto directory =
+        (std::filesystem::temp_directory_path() / "oid-XXXXXX").string();
+    if (::mkdtemp(directory.data()) == nullptr) {
+        throw std::system_error{errno, std::generic_category(), "mkdtemp"};
+    }
+    return directory + "/window.sock";
+}
+
+void remove_socket_path(const std::string& path) {
+    std::error_code ignore;
+    std::filesystem::remove(path, ignore);
+    std::filesystem::remove(std::filesystem::path{path}.parent_path(), ignore);
+}
+#endif
 } // namespace
 
 AsioTransport::AsioTransport(const std::string& host,
@@ -74,24 +123,47 @@ AsioTransport::AsioTransport(const std::string& host,
         return;
     }
 
+    asio::ip::tcp::socket sock{*ctx_};
     bool done = false;
     asio::error_code op_ec;
-    asio::async_connect(socket_,
+    asio::async_connect(sock,
                         endpoints,
                         [&op_ec, &done](const asio::error_code& e,
                                         const asio::ip::tcp::endpoint&) {
                             op_ec = e;
                             done = true;
                         });
-    if (run_until(*ctx_, socket_, done, timeout_) || op_ec) {
+    if (run_until(*ctx_, sock, done, timeout_) || op_ec) {
+        disconnected_ = true; // sock closes as it goes out of scope
+        return;
+    }
+    socket_ = std::move(sock);
+}
+
+#if defined(OID_HAS_LOCAL_SOCKET_TRANSPORT)
+AsioTransport::AsioTransport(
+    const asio::local::stream_protocol::endpoint& endpoint,
+    const std::chrono::milliseconds timeout)
+    : owned_ctx_{std::make_unique<asio::io_context>()}, ctx_{owned_ctx_.get()},
+      socket_{*ctx_}, timeout_{timeout} {
+    // Must not throw either, for the same reason as the TCP client above.
+    asio::local::stream_protocol::socket sock{*ctx_};
+    bool done = false;
+    asio::error_code op_ec;
+    sock.async_connect(endpoint, [&op_ec, &done](const asio::error_code& e) {
+        op_ec = e;
+        done = true;
+    });
+    if (run_until(*ctx_, sock, done, timeout_) || op_ec) {
         disconnected_ = true;
-        asio::error_code close_ec;
-        socket_.close(close_ec);
+        return;
     }
+    socket_ = std::move(sock);
 }
+#endif
 
 AsioTransport::AsioTransport(asio::io_context& ctx,
-                             asio::ip::tcp::socket&& sock,
+                             asio::generic::stream_protocol::socket&& sock,
                              const std::chrono::milliseconds timeout)
     : owned_ctx_{nullptr}, ctx_{&ctx}, socket_{std::move(sock)},
       timeout_{timeout} {}
@@ -105,6 +177,21 @@ void AsioTransport::send(const std::span<const std::byte> data) {
     }
 }
 
+void AsioTransport::send_gather(
+    const std::span<const std::span<const std::byte>> parts) {
+    std::vector<asio::const_buffer> buffers;
+    buffers.reserve(parts.size());
+    for (const auto part : parts) {
+        buffers.emplace_back(part.data(), part.size());
+    }
+    asio::error_code ec;
+    // Same all-or-error contract as send(), over the whole sequence.
+    asio::write(socket_, buffers, ec);
+    if (ec) {
+        throw_socket_timeout_error("write");
+    }
+}
+
 std::size_t AsioTransport::receive(const std::span<std::byte> dst) {
     bool done = false;
     asio::error_code op_ec;
@@ -127,6 +214,35 @@ std::size_t AsioTransport::receive(const std::span<std::byte> dst) {
     return n;
 }
 
+bool AsioTransport::wait_for_data() {
+    bool done = false;
+    bool readable = false;
+    // Anything but cancellation -- a socket error too -- leaves something
+    // for receive() to find out.
+    socket_.async_wait(asio::socket_base::wait_read,
+                       [&done, &readable](const asio::error_code& e) {
+                           readable = e != asio::error::operation_aborted;
+                           done = true;
+                       });
+    // One handler at a time: run_one() also returns for the reactor's own
+    // steps, which complete neither.
+    ctx_->restart();
+    while (!done && !*interrupted_) {
+        ctx_->run_one();
+    }
+    if (!done) {
+        asio::error_code ignore;
+        socket_.cancel(ignore);
+        ctx_->run(); // let the cancelled handler run; its captures are here
+    }
+    *interrupted_ = false;
+    return readable;
+}
+
+void AsioTransport::interrupt_wait() {
+    asio::post(*ctx_, [interrupted = interrupted_] { *interrupted = true; });
+}
+
 bool AsioTransport::has_data() const {
     asio::error_code ec;
     return socket_.available(ec) > 0 && !ec;
@@ -163,26 +279,47 @@ void AsioTransport::set_timeout(const std::chrono::milliseconds timeout) {
 }
 
 AsioAcceptor::AsioAcceptor()
-    : acceptor_{io_context_, asio::ip::tcp::endpoint{asio::ip::tcp::v4(), 0}} {}
+    : acceptor_{io_context_,
+                asio::ip::tcp::endpoint{asio::ip::address_v4::loopback(), 0}} {}
 
 unsigned short AsioAcceptor::port() const {
     return acceptor_.local_endpoint().port();
 }
 
 AsioTransport AsioAcceptor::accept(const std::chrono::milliseconds timeout) {
-    asio::ip::tcp::socket sock{io_context_};
+    return accept_on(io_context_, acceptor_, timeout);
+}
 
-    bool done = false;
-    asio::error_code op_ec;
-    acceptor_.async_accept(sock, [&op_ec, &done](const asio::error_code& e) {
-        op_ec = e;
-        done = true;
-    });
-    if (run_until(io_context_, acceptor_, done, timeout) || op_ec) {
-        throw_socket_timeout_error("accept");
+#if defined(OID_HAS_LOCAL_SOCKET_TRANSPORT)
+AsioLocalAcceptor::AsioLocalAcceptor()
+    : path_{make_socket_path()}, acceptor_{io_context_} {
+    // The directory exists by now; don't leave it behind if binding fails
+    // (the destructor won't run).
+    try {
+        const asio::local::stream_protocol::endpoint endpoint{path_};
+        acceptor_.open(endpoint.protocol());
+        acceptor_.bind(endpoint);
+        acceptor_.listen();
+    } catch (...) {
+        remove_socket_path(path_);
+        throw;
     }
+}
+
+AsioLocalAcceptor::~AsioLocalAcceptor() {
+    asio::error_code ignore;
+    acceptor_.close(ignore);
+    remove_socket_path(path_);
+}
+
+const std::string& AsioLocalAcceptor::path() const {
+    return path_;
+}
 
-    return AsioTransport{io_context_, std::move(sock), timeout};
+AsioTransport
+AsioLocalAcceptor::accept(const std::chrono::milliseconds timeout) {
+    return accept_on(io_context_, acceptor_, timeout);
 }
+#endif
 
 } // namespace oid
@@ -31,6 +31,7 @@
 #include <memory>
 #include <span>
 #include <string>
+#include <vector>
 
 #include <asio.hpp>
 
@@ -38,16 +39,16 @@
 
 namespace oid {
 
-// Standalone-Asio TCP transport implementing ITransport, usable on both
-// ends of the connection. Reproduces TcpTransport's semantics: send blocks
-// until all bytes are handed to the OS (throws on error), receive is a
-// best-effort single read that may return a short count and returns 0 only
-// when the peer sends nothing / disconnects (the MessageDecoder read loop
-// escalates a 0 to a timeout), has_data is a non-blocking peek. All
-// blocking operations (connect/receive) are bounded by `timeout_`, on which
-// they throw SocketTimeoutError -- except the client ctor's connect, which
-// matches the old Qt-based TcpTransport's graceful-degrade behavior (see
-// below).
+// Standalone-Asio stream transport implementing ITransport, usable on both ends
+// of the connection, over TCP or -- where OID_HAS_LOCAL_SOCKET_TRANSPORT is
+// defined -- a Unix-domain socket. Reproduces TcpTransport's semantics: send
+// blocks until all bytes are handed to the OS (throws on error), receive is a
+// best-effort single read that may return a short count and returns 0 only when
+// the peer sends nothing / disconnects (the MessageDecoder read loop escalates
+// a 0 to a timeout), has_data is a non-blocking peek. All blocking operations
+// (connect/receive) are bounded by `timeout_`, on which they throw
+// SocketTimeoutError -- except the client ctor's connect, which matches the old
+// Qt-based TcpTransport's graceful-degrade behavior (see below).
 class AsioTransport final : public ITransport {
   public:
     // Client: owns its io_context; resolve+connect with a bounded deadline.
@@ -61,22 +62,45 @@ class AsioTransport final : public ITransport {
                   unsigned short port,
                   std::chrono::milliseconds timeout = std::chrono::seconds{5});
 
+#if defined(OID_HAS_LOCAL_SOCKET_TRANSPORT)
+    // Client over the Unix-domain socket at `endpoint`; same owned
+    // io_context, bounded connect and graceful degrade as the TCP client.
+    explicit AsioTransport(
+        const asio::local::stream_protocol::endpoint& endpoint,
+        std::chrono::milliseconds timeout = std::chrono::seconds{5});
+#endif
+
     // Server: adopt an already-accepted socket bound to `ctx` (the
     // acceptor's io_context). LIFETIME: `ctx` is NOT owned by this
-    // transport and must outlive it -- it is normally the AsioAcceptor's
-    // io_context_, so the AsioAcceptor must outlive every AsioTransport it
-    // produced via accept().
+    // transport and must outlive it -- it is normally the acceptor's
+    // io_context_, so the AsioAcceptor (or AsioLocalAcceptor) must outlive
+    // every AsioTransport it produced via accept().
     AsioTransport(asio::io_context& ctx,
-                  asio::ip::tcp::socket&& sock,
+                  asio::generic::stream_protocol::socket&& sock,
                   std::chrono::milliseconds timeout = std::chrono::seconds{5});
 
     void send(std::span<const std::byte> data) override;
+    // One gathered write (writev on POSIX) over all `parts`; blocks until
+    // every byte is handed to the OS, throwing on error like send().
+    void
+    send_gather(std::span<const std::span<const std::byte>> parts) override;
     // Bounded single read; throws SocketTimeoutError if nothing arrives
     // within timeout_. Returns 0 on EOF/error (sets disconnected()) so
     // MessageDecoder::read_impl escalates it.
     std::size_t receive(std::span<std::byte> dst) override;
     [[nodiscard]] bool has_data() const override;
 
+    // Blocks until the socket is readable -- bytes to read, or the peer
+    // gone -- or until interrupt_wait() is called from another thread, with
+    // no deadline. Returns whether the socket became readable. Runs the
+    // transport's io_context, so it must not overlap another blocking call
+    // on this transport (or on the context it shares).
+    bool wait_for_data();
+
+    // Any thread: makes a wait_for_data() in progress return, or the next
+    // one return at once.
+    void interrupt_wait();
+
     // True once receive() has observed EOF/an error on the socket.
     [[nodiscard]] bool disconnected() const;
 
@@ -103,17 +127,25 @@ class AsioTransport final : public ITransport {
     // mutable: the const is_connected() liveness probe toggles the socket's
     // non-blocking mode and issues a MSG_PEEK receive, neither of which
     // asio exposes as const, even though they don't change observable
-    // transport state.
-    mutable asio::ip::tcp::socket socket_; // constructed on *ctx_
+    // transport state. Generic, so one transport covers TCP and
+    // Unix-domain sockets alike.
+    mutable asio::generic::stream_protocol::socket
+        socket_; // constructed on *ctx_
     std::chrono::milliseconds timeout_;
     // mutable: latched by the const is_connected() liveness probe on
     // EOF/error, in addition to the non-const receive() path.
     mutable bool disconnected_{false};
+    // Set by a handler interrupt_wait() posts, so only by whichever thread
+    // is running the io_context; cleared as wait_for_data() returns. Shared
+    // with the handler, which may outlive this transport in a context it
+    // shares with others.
+    std::shared_ptr<bool> interrupted_{std::make_shared<bool>(false)};
 };
 
 // Standalone-Asio TCP listener producing AsioTransport instances for the
-// server side of the connection. Binds an ephemeral port on all
-// interfaces; callers query port() to learn what it picked.
+// server side of the connection. Binds an ephemeral port on the loopback
+// interface only -- the window it serves runs on the same host; callers
+// query port() to learn what it picked.
 class AsioAcceptor {
   public:
     AsioAcceptor();
@@ -131,6 +163,36 @@ class AsioAcceptor {
     asio::ip::tcp::acceptor acceptor_;
 };
 
+#if defined(OID_HAS_LOCAL_SOCKET_TRANSPORT)
+// Unix-domain counterpart of AsioAcceptor, for a window on the same host:
+// no TCP/IP stack on the path and nothing listening on a port. Binds a
+// fresh socket file in the temporary directory, readable and writable by
+// the owner only, and removes it on destruction. Throws std::system_error
+// (a std::runtime_error) if the socket cannot be created or bound, e.g.
+// when the directory's path is too long for sockaddr_un.
+class AsioLocalAcceptor {
+  public:
+    AsioLocalAcceptor();
+    ~AsioLocalAcceptor();
+
+    AsioLocalAcceptor(const AsioLocalAcceptor&) = delete;
+    AsioLocalAcceptor& operator=(const AsioLocalAcceptor&) = delete;
+
+    // Filesystem path of the socket, for the peer to connect to.
+    [[nodiscard]] const std::string& path() const;
+
+    // Bounded accept, as AsioAcceptor::accept(), with the same lifetime
+    // requirement on the returned transport.
+    AsioTransport accept(std::chrono::milliseconds timeout);
+
+  private:
+    std::string path_;
+    asio::io_context
+        io_context_; // owned; must outlive every accepted transport
+    asio::local::stream_protocol::acceptor acceptor_;
+};
+#endif
+
 } // namespace oid
 
 #endif // IPC_ASIO_TRANSPORT_H_
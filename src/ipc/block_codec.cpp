@@ -0,0 +1,260 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "block_codec.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+namespace oid {
+
+namespace {
+
+// The format's fixed parameters (LZ4 block format).
+constexpr std::size_t MIN_MATCH = 4;
+// Every block ends in at least this many literals...
+constexpr std::size_t LAST_LITERALS = 5;
+// ...and no match starts closer than this to its end.
+constexpr std::size_t MATCH_FIND_LIMIT = 12;
+constexpr std::size_t MAX_OFFSET = 65535;
+constexpr std::size_t LENGTH_NIBBLE_MAX = 15;
+
+constexpr int HASH_LOG = 12;
+// Each miss in a row lengthens the next step once this many have
+// accumulated, so incompressible stretches are skimmed rather than searched
+// at every byte.
+constexpr unsigned SKIP_TRIGGER = 6;
+
+std::uint32_t read_u32(const std::byte* p) {
+    std::uint32_t value{};
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+std::uint64_t read_u64(const std::byte* p) {
+    std::uint64_t value{};
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+std::size_t hash_of(const std::uint32_t word) {
+    return (word * 2654435761U) >> (32 - HASH_LOG);
+}
+
+// Length of the common prefix of `a` and `b`, up to `limit` bytes.
+std::size_t common_length(const std::byte* a,
+                          const std::byte* b,
+                          const std::size_t limit) {
+    std::size_t length = 0;
+    if constexpr (std::endian::native == std::endian::little) {
+        while (length + sizeof(std::uint64_t) <= limit) {
+            if (const auto diff = read_u64(a + length) ^ read_u64(b + length);
+                diff != 0) {
+                return length +
+                       static_cast<std::size_t>(std::countr_zero(diff)) / 8;
+            }
+            length += sizeof(std::uint64_t);
+        }
+    }
+    while (length < limit && a[length] == b[length]) {
+        ++length;
+    }
+    return length;
+}
+
+// Lengths past a token nibble's 15 continue as a run of 255s closed by a
+// byte below 255.
+void push_length(std::vector<std::byte>& out, std::size_t length) {
+    while (length >= 255) {
+        out.push_back(std::byte{255});
+        length -= 255;
+    }
+    out.push_back(static_cast<std::byte>(length));
+}
+
+bool read_length(const std::span<const std::byte> block,
+                 std::size_t& pos,
+                 std::size_t& length) {
+    auto byte = std::byte{};
+    do {
+        if (pos == block.size()) {
+            return false;
+        }
+        byte = block[pos++];
+        length += std::to_integer<std::size_t>(byte);
+    } while (byte == std::byte{255});
+    return true;
+}
+
+// One sequence's token and literals; the match, if any, follows.
+void push_literals(std::vector<std::byte>& out,
+                   const std::span<const std::byte> literals,
+                   const std::size_t match_nibble) {
+    const auto count = literals.size();
+    const auto literal_nibble = (std::min)(count, LENGTH_NIBBLE_MAX);
+    out.push_back(static_cast<std::byte>((literal_nibble << 4) | match_nibble));
+    if (count >= LENGTH_NIBBLE_MAX) {
+        push_length(out, count - LENGTH_NIBBLE_MAX);
+    }
+    out.insert(out.end(), literals.begin(), literals.end());
+}
+
+// Copies a match of `length` bytes starting `offset` bytes back. When the
+// two overlap the match repeats the last `offset` bytes, so it is copied
+// from the same start in steps that never reach past what is already
+// written, each twice as long as the last.
+void copy_match(std::byte* out,
+                const std::size_t pos,
+                const std::size_t offset,
+                const std::size_t length) {
+    const auto from = pos - offset;
+    std::size_t done = 0;
+    while (done < length) {
+        const auto step = (std::min)(length - done, pos + done - from);
+        std::memcpy(out + pos + done, out + from, step);
+        done += step;
+    }
+}
+
+} // namespace
+
+std::vector<std::byte> compress_block(const std::span<const std::byte> bytes) {
+    std::vector<std::byte> out;
+    out.reserve(compress_bound(bytes.size()));
+
+    const std::byte* const src = bytes.data();
+    const auto size = bytes.size();
+    std::size_t anchor = 0;
+    if (size > MATCH_FIND_LIMIT) {
+        const auto match_start_limit = size - MATCH_FIND_LIMIT;
+        const auto match_end_limit = size - LAST_LITERALS;
+        // Most recent position of each hashed 4-byte word.
+        std::array<std::size_t, std::size_t{1} << HASH_LOG> table{};
+
+        std::size_t pos = 1;
+        while (pos < match_start_limit) {
+            std::size_t ref = 0;
+            auto found = false;
+            for (unsigned attempts = 1U << SKIP_TRIGGER;
+                 pos < match_start_limit;
+                 pos += attempts++ >> SKIP_TRIGGER) {
+                const auto word = read_u32(src + pos);
+                auto& slot = table[hash_of(word)];
+                ref = slot;
+                slot = pos;
+                if (ref < pos && pos - ref <= MAX_OFFSET &&
+                    read_u32(src + ref) == word) {
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) {
+                break;
+            }
+
+            while (pos > anchor && ref > 0 && src[pos - 1] == src[ref - 1]) {
+                --pos;
+                --ref;
+            }
+            const auto length =
+                MIN_MATCH + common_length(src + pos + MIN_MATCH,
+                                          src + ref + MIN_MATCH,
+                                          match_end_limit - pos - MIN_MATCH);
+
+            const auto offset = pos - ref;
+            const auto extra = length - MIN_MATCH;
+            push_literals(out,
+                          bytes.subspan(anchor, pos - anchor),
+                          (std::min)(extra, LENGTH_NIBBLE_MAX));
+            out.push_back(static_cast<std::byte>(offset & 0xFF));
+            out.push_back(static_cast<std::byte>(offset >> 8));
+            if (extra >= LENGTH_NIBBLE_MAX) {
+                push_length(out, extra - LENGTH_NIBBLE_MAX);
+            }
+
+            pos += length;
+            anchor = pos;
+            if (pos < match_start_limit) {
+                table[hash_of(read_u32(src + pos - 2))] = pos - 2;
+            }
+        }
+    }
+    push_literals(out, bytes.subspan(anchor), 0);
+    return out;
+}
+
+bool decompress_block(const std::span<const std::byte> block,
+                      const std::span<std::byte> out) {
+    std::size_t in = 0;
+    std::size_t pos = 0;
+    while (in < block.size()) {
+        const auto token = std::to_integer<std::size_t>(block[in++]);
+
+        auto literals = token >> 4;
+        if (literals == LENGTH_NIBBLE_MAX &&
+            !read_length(block, in, literals)) {
+            return false;
+        }
+        if (literals > block.size() - in || literals > out.size() - pos) {
+            return false;
+        }
+        if (literals != 0) {
+            std::memcpy(out.data() + pos, block.data() + in, literals);
+        }
+        in += literals;
+        pos += literals;
+
+        // Only the last sequence has no match.
+        if (in == block.size()) {
+            return pos == out.size();
+        }
+        if (block.size() - in < 2) {
+            return false;
+        }
+        const auto offset = std::to_integer<std::size_t>(block[in]) |
+                            (std::to_integer<std::size_t>(block[in + 1]) << 8);
+        in += 2;
+        if (offset == 0 || offset > pos) {
+            return false;
+        }
+        auto length = token & LENGTH_NIBBLE_MAX;
+        if (length == LENGTH_NIBBLE_MAX && !read_length(block, in, length)) {
+            return false;
+        }
+        length += MIN_MATCH;
+        if (length > out.size() - pos) {
+            return false;
+        }
+        copy_match(out.data(), pos, offset, length);
+        pos += length;
+    }
+    // An empty block is not even a valid encoding of nothing.
+    return false;
+}
+
+} // namespace oid
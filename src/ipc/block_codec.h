@@ -0,0 +1,60 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef IPC_BLOCK_CODEC_H_
+#define IPC_BLOCK_CODEC_H_
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace oid {
+
+// Fast byte-oriented block compression in the LZ4 block format: greedy
+// matching over a 64 KiB window, no entropy coding. Worth it on masks,
+// label images and mostly-constant float buffers, which shrink by an
+// order of magnitude or more at several hundred MB/s per core; noisy data
+// barely shrinks, so callers keep the raw bytes when it does not pay.
+// Each block stands alone: it carries neither its own size nor a checksum.
+
+// Largest size compress_block() can produce for `size` input bytes.
+[[nodiscard]] constexpr std::size_t compress_bound(const std::size_t size) {
+    return size + size / 255 + 16;
+}
+
+// Compresses `bytes` into a new block.
+[[nodiscard]] std::vector<std::byte>
+compress_block(std::span<const std::byte> bytes);
+
+// Decompresses `block` into `out`, which must be exactly the size that was
+// compressed. Returns false, leaving `out` unspecified, if the block is
+// malformed or does not decode to exactly out.size() bytes; never reads or
+// writes outside the two spans, whatever `block` contains.
+[[nodiscard]] bool decompress_block(std::span<const std::byte> block,
+                                    std::span<std::byte> out);
+
+} // namespace oid
+
+#endif // IPC_BLOCK_CODEC_H_
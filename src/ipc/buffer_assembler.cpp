@@ -26,101 +26,361 @@
 #include "buffer_assembler.h"
 
 #include <algorithm>
-#include <cstring>
 #include <utility>
 
+#include "block_codec.h"
 #include "raw_data_decode.h"
 
 namespace oid {
 
-bool BufferAssembler::begin(BeginParams params) {
-    // A rejected begin must also drop any transfer already in flight under
-    // this name, or its chunks would keep landing in the previous
-    // allocation, under the previous geometry.
-    auto name = params.variable_name;
+bool BufferAssembler::acceptable(const BeginParams& params) {
     // An unknown type would be taken as UNSIGNED_BYTE by type_size(), so the
     // size arithmetic below would silently use the wrong element width.
     if (!is_known_buffer_type(params.type)) {
-        in_progress_.erase(name);
         return false;
     }
-    // The declaration is untrusted and drives the allocation right below, so
+    // The declaration is untrusted and drives the allocation in begin(), so
     // cap it before allocating rather than relying on the allocator to fail.
     if (exceeds_max_buffer_bytes(params.total_byte_size)) {
-        in_progress_.erase(name);
         return false;
     }
     // The renderer would refuse this geometry anyway (Buffer::configure());
     // catching it here means the transfer never gets allocated and assembled
     // first.
     if (!within_display_limits(params.width, params.height, params.channels)) {
-        in_progress_.erase(name);
         return false;
     }
     // Exact, not a lower bound: chunk() spaces rows by
     // total_byte_size / height, so the payload must have a uniform row size.
     // Requiring the padded size also makes the total divisible by height, so
     // bytes-per-row is always meaningful.
-    if (const auto required =
-            padded_payload_size(params.width,
-                                params.height,
-                                params.channels,
-                                params.stride,
-                                static_cast<BufferType>(params.type));
-        !required.has_value() || *required != params.total_byte_size) {
+    const auto required =
+        padded_payload_size(params.width,
+                            params.height,
+                            params.channels,
+                            params.stride,
+                            static_cast<BufferType>(params.type));
+    return required.has_value() && *required == params.total_byte_size;
+}
+
+bool BufferAssembler::begin(BeginParams params) {
+    // A rejected begin must also drop any transfer already in flight under
+    // this name, or its chunks would keep landing in the previous
+    // allocation, under the previous geometry.
+    auto name = params.variable_name;
+    if (!acceptable(params)) {
+        const std::scoped_lock lock(mutex_);
         in_progress_.erase(name);
         return false;
     }
-    const auto height = static_cast<std::size_t>(params.height);
-    const auto total = params.total_byte_size;
+    const auto total = narrows(params) ? params.total_byte_size / 2
+                                       : params.total_byte_size;
 
-    InProgress entry{.params = std::move(params),
-                     .bytes = std::vector<std::byte>(total, std::byte{}),
-                     .rows_received = std::vector<bool>(height, false)};
+    // Not zero-filled: end() refuses the transfer unless chunks overwrote
+    // every row.
+    auto entry = std::make_shared<InProgress>(
+        InProgress{.params = std::move(params),
+                   .bytes = PayloadBytes::uninitialized(total)});
+    const std::scoped_lock lock(mutex_);
     in_progress_.insert_or_assign(std::move(name), std::move(entry));
     return true;
 }
 
+bool BufferAssembler::begin_patch(PatchParams params) {
+    auto name = params.variable_name;
+    // Display name, layout and transpose stay as they are on the copy held.
+    BeginParams geometry;
+    geometry.variable_name = std::move(params.variable_name);
+    geometry.width = params.width;
+    geometry.height = params.height;
+    geometry.channels = params.channels;
+    geometry.stride = params.stride;
+    geometry.type = params.type;
+    geometry.total_byte_size = params.total_byte_size;
+    const std::scoped_lock lock(mutex_);
+    if (!acceptable(geometry)) {
+        in_progress_.erase(name);
+        return false;
+    }
+    in_progress_.insert_or_assign(
+        std::move(name),
+        std::make_shared<InProgress>(
+            InProgress{.params = std::move(geometry), .patch = true}));
+    return true;
+}
+
 bool BufferAssembler::chunk(const std::string& name,
                             const std::size_t row_offset,
                             const std::size_t row_count,
                             const std::span<const std::byte> bytes) {
-    const auto it = in_progress_.find(name);
-    if (it == in_progress_.end()) {
+    auto pending = chunk_rows(name, row_offset, row_count);
+    if (!pending.has_value() || pending->rows().size() != bytes.size()) {
         return false;
     }
-    auto& [entryParams, entryBytes, rowsReceived] = it->second;
-    const auto height = static_cast<std::size_t>(entryParams.height);
+    std::ranges::copy(bytes, pending->rows().begin());
+    return commit_rows(std::move(*pending));
+}
+
+bool BufferAssembler::compressed_chunk(
+    const std::string& name,
+    const std::size_t row_offset,
+    const std::size_t row_count,
+    const std::span<const std::byte> block) {
+    auto pending = chunk_rows(name, row_offset, row_count);
+    return pending.has_value() && decompress_block(block, pending->rows()) &&
+           commit_rows(std::move(*pending));
+}
+
+bool BufferAssembler::narrows(const BeginParams& params) const {
+    return float64_rows_ == Float64Rows::NARROWED &&
+           static_cast<BufferType>(params.type) == BufferType::FLOAT64;
+}
+
+std::optional<BufferAssembler::PendingRows>
+BufferAssembler::chunk_rows(const std::string& name,
+                            const std::size_t row_offset,
+                            const std::size_t row_count) {
+    std::shared_ptr<InProgress> transfer;
+    {
+        const std::scoped_lock lock(mutex_);
+        const auto it = in_progress_.find(name);
+        if (it == in_progress_.end()) {
+            return std::nullopt;
+        }
+        transfer = it->second;
+    }
+    // The geometry never changes once begun, so it is read without the lock.
+    const auto& params = transfer->params;
+    const auto height = static_cast<std::size_t>(params.height);
 
     // Checked bound: row_offset > height rules out wraparound below.
     if (row_offset > height || row_count > height - row_offset) {
-        return false;
+        return std::nullopt;
     }
 
     // `stride` is row stride in elements, not bytes; derive real
-    // bytes-per-row from the allocation so multi-channel / multi-byte
-    // element buffers assemble correctly.
-    const auto bytes_per_row = entryBytes.size() / height;
+    // bytes-per-row from the declared (and validated) total so multi-channel
+    // / multi-byte element buffers assemble correctly.
+    const auto total = params.total_byte_size;
+    const auto bytes_per_row = total / height;
     const auto offset = row_offset * bytes_per_row;
-    if (const auto expected = row_count * bytes_per_row;
-        bytes.size() != expected || offset + bytes.size() > entryBytes.size()) {
+    const auto size = row_count * bytes_per_row;
+    if (offset + size > total) {
+        return std::nullopt;
+    }
+
+    // Rows narrowed on arrival are stored at half their wire size. They
+    // land in scratch first, and the pool hands that block straight to the
+    // next strip.
+    PendingRows pending;
+    pending.row_offset_ = row_offset;
+    pending.row_count_ = row_count;
+    if (narrows(params)) {
+        pending.wide_ = PayloadBytes::uninitialized(size);
+        pending.rows_ = pending.wide_;
+    } else if (transfer->patch) {
+        pending.strip_.resize(size);
+        pending.rows_ = pending.strip_;
+    } else {
+        pending.rows_ =
+            std::span<std::byte>{transfer->bytes}.subspan(offset, size);
+    }
+    pending.transfer_ = std::move(transfer);
+    return pending;
+}
+
+bool BufferAssembler::commit_rows(PendingRows pending) {
+    if (pending.transfer_ == nullptr) {
+        return false;
+    }
+    auto& entry = *pending.transfer_;
+
+    // Narrowed outside the lock: the rows are this caller's alone.
+    if (narrows(entry.params)) {
+        const auto height = static_cast<std::size_t>(entry.params.height);
+        const auto stored_row = entry.params.total_byte_size / height / 2;
+        auto stored = std::span<std::byte>{};
+        if (entry.patch) {
+            pending.strip_.resize(pending.wide_.size() / 2);
+            stored = pending.strip_;
+        } else {
+            stored = std::span<std::byte>{entry.bytes}.subspan(
+                pending.row_offset_ * stored_row, pending.wide_.size() / 2);
+        }
+        narrow_doubles_to_floats(pending.wide_, stored);
+    }
+
+    const std::scoped_lock lock(mutex_);
+    const auto it = in_progress_.find(entry.params.variable_name);
+    if (it == in_progress_.end() || it->second != pending.transfer_) {
         return false;
     }
-    std::memcpy(entryBytes.data() + offset, bytes.data(), bytes.size());
-    std::fill_n(rowsReceived.begin() + static_cast<std::ptrdiff_t>(row_offset),
-                row_count,
-                true);
+    if (entry.patch) {
+        if (pending.row_count_ != 0) {
+            entry.strips.push_back({.row_offset = pending.row_offset_,
+                                    .row_count = pending.row_count_,
+                                    .bytes = std::move(pending.strip_)});
+        }
+        return true;
+    }
+    entry.rows_received.insert(pending.row_offset_,
+                               pending.row_offset_ + pending.row_count_);
     return true;
 }
 
+std::optional<AssembledBuffer>
+BufferAssembler::preview(const std::string& name,
+                         const int factor,
+                         PayloadBytes bytes) {
+    std::shared_ptr<InProgress> transfer;
+    BeginParams params;
+    {
+        const std::scoped_lock lock(mutex_);
+        const auto it = in_progress_.find(name);
+        if (it == in_progress_.end() || it->second->patch || factor < 1) {
+            return std::nullopt;
+        }
+        transfer = it->second;
+        params = transfer->params;
+    }
+    const auto step = static_cast<std::size_t>(factor);
+    const auto width = static_cast<std::size_t>(params.width);
+    const auto height = static_cast<std::size_t>(params.height);
+    const auto pixel_bytes = static_cast<std::size_t>(params.channels) *
+                             type_size(static_cast<BufferType>(params.type));
+    const auto preview_width = (width + step - 1) / step;
+    const auto preview_height = (height + step - 1) / step;
+    if (bytes.size() != preview_height * preview_width * pixel_bytes) {
+        return std::nullopt;
+    }
+
+    // Shown as it came, decimated: blown up to the full geometry it would
+    // take a second buffer the size of the one being assembled.
+    {
+        const std::scoped_lock lock(mutex_);
+        transfer->previewed = true;
+        // The preview replaces whatever partial() showed before it.
+        transfer->partial_on_show = false;
+    }
+    return AssembledBuffer{.variable_name = std::move(params.variable_name),
+                           .display_name = std::move(params.display_name),
+                           .pixel_layout = std::move(params.pixel_layout),
+                           .transpose = params.transpose,
+                           .width = static_cast<int>(preview_width),
+                           .height = static_cast<int>(preview_height),
+                           .channels = params.channels,
+                           .stride = static_cast<int>(preview_width),
+                           .type = params.type,
+                           .bytes = std::move(bytes),
+                           .decimation = factor,
+                           .source_width = params.width,
+                           .source_height = params.height};
+}
+
+std::optional<AssembledBuffer>
+BufferAssembler::partial(const std::string& name) {
+    std::shared_ptr<InProgress> transfer;
+    std::vector<std::pair<std::size_t, std::size_t>> runs;
+    {
+        const std::scoped_lock lock(mutex_);
+        const auto it = in_progress_.find(name);
+        if (it == in_progress_.end() || it->second->patch ||
+            it->second->rows_received.runs() == 0) {
+            return std::nullopt;
+        }
+        transfer = it->second;
+        runs = transfer->rows_received.without(RowIntervals{});
+        transfer->rows_handed_out = transfer->rows_received;
+        transfer->previewed = true;
+        transfer->partial_on_show = true;
+    }
+    // Committed rows are never written again, so they are copied without
+    // the lock, as strips on other threads keep landing.
+    const auto& params = transfer->params;
+    const auto source = std::span<const std::byte>{transfer->bytes};
+    const auto bytes_per_row =
+        source.size() / static_cast<std::size_t>(params.height);
+    auto out = PayloadBytes::uninitialized(source.size());
+    auto missing = std::span<std::byte>{out};
+    std::size_t copied_to = 0;
+    for (const auto& [begin, end] : runs) {
+        std::ranges::fill(
+            missing.subspan(copied_to * bytes_per_row,
+                            (begin - copied_to) * bytes_per_row),
+            std::byte{});
+        std::ranges::copy(source.subspan(begin * bytes_per_row,
+                                         (end - begin) * bytes_per_row),
+                          missing.subspan(begin * bytes_per_row).begin());
+        copied_to = end;
+    }
+    std::ranges::fill(missing.subspan(copied_to * bytes_per_row),
+                      std::byte{});
+    return AssembledBuffer{.variable_name = params.variable_name,
+                           .display_name = params.display_name,
+                           .pixel_layout = params.pixel_layout,
+                           .transpose = params.transpose,
+                           .width = params.width,
+                           .height = params.height,
+                           .channels = params.channels,
+                           .stride = params.stride,
+                           .type = params.type,
+                           .bytes = std::move(out),
+                           .narrowed = narrows(params)};
+}
+
+std::optional<AssembledPatch>
+BufferAssembler::arrived_rows(const std::string& name) {
+    std::shared_ptr<InProgress> transfer;
+    std::vector<std::pair<std::size_t, std::size_t>> runs;
+    {
+        const std::scoped_lock lock(mutex_);
+        const auto it = in_progress_.find(name);
+        if (it == in_progress_.end() || it->second->patch ||
+            !it->second->partial_on_show) {
+            return std::nullopt;
+        }
+        transfer = it->second;
+        runs = transfer->rows_received.without(transfer->rows_handed_out);
+        for (const auto& [begin, end] : runs) {
+            transfer->rows_handed_out.insert(begin, end);
+        }
+    }
+    const auto& params = transfer->params;
+    const auto source = std::span<const std::byte>{transfer->bytes};
+    const auto bytes_per_row =
+        source.size() / static_cast<std::size_t>(params.height);
+    AssembledPatch out{.variable_name = params.variable_name,
+                       .width = params.width,
+                       .height = params.height,
+                       .channels = params.channels,
+                       .stride = params.stride,
+                       .type = params.type,
+                       .strips = {}};
+    out.strips.reserve(runs.size());
+    for (const auto& [begin, end] : runs) {
+        const auto rows = source.subspan(begin * bytes_per_row,
+                                         (end - begin) * bytes_per_row);
+        out.strips.push_back({.row_offset = begin,
+                              .row_count = end - begin,
+                              .bytes = {rows.begin(), rows.end()}});
+    }
+    return out;
+}
+
 std::optional<AssembledBuffer> BufferAssembler::end(const std::string& name) {
+    const std::scoped_lock lock(mutex_);
     const auto it = in_progress_.find(name);
     if (it == in_progress_.end()) {
         return std::nullopt;
     }
-    auto& [params, bytes, rowsReceived] = it->second;
+    auto& entry = *it->second;
+    auto& params = entry.params;
     // Refuse a partial transfer rather than hand back a zero-filled buffer.
-    if (!std::ranges::all_of(rowsReceived, [](const bool r) { return r; })) {
+    // A patch never fills its rows, so end() never completes one either;
+    // nor is one complete while a PendingRows still holds on to it.
+    if (entry.patch || it->second.use_count() > 1 ||
+        !entry.rows_received.covers(0,
+                                    static_cast<std::size_t>(params.height))) {
         in_progress_.erase(it);
         return std::nullopt;
     }
@@ -133,17 +393,51 @@ std::optional<AssembledBuffer> BufferAssembler::end(const std::string& name) {
                         .channels = params.channels,
                         .stride = params.stride,
                         .type = params.type,
-                        .bytes = std::move(bytes)};
+                        .bytes = std::move(entry.bytes),
+                        .narrowed = narrows(params)};
+    in_progress_.erase(it);
+    return out;
+}
+
+std::optional<AssembledPatch>
+BufferAssembler::end_patch(const std::string& name) {
+    const std::scoped_lock lock(mutex_);
+    const auto it = in_progress_.find(name);
+    if (it == in_progress_.end() || !it->second->patch) {
+        return std::nullopt;
+    }
+    auto& entry = *it->second;
+    AssembledPatch out{.variable_name = std::move(entry.params.variable_name),
+                       .width = entry.params.width,
+                       .height = entry.params.height,
+                       .channels = entry.params.channels,
+                       .stride = entry.params.stride,
+                       .type = entry.params.type,
+                       .strips = std::move(entry.strips)};
     in_progress_.erase(it);
     return out;
 }
 
 bool BufferAssembler::abort(const std::string& name) {
+    const std::scoped_lock lock(mutex_);
     return in_progress_.erase(name) != 0;
 }
 
 bool BufferAssembler::has_in_progress(const std::string& name) const {
+    const std::scoped_lock lock(mutex_);
     return in_progress_.contains(name);
 }
 
+bool BufferAssembler::has_patch_in_progress(const std::string& name) const {
+    const std::scoped_lock lock(mutex_);
+    const auto it = in_progress_.find(name);
+    return it != in_progress_.end() && it->second->patch;
+}
+
+bool BufferAssembler::has_preview(const std::string& name) const {
+    const std::scoped_lock lock(mutex_);
+    const auto it = in_progress_.find(name);
+    return it != in_progress_.end() && it->second->previewed;
+}
+
 } // namespace oid
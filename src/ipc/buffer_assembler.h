@@ -27,12 +27,18 @@
 #define IPC_BUFFER_ASSEMBLER_H_
 
 #include <cstddef>
+#include <cstdint>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <span>
 #include <string>
 #include <vector>
 
+#include "payload_bytes.h"
+#include "row_intervals.h"
+
 namespace oid {
 
 // Geometry + completed bytes for a buffer reassembled from row-strip chunks.
@@ -46,11 +52,57 @@ struct AssembledBuffer {
     int channels{};
     int stride{};
     int type{};
-    std::vector<std::byte> bytes;
+    PayloadBytes bytes;
+    // FLOAT64 rows narrowed to float32 as they arrived (see
+    // BufferAssembler::Float64Rows::NARROWED); `type` still says FLOAT64.
+    bool narrowed{};
+    // Above 1 for a preview (see BufferAssembler::preview()): every
+    // `decimation`-th pixel of a source_width x source_height buffer, which
+    // the geometry above describes.
+    int decimation{1};
+    int source_width{};
+    int source_height{};
 };
 
+// New contents for some rows of a buffer the viewer already holds, as
+// received from a patch transfer (see BufferAssembler::begin_patch()).
+struct AssembledPatch {
+    // Whole rows [row_offset, row_offset + row_count), in the geometry's
+    // padded row size.
+    struct Strip {
+        std::size_t row_offset{};
+        std::size_t row_count{};
+        std::vector<std::byte> bytes;
+    };
+
+    std::string variable_name;
+    int width{};
+    int height{};
+    int channels{};
+    int stride{};
+    int type{};
+    // In arrival order; a row sent twice takes its later contents.
+    std::vector<Strip> strips;
+};
+
+// Every call may come from any thread: the viewer fills the strips of one
+// transfer from several data lanes at once (see ipc/plot_buffer_sender.h).
 class BufferAssembler {
+    struct InProgress;
+
   public:
+    // What FLOAT64 rows are assembled into.
+    enum class Float64Rows : std::uint8_t {
+        AS_RECEIVED,
+        // Narrowed to float32 strip by strip as they arrive, into a buffer
+        // (or patch strips) half the size of the transfer.
+        NARROWED,
+    };
+
+    explicit BufferAssembler(
+        const Float64Rows float64_rows = Float64Rows::AS_RECEIVED)
+        : float64_rows_{float64_rows} {}
+
     struct BeginParams {
         std::string variable_name;
         std::string display_name;
@@ -73,6 +125,26 @@ class BufferAssembler {
     // true once the transfer has started.
     [[nodiscard]] bool begin(BeginParams params);
 
+    // Geometry of a patch transfer: the buffer it applies to must still have
+    // exactly this shape, which the receiver checks before applying it.
+    struct PatchParams {
+        std::string variable_name;
+        int width{};
+        int height{};
+        int channels{};
+        int stride{};
+        int type{};
+        std::size_t total_byte_size;
+    };
+
+    // Start a patch transfer for buffer `name`: only the rows that changed
+    // follow, as ordinary chunk()s, and end_patch() hands them back as
+    // strips to apply to the copy already held. Nothing of full-buffer size
+    // is allocated. Accepts and refuses exactly what begin() would for the
+    // same geometry and total_byte_size, and likewise replaces (or, when
+    // refused, drops) any transfer already in flight under the name.
+    [[nodiscard]] bool begin_patch(PatchParams params);
+
     // Append row-strip chunk. Returns false if name unknown, rows out of
     // bounds, or size mismatch.
     [[nodiscard]] bool chunk(const std::string& name,
@@ -80,24 +152,136 @@ class BufferAssembler {
                              std::size_t row_count,
                              std::span<const std::byte> bytes);
 
+    // Rows handed out by chunk_rows(), to be filled through rows() and
+    // handed back to commit_rows(). Keeps its transfer alive, so rows()
+    // stays valid even if the transfer is replaced or dropped meanwhile.
+    class PendingRows {
+      public:
+        [[nodiscard]] std::span<std::byte> rows() const {
+            return rows_;
+        }
+
+      private:
+        friend class BufferAssembler;
+
+        std::shared_ptr<InProgress> transfer_{};
+        std::size_t row_offset_{};
+        std::size_t row_count_{};
+        // Where the rows are handed out when that is not their final place:
+        // at wire size for rows narrowed on arrival, else a patch's strip.
+        PayloadBytes wide_{};
+        std::vector<std::byte> strip_{};
+        std::span<std::byte> rows_{};
+    };
+
+    // chunk() in two steps, so an uncompressed chunk's rows can be read off
+    // the transport straight into place, and strips of one transfer can be
+    // filled at once on different threads: chunk_rows() hands out exactly
+    // the rows' wire size to fill, and commit_rows() then marks them
+    // received. Rows narrowed on arrival are handed out as scratch, and
+    // narrowed into place by commit_rows(). chunk_rows() returns nullopt for
+    // rows chunk() would refuse; until they are committed they count as
+    // missing. commit_rows() returns false if their transfer is no longer
+    // the one in flight under its name.
+    [[nodiscard]] std::optional<PendingRows>
+    chunk_rows(const std::string& name,
+               std::size_t row_offset,
+               std::size_t row_count);
+    [[nodiscard]] bool commit_rows(PendingRows pending);
+
+    // chunk() for rows sent compressed (PLOT_BUFFER_CHUNK_COMPRESSED): the
+    // block is decompressed straight into place, and must decode to exactly
+    // the rows' size. Returns false if it does not, as well as for anything
+    // chunk() refuses.
+    [[nodiscard]] bool compressed_chunk(const std::string& name,
+                                        std::size_t row_offset,
+                                        std::size_t row_count,
+                                        std::span<const std::byte> block);
+
+    // A stand-in for the full buffer `name` is still assembling, from a
+    // PLOT_BUFFER_PREVIEW: `bytes` holds the pixel at every `factor`-th
+    // column of every `factor`-th row, unpadded, and becomes the stand-in's
+    // as it is, decimated by `factor` like an overview. Returns nullopt if
+    // no full transfer is in flight under `name`, if `factor` is not
+    // positive or if `bytes` is not the size that implies. The transfer
+    // itself is left as it was.
+    [[nodiscard]] std::optional<AssembledBuffer>
+    preview(const std::string& name, int factor, PayloadBytes bytes);
+
+    // The full transfer in flight under `name` as far as it has arrived: a
+    // copy of every row received so far, with the rows still missing
+    // zeroed, to show while the rest streams in. Returns nullopt if no full
+    // transfer is in flight under `name` or none of its rows has arrived.
+    // Counts as a preview() for has_preview(), and the rows copied as
+    // handed out for arrived_rows(). While either copies, end() refuses the
+    // transfer as it would one with rows still being filled.
+    [[nodiscard]] std::optional<AssembledBuffer>
+    partial(const std::string& name);
+
+    // The rows of the full transfer in flight under `name` received since
+    // any were last handed out -- by partial() or an earlier arrived_rows()
+    // -- as strips to patch into the copy on show. Returns nullopt if no
+    // full transfer is in flight under `name` or no partial() of it is on
+    // show: a preview() on show already has every pixel it samples, and no
+    // room for the others. No strips means no rows arrived since.
+    [[nodiscard]] std::optional<AssembledPatch>
+    arrived_rows(const std::string& name);
+
     // Finish transfer, moving bytes out and dropping entry. Returns nullopt
-    // if name unknown or if any row was never received.
+    // if name unknown or if any row was never received (rows handed out by
+    // chunk_rows() and still being filled count as never received), or if
+    // the transfer in flight is a patch (see end_patch()).
     [[nodiscard]] std::optional<AssembledBuffer> end(const std::string& name);
 
+    // Finish a patch transfer, moving its strips out and dropping the entry.
+    // Returns nullopt if name unknown or the transfer in flight is not a
+    // patch. A patch with no strips is valid (and changes nothing).
+    [[nodiscard]] std::optional<AssembledPatch>
+    end_patch(const std::string& name);
+
     // Drop any in-progress transfer for `name`. Returns true if one existed.
     bool abort(const std::string& name);
 
     // True while a transfer for `name` is in flight (begun, not yet ended).
     [[nodiscard]] bool has_in_progress(const std::string& name) const;
 
+    // True while the transfer in flight for `name` is a patch.
+    [[nodiscard]] bool has_patch_in_progress(const std::string& name) const;
+
+    // True while the transfer in flight for `name` has handed out a
+    // preview() or a partial().
+    [[nodiscard]] bool has_preview(const std::string& name) const;
+
   private:
     struct InProgress {
         BeginParams params;
-        std::vector<std::byte> bytes;
-        // Per-row arrival tracking so end() can refuse a partial transfer.
-        std::vector<bool> rows_received;
+        PayloadBytes bytes{};
+        // Rows arrived so far, so end() can refuse a partial transfer.
+        RowIntervals rows_received{};
+        // Patch transfers keep what arrives here instead of in `bytes`.
+        bool patch{};
+        std::vector<AssembledPatch::Strip> strips{};
+        bool previewed{};
+        // What is on show is a partial(), at full size, rather than a
+        // preview(): arrived_rows() has something to patch.
+        bool partial_on_show{};
+        // Rows copied out by partial() or arrived_rows() since the copy on
+        // show was made.
+        RowIntervals rows_handed_out{};
     };
-    std::map<std::string, InProgress, std::less<>> in_progress_{};
+
+    // begin()'s acceptance rule, shared with begin_patch().
+    [[nodiscard]] static bool acceptable(const BeginParams& params);
+
+    // True if `params`' rows are narrowed as they arrive.
+    [[nodiscard]] bool narrows(const BeginParams& params) const;
+
+    Float64Rows float64_rows_{Float64Rows::AS_RECEIVED};
+    // Guards `in_progress_` and the bookkeeping of its entries, not the
+    // pixels: those are written by whoever holds their PendingRows.
+    mutable std::mutex mutex_{};
+    std::map<std::string, std::shared_ptr<InProgress>, std::less<>>
+        in_progress_{};
 };
 
 } // namespace oid
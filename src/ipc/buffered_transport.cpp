@@ -0,0 +1,73 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "buffered_transport.h"
+
+#include <algorithm>
+
+namespace oid {
+
+BufferedTransport::BufferedTransport(ITransport& inner,
+                                     const std::size_t read_ahead_bytes)
+    : inner_{inner}, buffer_(read_ahead_bytes) {}
+
+void BufferedTransport::send(const std::span<const std::byte> data) {
+    inner_.send(data);
+}
+
+void BufferedTransport::send_gather(
+    const std::span<const std::span<const std::byte>> parts) {
+    inner_.send_gather(parts);
+}
+
+std::size_t BufferedTransport::receive(const std::span<std::byte> dst) {
+    if (dst.empty()) {
+        return 0;
+    }
+    if (begin_ == end_) {
+        if (dst.size() >= buffer_.size()) {
+            return inner_.receive(dst);
+        }
+        const auto received = inner_.receive(buffer_);
+        begin_ = 0;
+        end_ = received;
+    }
+    const auto n = std::min(dst.size(), end_ - begin_);
+    std::copy_n(buffer_.begin() + static_cast<std::ptrdiff_t>(begin_),
+                n,
+                dst.begin());
+    begin_ += n;
+    return n;
+}
+
+bool BufferedTransport::has_data() const {
+    return begin_ != end_ || inner_.has_data();
+}
+
+std::size_t BufferedTransport::buffered_bytes() const {
+    return end_ - begin_;
+}
+
+} // namespace oid
@@ -0,0 +1,77 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef IPC_BUFFERED_TRANSPORT_H_
+#define IPC_BUFFERED_TRANSPORT_H_
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "transport.h"
+
+namespace oid {
+
+// Read-ahead of a BufferedTransport; also the size from which a read skips
+// it.
+constexpr std::size_t DEFAULT_READ_AHEAD_BYTES = 64ULL * 1024ULL;
+
+// Reads `inner` ahead for a MessageDecoder, which reads every field of a
+// message separately: a length, then a name, then the next length... Each
+// receive() from `inner` asks for a whole buffer, so a message of many small
+// fields (a SET_AVAILABLE_SYMBOLS with thousands of names) costs a handful of
+// receives instead of two per field. A read of at least a buffer, with
+// nothing buffered, goes straight from `inner` into the destination, so
+// pixel payloads are not copied twice. Sends pass straight through.
+//
+// Bytes read ahead are only in the buffer: once reading through it, every
+// read of `inner` must. LIFETIME: `inner` is not owned and must outlive this
+// transport.
+class BufferedTransport final : public ITransport {
+  public:
+    explicit BufferedTransport(
+        ITransport& inner,
+        std::size_t read_ahead_bytes = DEFAULT_READ_AHEAD_BYTES);
+
+    void send(std::span<const std::byte> data) override;
+    void
+    send_gather(std::span<const std::span<const std::byte>> parts) override;
+    // Like `inner`'s, a 0 means it returned 0.
+    std::size_t receive(std::span<std::byte> dst) override;
+    [[nodiscard]] bool has_data() const override;
+
+    // Bytes read from `inner` and not yet received.
+    [[nodiscard]] std::size_t buffered_bytes() const;
+
+  private:
+    ITransport& inner_;
+    std::vector<std::byte> buffer_;
+    std::size_t begin_{0};
+    std::size_t end_{0};
+};
+
+} // namespace oid
+
+#endif // IPC_BUFFERED_TRANSPORT_H_
@@ -0,0 +1,134 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "content_hash.h"
+
+#include <bit>
+#include <cstring>
+
+namespace oid {
+
+namespace {
+
+constexpr std::uint64_t PRIME_1 = 0x9E3779B185EBCA87ULL;
+constexpr std::uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr std::uint64_t PRIME_3 = 0x165667B19E3779F9ULL;
+constexpr std::uint64_t PRIME_4 = 0x85EBCA77C2B2AE63ULL;
+constexpr std::uint64_t PRIME_5 = 0x27D4EB2F165667C5ULL;
+
+// The reference implementation reads little-endian words. On little-endian
+// targets memcpy keeps the load alignment-agnostic and compiles to a plain
+// load; elsewhere the word is assembled byte by byte.
+template <typename Word> Word read_le(const std::byte* p) {
+    Word value{};
+    if constexpr (std::endian::native == std::endian::little) {
+        std::memcpy(&value, p, sizeof(value));
+    } else {
+        for (std::size_t i = 0; i < sizeof(value); ++i) {
+            value |= static_cast<Word>(static_cast<Word>(p[i]) << (8 * i));
+        }
+    }
+    return value;
+}
+
+std::uint64_t read_u64(const std::byte* p) {
+    return read_le<std::uint64_t>(p);
+}
+
+std::uint32_t read_u32(const std::byte* p) {
+    return read_le<std::uint32_t>(p);
+}
+
+std::uint64_t round(std::uint64_t acc, const std::uint64_t input) {
+    acc += input * PRIME_2;
+    acc = std::rotl(acc, 31);
+    return acc * PRIME_1;
+}
+
+std::uint64_t merge_round(std::uint64_t acc, const std::uint64_t lane) {
+    acc ^= round(0, lane);
+    return acc * PRIME_1 + PRIME_4;
+}
+
+} // namespace
+
+std::uint64_t content_hash(const std::span<const std::byte> bytes,
+                           const std::uint64_t seed) {
+    const std::byte* p = bytes.data();
+    const std::byte* const end = p + bytes.size();
+    std::uint64_t hash{};
+
+    if (bytes.size() >= 32) {
+        // Four independent lanes over 32-byte stripes: the bulk of any
+        // payload goes through here, and the lanes keep the multiplier
+        // pipelines busy rather than waiting on one dependency chain.
+        std::uint64_t v1 = seed + PRIME_1 + PRIME_2;
+        std::uint64_t v2 = seed + PRIME_2;
+        std::uint64_t v3 = seed;
+        std::uint64_t v4 = seed - PRIME_1;
+        const std::byte* const limit = end - 32;
+        do {
+            v1 = round(v1, read_u64(p));
+            v2 = round(v2, read_u64(p + 8));
+            v3 = round(v3, read_u64(p + 16));
+            v4 = round(v4, read_u64(p + 24));
+            p += 32;
+        } while (p <= limit);
+
+        hash = std::rotl(v1, 1) + std::rotl(v2, 7) + std::rotl(v3, 12) +
+               std::rotl(v4, 18);
+        hash = merge_round(hash, v1);
+        hash = merge_round(hash, v2);
+        hash = merge_round(hash, v3);
+        hash = merge_round(hash, v4);
+    } else {
+        hash = seed + PRIME_5;
+    }
+
+    hash += static_cast<std::uint64_t>(bytes.size());
+
+    for (; end - p >= 8; p += 8) {
+        hash ^= round(0, read_u64(p));
+        hash = std::rotl(hash, 27) * PRIME_1 + PRIME_4;
+    }
+    if (end - p >= 4) {
+        hash ^= static_cast<std::uint64_t>(read_u32(p)) * PRIME_1;
+        hash = std::rotl(hash, 23) * PRIME_2 + PRIME_3;
+        p += 4;
+    }
+    for (; p < end; ++p) {
+        hash ^= static_cast<std::uint64_t>(*p) * PRIME_5;
+        hash = std::rotl(hash, 11) * PRIME_1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= PRIME_2;
+    hash ^= hash >> 29;
+    hash *= PRIME_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+} // namespace oid
@@ -0,0 +1,45 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef IPC_CONTENT_HASH_H_
+#define IPC_CONTENT_HASH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace oid {
+
+// 64-bit non-cryptographic hash of `bytes` (the XXH64 algorithm, bit-exact
+// with the reference implementation). Fast enough to run over a whole plot
+// payload on every debugger stop -- several GB/s, memory-bound on anything
+// large -- and used only to notice that a buffer has not changed since it
+// was last sent, never for anything an adversary could exploit.
+[[nodiscard]] std::uint64_t content_hash(std::span<const std::byte> bytes,
+                                         std::uint64_t seed = 0);
+
+} // namespace oid
+
+#endif // IPC_CONTENT_HASH_H_
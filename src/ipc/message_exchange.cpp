@@ -26,6 +26,7 @@
 #include "message_exchange.h"
 
 #include <utility>
+#include <vector>
 
 namespace oid {
 
@@ -46,6 +47,43 @@ size_t StringBlock::size() const noexcept {
     return reinterpret_cast<const std::byte*>(data_.data());
 }
 
+void MessageComposer::send(ITransport& transport) const {
+    std::size_t staged_total = 0;
+    for (const auto& block : message_blocks_) {
+        if (block->size() < GATHER_MIN_BYTES) {
+            staged_total += block->size();
+        }
+    }
+    // Reserved up front so the spans taken into `staging` below stay valid:
+    // it is never filled past this capacity, so it never reallocates.
+    std::vector<std::byte> staging;
+    staging.reserve(staged_total);
+
+    std::vector<std::span<const std::byte>> parts;
+    std::size_t run_begin = 0;
+    const auto flush_staged_run = [&staging, &parts, &run_begin] {
+        if (staging.size() > run_begin) {
+            parts.emplace_back(staging.data() + run_begin,
+                               staging.size() - run_begin);
+            run_begin = staging.size();
+        }
+    };
+    for (const auto& block : message_blocks_) {
+        const auto bytes = std::span{block->data(), block->size()};
+        if (bytes.size() < GATHER_MIN_BYTES) {
+            staging.insert(staging.end(), bytes.begin(), bytes.end());
+            continue;
+        }
+        flush_staged_run();
+        parts.push_back(bytes);
+    }
+    flush_staged_run();
+
+    if (!parts.empty()) {
+        transport.send_gather(parts);
+    }
+}
+
 MessageDecoder::MessageDecoder(ITransport& transport) : transport_{transport} {}
 
 } // namespace oid
@@ -38,6 +38,7 @@
 #include <type_traits>
 #include <vector>
 
+#include "payload_bytes.h"
 #include "raw_data_decode.h"
 #include "transport.h"
 
@@ -56,14 +57,70 @@ enum class MessageType {
     BUFFER_REMOVED = 9,
     PLOT_BUFFER_BEGIN = 10,
     PLOT_BUFFER_CHUNK = 11,
-    PLOT_BUFFER_END = 12
+    PLOT_BUFFER_END = 12,
+    PLOT_BUFFER_UNCHANGED = 13,
+    PLOT_BUFFER_PATCH_BEGIN = 14,
+    VIEWER_CAPABILITIES = 15,
+    PLOT_BUFFER_CHUNK_COMPRESSED = 16,
+    PLOT_BUFFER_PREVIEW = 17,
+    PLOT_BUFFER_OVERVIEW = 18,
+    PLOT_BUFFER_REGION_REQUEST = 19,
+    PLOT_BUFFER_REGION = 20,
+    PLOT_BUFFER_BATCH_BEGIN = 21,
+    PLOT_BUFFER_BATCH_END = 22,
+    PLOT_BUFFER_LANES = 23,
+    PLOT_BUFFER_LANE_FENCE = 24,
+    PLOT_BUFFER_FULL_REQUEST = 25,
+    SET_AVAILABLE_SYMBOLS_DELTA = 26
 };
 
+// Bits of the mask a viewer sends in VIEWER_CAPABILITIES, right after it
+// connects, naming the optional parts of the protocol it understands. The
+// bridge uses none of them before that message arrives.
+
+// The viewer accepts PLOT_BUFFER_CHUNK_COMPRESSED in place of
+// PLOT_BUFFER_CHUNK: the same message, its row bytes a compress_block()
+// block (ipc/block_codec.h).
+constexpr int CAPABILITY_COMPRESSED_CHUNKS = 1 << 0;
+
+// The viewer accepts a PLOT_BUFFER_PREVIEW between a PLOT_BUFFER_BEGIN and
+// its first strip (see send_plot_buffer()).
+constexpr int CAPABILITY_PROGRESSIVE_PREVIEW = 1 << 1;
+
+// The viewer accepts a PLOT_BUFFER_OVERVIEW in place of a buffer too large
+// to ship, and asks for what it shows of it with PLOT_BUFFER_REGION_REQUEST
+// (see ipc/pixel_region.h).
+constexpr int CAPABILITY_REGION_FETCH = 1 << 2;
+
+// The viewer accepts plots framed by PLOT_BUFFER_BATCH_BEGIN and
+// PLOT_BUFFER_BATCH_END (see send_plot_batch_begin()).
+constexpr int CAPABILITY_PLOT_BATCHES = 1 << 3;
+
+// The viewer reads row strips off the data lanes it connected besides the
+// control socket: after a PLOT_BUFFER_LANES on the control socket, a
+// transfer's strips arrive spread over the lanes, each closing its share
+// with a PLOT_BUFFER_LANE_FENCE (see send_plot_buffer()).
+constexpr int CAPABILITY_DATA_LANES = 1 << 4;
+
+// The viewer accepts a PLOT_BUFFER_OVERVIEW of a buffer small enough to
+// ship (a quick look, see ipc/pixel_region.h), and asks for it in full with
+// PLOT_BUFFER_FULL_REQUEST when the user wants more than the overview.
+constexpr int CAPABILITY_QUICK_LOOK = 1 << 5;
+
+// The viewer accepts SET_AVAILABLE_SYMBOLS_DELTA, which edits the last
+// symbol list it got instead of replacing it (see ipc/symbol_list_delta.h).
+constexpr int CAPABILITY_SYMBOL_DELTAS = 1 << 6;
+
 // Ceiling on a decoded string length. Names, pixel layouts and session JSON
 // are the only strings on this wire; the bound exists so a peer-supplied
 // length cannot drive an unbounded allocation, not to constrain real data.
 constexpr std::size_t MAX_STRING_BYTES = 16ULL * 1024ULL * 1024ULL;
 
+// Blocks at least this large are sent from their own storage rather than
+// packed into MessageComposer's staging buffer. Below it the per-part cost of
+// a gathered write outweighs the copy it saves.
+constexpr std::size_t GATHER_MIN_BYTES = 64ULL * 1024ULL;
+
 // C++20 concept to replace SFINAE for primitive type checking
 template <typename T>
 concept PrimitiveType =
@@ -195,21 +252,12 @@ class MessageComposer {
         return *this;
     }
 
-    void send(ITransport& transport) const {
-        std::size_t total = 0;
-        for (const auto& block : message_blocks_) {
-            total += block->size();
-        }
-        std::vector<std::byte> frame;
-        frame.reserve(total);
-        for (const auto& block : message_blocks_) {
-            const auto* data = block->data();
-            frame.insert(frame.end(), data, data + block->size());
-        }
-        if (!frame.empty()) {
-            transport.send(frame);
-        }
-    }
+    // Hands the message to `transport` as one gather list. Blocks smaller
+    // than GATHER_MIN_BYTES (headers, geometry, names) are packed into a
+    // single staging buffer; larger ones -- in practice a BufferBlock's pixel
+    // payload -- are referenced in place, so they reach the socket without
+    // an intermediate copy of the whole message.
+    void send(ITransport& transport) const;
 
     void clear() {
         message_blocks_.clear();
@@ -279,6 +327,35 @@ class MessageDecoder {
         return *this;
     }
 
+    // As above, into a block that is not zero-filled first: the payload
+    // overwrites all of it.
+    MessageDecoder& read(PayloadBytes& value) {
+        value = PayloadBytes::uninitialized(read_length());
+        return read_payload(value);
+    }
+
+    // read(PayloadBytes&) in two steps, for a caller that decides from the
+    // declared length where the payload goes -- e.g. straight into the
+    // buffer it belongs to: read_length() reads the length prefix, refusing
+    // an impossible one as above, and read_payload() then reads exactly
+    // dst.size() bytes of payload into `dst`.
+    [[nodiscard]] std::size_t read_length() {
+        auto container_size = std::size_t{};
+        read(container_size);
+
+        // As above.
+        if (exceeds_max_buffer_bytes(container_size)) {
+            throw MessageDecodeError{"declared payload exceeds the maximum "
+                                     "buffer size"};
+        }
+        return container_size;
+    }
+
+    MessageDecoder& read_payload(const std::span<std::byte> dst) {
+        read_impl(dst);
+        return *this;
+    }
+
     MessageDecoder& read(std::string& value) {
         const auto symbol_length = [&] {
             auto length = std::size_t{};
@@ -0,0 +1,136 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "outbound_queue.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace oid {
+
+OutboundQueue::OutboundQueue(const std::size_t byte_budget,
+                             std::function<void()> on_work)
+    : byte_budget_{byte_budget}, on_work_{std::move(on_work)} {}
+
+bool OutboundQueue::push(Send send,
+                         const std::size_t bytes,
+                         const std::string& key) {
+    std::unique_lock lock(mutex_);
+    return push_locked(lock, send, bytes, key, true);
+}
+
+bool OutboundQueue::try_push(Send send,
+                             const std::size_t bytes,
+                             const std::string& key) {
+    std::unique_lock lock(mutex_);
+    return push_locked(lock, send, bytes, key, false);
+}
+
+bool OutboundQueue::push_locked(std::unique_lock<std::mutex>& lock,
+                                Send& send,
+                                const std::size_t bytes,
+                                const std::string& key,
+                                const bool wait) {
+    const auto waiting = [this, &key] {
+        return key.empty() ? entries_.end()
+                           : std::ranges::find(entries_, key, &Entry::key);
+    };
+    const auto fits = [this, &waiting, bytes] {
+        const auto entry = waiting();
+        const auto replaced = entry == entries_.end() ? 0 : entry->bytes;
+        const auto others = queued_bytes_ - replaced + in_flight_bytes_;
+        return others == 0 || others + bytes <= byte_budget_;
+    };
+    if (wait) {
+        drained_.wait(lock, [this, &fits] { return closed_ || fits(); });
+    }
+    if (closed_ || !fits()) {
+        return false;
+    }
+
+    // Looked up again: the wait may have let the writer take the old one.
+    if (const auto entry = waiting(); entry != entries_.end()) {
+        queued_bytes_ -= entry->bytes;
+        entry->send = std::move(send);
+        entry->bytes = bytes;
+    } else {
+        entries_.push_back(
+            Entry{.send = std::move(send), .bytes = bytes, .key = key});
+    }
+    queued_bytes_ += bytes;
+    queued_.notify_one();
+    lock.unlock();
+    if (on_work_) {
+        on_work_();
+    }
+    return true;
+}
+
+bool OutboundQueue::run_next(const std::chrono::milliseconds timeout) {
+    std::unique_lock lock(mutex_);
+    queued_.wait_for(lock, timeout, [this] {
+        return closed_ || !entries_.empty();
+    });
+    if (entries_.empty()) {
+        return false;
+    }
+    auto entry = std::move(entries_.front());
+    entries_.pop_front();
+    queued_bytes_ -= entry.bytes;
+    in_flight_bytes_ = entry.bytes;
+    lock.unlock();
+
+    entry.send();
+    // The callable may hold the message's bytes: release them before the
+    // budget does.
+    entry.send = nullptr;
+
+    lock.lock();
+    in_flight_bytes_ = 0;
+    drained_.notify_all();
+    return true;
+}
+
+void OutboundQueue::close() {
+    auto dropped = std::deque<Entry>{};
+    {
+        const std::scoped_lock lock(mutex_);
+        closed_ = true;
+        dropped.swap(entries_);
+        queued_bytes_ = 0;
+    }
+    drained_.notify_all();
+    queued_.notify_all();
+    if (on_work_) {
+        on_work_();
+    }
+}
+
+std::size_t OutboundQueue::byte_size() const {
+    const std::scoped_lock lock(mutex_);
+    return queued_bytes_ + in_flight_bytes_;
+}
+
+} // namespace oid
@@ -0,0 +1,117 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef IPC_OUTBOUND_QUEUE_H_
+#define IPC_OUTBOUND_QUEUE_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <string>
+
+#include "transport.h"
+
+namespace oid {
+
+// Bytes an OutboundQueue holds, queued and in flight, before push() makes
+// the caller wait for the writer to catch up.
+constexpr std::size_t DEFAULT_OUTBOUND_BYTE_BUDGET = 512ULL * 1024ULL * 1024ULL;
+
+// Messages waiting for a writer thread, so that whoever produces them never
+// waits on the peer reading them. Each is a callable that does the actual
+// send, weighed by the bytes it holds. A message pushed under a key replaces
+// the one still waiting under the same key, in its place: a peer that reads
+// slowly gets the latest version of each plot instead of every version in
+// turn. Any number of producers; one writer calling run_next(). The
+// callables must not throw.
+class OutboundQueue {
+  public:
+    using Send = std::function<void()>;
+
+    // `on_work`, if set, is called outside the queue's lock each time a
+    // message is queued and on close(), for a writer that sleeps on more
+    // than run_next() (a socket too) to be woken by.
+    explicit OutboundQueue(
+        std::size_t byte_budget = DEFAULT_OUTBOUND_BYTE_BUDGET,
+        std::function<void()> on_work = {});
+
+    OutboundQueue(const OutboundQueue&) = delete;
+    OutboundQueue& operator=(const OutboundQueue&) = delete;
+
+    // Queues `send`, weighing `bytes` against the budget; with a non-empty
+    // `key`, replaces the message waiting under it instead. Blocks while that
+    // would take the queue over budget, unless nothing else is queued or in
+    // flight (so a message larger than the budget still goes, alone).
+    // Returns false, dropping `send`, once the queue is closed.
+    bool push(Send send, std::size_t bytes, const std::string& key = {});
+
+    // Like push(), but returns false instead of blocking.
+    bool try_push(Send send, std::size_t bytes, const std::string& key = {});
+
+    // Writer: waits up to `timeout` for a message and sends it. Returns
+    // whether one was sent; returns at once once the queue is closed.
+    bool run_next(std::chrono::milliseconds timeout);
+
+    // Drops every waiting message and makes push() fail from now on, waking
+    // producers blocked in it. A message in flight finishes.
+    void close();
+
+    // Bytes queued and in flight.
+    [[nodiscard]] std::size_t byte_size() const;
+
+  private:
+    struct Entry {
+        Send send;
+        std::size_t bytes{};
+        std::string key;
+    };
+
+    // Pushes under `lock` if the budget allows (or `wait` is set and it
+    // comes to allow it), then lets go of it to call on_work_; returns
+    // false otherwise or if closed.
+    bool push_locked(std::unique_lock<std::mutex>& lock,
+                     Send& send,
+                     std::size_t bytes,
+                     const std::string& key,
+                     bool wait);
+
+    const std::size_t byte_budget_;
+    const std::function<void()> on_work_;
+    mutable std::mutex mutex_;
+    std::condition_variable queued_;
+    std::condition_variable drained_;
+    std::deque<Entry> entries_;
+    std::size_t queued_bytes_{};
+    std::size_t in_flight_bytes_{};
+    bool closed_{false};
+};
+
+} // namespace oid
+
+#endif // IPC_OUTBOUND_QUEUE_H_
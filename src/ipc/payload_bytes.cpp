@@ -0,0 +1,252 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "payload_bytes.h"
+
+#include <algorithm>
+#include <bit>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace oid {
+
+namespace {
+
+// From this size on, blocks are whole huge pages, aligned to one.
+constexpr std::size_t HUGE_PAGE_BYTES = 2ULL * 1024ULL * 1024ULL;
+
+std::size_t round_up(const std::size_t size, const std::size_t step) {
+    return (size + step - 1) / step * step;
+}
+
+// Sizes that round to the same class share blocks. Quarters of a power of
+// two below a huge page, so no block is more than a quarter larger than
+// asked for; whole huge pages above. A re-plot of the same geometry always
+// lands in the class its previous version left a block in.
+std::size_t size_class(const std::size_t size) {
+    if (size >= HUGE_PAGE_BYTES) {
+        return round_up(size, HUGE_PAGE_BYTES);
+    }
+    return round_up(size,
+                    std::max(std::bit_floor(size) / 4, PAYLOAD_ALIGNMENT));
+}
+
+std::align_val_t alignment_of(const std::size_t capacity) {
+    return std::align_val_t{capacity >= HUGE_PAGE_BYTES ? HUGE_PAGE_BYTES
+                                                        : PAYLOAD_ALIGNMENT};
+}
+
+std::byte* allocate(const std::size_t capacity) {
+    auto* const block = static_cast<std::byte*>(
+        ::operator new(capacity, alignment_of(capacity)));
+#if defined(__linux__)
+    if (capacity >= HUGE_PAGE_BYTES) {
+        // Only advice: ignored where transparent huge pages are off.
+        madvise(block, capacity, MADV_HUGEPAGE);
+    }
+#endif
+    return block;
+}
+
+void deallocate(std::byte* const block, const std::size_t capacity) {
+    ::operator delete(block, alignment_of(capacity));
+}
+
+// Blocks freed by PayloadBytes, for the next one of the same size class.
+// The receiver thread takes them and the UI thread gives them back.
+class PayloadPool {
+  public:
+    std::byte* take(const std::size_t capacity) {
+        {
+            const std::scoped_lock lock(mutex_);
+            // The most recently freed first: the likeliest to be cached.
+            const auto it =
+                std::ranges::find(free_.rbegin(),
+                                  free_.rend(),
+                                  capacity,
+                                  &Block::capacity);
+            if (it != free_.rend()) {
+                auto* const block = it->data;
+                free_bytes_ -= capacity;
+                free_.erase(std::next(it).base());
+                return block;
+            }
+        }
+        return allocate(capacity);
+    }
+
+    void give(std::byte* const data, const std::size_t capacity) {
+        auto evicted = std::vector<Block>{};
+        {
+            const std::scoped_lock lock(mutex_);
+            const auto same_class =
+                std::ranges::find(free_, capacity, &Block::capacity);
+            if (same_class != free_.end()) {
+                evicted.push_back(*same_class);
+                free_bytes_ -= capacity;
+                free_.erase(same_class);
+            }
+            free_.push_back({.data = data, .capacity = capacity});
+            free_bytes_ += capacity;
+            while (free_bytes_ > PAYLOAD_POOL_MAX_BYTES) {
+                evicted.push_back(free_.front());
+                free_bytes_ -= free_.front().capacity;
+                free_.pop_front();
+            }
+        }
+        for (const auto& block : evicted) {
+            deallocate(block.data, block.capacity);
+        }
+    }
+
+    void trim() {
+        auto evicted = std::deque<Block>{};
+        {
+            const std::scoped_lock lock(mutex_);
+            evicted.swap(free_);
+            free_bytes_ = 0;
+        }
+        for (const auto& block : evicted) {
+            deallocate(block.data, block.capacity);
+        }
+    }
+
+  private:
+    struct Block {
+        std::byte* data{};
+        std::size_t capacity{};
+    };
+
+    std::mutex mutex_;
+    // Oldest first.
+    std::deque<Block> free_;
+    std::size_t free_bytes_{0};
+};
+
+// Never destroyed: a PayloadBytes in a static may be freed after it would
+// have been.
+PayloadPool& pool() {
+    static auto* const instance = new PayloadPool{};
+    return *instance;
+}
+
+} // namespace
+
+PayloadBytes::PayloadBytes(const std::span<const std::byte> bytes)
+    : PayloadBytes{uninitialized(bytes.size())} {
+    std::ranges::copy(bytes, data_);
+}
+
+PayloadBytes PayloadBytes::uninitialized(const std::size_t size) {
+    auto bytes = PayloadBytes{};
+    if (size != 0) {
+        bytes.capacity_ = size_class(size);
+        bytes.data_ = pool().take(bytes.capacity_);
+        bytes.size_ = size;
+    }
+    return bytes;
+}
+
+PayloadBytes PayloadBytes::unpooled(const std::size_t size) {
+    auto bytes = PayloadBytes{};
+    bytes.pooled_ = false;
+    if (size != 0) {
+        bytes.capacity_ = size_class(size);
+        bytes.data_ = allocate(bytes.capacity_);
+        bytes.size_ = size;
+    }
+    return bytes;
+}
+
+void PayloadBytes::shrink(const std::size_t size) {
+    if (size >= size_) {
+        return;
+    }
+    size_ = size;
+#if defined(__linux__)
+    if (capacity_ >= HUGE_PAGE_BYTES) {
+        // Refaulted, zeroed, when the block is next used: every byte of it
+        // is written before it is read anyway.
+        const auto kept =
+            (size + HUGE_PAGE_BYTES - 1) / HUGE_PAGE_BYTES * HUGE_PAGE_BYTES;
+        if (kept < capacity_) {
+            madvise(data_ + kept, capacity_ - kept, MADV_DONTNEED);
+        }
+    }
+#endif
+}
+
+PayloadBytes::PayloadBytes(const PayloadBytes& other)
+    : PayloadBytes{std::span<const std::byte>{other}} {}
+
+PayloadBytes& PayloadBytes::operator=(const PayloadBytes& other) {
+    if (this != &other) {
+        *this = PayloadBytes{other};
+    }
+    return *this;
+}
+
+PayloadBytes::PayloadBytes(PayloadBytes&& other) noexcept
+    : data_{std::exchange(other.data_, nullptr)},
+      size_{std::exchange(other.size_, 0)},
+      capacity_{std::exchange(other.capacity_, 0)},
+      pooled_{other.pooled_} {}
+
+PayloadBytes& PayloadBytes::operator=(PayloadBytes&& other) noexcept {
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(pooled_, other.pooled_);
+    return *this;
+}
+
+PayloadBytes::~PayloadBytes() {
+    if (data_ == nullptr) {
+        return;
+    }
+    if (pooled_) {
+        pool().give(data_, capacity_);
+    } else {
+        deallocate(data_, capacity_);
+    }
+}
+
+bool operator==(const PayloadBytes& a, const std::span<const std::byte> b) {
+    return std::ranges::equal(std::span<const std::byte>{a}, b);
+}
+
+void trim_payload_pool() {
+    pool().trim();
+}
+
+} // namespace oid
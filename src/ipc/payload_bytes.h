@@ -0,0 +1,142 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef IPC_PAYLOAD_BYTES_H_
+#define IPC_PAYLOAD_BYTES_H_
+
+#include <cstddef>
+#include <span>
+
+namespace oid {
+
+// Alignment of every PayloadBytes block: a cache line, and what the widest
+// vector loads over pixels want.
+constexpr std::size_t PAYLOAD_ALIGNMENT = 64;
+
+// Freed blocks kept for reuse, in total; the oldest go back to the system
+// past it. Of each size class only the most recently freed block is kept:
+// all a re-plot of the same geometry takes while its predecessor is alive.
+constexpr std::size_t PAYLOAD_POOL_MAX_BYTES = 512ULL * 1024ULL * 1024ULL;
+
+// Pixel bytes of a buffer, as received or loaded. Unlike a
+// std::vector<std::byte>, a block of a given size is not zero-filled before
+// the socket overwrites it, and comes from a pool of blocks freed earlier:
+// a buffer re-plotted with the same geometry takes the block its previous
+// version left, whose pages are already faulted in. Blocks are
+// PAYLOAD_ALIGNMENT-aligned; large ones are also aligned and sized for
+// transparent huge pages, where the system has them.
+class PayloadBytes {
+  public:
+    PayloadBytes() = default;
+
+    // A copy of `bytes`.
+    explicit PayloadBytes(std::span<const std::byte> bytes);
+
+    // `size` bytes left as they were in the block: every one must be written
+    // before it is read.
+    [[nodiscard]] static PayloadBytes uninitialized(std::size_t size);
+
+    // As uninitialized(), but the block neither comes from nor goes back to
+    // the pool: for a one-off buffer whose memory should not outlive it,
+    // e.g. a read of the debuggee inside the debugger's own process.
+    [[nodiscard]] static PayloadBytes unpooled(std::size_t size);
+
+    // Drops every byte past the first `size`. The block itself stays, but
+    // where whole huge pages of it fall past `size` their memory goes back
+    // to the system until the block is reused.
+    void shrink(std::size_t size);
+
+    PayloadBytes(const PayloadBytes& other);
+    PayloadBytes& operator=(const PayloadBytes& other);
+    PayloadBytes(PayloadBytes&& other) noexcept;
+    PayloadBytes& operator=(PayloadBytes&& other) noexcept;
+    ~PayloadBytes();
+
+    [[nodiscard]] std::byte* data() {
+        return data_;
+    }
+    [[nodiscard]] const std::byte* data() const {
+        return data_;
+    }
+    [[nodiscard]] std::size_t size() const {
+        return size_;
+    }
+    [[nodiscard]] bool empty() const {
+        return size_ == 0;
+    }
+
+    [[nodiscard]] std::byte* begin() {
+        return data_;
+    }
+    [[nodiscard]] std::byte* end() {
+        return data_ + size_;
+    }
+    [[nodiscard]] const std::byte* begin() const {
+        return data_;
+    }
+    [[nodiscard]] const std::byte* end() const {
+        return data_ + size_;
+    }
+
+    [[nodiscard]] std::byte& operator[](const std::size_t i) {
+        return data_[i];
+    }
+    [[nodiscard]] const std::byte& operator[](const std::size_t i) const {
+        return data_[i];
+    }
+    [[nodiscard]] std::byte& front() {
+        return data_[0];
+    }
+    [[nodiscard]] const std::byte& front() const {
+        return data_[0];
+    }
+
+    // NOLINTNEXTLINE(*-explicit-constructor)
+    operator std::span<std::byte>() {
+        return {data_, size_};
+    }
+    // NOLINTNEXTLINE(*-explicit-constructor)
+    operator std::span<const std::byte>() const {
+        return {data_, size_};
+    }
+
+    friend bool operator==(const PayloadBytes& a,
+                           std::span<const std::byte> b);
+
+  private:
+    std::byte* data_{nullptr};
+    std::size_t size_{0};
+    // Size class of the block; 0 without one.
+    std::size_t capacity_{0};
+    bool pooled_{true};
+};
+
+// Returns every block the pool holds to the system, e.g. once a buffer is
+// removed and no re-plot of it will come to take its block.
+void trim_payload_pool();
+
+} // namespace oid
+
+#endif // IPC_PAYLOAD_BYTES_H_
@@ -0,0 +1,90 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef IPC_PIXEL_REGION_H_
+#define IPC_PIXEL_REGION_H_
+
+#include <algorithm>
+#include <cstddef>
+
+namespace oid {
+
+// Lazy plots: a buffer at least LAZY_PLOT_MIN_BYTES large is not shipped at
+// all. The viewer gets a PLOT_BUFFER_OVERVIEW -- the buffer decimated so its
+// longer side fits OVERVIEW_MAX_DIMENSION -- and asks for the full-resolution
+// pixels it actually shows, REGION_TILE_SIZE squares at a time, with
+// PLOT_BUFFER_REGION_REQUEST. Only for a viewer that announced
+// CAPABILITY_REGION_FETCH.
+constexpr std::size_t LAZY_PLOT_MIN_BYTES = 1024ULL * 1024ULL * 1024ULL;
+constexpr int OVERVIEW_MAX_DIMENSION = 2048;
+constexpr int REGION_TILE_SIZE = 512;
+
+// Quick looks: in quick-look mode, a buffer the bridge reads itself and
+// that is at least QUICK_LOOK_MIN_BYTES large, though small enough to ship,
+// is sent as a PLOT_BUFFER_OVERVIEW too, decimated by the factor the user
+// asked for; only the rows it samples are read. The viewer fetches regions
+// of it as of a lazy plot, and may ask for the whole buffer with
+// PLOT_BUFFER_FULL_REQUEST. Only for a viewer that announced
+// CAPABILITY_QUICK_LOOK.
+constexpr std::size_t QUICK_LOOK_MIN_BYTES = 16ULL * 1024ULL * 1024ULL;
+
+// A rectangle of a buffer, in pixels of the full-resolution buffer.
+struct PixelRegion {
+    int row{};
+    int col{};
+    int rows{};
+    int cols{};
+
+    bool operator==(const PixelRegion&) const = default;
+};
+
+// Smallest decimation factor that brings a `width` x `height` buffer within
+// OVERVIEW_MAX_DIMENSION on both sides; 1 if it already fits.
+[[nodiscard]] constexpr int overview_factor(const int width,
+                                            const int height) {
+    const auto longest = std::max(width, height);
+    return std::max(
+        1, (longest + OVERVIEW_MAX_DIMENSION - 1) / OVERVIEW_MAX_DIMENSION);
+}
+
+// Whether a buffer of `bytes` (see padded_payload_size()) may be plotted as
+// a quick look: smaller ones cost less to send whole than to upgrade, and
+// larger ones are plotted lazily instead, if at all.
+[[nodiscard]] constexpr bool quick_look_size(const std::size_t bytes) {
+    return bytes >= QUICK_LOOK_MIN_BYTES && bytes < LAZY_PLOT_MIN_BYTES;
+}
+
+// Whether `region` is non-empty and lies inside a `width` x `height` buffer.
+[[nodiscard]] constexpr bool
+region_within(const PixelRegion& region, const int width, const int height) {
+    return region.row >= 0 && region.col >= 0 && region.rows > 0 &&
+           region.cols > 0 && region.row < height && region.col < width &&
+           region.rows <= height - region.row &&
+           region.cols <= width - region.col;
+}
+
+} // namespace oid
+
+#endif // IPC_PIXEL_REGION_H_
@@ -0,0 +1,593 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "plot_buffer_sender.h"
+
+#include <algorithm>
+#include <deque>
+#include <exception>
+#include <future>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "block_codec.h"
+#include "content_hash.h"
+#include "message_exchange.h"
+
+namespace oid {
+
+namespace {
+
+void send_contents(ITransport& transport,
+                   const PlotBufferHeader& header,
+                   const std::span<const std::byte> pixels) {
+    MessageComposer composer;
+    composer.push(MessageType::PLOT_BUFFER_CONTENTS)
+        .push(header.variable_name)
+        .push(header.display_name)
+        .push(header.pixel_layout)
+        .push(header.transpose)
+        .push(header.width)
+        .push(header.height)
+        .push(header.channels)
+        .push(header.stride)
+        .push(header.type)
+        .push(pixels);
+    composer.send(transport);
+}
+
+// PLOT_BUFFER_PREVIEW: the first pixel of every `factor` x `factor` block,
+// row by row.
+void send_preview(ITransport& transport,
+                  const PlotBufferHeader& header,
+                  const std::span<const std::byte> pixels,
+                  const std::size_t bytes_per_row,
+                  const int factor) {
+    const auto step = static_cast<std::size_t>(factor);
+    const auto width = static_cast<std::size_t>(header.width);
+    const auto height = static_cast<std::size_t>(header.height);
+    const auto pixel_bytes =
+        static_cast<std::size_t>(header.channels) * type_size(header.type);
+    std::vector<std::byte> preview;
+    preview.reserve(((width + step - 1) / step) *
+                    ((height + step - 1) / step) * pixel_bytes);
+    for (std::size_t row = 0; row < height; row += step) {
+        const auto line = pixels.subspan(row * bytes_per_row, bytes_per_row);
+        for (std::size_t col = 0; col < width; col += step) {
+            const auto pixel = line.subspan(col * pixel_bytes, pixel_bytes);
+            preview.insert(preview.end(), pixel.begin(), pixel.end());
+        }
+    }
+
+    MessageComposer message;
+    message.push(MessageType::PLOT_BUFFER_PREVIEW)
+        .push(header.variable_name)
+        .push(factor)
+        .push(std::span<const std::byte>{preview});
+    message.send(transport);
+}
+
+// Bytes of one pixel, and of one row including its stride padding.
+std::pair<std::size_t, std::size_t> pixel_and_row_bytes(
+    const PlotBufferHeader& header) {
+    const auto pixel_bytes =
+        static_cast<std::size_t>(header.channels) * type_size(header.type);
+    return {pixel_bytes, static_cast<std::size_t>(header.stride) * pixel_bytes};
+}
+
+// Size of the overview of `header`'s buffer taking every `step`-th pixel of
+// every `step`-th row.
+std::size_t overview_bytes(const PlotBufferHeader& header,
+                           const std::size_t step) {
+    const auto width = static_cast<std::size_t>(header.width);
+    const auto height = static_cast<std::size_t>(header.height);
+    return ((width + step - 1) / step) * ((height + step - 1) / step) *
+           pixel_and_row_bytes(header).first;
+}
+
+// Appends every `step`-th pixel of `line`, a row without stride padding, to
+// `overview`.
+void append_sampled_pixels(std::vector<std::byte>& overview,
+                           const std::span<const std::byte> line,
+                           const std::size_t step,
+                           const std::size_t pixel_bytes) {
+    for (std::size_t at = 0; at < line.size(); at += step * pixel_bytes) {
+        const auto pixel = line.subspan(at, pixel_bytes);
+        overview.insert(overview.end(), pixel.begin(), pixel.end());
+    }
+}
+
+void send_overview(ITransport& transport,
+                   const PlotBufferHeader& header,
+                   const int factor,
+                   const bool quick_look,
+                   const std::span<const std::byte> overview) {
+    MessageComposer message;
+    message.push(MessageType::PLOT_BUFFER_OVERVIEW)
+        .push(header.variable_name)
+        .push(header.display_name)
+        .push(header.pixel_layout)
+        .push(header.transpose)
+        .push(header.width)
+        .push(header.height)
+        .push(header.channels)
+        .push(header.stride)
+        .push(static_cast<int>(header.type))
+        .push(factor)
+        .push(quick_look)
+        .push(overview);
+    message.send(transport);
+}
+
+// How many strips are compressed at once.
+std::size_t compression_workers() {
+    return std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1, 8);
+}
+
+void send_strip(ITransport& transport,
+                const MessageType type,
+                const std::string& name,
+                const std::size_t row,
+                const std::size_t count,
+                const std::span<const std::byte> bytes) {
+    MessageComposer strip;
+    strip.push(type).push(name).push(row).push(count).push(bytes);
+    strip.send(transport);
+}
+
+// One PLOT_BUFFER_CHUNK per `max_rows` rows of [rows.first, rows.second),
+// each referencing its slice of `pixels` in place. With `compress`, each is
+// compressed on a worker thread and sent as PLOT_BUFFER_CHUNK_COMPRESSED
+// when that came out smaller; workers run ahead of the strip being sent, so
+// compression overlaps the transfer and at most compression_workers()
+// compressed strips exist at a time.
+void send_row_strips(ITransport& transport,
+                     const std::string& name,
+                     const std::span<const std::byte> pixels,
+                     const std::size_t bytes_per_row,
+                     const std::pair<std::size_t, std::size_t> rows,
+                     const std::size_t max_rows,
+                     const bool compress) {
+    const auto strip_at = [&](const std::size_t row) {
+        const auto count = std::min(max_rows, rows.second - row);
+        return pixels.subspan(row * bytes_per_row, count * bytes_per_row);
+    };
+    if (!compress) {
+        for (auto row = rows.first; row < rows.second; row += max_rows) {
+            const auto strip = strip_at(row);
+            send_strip(transport,
+                       MessageType::PLOT_BUFFER_CHUNK,
+                       name,
+                       row,
+                       strip.size() / bytes_per_row,
+                       strip);
+        }
+        return;
+    }
+
+    struct Pending {
+        std::size_t row;
+        std::future<std::vector<std::byte>> block;
+    };
+    std::deque<Pending> pending;
+    auto next_row = rows.first;
+    const auto workers = compression_workers();
+    const auto launch = [&] {
+        pending.push_back({next_row,
+                           std::async(std::launch::async,
+                                      [strip = strip_at(next_row)] {
+                                          return compress_block(strip);
+                                      })});
+        next_row += max_rows;
+    };
+    while (next_row < rows.second && pending.size() < workers) {
+        launch();
+    }
+    while (!pending.empty()) {
+        const auto row = pending.front().row;
+        const auto block = pending.front().block.get();
+        pending.pop_front();
+        if (next_row < rows.second) {
+            launch();
+        }
+        const auto strip = strip_at(row);
+        const auto shrank = block.size() < strip.size();
+        send_strip(transport,
+                   shrank ? MessageType::PLOT_BUFFER_CHUNK_COMPRESSED
+                          : MessageType::PLOT_BUFFER_CHUNK,
+                   name,
+                   row,
+                   strip.size() / bytes_per_row,
+                   shrank ? std::span<const std::byte>{block} : strip);
+    }
+}
+
+// send_row_strips() over `lanes`: strip i goes to lane i % lanes.size(),
+// each lane sending (and compressing) its own on a thread of its own, then
+// PLOT_BUFFER_LANE_FENCE. Returns once every lane is done; rethrows the
+// first lane's exception, if any.
+void send_lane_strips(const DataLanes& lanes,
+                      const std::string& name,
+                      const std::span<const std::byte> pixels,
+                      const std::size_t bytes_per_row,
+                      const std::size_t height,
+                      const std::size_t max_rows,
+                      const bool compress) {
+    const auto count = lanes.lanes.size();
+    std::vector<std::exception_ptr> errors(count);
+    {
+        std::vector<std::jthread> senders;
+        senders.reserve(count);
+        for (std::size_t lane = 0; lane < count; ++lane) {
+            senders.emplace_back([&, lane] {
+                auto& transport = *lanes.lanes[lane];
+                try {
+                    for (auto row = lane * max_rows; row < height;
+                         row += count * max_rows) {
+                        const auto rows = std::min(max_rows, height - row);
+                        const auto strip = pixels.subspan(
+                            row * bytes_per_row, rows * bytes_per_row);
+                        const auto block = compress
+                                               ? compress_block(strip)
+                                               : std::vector<std::byte>{};
+                        const auto shrank =
+                            compress && block.size() < strip.size();
+                        const auto type =
+                            shrank ? MessageType::PLOT_BUFFER_CHUNK_COMPRESSED
+                                   : MessageType::PLOT_BUFFER_CHUNK;
+                        send_strip(transport,
+                                   type,
+                                   name,
+                                   row,
+                                   rows,
+                                   shrank ? std::span<const std::byte>{block}
+                                          : strip);
+                    }
+                    MessageComposer fence;
+                    fence.push(MessageType::PLOT_BUFFER_LANE_FENCE)
+                        .push(lanes.fence);
+                    fence.send(transport);
+                } catch (...) {
+                    errors[lane] = std::current_exception();
+                }
+            });
+        }
+    }
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+} // namespace
+
+std::size_t default_data_lanes() {
+    const auto cores = std::thread::hardware_concurrency();
+    return cores < 4 ? 0 : std::min<std::size_t>(cores / 2, 4);
+}
+
+void send_plot_buffer(ITransport& transport,
+                      const PlotBufferHeader& header,
+                      const std::span<const std::byte> pixels,
+                      const std::size_t chunk_bytes,
+                      const bool compress,
+                      const int preview_factor,
+                      const DataLanes& lanes) {
+    // The chunked path addresses rows by one fixed size, so BEGIN must
+    // declare exactly the padded size (see BufferAssembler::begin()).
+    const auto padded = padded_payload_size(header.width,
+                                            header.height,
+                                            header.channels,
+                                            header.stride,
+                                            header.type);
+    if (chunk_bytes == 0 || (pixels.size() <= chunk_bytes && !compress) ||
+        !padded.has_value() || *padded != pixels.size()) {
+        send_contents(transport, header, pixels);
+        return;
+    }
+
+    // BEGIN carries the type as a plain int, unlike PLOT_BUFFER_CONTENTS.
+    MessageComposer begin;
+    begin.push(MessageType::PLOT_BUFFER_BEGIN)
+        .push(header.variable_name)
+        .push(header.display_name)
+        .push(header.pixel_layout)
+        .push(header.transpose)
+        .push(header.width)
+        .push(header.height)
+        .push(header.channels)
+        .push(header.stride)
+        .push(static_cast<int>(header.type))
+        .push(pixels.size());
+    begin.send(transport);
+
+    const auto height = static_cast<std::size_t>(header.height);
+    const auto bytes_per_row = pixels.size() / height;
+    if (preview_factor > 1) {
+        send_preview(transport, header, pixels, bytes_per_row, preview_factor);
+    }
+    const auto max_rows = std::max<std::size_t>(1, chunk_bytes / bytes_per_row);
+    if (lanes.lanes.empty()) {
+        send_row_strips(transport,
+                        header.variable_name,
+                        pixels,
+                        bytes_per_row,
+                        {0, height},
+                        max_rows,
+                        compress);
+    } else {
+        MessageComposer announce;
+        announce.push(MessageType::PLOT_BUFFER_LANES)
+            .push(header.variable_name)
+            .push(lanes.fence)
+            .push(lanes.lanes.size());
+        announce.send(transport);
+        send_lane_strips(lanes,
+                         header.variable_name,
+                         pixels,
+                         bytes_per_row,
+                         height,
+                         max_rows,
+                         compress);
+    }
+
+    MessageComposer end;
+    end.push(MessageType::PLOT_BUFFER_END).push(header.variable_name);
+    end.send(transport);
+}
+
+PlotFingerprint
+fingerprint_plot_buffer(const PlotBufferHeader& header,
+                        const std::span<const std::byte> pixels) {
+    // The header is hashed in its wire encoding, which already frames each
+    // string by its length.
+    MessageComposer fields;
+    fields.push(header.variable_name)
+        .push(header.display_name)
+        .push(header.pixel_layout)
+        .push(header.transpose)
+        .push(header.width)
+        .push(header.height)
+        .push(header.channels)
+        .push(header.stride)
+        .push(header.type);
+    FrameCapture encoded;
+    fields.send(encoded);
+
+    PlotFingerprint fingerprint{.header_hash = content_hash(encoded.frame)};
+    // Strips address whole rows at one fixed size, the same requirement the
+    // chunked transfer has.
+    const auto padded = padded_payload_size(header.width,
+                                            header.height,
+                                            header.channels,
+                                            header.stride,
+                                            header.type);
+    if (!padded.has_value() || *padded != pixels.size() || pixels.empty()) {
+        fingerprint.strip_hashes.push_back(content_hash(pixels));
+        return fingerprint;
+    }
+    const auto height = static_cast<std::size_t>(header.height);
+    const auto bytes_per_row = pixels.size() / height;
+    fingerprint.rows_per_strip =
+        std::max<std::size_t>(1, DELTA_STRIP_BYTES / bytes_per_row);
+    const auto strip_bytes = fingerprint.rows_per_strip * bytes_per_row;
+    fingerprint.strip_hashes.reserve((pixels.size() + strip_bytes - 1) /
+                                     strip_bytes);
+    for (std::size_t offset = 0; offset < pixels.size();
+         offset += strip_bytes) {
+        fingerprint.strip_hashes.push_back(content_hash(pixels.subspan(
+            offset, std::min(strip_bytes, pixels.size() - offset))));
+    }
+    return fingerprint;
+}
+
+std::optional<std::vector<std::size_t>>
+changed_strips(const PlotFingerprint& before, const PlotFingerprint& now) {
+    if (before.header_hash != now.header_hash ||
+        before.rows_per_strip != now.rows_per_strip ||
+        before.strip_hashes.size() != now.strip_hashes.size()) {
+        return std::nullopt;
+    }
+    std::vector<std::size_t> changed;
+    for (std::size_t i = 0; i < now.strip_hashes.size(); ++i) {
+        if (before.strip_hashes[i] != now.strip_hashes[i]) {
+            changed.push_back(i);
+        }
+    }
+    // A payload hashed whole has nothing smaller than itself to resend.
+    if (!changed.empty() && now.rows_per_strip == 0) {
+        return std::nullopt;
+    }
+    return changed;
+}
+
+void send_plot_buffer_patch(ITransport& transport,
+                            const PlotBufferHeader& header,
+                            const std::span<const std::byte> pixels,
+                            const PlotFingerprint& fingerprint,
+                            const std::span<const std::size_t> strips,
+                            const std::size_t chunk_bytes,
+                            const bool compress) {
+    // Geometry rides along so the viewer can check the patch really applies
+    // to the copy it holds.
+    MessageComposer begin;
+    begin.push(MessageType::PLOT_BUFFER_PATCH_BEGIN)
+        .push(header.variable_name)
+        .push(header.width)
+        .push(header.height)
+        .push(header.channels)
+        .push(header.stride)
+        .push(static_cast<int>(header.type))
+        .push(pixels.size());
+    begin.send(transport);
+
+    const auto height = static_cast<std::size_t>(header.height);
+    const auto bytes_per_row = pixels.size() / height;
+    const auto max_rows =
+        chunk_bytes == 0
+            ? height
+            : std::max<std::size_t>(1, chunk_bytes / bytes_per_row);
+
+    // Adjacent changed strips go out as one run of rows.
+    const auto rows_per_strip = fingerprint.rows_per_strip;
+    for (std::size_t i = 0; i < strips.size();) {
+        auto j = i + 1;
+        while (j < strips.size() && strips[j] == strips[j - 1] + 1) {
+            ++j;
+        }
+        const auto first_row = strips[i] * rows_per_strip;
+        const auto end_row =
+            std::min(height, (strips[j - 1] + 1) * rows_per_strip);
+        send_row_strips(transport,
+                        header.variable_name,
+                        pixels,
+                        bytes_per_row,
+                        {first_row, end_row},
+                        max_rows,
+                        compress);
+        i = j;
+    }
+
+    MessageComposer end;
+    end.push(MessageType::PLOT_BUFFER_END).push(header.variable_name);
+    end.send(transport);
+}
+
+bool send_plot_buffer_overview(ITransport& transport,
+                               const PlotBufferHeader& header,
+                               const int factor,
+                               const bool quick_look,
+                               const PixelReader& reader) {
+    if (factor < 1 || header.width <= 0 || header.height <= 0) {
+        return false;
+    }
+    const auto step = static_cast<std::size_t>(factor);
+    const auto width = static_cast<std::size_t>(header.width);
+    const auto height = static_cast<std::size_t>(header.height);
+    const auto [pixel_bytes, row_bytes] = pixel_and_row_bytes(header);
+
+    std::vector<std::byte> line(width * pixel_bytes);
+    std::vector<std::byte> overview;
+    overview.reserve(overview_bytes(header, step));
+    for (std::size_t row = 0; row < height; row += step) {
+        if (!reader(row * row_bytes, line)) {
+            return false;
+        }
+        append_sampled_pixels(overview, line, step, pixel_bytes);
+    }
+    send_overview(transport, header, factor, quick_look, overview);
+    return true;
+}
+
+bool send_plot_buffer_overview_rows(ITransport& transport,
+                                    const PlotBufferHeader& header,
+                                    const int factor,
+                                    const bool quick_look,
+                                    const std::span<const std::byte> rows) {
+    if (factor < 1 || header.width <= 0 || header.height <= 0) {
+        return false;
+    }
+    const auto step = static_cast<std::size_t>(factor);
+    const auto pixel_bytes = pixel_and_row_bytes(header).first;
+    const auto line_bytes =
+        static_cast<std::size_t>(header.width) * pixel_bytes;
+    const auto sampled_rows =
+        (static_cast<std::size_t>(header.height) + step - 1) / step;
+    if (rows.size() != sampled_rows * line_bytes) {
+        return false;
+    }
+
+    std::vector<std::byte> overview;
+    overview.reserve(overview_bytes(header, step));
+    for (std::size_t row = 0; row < sampled_rows; ++row) {
+        append_sampled_pixels(overview,
+                              rows.subspan(row * line_bytes, line_bytes),
+                              step,
+                              pixel_bytes);
+    }
+    send_overview(transport, header, factor, quick_look, overview);
+    return true;
+}
+
+bool send_plot_buffer_region(ITransport& transport,
+                             const PlotBufferHeader& header,
+                             const PixelRegion& region,
+                             const PixelReader& reader) {
+    if (!region_within(region, header.width, header.height)) {
+        return false;
+    }
+    const auto [pixel_bytes, row_bytes] = pixel_and_row_bytes(header);
+    const auto region_row_bytes =
+        static_cast<std::size_t>(region.cols) * pixel_bytes;
+
+    std::vector<std::byte> pixels(static_cast<std::size_t>(region.rows) *
+                                  region_row_bytes);
+    for (int r = 0; r < region.rows; ++r) {
+        const auto offset =
+            static_cast<std::size_t>(region.row + r) * row_bytes +
+            static_cast<std::size_t>(region.col) * pixel_bytes;
+        const auto out = std::span<std::byte>{pixels}.subspan(
+            static_cast<std::size_t>(r) * region_row_bytes, region_row_bytes);
+        if (!reader(offset, out)) {
+            return false;
+        }
+    }
+
+    MessageComposer message;
+    message.push(MessageType::PLOT_BUFFER_REGION)
+        .push(header.variable_name)
+        .push(region.row)
+        .push(region.col)
+        .push(region.rows)
+        .push(region.cols)
+        .push(header.channels)
+        .push(static_cast<int>(header.type))
+        .push(std::span<const std::byte>{pixels});
+    message.send(transport);
+    return true;
+}
+
+void send_plot_buffer_unchanged(ITransport& transport,
+                                const std::string& variable_name) {
+    MessageComposer composer;
+    composer.push(MessageType::PLOT_BUFFER_UNCHANGED).push(variable_name);
+    composer.send(transport);
+}
+
+void send_plot_batch_begin(ITransport& transport) {
+    MessageComposer composer;
+    composer.push(MessageType::PLOT_BUFFER_BATCH_BEGIN);
+    composer.send(transport);
+}
+
+void send_plot_batch_end(ITransport& transport) {
+    MessageComposer composer;
+    composer.push(MessageType::PLOT_BUFFER_BATCH_END);
+    composer.send(transport);
+}
+
+} // namespace oid
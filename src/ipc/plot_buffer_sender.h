@@ -0,0 +1,227 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef IPC_PLOT_BUFFER_SENDER_H_
+#define IPC_PLOT_BUFFER_SENDER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "pixel_region.h"
+#include "raw_data_decode.h"
+#include "transport.h"
+
+namespace oid {
+
+// Default target size of one PLOT_BUFFER_CHUNK row strip. Large enough that
+// per-message overhead vanishes next to the copy, small enough that the
+// viewer starts assembling long before the tail of a multi-GB buffer leaves
+// the bridge.
+constexpr std::size_t DEFAULT_PLOT_CHUNK_BYTES = 16ULL * 1024ULL * 1024ULL;
+
+// Progressive transfer: buffers at least PREVIEW_MIN_BYTES large are worth
+// a preview of every PREVIEW_FACTOR-th row and column, 1/64th of the
+// payload, so the viewer has a picture long before the last strip lands.
+constexpr std::size_t PREVIEW_MIN_BYTES = 64ULL * 1024ULL * 1024ULL;
+constexpr int PREVIEW_FACTOR = 8;
+
+// Most data lanes (see DataLanes) a bridge opens to one viewer.
+constexpr std::size_t MAX_DATA_LANES = 8;
+
+// How many data lanes are worth opening on this machine: none on fewer
+// than four cores, where the lanes' threads would only compete with the
+// debugger, else one per two cores up to four.
+[[nodiscard]] std::size_t default_data_lanes();
+
+// Connections to the viewer besides the control one, over which a chunked
+// transfer's row strips are spread (only for a viewer that announced
+// CAPABILITY_DATA_LANES), so that several cores frame, compress and copy
+// strips at once. `fence` must grow with every transfer sent on them: the
+// viewer holds PLOT_BUFFER_END until each lane has passed it.
+struct DataLanes {
+    std::span<ITransport* const> lanes{};
+    std::uint64_t fence{};
+};
+
+// Everything a plot message carries besides the pixels.
+struct PlotBufferHeader {
+    std::string variable_name;
+    std::string display_name;
+    std::string pixel_layout;
+    bool transpose{};
+    int width{};
+    int height{};
+    int channels{};
+    int stride{};
+    BufferType type{};
+};
+
+// Sends `pixels` to the viewer as PLOT_BUFFER_BEGIN, one PLOT_BUFFER_CHUNK
+// per strip of whole rows of about `chunk_bytes` (at least one row), then
+// PLOT_BUFFER_END. Each strip is referenced in place, so no full-size
+// staging copy exists on this side, and the viewer's BufferAssembler fills
+// its allocation strip by strip as they arrive.
+//
+// With `compress` (only for a viewer that announced
+// CAPABILITY_COMPRESSED_CHUNKS), each strip that compress_block() shrinks is
+// sent as PLOT_BUFFER_CHUNK_COMPRESSED instead, compressed on worker threads
+// while earlier strips are on the wire; one that does not shrink goes raw.
+//
+// With a `preview_factor` above 1 (only for a viewer that announced
+// CAPABILITY_PROGRESSIVE_PREVIEW), a PLOT_BUFFER_PREVIEW follows BEGIN: the
+// pixel at every `preview_factor`-th column of every `preview_factor`-th
+// row, packed without stride padding. The strips that follow still carry
+// every row, so what the viewer ends up with is exact.
+//
+// With `lanes`, a PLOT_BUFFER_LANES announcing the fence and lane count
+// follows BEGIN (and the preview), and the strips go round-robin over the
+// lanes instead of the control transport, each lane on its own thread
+// (compressing its strips inline) and closed by a PLOT_BUFFER_LANE_FENCE.
+// END follows on the control transport once every lane is done, so the
+// order of everything else sent there is untouched.
+//
+// Falls back to a single PLOT_BUFFER_CONTENTS message when `chunk_bytes` is
+// 0, when the buffer fits in one strip anyway (unless compressing), or when
+// `pixels` is not the fully padded size of the geometry (e.g. a final row
+// trimmed of its stride padding), which only the single-message path
+// accepts. That message is never compressed.
+//
+// Throws whatever a transport throws (from a lane, once all lanes are
+// done); a transfer cut short that way is dropped by the viewer as
+// incomplete.
+void send_plot_buffer(ITransport& transport,
+                      const PlotBufferHeader& header,
+                      std::span<const std::byte> pixels,
+                      std::size_t chunk_bytes = DEFAULT_PLOT_CHUNK_BYTES,
+                      bool compress = false,
+                      int preview_factor = 0,
+                      const DataLanes& lanes = {});
+
+// Granularity at which a re-plot is compared against the previous one: rows
+// are grouped into strips of about this many bytes (at least one row each),
+// and only strips whose contents changed are sent again.
+constexpr std::size_t DELTA_STRIP_BYTES = 64ULL * 1024ULL;
+
+// What the bridge remembers of a plot it sent, to tell on the next stop
+// whether the buffer is unchanged, changed in some rows, or different
+// altogether. Hashes only -- the pixels themselves are not kept.
+struct PlotFingerprint {
+    // Every header field, so a buffer that kept its bytes but changed shape,
+    // type or layout never counts as the same plot.
+    std::uint64_t header_hash{};
+    // Rows per entry of `strip_hashes`; 0 when the payload is not the padded
+    // size of its geometry, in which case it is hashed whole into a single
+    // entry and can only ever be resent whole.
+    std::size_t rows_per_strip{};
+    std::vector<std::uint64_t> strip_hashes{};
+
+    bool operator==(const PlotFingerprint&) const = default;
+};
+
+[[nodiscard]] PlotFingerprint
+fingerprint_plot_buffer(const PlotBufferHeader& header,
+                        std::span<const std::byte> pixels);
+
+// Indices of the strips of `now` whose contents differ from `before`, in
+// ascending order; empty if the plot is unchanged. nullopt if the two cannot
+// be compared strip by strip (different header or strip layout), so only a
+// full send will do.
+[[nodiscard]] std::optional<std::vector<std::size_t>>
+changed_strips(const PlotFingerprint& before, const PlotFingerprint& now);
+
+// Sends only the strips listed in `strips` (indices into `fingerprint`'s
+// strips, ascending) as a patch on the copy the viewer already holds:
+// PLOT_BUFFER_PATCH_BEGIN, one PLOT_BUFFER_CHUNK per run of adjacent changed
+// strips (split further at `chunk_bytes`, if non-zero), then
+// PLOT_BUFFER_END. `fingerprint` must describe `pixels` and must have come
+// with strip hashes (rows_per_strip != 0). `compress` as for
+// send_plot_buffer().
+void send_plot_buffer_patch(ITransport& transport,
+                            const PlotBufferHeader& header,
+                            std::span<const std::byte> pixels,
+                            const PlotFingerprint& fingerprint,
+                            std::span<const std::size_t> strips,
+                            std::size_t chunk_bytes = DEFAULT_PLOT_CHUNK_BYTES,
+                            bool compress = false);
+
+// Tells the viewer that `variable_name` is exactly what it last received
+// under that name (see changed_strips()), so it keeps its copy instead of
+// taking a new one.
+void send_plot_buffer_unchanged(ITransport& transport,
+                                const std::string& variable_name);
+
+// Frame the plots of one debugger stop: the viewer holds every plot it
+// completes between PLOT_BUFFER_BATCH_BEGIN and PLOT_BUFFER_BATCH_END and
+// takes them in at once, so its views never mix buffers from two stops.
+// Previews still show as they arrive. Batches do not nest.
+void send_plot_batch_begin(ITransport& transport);
+void send_plot_batch_end(ITransport& transport);
+
+// Reads `out.size()` bytes at byte `offset` of a lazy plot's pixels (laid
+// out as PLOT_BUFFER_CONTENTS would carry them) straight from where they
+// live, typically the debuggee's memory. Returns false if they cannot be
+// read.
+using PixelReader =
+    std::function<bool(std::size_t offset, std::span<std::byte> out)>;
+
+// Sends PLOT_BUFFER_OVERVIEW for a lazy plot (see ipc/pixel_region.h): the
+// header, `factor`, whether it is a `quick_look` the viewer may ask for in
+// full, and the first pixel of every `factor` x `factor` block, packed
+// without stride padding. Only every `factor`-th row is read through
+// `reader`. Returns false, having sent nothing, if a read fails.
+bool send_plot_buffer_overview(ITransport& transport,
+                               const PlotBufferHeader& header,
+                               int factor,
+                               bool quick_look,
+                               const PixelReader& reader);
+
+// Sends the same PLOT_BUFFER_OVERVIEW from `rows`: every `factor`-th row of
+// the buffer, already read (say by one scatter read, for a quick look),
+// each header.width pixels without stride padding. Returns false, having
+// sent nothing, if `rows` holds any other number of bytes.
+bool send_plot_buffer_overview_rows(ITransport& transport,
+                                    const PlotBufferHeader& header,
+                                    int factor,
+                                    bool quick_look,
+                                    std::span<const std::byte> rows);
+
+// Answers a PLOT_BUFFER_REGION_REQUEST with PLOT_BUFFER_REGION: `region`,
+// the channel count and type (so the viewer can check the pixels against
+// the overview it holds) and the pixels at full resolution, packed without
+// stride padding, read row by row through `reader`. Returns false, having
+// sent nothing, if the region is not within the buffer or a read fails.
+bool send_plot_buffer_region(ITransport& transport,
+                             const PlotBufferHeader& header,
+                             const PixelRegion& region,
+                             const PixelReader& reader);
+
+} // namespace oid
+
+#endif // IPC_PLOT_BUFFER_SENDER_H_
@@ -28,21 +28,200 @@
 #include <algorithm>
 
 #include <bit>
+#include <cassert>
+#include <cstring>
 #include <limits>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 namespace oid {
 
-std::vector<std::byte>
-make_float_buffer_from_double(const std::vector<std::byte>& buff_double) {
+namespace {
+
+// Doubles one worker narrows before another thread is worth starting:
+// 8 MiB of them.
+constexpr std::size_t MIN_DOUBLES_PER_WORKER = std::size_t{1} << 20;
+
+// Narrows the `count` doubles at `src` into the floats at `dst`, front to
+// back. Every access is a vector load or store or a memcpy, never through a
+// double* or float*, and each group of doubles is loaded before its floats
+// are stored: `dst` may therefore be `src` itself.
+void narrow_range_scalar(const std::byte* src,
+                         std::byte* dst,
+                         const std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        double wide{};
+        std::memcpy(&wide, src + i * sizeof(double), sizeof(double));
+        const auto narrow = static_cast<float>(wide);
+        std::memcpy(dst + i * sizeof(float), &narrow, sizeof(float));
+    }
+}
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+// SSE2 is part of x86-64 itself.
+void narrow_range_sse2(const std::byte* src,
+                       std::byte* dst,
+                       const std::size_t count) {
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const auto* const in =
+            reinterpret_cast<const double*>(src + i * sizeof(double));
+        const __m128d lo = _mm_loadu_pd(in);
+        const __m128d hi = _mm_loadu_pd(in + 2);
+        _mm_storeu_ps(reinterpret_cast<float*>(dst + i * sizeof(float)),
+                      _mm_movelh_ps(_mm_cvtpd_ps(lo), _mm_cvtpd_ps(hi)));
+    }
+    narrow_range_scalar(
+        src + i * sizeof(double), dst + i * sizeof(float), count - i);
+}
+
+#if defined(__GNUC__)
+#define OID_HAS_AVX_NARROWING
+
+__attribute__((target("avx"))) void
+narrow_range_avx(const std::byte* src,
+                 std::byte* dst,
+                 const std::size_t count) {
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const auto* const in =
+            reinterpret_cast<const double*>(src + i * sizeof(double));
+        const __m256d lo = _mm256_loadu_pd(in);
+        const __m256d hi = _mm256_loadu_pd(in + 4);
+        auto* const out = reinterpret_cast<float*>(dst + i * sizeof(float));
+        _mm_storeu_ps(out, _mm256_cvtpd_ps(lo));
+        _mm_storeu_ps(out + 4, _mm256_cvtpd_ps(hi));
+    }
+    narrow_range_sse2(
+        src + i * sizeof(double), dst + i * sizeof(float), count - i);
+}
+#endif
+
+#elif defined(__aarch64__)
+
+// NEON is part of AArch64 itself. The vectors go through memcpy, as the
+// scalar tail's values do, so an in-place narrowing never reads through a
+// double* what was just stored as floats.
+void narrow_range_neon(const std::byte* src,
+                       std::byte* dst,
+                       const std::size_t count) {
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float64x2_t lo;
+        float64x2_t hi;
+        std::memcpy(&lo, src + i * sizeof(double), sizeof(lo));
+        std::memcpy(&hi, src + (i + 2) * sizeof(double), sizeof(hi));
+        const float32x4_t out = vcvt_high_f32_f64(vcvt_f32_f64(lo), hi);
+        std::memcpy(dst + i * sizeof(float), &out, sizeof(out));
+    }
+    narrow_range_scalar(
+        src + i * sizeof(double), dst + i * sizeof(float), count - i);
+}
+
+#endif
+
+void narrow_range(const std::byte* src,
+                  std::byte* dst,
+                  const std::size_t count) {
+#if defined(OID_HAS_AVX_NARROWING)
+    static const bool has_avx = __builtin_cpu_supports("avx") != 0;
+    if (has_avx) {
+        narrow_range_avx(src, dst, count);
+        return;
+    }
+#endif
+#if defined(__x86_64__) || defined(_M_X64)
+    narrow_range_sse2(src, dst, count);
+#elif defined(__aarch64__)
+    narrow_range_neon(src, dst, count);
+#else
+    narrow_range_scalar(src, dst, count);
+#endif
+}
+
+std::size_t narrowing_workers(const std::size_t count) {
+#if defined(__EMSCRIPTEN__)
+    // No threads without SharedArrayBuffer.
+    return 1;
+#else
+    const auto cores =
+        std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1, 8);
+    return std::clamp<std::size_t>(count / MIN_DOUBLES_PER_WORKER, 1, cores);
+#endif
+}
+
+// narrow_range() split into contiguous stretches, one per worker; the
+// calling thread takes the last. Stretches are disjoint, so this is as safe
+// in place as narrow_range() is, as long as no stretch stores onto doubles
+// another one has yet to load.
+void narrow_parallel(const std::byte* src,
+                     std::byte* dst,
+                     const std::size_t count) {
+    const auto workers = narrowing_workers(count);
+    const auto per_worker = count / workers;
+    std::vector<std::jthread> threads;
+    threads.reserve(workers - 1);
+    for (std::size_t w = 0; w + 1 < workers; ++w) {
+        const auto first = w * per_worker;
+        const auto* const from = src + first * sizeof(double);
+        auto* const to = dst + first * sizeof(float);
+        try {
+            threads.emplace_back(
+                [from, to, per_worker] { narrow_range(from, to, per_worker); });
+        } catch (const std::system_error&) {
+            // Out of threads: this stretch is narrowed here instead.
+            narrow_range(from, to, per_worker);
+        }
+    }
+    const auto last = (workers - 1) * per_worker;
+    narrow_range(src + last * sizeof(double),
+                 dst + last * sizeof(float),
+                 count - last);
+}
+
+} // namespace
+
+void narrow_doubles_to_floats(const std::span<const std::byte> buff_double,
+                              const std::span<std::byte> buff_float) {
     const auto element_count = buff_double.size() / sizeof(double);
-    std::vector<std::byte> buff_float(element_count * sizeof(float));
+    assert(buff_float.size() == element_count * sizeof(float));
+    narrow_parallel(buff_double.data(), buff_float.data(), element_count);
+}
 
-    const auto src = std::bit_cast<const double*>(buff_double.data());
-    const auto dst = std::bit_cast<float*>(buff_float.data());
-    std::transform(src, src + element_count, dst, [](const double d) {
-        return static_cast<float>(d);
-    });
+std::span<std::byte>
+narrow_doubles_to_floats_in_place(const std::span<std::byte> bytes) {
+    const auto element_count = bytes.size() / sizeof(double);
+    auto* const data = bytes.data();
 
+    // Doubles [done, 2 * done) narrow onto bytes [4 * done, 8 * done), which
+    // held doubles [done / 2, done): already narrowed. So each doubling of
+    // the narrowed prefix is split across workers, with nothing stored onto
+    // doubles still to be loaded; only the first stretch runs alone.
+    auto done = std::min(element_count, MIN_DOUBLES_PER_WORKER);
+    narrow_range(data, data, done);
+    while (done < element_count) {
+        const auto next = std::min(element_count, 2 * done);
+        narrow_parallel(data + done * sizeof(double),
+                        data + done * sizeof(float),
+                        next - done);
+        done = next;
+    }
+    return bytes.first(element_count * sizeof(float));
+}
+
+std::vector<std::byte>
+make_float_buffer_from_double(const std::span<const std::byte> buff_double) {
+    const auto element_count = buff_double.size() / sizeof(double);
+    std::vector<std::byte> buff_float(element_count * sizeof(float));
+    narrow_doubles_to_floats(buff_double, buff_float);
     return buff_float;
 }
 
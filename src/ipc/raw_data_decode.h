@@ -31,6 +31,7 @@
 
 #include <limits>
 #include <optional>
+#include <span>
 #include <vector> // for std::vector
 
 namespace oid {
@@ -95,8 +96,19 @@ within_display_limits(const int width, const int height, const int channels) {
     return is_known_buffer_type(static_cast<BufferType>(type));
 }
 
+// Narrows the FLOAT64 elements of `buff_double` into `buff_float`, which
+// must hold exactly half as many bytes and not overlap it. Vectorized, and
+// split across threads for large buffers.
+void narrow_doubles_to_floats(std::span<const std::byte> buff_double,
+                              std::span<std::byte> buff_float);
+
+// narrow_doubles_to_floats() over `bytes` itself, so no second buffer is
+// needed: returns the front of `bytes`, which now holds the floats.
+std::span<std::byte>
+narrow_doubles_to_floats_in_place(std::span<std::byte> bytes);
+
 std::vector<std::byte>
-make_float_buffer_from_double(const std::vector<std::byte>& buff_double);
+make_float_buffer_from_double(std::span<const std::byte> buff_double);
 
 // True if `byte_count` wire bytes can hold every pixel the declared geometry
 // addresses. The last row needs only `width` pixels, not the full `stride`,
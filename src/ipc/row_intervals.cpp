@@ -0,0 +1,91 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "row_intervals.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace oid {
+
+void RowIntervals::insert(std::size_t begin, std::size_t end) {
+    if (begin >= end) {
+        return;
+    }
+    // Absorb the run starting at or before `begin` if it reaches it, then
+    // every run starting inside (or right after) the grown range.
+    auto it = runs_.upper_bound(begin);
+    if (it != runs_.begin()) {
+        if (const auto previous = std::prev(it); previous->second >= begin) {
+            begin = previous->first;
+            end = std::max(end, previous->second);
+            it = runs_.erase(previous);
+        }
+    }
+    while (it != runs_.end() && it->first <= end) {
+        end = std::max(end, it->second);
+        it = runs_.erase(it);
+    }
+    runs_.emplace_hint(it, begin, end);
+}
+
+bool RowIntervals::covers(const std::size_t begin,
+                          const std::size_t end) const {
+    if (begin >= end) {
+        return true;
+    }
+    // Runs never touch, so only the one starting at or before `begin` can
+    // hold all of the range.
+    const auto it = runs_.upper_bound(begin);
+    return it != runs_.begin() && std::prev(it)->second >= end;
+}
+
+std::vector<std::pair<std::size_t, std::size_t>>
+RowIntervals::without(const RowIntervals& other) const {
+    std::vector<std::pair<std::size_t, std::size_t>> out;
+    for (const auto& [first, end] : runs_) {
+        auto begin = first;
+        // Every run of `other` that ends inside this one cuts it, in order.
+        auto it = other.runs_.upper_bound(begin);
+        if (it != other.runs_.begin()) {
+            it = std::prev(it);
+        }
+        for (; it != other.runs_.end() && it->first < end; ++it) {
+            if (it->second <= begin) {
+                continue;
+            }
+            if (it->first > begin) {
+                out.emplace_back(begin, it->first);
+            }
+            begin = it->second;
+        }
+        if (begin < end) {
+            out.emplace_back(begin, end);
+        }
+    }
+    return out;
+}
+
+} // namespace oid
@@ -0,0 +1,72 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef IPC_ROW_INTERVALS_H_
+#define IPC_ROW_INTERVALS_H_
+
+#include <cstddef>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace oid {
+
+// Set of rows kept as disjoint half-open runs [begin, end), merged with their
+// neighbours as they are added: memory, insertion and coverage checks scale
+// with the number of separate runs -- for a buffer arriving in row strips,
+// with the strips out of order -- and not with the height of the buffer.
+class RowIntervals {
+  public:
+    // Adds rows [begin, end); an empty range adds nothing.
+    void insert(std::size_t begin, std::size_t end);
+
+    // True if every row of [begin, end) has been added; trivially true for
+    // an empty range.
+    [[nodiscard]] bool covers(std::size_t begin, std::size_t end) const;
+
+    // The runs of rows added here but not to `other`, as [begin, end) pairs
+    // in row order.
+    [[nodiscard]] std::vector<std::pair<std::size_t, std::size_t>>
+    without(const RowIntervals& other) const;
+
+    // The runs held, as [begin, end) pairs in row order.
+    [[nodiscard]] std::vector<std::pair<std::size_t, std::size_t>>
+    intervals() const {
+        return {runs_.begin(), runs_.end()};
+    }
+
+    // Number of separate runs held.
+    [[nodiscard]] std::size_t runs() const {
+        return runs_.size();
+    }
+
+  private:
+    // begin -> end of each run; no two runs overlap or touch.
+    std::map<std::size_t, std::size_t> runs_{};
+};
+
+} // namespace oid
+
+#endif // IPC_ROW_INTERVALS_H_
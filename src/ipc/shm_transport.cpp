@@ -0,0 +1,391 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "shm_transport.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "message_exchange.h"
+
+namespace oid {
+
+// Lives at the start of the segment, followed by the data region. head and
+// tail sit on their own cache lines so the two processes do not false-share
+// while one writes and the other drains.
+struct SharedMemoryRingHeader {
+    std::uint64_t magic;
+    std::uint64_t capacity;
+    alignas(64) std::atomic<std::uint64_t> head; // bytes published (writer)
+    alignas(64) std::atomic<std::uint64_t> tail; // bytes consumed (reader)
+};
+
+// The atomics are shared between processes, which is only sound when they
+// are plain lock-free words rather than library-side locks.
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+
+namespace {
+
+constexpr std::uint64_t RING_MAGIC = 0x474e49524d485344ULL; // "DSHMRING"
+constexpr std::size_t HEADER_BYTES = sizeof(SharedMemoryRingHeader);
+
+constexpr std::size_t SHM_RECORD_IN_RING = std::size_t{1}
+                                           << (sizeof(std::size_t) * 8 - 1);
+
+// The viewer's answer to a shared-memory offer. Anything other than
+// SHM_OFFER_ACCEPTED is treated as declining.
+constexpr std::size_t SHM_OFFER_ACCEPTED = 0x31414d4853444f; // "ODSHMA1"
+constexpr std::size_t SHM_OFFER_DECLINED = 0x30444d4853444f; // "ODSHMD0"
+
+[[noreturn]] void throw_errno(const char* what) {
+    throw std::system_error{errno, std::generic_category(), what};
+}
+
+// Short enough for macOS's 31-character shm name limit.
+std::string make_segment_name(const unsigned attempt) {
+    static std::atomic<unsigned> counter{0};
+    return "/oid-" + std::to_string(::getpid()) + "-" +
+           std::to_string(counter.fetch_add(1) + attempt);
+}
+
+void* map_segment(const int fd, const std::size_t size) {
+    void* mapping =
+        ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    return mapping == MAP_FAILED ? nullptr : mapping;
+}
+
+} // namespace
+
+SharedMemoryRing SharedMemoryRing::create(const std::size_t capacity) {
+    if (capacity == 0) {
+        throw std::invalid_argument{"shared-memory ring capacity is zero"};
+    }
+    const auto mapping_size = HEADER_BYTES + capacity;
+
+    // O_EXCL guards against adopting a segment some other process left
+    // behind under the same name; a collision just retries with a new one.
+    std::string name;
+    int fd = -1;
+    for (unsigned attempt = 0; fd < 0 && attempt < 8; ++attempt) {
+        name = make_segment_name(attempt);
+        fd = ::shm_open(
+            name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+        if (fd < 0 && errno != EEXIST) {
+            throw_errno("shm_open");
+        }
+    }
+    if (fd < 0) {
+        throw_errno("shm_open");
+    }
+
+    void* mapping = nullptr;
+    if (::ftruncate(fd, static_cast<off_t>(mapping_size)) == 0) {
+        mapping = map_segment(fd, mapping_size);
+    }
+    const auto saved_errno = errno;
+    ::close(fd);
+    if (mapping == nullptr) {
+        ::shm_unlink(name.c_str());
+        errno = saved_errno;
+        throw_errno("mmap");
+    }
+
+    auto* header = new (mapping) SharedMemoryRingHeader{};
+    header->magic = RING_MAGIC;
+    header->capacity = capacity;
+    return SharedMemoryRing{std::move(name), mapping, mapping_size, true};
+}
+
+SharedMemoryRing SharedMemoryRing::open(const std::string& name) {
+    const int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0) {
+        throw_errno("shm_open");
+    }
+
+    struct stat st{};
+    void* mapping = nullptr;
+    std::size_t mapping_size = 0;
+    if (::fstat(fd, &st) == 0) {
+        mapping_size = static_cast<std::size_t>(st.st_size);
+        if (mapping_size > HEADER_BYTES) {
+            mapping = map_segment(fd, mapping_size);
+        }
+    }
+    const auto saved_errno = errno;
+    ::close(fd);
+    if (mapping == nullptr) {
+        if (mapping_size <= HEADER_BYTES) {
+            throw std::runtime_error{
+                "shared-memory segment is not an OID ring"};
+        }
+        errno = saved_errno;
+        throw_errno("mmap");
+    }
+
+    // Constructed before validating so the destructor unmaps on rejection.
+    auto ring = SharedMemoryRing{name, mapping, mapping_size, false};
+    if (ring.header_->magic != RING_MAGIC ||
+        ring.header_->capacity != mapping_size - HEADER_BYTES) {
+        throw std::runtime_error{"shared-memory segment is not an OID ring"};
+    }
+    return ring;
+}
+
+SharedMemoryRing::SharedMemoryRing(std::string name,
+                                   void* mapping,
+                                   const std::size_t mapping_size,
+                                   const bool owns_name)
+    : name_{std::move(name)}, mapping_{mapping}, mapping_size_{mapping_size},
+      header_{static_cast<SharedMemoryRingHeader*>(mapping)},
+      data_{static_cast<std::byte*>(mapping) + HEADER_BYTES},
+      owns_name_{owns_name} {}
+
+SharedMemoryRing::SharedMemoryRing(SharedMemoryRing&& other) noexcept
+    : name_{std::move(other.name_)},
+      mapping_{std::exchange(other.mapping_, nullptr)},
+      mapping_size_{std::exchange(other.mapping_size_, 0)},
+      header_{std::exchange(other.header_, nullptr)},
+      data_{std::exchange(other.data_, nullptr)},
+      owns_name_{std::exchange(other.owns_name_, false)} {}
+
+SharedMemoryRing&
+SharedMemoryRing::operator=(SharedMemoryRing&& other) noexcept {
+    if (this != &other) {
+        std::swap(name_, other.name_);
+        std::swap(mapping_, other.mapping_);
+        std::swap(mapping_size_, other.mapping_size_);
+        std::swap(header_, other.header_);
+        std::swap(data_, other.data_);
+        std::swap(owns_name_, other.owns_name_);
+    }
+    return *this;
+}
+
+SharedMemoryRing::~SharedMemoryRing() noexcept {
+    unlink();
+    if (mapping_ != nullptr) {
+        ::munmap(mapping_, mapping_size_);
+    }
+}
+
+const std::string& SharedMemoryRing::name() const {
+    return name_;
+}
+
+std::size_t SharedMemoryRing::capacity() const {
+    return mapping_size_ - HEADER_BYTES;
+}
+
+void SharedMemoryRing::unlink() noexcept {
+    if (owns_name_) {
+        ::shm_unlink(name_.c_str());
+        owns_name_ = false;
+    }
+}
+
+std::size_t SharedMemoryRing::free_bytes() const {
+    const auto head = header_->head.load(std::memory_order_relaxed);
+    const auto tail = header_->tail.load(std::memory_order_acquire);
+    return capacity() - static_cast<std::size_t>(head - tail);
+}
+
+std::size_t SharedMemoryRing::readable_bytes() const {
+    const auto head = header_->head.load(std::memory_order_acquire);
+    const auto tail = header_->tail.load(std::memory_order_relaxed);
+    return static_cast<std::size_t>(head - tail);
+}
+
+void SharedMemoryRing::push(const std::span<const std::byte> src) {
+    const auto head = header_->head.load(std::memory_order_relaxed);
+    const auto offset = static_cast<std::size_t>(head % capacity());
+    const auto first = std::min(src.size(), capacity() - offset);
+    std::memcpy(data_ + offset, src.data(), first);
+    std::memcpy(data_, src.data() + first, src.size() - first);
+    header_->head.store(head + src.size(), std::memory_order_release);
+}
+
+void SharedMemoryRing::pop(const std::span<std::byte> dst) {
+    const auto tail = header_->tail.load(std::memory_order_relaxed);
+    const auto offset = static_cast<std::size_t>(tail % capacity());
+    const auto first = std::min(dst.size(), capacity() - offset);
+    std::memcpy(dst.data(), data_ + offset, first);
+    std::memcpy(dst.data() + first, data_, dst.size() - first);
+    header_->tail.store(tail + dst.size(), std::memory_order_release);
+}
+
+SharedMemoryTransport::SharedMemoryTransport(
+    ITransport& control,
+    SharedMemoryRing ring,
+    const Role role,
+    const std::chrono::milliseconds timeout)
+    : control_{control}, ring_{std::move(ring)}, role_{role},
+      timeout_{timeout} {}
+
+void SharedMemoryTransport::send(const std::span<const std::byte> data) {
+    const std::span<const std::byte> parts[] = {data};
+    send_gather(parts);
+}
+
+void SharedMemoryTransport::send_gather(
+    const std::span<const std::span<const std::byte>> parts) {
+    if (role_ == Role::READER) {
+        control_.send_gather(parts);
+        return;
+    }
+
+    // Runs of small parts travel as one inline record; each large part goes
+    // through the ring. Order is preserved because the reader consumes
+    // records strictly in the order their headers arrive on the socket.
+    auto run_begin = parts.begin();
+    for (auto it = parts.begin(); it != parts.end(); ++it) {
+        if (it->size() >= GATHER_MIN_BYTES) {
+            send_inline({run_begin, it});
+            send_through_ring(*it);
+            run_begin = std::next(it);
+        }
+    }
+    send_inline({run_begin, parts.end()});
+}
+
+void SharedMemoryTransport::send_inline(
+    const std::span<const std::span<const std::byte>> parts) {
+    std::size_t record_size = 0;
+    for (const auto part : parts) {
+        record_size += part.size();
+    }
+    if (record_size == 0) {
+        return;
+    }
+
+    std::vector<std::span<const std::byte>> record;
+    record.reserve(parts.size() + 1);
+    record.emplace_back(std::as_bytes(std::span{&record_size, 1}));
+    record.insert(record.end(), parts.begin(), parts.end());
+    control_.send_gather(record);
+}
+
+void SharedMemoryTransport::send_through_ring(std::span<const std::byte> part) {
+    const auto piece_limit = std::max<std::size_t>(ring_.capacity() / 2, 1);
+    while (!part.empty()) {
+        const auto piece = part.first(std::min(part.size(), piece_limit));
+        wait_for_ring_space(piece.size());
+        ring_.push(piece);
+        // Published before the record header is sent, so the reader never
+        // sees a header for bytes that are not in the ring yet.
+        const auto header = piece.size() | SHM_RECORD_IN_RING;
+        control_.send(std::as_bytes(std::span{&header, 1}));
+        part = part.subspan(piece.size());
+    }
+}
+
+void SharedMemoryTransport::wait_for_ring_space(const std::size_t bytes) const {
+    // The reader frees space as it decodes, so this normally spins only
+    // briefly. The deadline restarts whenever the reader makes progress and
+    // only trips when it has stopped draining altogether (e.g. it hung).
+    auto free = ring_.free_bytes();
+    auto deadline = std::chrono::steady_clock::now() + timeout_;
+    while (free < bytes) {
+        std::this_thread::sleep_for(std::chrono::microseconds{50});
+        const auto now_free = ring_.free_bytes();
+        const auto now = std::chrono::steady_clock::now();
+        if (now_free != free) {
+            free = now_free;
+            deadline = now + timeout_;
+        } else if (now >= deadline) {
+            throw_socket_timeout_error("write");
+        }
+    }
+}
+
+std::size_t SharedMemoryTransport::receive(const std::span<std::byte> dst) {
+    if (role_ == Role::WRITER || dst.empty()) {
+        return control_.receive(dst);
+    }
+
+    if (record_remaining_ == 0) {
+        auto header = std::size_t{};
+        MessageDecoder{control_}.read(header);
+        record_in_ring_ = (header & SHM_RECORD_IN_RING) != 0;
+        record_remaining_ = header & ~SHM_RECORD_IN_RING;
+        if (record_remaining_ == 0 ||
+            (record_in_ring_ && record_remaining_ > ring_.readable_bytes())) {
+            record_remaining_ = 0;
+            throw MessageDecodeError{"shared-memory record out of step with "
+                                     "the ring"};
+        }
+    }
+
+    const auto want = std::min(dst.size(), record_remaining_);
+    auto got = want;
+    if (record_in_ring_) {
+        ring_.pop(dst.first(want));
+    } else {
+        got = control_.receive(dst.first(want));
+    }
+    record_remaining_ -= got;
+    return got;
+}
+
+bool SharedMemoryTransport::has_data() const {
+    if (role_ == Role::READER && record_remaining_ > 0 && record_in_ring_) {
+        return true;
+    }
+    return control_.has_data();
+}
+
+std::optional<SharedMemoryRing>
+answer_shared_memory_offer(ITransport& control, const std::string& name) {
+    std::optional<SharedMemoryRing> ring;
+    try {
+        ring = SharedMemoryRing::open(name);
+    } catch (const std::runtime_error&) {
+        // Declined below; the bridge keeps sending over the socket.
+    }
+    const auto answer = ring ? SHM_OFFER_ACCEPTED : SHM_OFFER_DECLINED;
+    control.send(std::as_bytes(std::span{&answer, 1}));
+    return ring;
+}
+
+bool read_shared_memory_answer(ITransport& control) {
+    auto answer = std::size_t{};
+    MessageDecoder{control}.read(answer);
+    return answer == SHM_OFFER_ACCEPTED;
+}
+
+} // namespace oid
@@ -0,0 +1,167 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef IPC_SHM_TRANSPORT_H_
+#define IPC_SHM_TRANSPORT_H_
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string>
+
+#include "transport.h"
+
+namespace oid {
+
+// Default size of the ring a bridge offers. Payloads larger than the ring are
+// streamed through it in pieces, so this bounds the mapping, not the buffer
+// size; it only needs to be large enough for writer and reader to overlap.
+constexpr std::size_t SHM_RING_BYTES = 64ULL * 1024ULL * 1024ULL;
+
+struct SharedMemoryRingHeader;
+
+// Single-producer/single-consumer byte ring in a POSIX shared-memory segment
+// (shm_open + mmap), shared by the bridge (producer) and the viewer
+// (consumer) on the same host. head/tail are monotonically increasing byte
+// counts kept in the segment itself, so neither side needs a syscall to hand
+// bytes over. The caller guarantees push() fits (free_bytes()) and pop() is
+// backed by published bytes (readable_bytes()).
+class SharedMemoryRing {
+  public:
+    // Producer: creates a fresh, uniquely named segment. The name stays
+    // linked until unlink() or destruction so the consumer can open it.
+    // Throws std::system_error if the segment cannot be created or mapped.
+    static SharedMemoryRing create(std::size_t capacity = SHM_RING_BYTES);
+
+    // Consumer: maps the segment a producer created under `name`. Throws
+    // std::system_error if it does not exist or cannot be mapped, and
+    // std::runtime_error if it is not an OID ring.
+    static SharedMemoryRing open(const std::string& name);
+
+    SharedMemoryRing(SharedMemoryRing&& other) noexcept;
+    SharedMemoryRing& operator=(SharedMemoryRing&& other) noexcept;
+    SharedMemoryRing(const SharedMemoryRing&) = delete;
+    SharedMemoryRing& operator=(const SharedMemoryRing&) = delete;
+    ~SharedMemoryRing() noexcept;
+
+    [[nodiscard]] const std::string& name() const;
+    [[nodiscard]] std::size_t capacity() const;
+
+    // Removes the segment's name (creator only; idempotent). Existing
+    // mappings stay valid, so once the peer has mapped the ring nothing is
+    // left behind in /dev/shm even if either process dies.
+    void unlink() noexcept;
+
+    [[nodiscard]] std::size_t free_bytes() const;
+    [[nodiscard]] std::size_t readable_bytes() const;
+    void push(std::span<const std::byte> src);
+    void pop(std::span<std::byte> dst);
+
+  private:
+    SharedMemoryRing(std::string name,
+                     void* mapping,
+                     std::size_t mapping_size,
+                     bool owns_name);
+
+    std::string name_;
+    void* mapping_{nullptr};
+    std::size_t mapping_size_{0};
+    SharedMemoryRingHeader* header_{nullptr};
+    std::byte* data_{nullptr};
+    bool owns_name_{false};
+};
+
+// ITransport that keeps `control` (the TCP socket) for framing and small
+// messages and moves large blocks through a SharedMemoryRing. The stream is
+// one-directional: the WRITER (bridge) wraps everything it sends in records,
+// the READER (viewer) unwraps them, and the opposite direction passes
+// straight through to `control` unchanged. A record is a std::size_t word
+// carrying the byte count, with its top bit set when the bytes sit at
+// the ring's tail rather than following on the socket.
+//
+// Blocks below GATHER_MIN_BYTES are sent inline; larger ones are pushed into
+// the ring in pieces of at most half its capacity, so the reader drains one
+// piece while the writer fills the next. A writer waiting for space throws
+// SocketTimeoutError once the reader has made no progress for `timeout`.
+//
+// A ring block is copied twice: into the ring by the writer, and out of it
+// into its destination by the reader. Neither copy is worth removing. The
+// reader cannot keep the bytes where they are, because the ring space is
+// reused for the next piece. A segment of its own for each payload, which
+// the reader would keep, costs more in page faults on both sides than the
+// copy it saves: 1.5-2.8 s per GiB, against 0.49 s for both ring copies.
+// And the writer cannot read the debuggee straight into ring space: it
+// sends from the I/O thread, after the debugger may have resumed it.
+//
+// LIFETIME: `control` is not owned and must outlive this transport.
+class SharedMemoryTransport final : public ITransport {
+  public:
+    enum class Role { WRITER, READER };
+
+    SharedMemoryTransport(
+        ITransport& control,
+        SharedMemoryRing ring,
+        Role role,
+        std::chrono::milliseconds timeout = std::chrono::seconds{5});
+
+    void send(std::span<const std::byte> data) override;
+    void
+    send_gather(std::span<const std::span<const std::byte>> parts) override;
+    std::size_t receive(std::span<std::byte> dst) override;
+    [[nodiscard]] bool has_data() const override;
+
+  private:
+    void send_inline(std::span<const std::span<const std::byte>> parts);
+    void send_through_ring(std::span<const std::byte> part);
+    void wait_for_ring_space(std::size_t bytes) const;
+
+    ITransport& control_;
+    SharedMemoryRing ring_;
+    Role role_;
+    std::chrono::milliseconds timeout_;
+    // READER: what is left of the record currently being consumed.
+    std::size_t record_remaining_{0};
+    bool record_in_ring_{false};
+};
+
+// Connect-time negotiation. The bridge creates a ring and passes its name to
+// the viewer it launches (`--shm NAME`); right after connecting, the viewer
+// maps it and answers on the socket with a single word before any message.
+// Either side falling back simply leaves the plain socket in use.
+
+// Viewer: maps the offered ring and answers the offer. Returns the ring on
+// acceptance, or std::nullopt after declining (e.g. the segment is gone).
+// Throws what control.send() throws.
+std::optional<SharedMemoryRing>
+answer_shared_memory_offer(ITransport& control, const std::string& name);
+
+// Bridge: reads the viewer's answer. True if the viewer mapped the ring;
+// throws SocketTimeoutError (via MessageDecoder) if no answer arrives.
+bool read_shared_memory_answer(ITransport& control);
+
+} // namespace oid
+
+#endif // IPC_SHM_TRANSPORT_H_
@@ -0,0 +1,147 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "symbol_list_delta.h"
+
+#include <algorithm>
+#include <string_view>
+#include <unordered_set>
+
+#include "message_exchange.h"
+
+namespace oid {
+
+namespace {
+
+using NameSet = std::unordered_set<std::string_view>;
+
+// The names of `symbols`, or nullopt if one is listed twice.
+std::optional<NameSet> name_set(const std::deque<std::string>& symbols) {
+    NameSet names;
+    names.reserve(symbols.size());
+    for (const auto& symbol : symbols) {
+        if (!names.insert(symbol).second) {
+            return std::nullopt;
+        }
+    }
+    return names;
+}
+
+} // namespace
+
+std::optional<SymbolListDelta>
+diff_symbol_lists(const std::deque<std::string>& before,
+                  const std::deque<std::string>& after) {
+    const auto before_names = name_set(before);
+    const auto after_names = name_set(after);
+    if (!before_names.has_value() || !after_names.has_value()) {
+        return std::nullopt;
+    }
+
+    SymbolListDelta delta;
+    for (const auto& symbol : before) {
+        if (!after_names->contains(symbol)) {
+            delta.removed.push_back(symbol);
+        }
+    }
+    // The names kept must come in the same order in both lists, or removing
+    // and inserting does not get from one to the other.
+    auto kept = before.begin();
+    for (std::size_t index = 0; index < after.size(); ++index) {
+        if (!before_names->contains(after[index])) {
+            delta.added.emplace_back(index, after[index]);
+            continue;
+        }
+        kept = std::find_if(kept, before.end(), [&](const auto& symbol) {
+            return after_names->contains(symbol);
+        });
+        if (kept == before.end() || *kept != after[index]) {
+            return std::nullopt;
+        }
+        ++kept;
+    }
+
+    if (!delta.empty() &&
+        delta.removed.size() + delta.added.size() >= after.size()) {
+        return std::nullopt;
+    }
+    return delta;
+}
+
+bool apply_symbol_list_delta(std::vector<std::string>& symbols,
+                             const SymbolListDelta& delta) {
+    const std::unordered_set<std::string_view> removed{delta.removed.begin(),
+                                                       delta.removed.end()};
+    std::vector<std::string> updated;
+    updated.reserve(symbols.size() + delta.added.size());
+    // One merge: the names kept, in order, with each addition dropped in as
+    // the list reaches its index.
+    auto kept = symbols.begin();
+    const auto take_kept = [&] {
+        while (kept != symbols.end() && removed.contains(*kept)) {
+            ++kept;
+        }
+        if (kept == symbols.end()) {
+            return false;
+        }
+        updated.push_back(*kept++);
+        return true;
+    };
+    for (const auto& [index, symbol] : delta.added) {
+        while (updated.size() < index) {
+            if (!take_kept()) {
+                return false;
+            }
+        }
+        if (index != updated.size()) {
+            return false;
+        }
+        updated.push_back(symbol);
+    }
+    for (; kept != symbols.end(); ++kept) {
+        if (!removed.contains(*kept)) {
+            updated.push_back(*kept);
+        }
+    }
+    symbols = std::move(updated);
+    return true;
+}
+
+void send_available_symbols_delta(ITransport& transport,
+                                  const SymbolListDelta& delta) {
+    MessageComposer message;
+    message.push(MessageType::SET_AVAILABLE_SYMBOLS_DELTA)
+        .push(delta.removed.size());
+    for (const auto& symbol : delta.removed) {
+        message.push(symbol);
+    }
+    message.push(delta.added.size());
+    for (const auto& [index, symbol] : delta.added) {
+        message.push(index).push(symbol);
+    }
+    message.send(transport);
+}
+
+} // namespace oid
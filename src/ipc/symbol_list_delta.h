@@ -0,0 +1,75 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef IPC_SYMBOL_LIST_DELTA_H_
+#define IPC_SYMBOL_LIST_DELTA_H_
+
+#include <cstddef>
+#include <deque>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "transport.h"
+
+namespace oid {
+
+// What turns one available-symbols list into the next, as a
+// SET_AVAILABLE_SYMBOLS_DELTA carries it: the names to drop, then the names
+// to insert, each at the index it has in the new list.
+struct SymbolListDelta {
+    std::vector<std::string> removed{};
+    // (index in the new list, name), by ascending index.
+    std::vector<std::pair<std::size_t, std::string>> added{};
+
+    [[nodiscard]] bool empty() const {
+        return removed.empty() && added.empty();
+    }
+
+    bool operator==(const SymbolListDelta&) const = default;
+};
+
+// The delta from `before` to `after`; empty if they are equal. nullopt if
+// no delta describes the change -- a name listed twice, or names both lists
+// hold that changed order -- or if it would not be smaller than `after`
+// itself, so sending the whole list is the better choice.
+[[nodiscard]] std::optional<SymbolListDelta>
+diff_symbol_lists(const std::deque<std::string>& before,
+                  const std::deque<std::string>& after);
+
+// Applies `delta` to `symbols`. Returns false, leaving `symbols` untouched,
+// if it does not fit them: an insertion index past the end of the list, or
+// additions out of index order.
+[[nodiscard]] bool apply_symbol_list_delta(std::vector<std::string>& symbols,
+                                           const SymbolListDelta& delta);
+
+// Sends `delta` as SET_AVAILABLE_SYMBOLS_DELTA.
+void send_available_symbols_delta(ITransport& transport,
+                                  const SymbolListDelta& delta);
+
+} // namespace oid
+
+#endif // IPC_SYMBOL_LIST_DELTA_H_
@@ -28,6 +28,7 @@
 
 #include <cstddef>
 #include <span>
+#include <vector>
 
 namespace oid {
 
@@ -35,10 +36,48 @@ class ITransport {
   public:
     virtual ~ITransport() = default;
     virtual void send(std::span<const std::byte> data) = 0;
+    // Sends `parts` back to back as one message, in order. The default
+    // flattens them into a single send(); transports that can hand a buffer
+    // sequence straight to the OS (writev) override it, so a large payload
+    // part reaches the socket without being copied into a staging frame.
+    virtual void send_gather(std::span<const std::span<const std::byte>> parts);
     virtual std::size_t receive(std::span<std::byte> dst) = 0;
     virtual bool has_data() const = 0;
 };
 
+inline void
+ITransport::send_gather(std::span<const std::span<const std::byte>> parts) {
+    std::size_t total = 0;
+    for (const auto part : parts) {
+        total += part.size();
+    }
+    std::vector<std::byte> frame;
+    frame.reserve(total);
+    for (const auto part : parts) {
+        frame.insert(frame.end(), part.begin(), part.end());
+    }
+    if (!frame.empty()) {
+        send(frame);
+    }
+}
+
+// Collects a composed message's bytes instead of sending them: to queue or
+// hand over a message as one frame, or to hash its encoding.
+class FrameCapture final : public ITransport {
+  public:
+    void send(const std::span<const std::byte> data) override {
+        frame.insert(frame.end(), data.begin(), data.end());
+    }
+    std::size_t receive(std::span<std::byte> /*dst*/) override {
+        return 0;
+    }
+    bool has_data() const override {
+        return false;
+    }
+
+    std::vector<std::byte> frame;
+};
+
 } // namespace oid
 
 #endif // IPC_TRANSPORT_H_
@@ -74,6 +74,7 @@
 #include "host/ui/panels/status_bar.h"
 #include "host/ui/panels/symbol_search_panel.h"
 #include "host/ui/panels/toolbar_panel.h"
+#include "host/ui/region_fetcher.h"
 #include "host/ui/shortcuts.h"
 #include "host/ui/stage_manager.h"
 #include "host/ui/svg_icon_cache.h"
@@ -390,6 +391,7 @@ struct FrameContext {
     oid::platform::SessionBridge& session_bridge;
     SettingsPersistence settings_persistence;
     oid::host::FileOpenQueue& file_open_queue;
+    oid::host::RegionFetcher& regions;
 #if !defined(__EMSCRIPTEN__)
     // Non-null only when OID_AGENT=1; see the construction site in main()
     // and the per-frame drain() call below. Native-only: the Emscripten
@@ -437,9 +439,9 @@ void poll_ipc_and_update_thumbnails(FrameContext& ctx) {
 }
 
 // Draws the menu bar and handles the frame's global keyboard shortcuts
-// (quit, go-to toggle, symbol-search focus). Returns whether the symbol
-// search box should claim focus this frame (draw_main_ui's search panel
-// acts on it).
+// (quit, go-to toggle, symbol-search focus, quick look in full). Returns
+// whether the symbol search box should claim focus this frame
+// (draw_main_ui's search panel acts on it).
 bool process_menu_and_shortcuts(const FrameContext& ctx) {
     bool request_quit = false;
     bool request_open = false;
@@ -497,6 +499,18 @@ bool process_menu_and_shortcuts(const FrameContext& ctx) {
             shortcut_mod, ImGui::IsKeyPressed(ImGuiKey_K, /*repeat=*/false))) {
         focus_symbol_search = true;
     }
+
+    // Ctrl+R (Cmd+R on macOS) asks the debugger for the selected quick
+    // look in full (see oid::host::is_quick_look()); the status bar says
+    // when there is one. The full buffer replaces it as any re-plot does.
+    if (oid::host::should_fire_ctrl_shortcut(
+            shortcut_mod, ImGui::IsKeyPressed(ImGuiKey_R, /*repeat=*/false)) &&
+        ctx.ui.has_selection()) {
+        if (const auto& record = ctx.model.at(ctx.ui.selected());
+            oid::host::is_quick_look(record)) {
+            ctx.ipc.request_full_plot(record.variable_name);
+        }
+    }
     return focus_symbol_search;
 }
 
@@ -669,6 +683,9 @@ void draw_main_ui(const FrameContext& ctx, const bool focus_symbol_search) {
         }
         if (oid::Stage* sel = ctx.stages.selected_stage(ctx.ui.selected());
             sel != nullptr) {
+            // Full-resolution tiles for a lazy plot's overview, asked for
+            // and drawn before the canvas renders this frame.
+            ctx.regions.update(ctx.ipc, ctx.model, ctx.ui.selected(), *sel);
             draw_canvas_pane(*ctx.canvas,
                              ctx.view,
                              *sel,
@@ -806,8 +823,13 @@ int main(int argc, char** argv) {
     // frontend adds on top. Defaults match the bridge's default listen port.
     // Unrecognized args (e.g. a stray "-style fusion" the bridge may still
     // pass on the Qt side) are ignored.
-    const auto [hostname, port, open_files, agent_debugger_pid] =
-        oid::host::parse_cli(argc, argv);
+    const auto [hostname,
+                port,
+                open_files,
+                agent_debugger_pid,
+                shm_name,
+                socket_path,
+                data_lanes] = oid::host::parse_cli(argc, argv);
     const oid::platform::Endpoint endpoint{hostname,
                                            static_cast<unsigned short>(port)};
 
@@ -848,10 +870,22 @@ int main(int argc, char** argv) {
     // bridge isn't listening yet (or ever), the transport just marks itself
     // disconnected and ipc.poll() below becomes a no-op each frame -- the
     // app still runs with an empty buffer list rather than failing to
-    // start.
-    const auto transport =
-        oid::platform::make_transport({endpoint.host, endpoint.port});
-    oid::host::IpcClient ipc{*transport, model};
+    // start. When the bridge offered a shared-memory ring (--shm), the
+    // native transport answers the offer right after connecting. A bridge on
+    // this host passes --socket, and the native transport connects there
+    // rather than to host:port. The data lanes it asks for with --lanes are
+    // connected the same way, and read from on threads of their own.
+    const oid::platform::TransportDeps transport_deps{
+        endpoint.host,
+        endpoint.port,
+        shm_name,
+        socket_path,
+        static_cast<std::size_t>(data_lanes)};
+    const auto transport = oid::platform::make_transport(transport_deps);
+    oid::host::IpcClient ipc{
+        *transport,
+        model,
+        oid::platform::connect_data_lanes(transport_deps, *transport)};
     oid::host::UiState ui{model};
 
     // Left pane (buffer list) width in screen points; set by apply_settings
@@ -908,8 +942,20 @@ int main(int argc, char** argv) {
             }
         };
     apply_settings(loaded);
+#if !defined(__EMSCRIPTEN__)
+    // Lets the bridge use the optional wire features this viewer decodes
+    // (see IpcClient::announce_capabilities()); an embedding host speaks the
+    // baseline protocol.
+    ipc.announce_capabilities();
+    // Socket reads and buffer decoding (FLOAT64 conversion included) move
+    // off the GL thread: a large plot no longer stalls rendering while it
+    // arrives, and ipc.poll() just applies what is already decoded.
+    // Non-native transports are driven by the host's event loop instead.
+    ipc.start_receiver();
+#endif
 
     oid::host::StageManager stages{canvas, model};
+    oid::host::RegionFetcher regions;
     // Buffer-list thumbnail icon cache; declared after
     // `canvas` (which it holds a reference to) and before the frame loop, so
     // it's destroyed -- deleting its cached GL textures -- before the GLFW
@@ -1090,7 +1136,8 @@ int main(int argc, char** argv) {
         session_bridge,
         SettingsPersistence{
             seen_this_session, prev_buffers, saver, settings_backend.scope()},
-        file_open_queue};
+        file_open_queue,
+        regions};
 #if !defined(__EMSCRIPTEN__)
     ctx.agent = agent_server ? &*agent_server : nullptr;
 #endif
@@ -27,24 +27,42 @@
 
 #include <cstdint>
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <deque>
 #include <functional>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <span>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "debuggerinterface/preprocessor_directives.h"
 #include "debuggerinterface/python_native_interface.h"
 #include "ipc/asio_transport.h"
+#include "ipc/buffered_transport.h"
 #include "ipc/message_exchange.h"
+#include "ipc/outbound_queue.h"
+#include "ipc/payload_bytes.h"
+#include "ipc/pixel_region.h"
+#include "ipc/plot_buffer_sender.h"
+#include "ipc/raw_data_decode.h"
+#include "ipc/symbol_list_delta.h"
+#if defined(OID_HAS_SHM_TRANSPORT)
+#include "ipc/shm_transport.h"
+#endif
 #include "system/process/process.h"
 #include "system/process/process_id.h"
+#include "system/process/process_memory.h"
 
 struct PlotBufferParams {
     std::string variable_name_str;
@@ -71,6 +89,41 @@ struct PlotBufferRequestMessage final : UiMessage {
     std::string buffer_name{};
 };
 
+struct ViewerCapabilitiesMessage final : UiMessage {
+    int capabilities{};
+};
+
+struct BufferRemovedMessage final : UiMessage {
+    std::string buffer_name{};
+};
+
+struct FullPlotRequestMessage final : UiMessage {
+    std::string buffer_name{};
+};
+
+struct RegionRequest {
+    std::string buffer_name{};
+    oid::PixelRegion region{};
+};
+
+struct RegionRequestMessage final : UiMessage {
+    RegionRequest request{};
+};
+
+// A plot on its way to the I/O thread. Its pixels stay where the debugger
+// read them, held by `view` (see OidBridge::share_with_io()), or in `read`
+// when the bridge read them itself.
+struct PlotJob {
+    oid::PlotBufferHeader header{};
+    std::span<const std::byte> pixels{};
+    std::shared_ptr<Py_buffer> view{};
+    std::shared_ptr<const oid::PayloadBytes> read{};
+    bool compress{};
+    int preview_factor{};
+    // Whether its strips go over the data lanes (see send_plot()).
+    bool lanes{};
+};
+
 class PyGILRAII {
   public:
     PyGILRAII() {
@@ -91,12 +144,47 @@ class PyGILRAII {
     PyGILState_STATE _py_gil_state{};
 };
 
+// Lets the debugger's other Python threads run while this one, holding the
+// GIL, waits on something that needs no Python.
+class PyGILReleaseRAII {
+  public:
+    PyGILReleaseRAII() : _py_thread_state{PyEval_SaveThread()} {}
+
+    PyGILReleaseRAII(const PyGILReleaseRAII&) = delete;
+    PyGILReleaseRAII(const PyGILReleaseRAII&&) = delete;
+
+    PyGILReleaseRAII& operator=(const PyGILReleaseRAII&) = delete;
+    PyGILReleaseRAII& operator=(const PyGILReleaseRAII&&) = delete;
+
+    ~PyGILReleaseRAII() noexcept {
+        PyEval_RestoreThread(_py_thread_state);
+    }
+
+  private:
+    PyThreadState* _py_thread_state{};
+};
+
+// How long the I/O thread gives the rest of a message whose header has
+// arrived.
+constexpr auto IO_READ_TIMEOUT = std::chrono::seconds{5};
+
 class OidBridge {
   public:
     explicit OidBridge(std::function<int(const char*)> plot_callback)
         : plot_callback_{std::move(plot_callback)} {}
 
-    bool start() {
+    // Launches the window without waiting for it: it creates its GL context
+    // and connects while the debugger goes on, and the start() that follows
+    // only has to adopt the connection. A window launched this way and not
+    // adopted yet is not launched again.
+    void launch() {
+        if (pending_launch_.has_value() && ui_proc_.isRunning()) {
+            return;
+        }
+        // Back to this thread until the window is settled: the checks below
+        // probe the socket.
+        stop_io();
+
         // The user may have closed a previous window: its process is gone and
         // its socket is dead. Drop the stale transport so wait_for_client()
         // below accepts the fresh window's connection; otherwise client_
@@ -106,18 +194,31 @@ class OidBridge {
         // data.
         if (client_ != nullptr &&
             (!ui_proc_.isRunning() || !client_->is_connected())) {
+#if defined(OID_HAS_SHM_TRANSPORT)
+            shm_client_.reset();
+#endif
+            inbound_.reset();
+            lanes_.clear();
             client_.reset();
+            // The fresh window starts empty, and announces its own
+            // capabilities.
+            sent_fingerprints_.clear();
+            sent_symbols_.reset();
+            lazy_plots_.clear();
+            region_requests_.clear();
+            full_requests_.clear();
+            received_messages_.clear();
+            inbox_.clear();
+            window_capabilities_ = 0;
         }
-        // acceptor_ already listens on an ephemeral port (all interfaces)
-        // as part of its construction.
-        const auto portStdString = std::to_string(acceptor_.port());
-
-        // The viewer accepts --host/--hostname/-h for the host, --port/-p
-        // for the port, and -o/--open to open files. Process::start() takes
-        // a non-const reference (it builds a mutable argv from the strings'
-        // data()), so command cannot be const here.
-        std::vector<std::string> command = {
-            oid_path_ + "/oidwindow", "-p", portStdString};
+        // The viewer accepts --socket for a Unix-domain socket, --host/
+        // --hostname/-h for the host, --port/-p for the port, --lanes for
+        // the data lanes to connect, and -o/--open to open files.
+        // Process::start() takes a non-const reference (it builds a mutable
+        // argv from the strings' data()), so command cannot be const here.
+        std::vector<std::string> command = {oid_path_ + "/oidwindow"};
+        listen(command);
+        const auto lanes = request_data_lanes(command);
 
         // Passed explicitly (not via OID_AGENT env, which the child already
         // inherits) so a standalone window launched outside the bridge never
@@ -125,15 +226,44 @@ class OidBridge {
         command.emplace_back("--agent-debugger-pid");
         command.emplace_back(std::to_string(oid::system::current_process_id()));
 
+        auto pending = PendingLaunch{.lanes = lanes};
+#if defined(OID_HAS_SHM_TRANSPORT)
+        pending.shm_offer = offer_shared_memory(command);
+#endif
+
         ui_proc_.start(command);
+        pending_launch_ = std::move(pending);
+    }
+
+    bool start() {
+        launch();
 
         ui_proc_.waitForStart();
 
         wait_for_client();
 
+        auto launched = std::move(*pending_launch_);
+        pending_launch_.reset();
+#if defined(OID_HAS_SHM_TRANSPORT)
+        if (launched.shm_offer.has_value()) {
+            negotiate_shared_memory(std::move(*launched.shm_offer));
+        }
+#endif
+        accept_data_lanes(launched.lanes);
+
+        start_io();
+
         return client_ != nullptr;
     }
 
+    // The debuggee is gone, but the window stays for the next one: forget
+    // the plots whose pixels only the old one could serve.
+    void end_session() {
+        lazy_plots_.clear();
+        region_requests_.clear();
+        full_requests_.clear();
+    }
+
     void set_path(const std::string_view& oid_path) {
         oid_path_ = oid_path;
     }
@@ -160,18 +290,43 @@ class OidBridge {
         return {};
     }
 
-    void
-    set_available_symbols(const std::deque<std::string>& available_vars) const {
+    void set_available_symbols(std::deque<std::string> available_vars) {
         assert(client_ != nullptr);
 
+        // A window that takes deltas gets only what changed since the last
+        // list, and nothing at all for a stop in the same scope. Deltas
+        // build on each other, so then no list may replace another in the
+        // queue.
+        const auto deltas =
+            (window_capabilities_ & oid::CAPABILITY_SYMBOL_DELTAS) != 0;
+        if (deltas && sent_symbols_.has_value()) {
+            if (const auto delta =
+                    oid::diff_symbol_lists(*sent_symbols_, available_vars);
+                delta.has_value()) {
+                if (!delta->empty()) {
+                    auto capture = oid::FrameCapture{};
+                    oid::send_available_symbols_delta(capture, *delta);
+                    queue_frame(std::move(capture.frame));
+                }
+                sent_symbols_ = std::move(available_vars);
+                return;
+            }
+        }
+
         auto message_composer = oid::MessageComposer{};
         message_composer.push(oid::MessageType::SET_AVAILABLE_SYMBOLS)
             .push(available_vars);
-        send_to_window(message_composer);
+        // Otherwise only the latest list matters.
+        send_to_window(message_composer, deltas ? "" : "symbols");
+        sent_symbols_ = std::move(available_vars);
     }
 
     void run_event_loop() {
-        try_read_incoming_messages(static_cast<int>(1000.0 / 5.0));
+        // Called when the notifier said there is something to act on, which
+        // is then already in the inbox; a caller polling instead gives the
+        // window a moment.
+        try_read_incoming_messages(
+            request_notifier_ ? 0 : static_cast<int>(1000.0 / 5.0));
 
         auto plot_request_message = std::make_unique<UiMessage>();
         while ((plot_request_message = try_get_stored_message(
@@ -188,55 +343,472 @@ class OidBridge {
                           << msg->buffer_name << "'" << std::endl;
             }
         }
+
+        while (!region_requests_.empty()) {
+            serve_region(region_requests_.front());
+            region_requests_.pop_front();
+        }
+
+        while (!full_requests_.empty()) {
+            upgrade_quick_look(full_requests_.front());
+            full_requests_.pop_front();
+        }
+
+        release_retired_views();
     }
 
-    void plot_buffer(const PlotBufferParams& params) const {
-        const auto& variable_name_str = params.variable_name_str;
-        const auto& display_name_str = params.display_name_str;
-        const auto& pixel_layout_str = params.pixel_layout_str;
-        const auto transpose_buffer = params.transpose_buffer;
-        const auto buff_width = params.buff_width;
-        const auto buff_height = params.buff_height;
-        const auto buff_channels = params.buff_channels;
-        const auto buff_stride = params.buff_stride;
-        const auto buff_type = params.buff_type;
-        const auto& buffer = params.buffer;
+    // Queues the plot for the I/O thread (see send_plot()), replacing an
+    // older plot of the same name still waiting there. params.buffer lies in
+    // `view`, which the I/O thread holds on to instead of a copy.
+    void plot_buffer(const PlotBufferParams& params, oid::PyBufferView view) {
+        assert(client_ != nullptr);
+
+        release_retired_views();
+        lazy_plots_.erase(params.variable_name_str);
+        const auto job = std::make_shared<const PlotJob>(PlotJob{
+            .header = header_of(params),
+            .pixels = params.buffer,
+            .view = share_with_io(std::move(view)),
+            .read = {},
+            .compress = compress_plots(),
+            .preview_factor = preview_factor(params.buffer.size()),
+            .lanes = use_data_lanes()});
+        queue_outbound([this, job] { send_plot(*job); },
+                       job->pixels.size(),
+                       plot_key(params.variable_name_str));
+    }
 
+    // Plots the buffer at `address` in the debuggee, process `pid`, reading
+    // it without the debugger (see read_debuggee_buffer()), or only every
+    // Nth row of it for a quick look (see plot_quick_look()) where that
+    // applies. Returns false, plotting nothing, if it cannot be read.
+    [[nodiscard]] bool plot_debuggee_buffer(const PlotBufferParams& params,
+                                            const long pid,
+                                            const std::uint64_t address) {
         assert(client_ != nullptr);
 
-        auto message_composer = oid::MessageComposer{};
-        message_composer.push(oid::MessageType::PLOT_BUFFER_CONTENTS)
-            .push(variable_name_str)
-            .push(display_name_str)
-            .push(pixel_layout_str)
-            .push(transpose_buffer)
-            .push(buff_width)
-            .push(buff_height)
-            .push(buff_channels)
-            .push(buff_stride)
-            .push(buff_type)
-            .push(buffer);
-        send_to_window(message_composer);
+        const auto size = oid::padded_payload_size(params.buff_width,
+                                                   params.buff_height,
+                                                   params.buff_channels,
+                                                   params.buff_stride,
+                                                   params.buff_type);
+        if (const auto factor = quick_look_factor(size.value_or(0));
+            factor > 1) {
+            return plot_quick_look(params, pid, address, factor);
+        }
+        return read_debuggee_buffer(header_of(params), pid, address);
+    }
+
+    // Plots a buffer too large to ship (see region_fetch_min_bytes()) as an
+    // overview read from `address` in the debuggee. The window then asks for
+    // the full-resolution regions it shows, served by run_event_loop() from
+    // the same address until the buffer is plotted again or removed.
+    void plot_lazy_buffer(const PlotBufferParams& params,
+                          const std::uint64_t address) {
+        assert(client_ != nullptr);
+
+        auto header = header_of(params);
+        lazy_plots_.erase(params.variable_name_str);
+        // Read here, on the debugger's thread, and only sent by the I/O
+        // thread.
+        auto overview = oid::FrameCapture{};
+        const auto factor = oid::overview_factor(header.width, header.height);
+        if (!oid::send_plot_buffer_overview(overview,
+                                            header,
+                                            factor,
+                                            false,
+                                            debuggee_reader(address))) {
+            std::cerr << "[OpenImageDebugger] could not read '"
+                      << params.variable_name_str
+                      << "' from the debuggee; plot dropped" << std::endl;
+            return;
+        }
+        lazy_plots_.insert_or_assign(
+            params.variable_name_str,
+            LazyPlot{.header = std::move(header),
+                     .address = address,
+                     .pid = std::nullopt});
+        queue_overview(params.variable_name_str, std::move(overview));
+    }
+
+    // Frames the plots of one debugger stop (see oid::send_plot_batch_begin)
+    // for a window that takes them; every begin_plot_batch() must be
+    // followed by end_plot_batch().
+    void begin_plot_batch() {
+        batch_open_ =
+            (window_capabilities_ & oid::CAPABILITY_PLOT_BATCHES) != 0;
+        if (batch_open_) {
+            send_batch_marker(oid::send_plot_batch_begin);
+        }
+    }
+
+    void end_plot_batch() {
+        if (std::exchange(batch_open_, false)) {
+            send_batch_marker(oid::send_plot_batch_end);
+        }
+    }
+
+    // Reads debuggee memory for lazy plots: fills the span from the given
+    // address, returning false if it cannot be read.
+    void set_memory_reader(
+        std::function<bool(std::uint64_t, std::span<std::byte>)> reader) {
+        memory_reader_ = std::move(reader);
+    }
+
+    // Calls `notifier`, with the GIL, from a thread of its own whenever the
+    // I/O thread receives something run_event_loop() acts on, so that the
+    // debugger need not poll. Needs the GIL.
+    void set_request_notifier(std::function<void()> notifier) {
+        stop_notifier();
+        request_notifier_ = std::move(notifier);
+        if (request_notifier_) {
+            notifier_stop_ = false;
+            notifier_thread_ = std::thread{[this] { notify_loop(); }};
+        }
+    }
+
+    // Size from which a buffer should be plotted lazily, through
+    // plot_lazy_buffer(); 0 while the window cannot fetch regions or there
+    // is no memory reader to serve them.
+    [[nodiscard]] std::size_t region_fetch_min_bytes() const {
+        const bool supported =
+            (window_capabilities_ & oid::CAPABILITY_REGION_FETCH) != 0;
+        return supported && memory_reader_ ? oid::LAZY_PLOT_MIN_BYTES : 0;
+    }
+
+    // Target size of one row strip sent by plot_buffer(); 0 sends every
+    // buffer as a single message.
+    void set_plot_chunk_bytes(const std::size_t chunk_bytes) {
+        plot_chunk_bytes_ = chunk_bytes;
+    }
+
+    // Whether plot strips may be sent compressed to a window that supports
+    // it (see compress_plots()).
+    void set_plot_compression(const bool enabled) {
+        plot_compression_ = enabled;
+    }
+
+    // Data lanes (see oid::DataLanes) asked of the next window launched; 0
+    // sends every strip over the control connection.
+    void set_plot_data_lanes(const std::size_t lanes) {
+        plot_data_lanes_ = std::min(lanes, oid::MAX_DATA_LANES);
+    }
+
+    // Decimation of quick looks (see ipc/pixel_region.h): buffers the
+    // bridge reads itself are plotted with only every `factor`-th pixel of
+    // every `factor`-th row, until the window asks for one in full. 1, the
+    // default, plots them in full.
+    void set_quick_look_factor(const int factor) {
+        quick_look_factor_ = std::max(1, factor);
     }
 
     ~OidBridge() noexcept {
+        stop_notifier();
         ui_proc_.kill();
+        stop_io();
+        release_retired_views();
     }
 
   private:
+    // What a window launched by launch() still needs from start().
+    struct PendingLaunch {
+        std::size_t lanes{};
+#if defined(OID_HAS_SHM_TRANSPORT)
+        std::optional<oid::SharedMemoryRing> shm_offer{};
+#endif
+    };
+
     oid::Process ui_proc_{};
-    // Declaration order matters: acceptor_ must outlive client_ (the
-    // AsioTransport returned by acceptor_.accept() references the
-    // acceptor's io_context), and members are destroyed in reverse
-    // declaration order.
-    oid::AsioAcceptor acceptor_{};
+    std::optional<PendingLaunch> pending_launch_{};
+    // Declaration order matters: the acceptors must outlive client_ (the
+    // AsioTransport returned by accept() references the acceptor's
+    // io_context), and members are destroyed in reverse declaration order.
+    // Both are created by the first start(), and at most one of them.
+#if defined(OID_HAS_LOCAL_SOCKET_TRANSPORT)
+    std::unique_ptr<oid::AsioLocalAcceptor> local_acceptor_{};
+#endif
+    std::unique_ptr<oid::AsioAcceptor> acceptor_{};
     std::unique_ptr<oid::AsioTransport> client_{};
+    // Connections the window opened besides client_ for plot strips only
+    // (see accept_data_lanes()); written to by the I/O thread alone.
+    std::vector<std::unique_ptr<oid::AsioTransport>> lanes_{};
+    // Fence of the last transfer sent over lanes_; I/O thread only.
+    std::uint64_t lane_fence_{};
+    // Every read of client_ goes through inbound_, which reads ahead so that
+    // decoding a message does not take a receive per field.
+    std::unique_ptr<oid::BufferedTransport> inbound_{};
+#if defined(OID_HAS_SHM_TRANSPORT)
+    // Outbound path once the window accepted a shared-memory ring; it reads
+    // and writes through client_, so it is declared (and destroyed) after it.
+    std::unique_ptr<oid::SharedMemoryTransport> shm_client_{};
+#endif
     std::string oid_path_{};
+    std::size_t plot_chunk_bytes_{oid::DEFAULT_PLOT_CHUNK_BYTES};
+    bool plot_compression_{true};
+    std::size_t plot_data_lanes_{oid::default_data_lanes()};
+    int quick_look_factor_{1};
+    // CAPABILITY_* mask from the window's VIEWER_CAPABILITIES; none until
+    // it arrives.
+    int window_capabilities_{};
+    // Whether begin_plot_batch() sent a PLOT_BUFFER_BATCH_BEGIN still to be
+    // closed.
+    bool batch_open_{};
 
     std::function<int(const char*)> plot_callback_{};
 
     std::map<oid::MessageType, std::unique_ptr<UiMessage>> received_messages_{};
 
+    // Fingerprint of the last plot sent under each name, while the window
+    // is known to hold it.
+    std::map<std::string, oid::PlotFingerprint, std::less<>>
+        sent_fingerprints_{};
+
+    // The last available-symbols list sent to the window, which
+    // SET_AVAILABLE_SYMBOLS_DELTA edits.
+    std::optional<std::deque<std::string>> sent_symbols_{};
+
+    struct LazyPlot {
+        oid::PlotBufferHeader header{};
+        std::uint64_t address{};
+        // The debuggee's, for a quick look: its regions are read without
+        // the debugger, and it can be plotted in full.
+        std::optional<long> pid{};
+    };
+
+    // Buffers plotted through plot_lazy_buffer() or plot_quick_look(), by
+    // name, while their regions can still be served.
+    std::map<std::string, LazyPlot, std::less<>> lazy_plots_{};
+
+    // Region requests are queued rather than stored in received_messages_,
+    // which keeps only the latest message of each type: the window asks for
+    // several tiles at once. So are the quick looks it asks for in full.
+    std::deque<RegionRequest> region_requests_{};
+    std::deque<std::string> full_requests_{};
+
+    std::function<bool(std::uint64_t, std::span<std::byte>)> memory_reader_{};
+
+    // See set_request_notifier(). wake_pending_ is set by wake_debugger()
+    // and cleared by notifier_thread_ as it calls request_notifier_, so a
+    // burst of requests costs the debugger one run_event_loop().
+    std::function<void()> request_notifier_{};
+    std::thread notifier_thread_{};
+    std::mutex wake_mutex_{};
+    std::condition_variable wake_ready_{};
+    bool wake_pending_{};
+    bool notifier_stop_{};
+
+    // Once the window is settled, all socket I/O happens on io_thread_ (see
+    // io_loop()): it sends what outbound_queue_ holds and decodes what the
+    // window sends into inbox_, which the debugger's thread applies in
+    // try_read_incoming_messages(). sent_fingerprints_ then belongs to the
+    // I/O thread; the rest of the state above to the debugger's thread.
+    std::unique_ptr<oid::OutboundQueue> outbound_queue_{};
+    std::thread io_thread_{};
+    std::atomic<bool> io_stop_{false};
+    std::mutex inbox_mutex_{};
+    std::condition_variable inbox_ready_{};
+    std::deque<std::pair<oid::MessageType, std::unique_ptr<UiMessage>>>
+        inbox_{};
+
+    // Views of plotted pixels that the I/O thread is done with, waiting for
+    // the GIL to be released (see share_with_io()).
+    std::mutex retired_views_mutex_{};
+    std::vector<oid::PyBufferView> retired_views_{};
+
+    [[nodiscard]] static oid::PlotBufferHeader
+    header_of(const PlotBufferParams& params) {
+        return oid::PlotBufferHeader{.variable_name = params.variable_name_str,
+                                     .display_name = params.display_name_str,
+                                     .pixel_layout = params.pixel_layout_str,
+                                     .transpose = params.transpose_buffer,
+                                     .width = params.buff_width,
+                                     .height = params.buff_height,
+                                     .channels = params.buff_channels,
+                                     .stride = params.buff_stride,
+                                     .type = params.buff_type};
+    }
+
+    // Reads the buffer at `address` through memory_reader_, at offsets from
+    // its first byte.
+    [[nodiscard]] oid::PixelReader
+    debuggee_reader(const std::uint64_t address) const {
+        return [this, address](const std::size_t offset,
+                               const std::span<std::byte> out) {
+            return memory_reader_ && memory_reader_(address + offset, out);
+        };
+    }
+
+    // Reads a lazy plot's pixels without the debugger where it has the
+    // debuggee's pid, through debuggee_reader() otherwise.
+    [[nodiscard]] oid::PixelReader lazy_reader(const LazyPlot& lazy) const {
+        if (!lazy.pid.has_value()) {
+            return debuggee_reader(lazy.address);
+        }
+        return [this, pid = *lazy.pid, address = lazy.address](
+                   const std::size_t offset, const std::span<std::byte> out) {
+            return oid::system::read_process_memory(
+                       pid, address + offset, out, 1) ||
+                   debuggee_reader(address)(offset, out);
+        };
+    }
+
+    // Decimation of a quick look at a buffer of `bytes`; 1 if it is to be
+    // plotted in full.
+    [[nodiscard]] int quick_look_factor(const std::size_t bytes) const {
+        const bool supported =
+            (window_capabilities_ & oid::CAPABILITY_QUICK_LOOK) != 0;
+        return supported && oid::quick_look_size(bytes) ? quick_look_factor_
+                                                        : 1;
+    }
+
+    // Reads the buffer `header` describes at `address` in process `pid`
+    // with oid::system::read_process_memory(), in parallel chunks and with
+    // the GIL released, into the block the I/O thread then sends from --
+    // one outside the payload pool, so the debugger's memory goes back to
+    // the system once the plot is sent. Where that cannot read it,
+    // memory_reader_ does. Returns false, plotting nothing, if neither can.
+    [[nodiscard]] bool read_debuggee_buffer(oid::PlotBufferHeader header,
+                                            const long pid,
+                                            const std::uint64_t address) {
+        const auto size = oid::padded_payload_size(header.width,
+                                                   header.height,
+                                                   header.channels,
+                                                   header.stride,
+                                                   header.type);
+        if (!size.has_value() || oid::exceeds_max_buffer_bytes(*size)) {
+            return false;
+        }
+        auto pixels = std::make_shared<oid::PayloadBytes>(
+            oid::PayloadBytes::unpooled(*size));
+        auto read = false;
+        {
+            const auto py_gil_release = PyGILReleaseRAII{};
+            read = oid::system::read_process_memory(pid, address, *pixels);
+        }
+        // E.g. a debuggee the debugger attached to through a server, which
+        // this process may not trace itself.
+        if (!read && !debuggee_reader(address)(0, *pixels)) {
+            return false;
+        }
+
+        release_retired_views();
+        lazy_plots_.erase(header.variable_name);
+        auto key = plot_key(header.variable_name);
+        const auto job = std::make_shared<const PlotJob>(
+            PlotJob{.header = std::move(header),
+                    .pixels = *pixels,
+                    .view = {},
+                    .read = std::move(pixels),
+                    .compress = compress_plots(),
+                    .preview_factor = preview_factor(*size),
+                    .lanes = use_data_lanes()});
+        queue_outbound(
+            [this, job] { send_plot(*job); }, *size, std::move(key));
+        return true;
+    }
+
+    // Plots the buffer at `address` in process `pid` as a quick look: an
+    // overview, as of a lazy plot, of every `factor`-th pixel of every
+    // `factor`-th row, which are all that is read -- with one scatter read
+    // (see oid::system::read_process_rows()) where it can be, through
+    // memory_reader_ otherwise. The window fetches regions of it as of a
+    // lazy plot, and may ask for all of it (see upgrade_quick_look()).
+    [[nodiscard]] bool plot_quick_look(const PlotBufferParams& params,
+                                       const long pid,
+                                       const std::uint64_t address,
+                                       const int factor) {
+        auto header = header_of(params);
+        const auto step = static_cast<std::size_t>(factor);
+        const auto pixel_bytes = static_cast<std::size_t>(header.channels) *
+                                 oid::type_size(header.type);
+        const auto row_bytes =
+            static_cast<std::size_t>(header.width) * pixel_bytes;
+        const auto row_step =
+            static_cast<std::uint64_t>(header.stride) * pixel_bytes * step;
+        const auto sampled_rows =
+            (static_cast<std::size_t>(header.height) + step - 1) / step;
+        std::vector<std::byte> rows(sampled_rows * row_bytes);
+        auto read = false;
+        {
+            const auto py_gil_release = PyGILReleaseRAII{};
+            read = oid::system::read_process_rows(
+                pid, address, row_step, row_bytes, rows);
+        }
+
+        auto overview = oid::FrameCapture{};
+        const auto sent = read ? oid::send_plot_buffer_overview_rows(
+                                     overview, header, factor, true, rows)
+                               : oid::send_plot_buffer_overview(
+                                     overview,
+                                     header,
+                                     factor,
+                                     true,
+                                     debuggee_reader(address));
+        if (!sent) {
+            return false;
+        }
+        release_retired_views();
+        lazy_plots_.insert_or_assign(
+            params.variable_name_str,
+            LazyPlot{.header = std::move(header),
+                     .address = address,
+                     .pid = pid});
+        queue_overview(params.variable_name_str, std::move(overview));
+        return true;
+    }
+
+    // Answers a PLOT_BUFFER_FULL_REQUEST: plots the quick look `name` in
+    // full, read from where its overview was. Lazy plots, too large to ship,
+    // stay as they are.
+    void upgrade_quick_look(const std::string& name) {
+        const auto lazy = lazy_plots_.find(name);
+        if (lazy == lazy_plots_.end() || !lazy->second.pid.has_value()) {
+            return;
+        }
+        if (!read_debuggee_buffer(lazy->second.header,
+                                  *lazy->second.pid,
+                                  lazy->second.address)) {
+            std::cerr << "[OpenImageDebugger] could not read '" << name
+                      << "' from the debuggee in full" << std::endl;
+        }
+    }
+
+    // Queues an overview composed on the debugger's thread for the I/O
+    // thread to send as the latest plot of `name`.
+    void queue_overview(const std::string& name, oid::FrameCapture overview) {
+        const auto bytes = overview.frame.size();
+        queue_outbound(
+            [this,
+             name,
+             frame = std::make_shared<const std::vector<std::byte>>(
+                 std::move(overview.frame))] {
+                sent_fingerprints_.erase(name);
+                send_frame(*frame);
+            },
+            bytes,
+            plot_key(name));
+    }
+
+    void serve_region(const RegionRequest& request) {
+        // A buffer plotted again in full, or removed, since the window asked
+        // has no regions to serve; the window drops its tiles as well.
+        const auto lazy = lazy_plots_.find(request.buffer_name);
+        if (lazy == lazy_plots_.end()) {
+            return;
+        }
+        auto region = oid::FrameCapture{};
+        if (!oid::send_plot_buffer_region(region,
+                                          lazy->second.header,
+                                          request.region,
+                                          lazy_reader(lazy->second))) {
+            std::cerr << "[OpenImageDebugger] could not read a region of '"
+                      << request.buffer_name << "' from the debuggee"
+                      << std::endl;
+            return;
+        }
+        queue_frame(std::move(region.frame));
+    }
+
     std::unique_ptr<UiMessage>
     try_get_stored_message(const oid::MessageType& msg_type) {
         if (const auto find_msg_handler = received_messages_.find(msg_type);
@@ -249,17 +821,124 @@ class OidBridge {
         return nullptr;
     }
 
-    // Sends a composed message to the UI window, tolerating a dead peer: the
-    // user can close the window at any moment, and a failed send must never
-    // let an exception cross the extern "C" bridge API into the debugger's
-    // Python interpreter -- libc++abi would terminate the whole debugger.
-    // The message is dropped; the next debugger stop relaunches the window
-    // (see start()'s stale-client reset). Caught as the base
-    // std::runtime_error for the same shared-library visibility reason as in
-    // try_read_incoming_messages below.
-    void send_to_window(const oid::MessageComposer& message_composer) const {
+    // Queues a composed message for the window. Only the latest message
+    // queued under a non-empty `key` is sent if several wait at once.
+    void send_to_window(const oid::MessageComposer& message_composer,
+                        const std::string& key = {}) {
+        auto capture = oid::FrameCapture{};
+        message_composer.send(capture);
+        queue_frame(std::move(capture.frame), key);
+    }
+
+    // Queues a batch marker the way send_to_window() queues a message.
+    void send_batch_marker(void (*send)(oid::ITransport&)) {
+        auto capture = oid::FrameCapture{};
+        send(capture);
+        queue_frame(std::move(capture.frame));
+    }
+
+    void queue_frame(std::vector<std::byte> frame,
+                     const std::string& key = {}) {
+        const auto bytes = frame.size();
+        queue_outbound(
+            [this,
+             frame = std::make_shared<const std::vector<std::byte>>(
+                 std::move(frame))] { send_frame(*frame); },
+            bytes,
+            key);
+    }
+
+    // Hands `send` to the I/O thread; dropped without a window. Waits,
+    // without the GIL, while the window is behind by a whole byte budget.
+    void queue_outbound(oid::OutboundQueue::Send send,
+                        const std::size_t bytes,
+                        const std::string& key = {}) {
+        if (outbound_queue_ == nullptr) {
+            return;
+        }
+        if (outbound_queue_->try_push(send, bytes, key)) {
+            return;
+        }
+        const auto py_gil_release = PyGILReleaseRAII{};
+        outbound_queue_->push(std::move(send), bytes, key);
+    }
+
+    // Shares a view with the I/O thread, which never takes the GIL that
+    // PyBuffer_Release() needs: whichever thread drops the last reference
+    // leaves the view to release_retired_views() instead, which the next
+    // plot or run_event_loop() calls. The debugger is not woken for it: it
+    // only runs for the window's requests.
+    std::shared_ptr<Py_buffer> share_with_io(oid::PyBufferView view) {
+        return {view.release(), [this](Py_buffer* const retired) {
+                    const std::scoped_lock lock(retired_views_mutex_);
+                    retired_views_.emplace_back(retired);
+                }};
+    }
+
+    // Any thread: has request_notifier_ called, once for everything woken
+    // for since its last call.
+    void wake_debugger() {
+        {
+            const std::scoped_lock lock(wake_mutex_);
+            wake_pending_ = true;
+        }
+        wake_ready_.notify_one();
+    }
+
+    void notify_loop() {
+        auto lock = std::unique_lock{wake_mutex_};
+        while (true) {
+            wake_ready_.wait(
+                lock, [this] { return wake_pending_ || notifier_stop_; });
+            if (notifier_stop_) {
+                return;
+            }
+            wake_pending_ = false;
+            lock.unlock();
+            {
+                const auto py_gil_raii = PyGILRAII{};
+                request_notifier_();
+            }
+            lock.lock();
+        }
+    }
+
+    // Needs the GIL, which it lets go of while the notifier finishes a call
+    // that may be waiting for it.
+    void stop_notifier() {
+        if (!notifier_thread_.joinable()) {
+            return;
+        }
+        {
+            const std::scoped_lock lock(wake_mutex_);
+            notifier_stop_ = true;
+        }
+        wake_ready_.notify_one();
+        const auto py_gil_release_raii = PyGILReleaseRAII{};
+        notifier_thread_.join();
+    }
+
+    // Needs the GIL.
+    void release_retired_views() {
+        auto retired = std::vector<oid::PyBufferView>{};
+        {
+            const std::scoped_lock lock(retired_views_mutex_);
+            retired.swap(retired_views_);
+        }
+    }
+
+    [[nodiscard]] static std::string plot_key(const std::string& name) {
+        return "plot " + name;
+    }
+
+    // I/O thread: sends a frame to the window, tolerating a dead peer. The
+    // user can close the window at any moment; the frame is dropped and the
+    // next debugger stop relaunches the window (see start()'s stale-client
+    // reset). Caught as the base std::runtime_error for the same
+    // shared-library visibility reason as in wait_for_client() below.
+    void send_frame(const std::vector<std::byte>& frame) const {
         try {
-            message_composer.send(*client_);
+            outbound().send(frame);
         } catch (const std::runtime_error& e) {
             std::cerr << "[OpenImageDebugger] could not reach the OID window "
                          "(closed?); message dropped: "
@@ -267,53 +946,336 @@ class OidBridge {
         }
     }
 
-    void try_read_incoming_messages(const int msecs = 3000) {
+    // I/O thread: sends a plot queued by plot_buffer().
+    void send_plot(const PlotJob& job) {
+        const auto& name = job.header.variable_name;
+        // Every debugger stop re-plots every observed buffer, and most of
+        // them have not changed since the last stop. Those are answered with
+        // a PLOT_BUFFER_UNCHANGED of a few bytes instead of the payload, and
+        // those that changed in only some rows with a patch of just those.
+        auto fingerprint = oid::fingerprint_plot_buffer(job.header, job.pixels);
+        const auto sent = sent_fingerprints_.find(name);
+        const auto changed =
+            sent == sent_fingerprints_.end()
+                ? std::nullopt
+                : oid::changed_strips(sent->second, fingerprint);
+
+        // Streamed as row strips (see oid::send_plot_buffer) so the window
+        // assembles while the tail is still in flight. Tolerates a dead peer
+        // exactly like send_frame().
+        try {
+            if (changed.has_value() && changed->empty()) {
+                oid::send_plot_buffer_unchanged(outbound(), name);
+                return;
+            }
+            // Forgotten first: a transfer cut short below leaves the window
+            // without this buffer (or with it half patched), so the next plot
+            // must send it in full.
+            sent_fingerprints_.erase(name);
+            if (changed.has_value()) {
+                oid::send_plot_buffer_patch(outbound(),
+                                            job.header,
+                                            job.pixels,
+                                            fingerprint,
+                                            *changed,
+                                            plot_chunk_bytes_,
+                                            job.compress);
+            } else {
+                // Strips spread over the lanes are sent while the control
+                // connection waits, so nothing else is reordered by them.
+                std::vector<oid::ITransport*> lanes;
+                if (job.lanes) {
+                    for (const auto& lane : lanes_) {
+                        lanes.push_back(lane.get());
+                    }
+                }
+                const auto fence = lanes.empty() ? 0 : ++lane_fence_;
+                oid::send_plot_buffer(outbound(),
+                                      job.header,
+                                      job.pixels,
+                                      plot_chunk_bytes_,
+                                      job.compress,
+                                      job.preview_factor,
+                                      {.lanes = lanes, .fence = fence});
+            }
+            sent_fingerprints_.try_emplace(name, std::move(fingerprint));
+        } catch (const std::runtime_error& e) {
+            std::cerr << "[OpenImageDebugger] could not reach the OID window "
+                         "(closed?); plot of '"
+                      << name << "' dropped: " << e.what() << std::endl;
+        }
+    }
+
+    // Compression costs CPU to save link bandwidth, which pays on a socket
+    // -- above all one tunnelled to a remote machine -- but not through the
+    // shared-memory ring, where the copy is already memory-speed.
+    [[nodiscard]] bool compress_plots() const {
+        if (!plot_compression_ ||
+            (window_capabilities_ & oid::CAPABILITY_COMPRESSED_CHUNKS) == 0) {
+            return false;
+        }
+#if defined(OID_HAS_SHM_TRANSPORT)
+        return shm_client_ == nullptr;
+#else
+        return true;
+#endif
+    }
+
+    // A buffer big enough to keep the window blank for a while is sent
+    // progressively: a decimated preview first (see oid::send_plot_buffer),
+    // if the window can show one.
+    [[nodiscard]] int preview_factor(const std::size_t byte_size) const {
+        const bool supported =
+            (window_capabilities_ & oid::CAPABILITY_PROGRESSIVE_PREVIEW) != 0;
+        return supported && byte_size >= oid::PREVIEW_MIN_BYTES
+                   ? oid::PREVIEW_FACTOR
+                   : 0;
+    }
+
+    // Strips are spread over the data lanes when the window reads them;
+    // compression, if on, then runs on one core per lane.
+    [[nodiscard]] bool use_data_lanes() const {
+        return !lanes_.empty() &&
+               (window_capabilities_ & oid::CAPABILITY_DATA_LANES) != 0;
+    }
+
+    // Messages to the window go through the shared-memory ring when it was
+    // negotiated; replies always come back on the plain socket.
+    [[nodiscard]] oid::ITransport& outbound() const {
+#if defined(OID_HAS_SHM_TRANSPORT)
+        if (shm_client_ != nullptr) {
+            return *shm_client_;
+        }
+#endif
+        return *client_;
+    }
+
+#if defined(OID_HAS_SHM_TRANSPORT)
+    // Creates a ring for a window about to be launched and adds its name to
+    // the window's command line. Only offered to a window this start() will
+    // adopt; failure to create one just leaves the plain socket.
+    std::optional<oid::SharedMemoryRing>
+    offer_shared_memory(std::vector<std::string>& command) const {
+        if (client_ != nullptr) {
+            return std::nullopt;
+        }
+        try {
+            auto ring = oid::SharedMemoryRing::create();
+            command.emplace_back("--shm");
+            command.emplace_back(ring.name());
+            return ring;
+        } catch (const std::runtime_error& e) {
+            std::cerr << "[OpenImageDebugger] shared memory unavailable, "
+                         "using the socket: "
+                      << e.what() << std::endl;
+            return std::nullopt;
+        }
+    }
+
+    // The window answers the offer right after connecting, before any
+    // message. A declined offer, or none at all within the timeout, keeps
+    // the plain socket. The ring's name is removed either way (here once
+    // the window has mapped it, otherwise by the ring's destructor), so
+    // nothing outlives the session in /dev/shm.
+    void negotiate_shared_memory(oid::SharedMemoryRing ring) {
         if (client_ == nullptr) {
             return;
         }
+        client_->set_timeout(std::chrono::seconds{5});
+        try {
+            if (oid::read_shared_memory_answer(*inbound_)) {
+                ring.unlink();
+                shm_client_ = std::make_unique<oid::SharedMemoryTransport>(
+                    *client_,
+                    std::move(ring),
+                    oid::SharedMemoryTransport::Role::WRITER);
+            }
+        } catch (const std::runtime_error&) {
+            // oid::SocketTimeoutError; caught as the base, see
+            // try_read_incoming_messages.
+        }
+    }
+#endif
+
+    void start_io() {
+        if (client_ == nullptr) {
+            return;
+        }
+        client_->set_timeout(IO_READ_TIMEOUT);
+        outbound_queue_ = std::make_unique<oid::OutboundQueue>(
+            oid::DEFAULT_OUTBOUND_BYTE_BUDGET,
+            [client = client_.get()] { client->interrupt_wait(); });
+        io_stop_ = false;
+        io_thread_ = std::thread{[this] { io_loop(); }};
+    }
+
+    // Waits for the message in flight, if any; the rest of the queue is
+    // dropped.
+    void stop_io() {
+        if (!io_thread_.joinable()) {
+            return;
+        }
+        io_stop_ = true;
+        outbound_queue_->close();
+        io_thread_.join();
+        outbound_queue_.reset();
+        release_retired_views();
+    }
+
+    // Sends and receives in turn, so a window busy sending to the bridge is
+    // never stuck behind a large plot on its way to it. With neither to do,
+    // sleeps on the socket until the window sends something or the queue
+    // wakes it (interrupt_wait(), on a push or on close()). Once the socket
+    // reads as closed, only the queue is left to wait for.
+    void io_loop() {
+        auto window_gone = false;
+        while (!io_stop_) {
+            const auto received = inbound_->has_data() && receive_message();
+            const auto sent =
+                outbound_queue_->run_next(std::chrono::milliseconds{0});
+            if (received || sent || io_stop_) {
+                continue;
+            }
+            if (window_gone) {
+                outbound_queue_->run_next(std::chrono::hours{1});
+            } else if (client_->wait_for_data() && !inbound_->has_data()) {
+                window_gone = true;
+            }
+        }
+    }
 
-        client_->set_timeout(std::chrono::milliseconds{msecs});
+    // I/O thread: decodes one message from the window into inbox_. Returns
+    // false if the window went silent mid-message or is gone.
+    bool receive_message() {
         try {
-            // Wait (bounded by msecs) for the first message, then drain
-            // whatever else is already buffered -- mirrors the old
-            // waitForReadyRead(msecs)+bytesAvailable() loop, where a lost
-            // or absent response simply falls out on timeout.
-            auto first = true;
-            while (first || client_->has_data()) {
-                first = false;
-
-                auto header = oid::MessageType{};
-                oid::MessageDecoder{*client_}.read(header);
-
-                switch (header) {
-                case oid::MessageType::PLOT_BUFFER_REQUEST:
-                    received_messages_[header] = decode_plot_buffer_request();
-                    break;
-                case oid::MessageType::GET_OBSERVED_SYMBOLS_RESPONSE:
-                    received_messages_[header] =
-                        decode_get_observed_symbols_response();
-                    break;
-                case oid::MessageType::BUFFER_REMOVED: {
-                    auto removed_name = std::string{};
-                    oid::MessageDecoder{*client_}.read(removed_name);
-                    // The debugger side does not currently track removals;
-                    // consuming the name keeps the message stream framed
-                    // correctly for the next message.
-                    break;
-                }
-                default:
-                    std::cerr << "[OpenImageDebugger] Received message with "
-                                 "incorrect header"
-                              << std::endl;
-                    break;
-                }
+            auto header = oid::MessageType{};
+            oid::MessageDecoder{*inbound_}.read(header);
+
+            auto message = std::unique_ptr<UiMessage>{};
+            switch (header) {
+            case oid::MessageType::PLOT_BUFFER_REQUEST:
+                message = decode_plot_buffer_request();
+                // The window asks for what it does not have (or wants back),
+                // so the answer must carry the pixels.
+                sent_fingerprints_.erase(
+                    dynamic_cast<PlotBufferRequestMessage&>(*message)
+                        .buffer_name);
+                break;
+            case oid::MessageType::GET_OBSERVED_SYMBOLS_RESPONSE:
+                message = decode_get_observed_symbols_response();
+                break;
+            case oid::MessageType::PLOT_BUFFER_REGION_REQUEST: {
+                auto request = std::make_unique<RegionRequestMessage>();
+                request->request = decode_region_request();
+                message = std::move(request);
+                break;
+            }
+            case oid::MessageType::VIEWER_CAPABILITIES: {
+                auto capabilities =
+                    std::make_unique<ViewerCapabilitiesMessage>();
+                oid::MessageDecoder{*inbound_}.read(capabilities->capabilities);
+                message = std::move(capabilities);
+                break;
+            }
+            case oid::MessageType::PLOT_BUFFER_FULL_REQUEST: {
+                auto request = std::make_unique<FullPlotRequestMessage>();
+                oid::MessageDecoder{*inbound_}.read(request->buffer_name);
+                // Whatever was sent under the name, the answer carries the
+                // pixels.
+                sent_fingerprints_.erase(request->buffer_name);
+                message = std::move(request);
+                break;
+            }
+            case oid::MessageType::BUFFER_REMOVED: {
+                auto removed = std::make_unique<BufferRemovedMessage>();
+                oid::MessageDecoder{*inbound_}.read(removed->buffer_name);
+                // The window dropped its copy: a later plot of the same name
+                // has to send the pixels again.
+                sent_fingerprints_.erase(removed->buffer_name);
+                message = std::move(removed);
+                break;
+            }
+            default:
+                std::cerr << "[OpenImageDebugger] Received message with "
+                             "incorrect header"
+                          << std::endl;
+                return true;
+            }
+
+            {
+                const std::scoped_lock lock(inbox_mutex_);
+                inbox_.emplace_back(header, std::move(message));
+            }
+            inbox_ready_.notify_one();
+            if (wakes_debugger(header)) {
+                wake_debugger();
             }
+            return true;
         } catch (const std::runtime_error&) {
-            // oid::SocketTimeoutError: no (further) message within the timeout
-            // -- not an error. Caught as the base std::runtime_error because
-            // it is thrown from liboidipc and this catch is in liboidbridge
-            // (built -fvisibility=hidden); a derived-type catch would miss it
-            // across the shared-library boundary and std::terminate.
+            // oid::SocketTimeoutError, or a closed socket. Caught as the base
+            // std::runtime_error because it is thrown from liboidipc and this
+            // catch is in liboidbridge (built -fvisibility=hidden); a
+            // derived-type catch would miss it across the shared-library
+            // boundary and std::terminate.
+            return false;
+        }
+    }
+
+    // What run_event_loop() acts on. The observed symbols are waited for
+    // where they were asked for, and a removed buffer can wait for the next
+    // of these.
+    [[nodiscard]] static bool wakes_debugger(const oid::MessageType header) {
+        switch (header) {
+        case oid::MessageType::PLOT_BUFFER_REQUEST:
+        case oid::MessageType::PLOT_BUFFER_REGION_REQUEST:
+        case oid::MessageType::PLOT_BUFFER_FULL_REQUEST:
+        case oid::MessageType::VIEWER_CAPABILITIES:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    // Applies what the I/O thread received, waiting up to msecs for the
+    // first message if none is there yet.
+    void try_read_incoming_messages(const int msecs = 3000) {
+        if (!io_thread_.joinable()) {
+            return;
+        }
+
+        auto received = decltype(inbox_){};
+        {
+            std::unique_lock lock(inbox_mutex_);
+            inbox_ready_.wait_for(lock, std::chrono::milliseconds{msecs}, [&] {
+                return !inbox_.empty();
+            });
+            received.swap(inbox_);
+        }
+
+        for (auto& [header, message] : received) {
+            switch (header) {
+            case oid::MessageType::PLOT_BUFFER_REGION_REQUEST:
+                region_requests_.push_back(std::move(
+                    dynamic_cast<RegionRequestMessage&>(*message).request));
+                break;
+            case oid::MessageType::VIEWER_CAPABILITIES:
+                window_capabilities_ =
+                    dynamic_cast<ViewerCapabilitiesMessage&>(*message)
+                        .capabilities;
+                break;
+            case oid::MessageType::PLOT_BUFFER_FULL_REQUEST:
+                full_requests_.push_back(std::move(
+                    dynamic_cast<FullPlotRequestMessage&>(*message)
+                        .buffer_name));
+                break;
+            case oid::MessageType::BUFFER_REMOVED:
+                lazy_plots_.erase(
+                    dynamic_cast<BufferRemovedMessage&>(*message).buffer_name);
+                break;
+            default:
+                received_messages_[header] = std::move(message);
+                break;
+            }
         }
     }
 
@@ -322,18 +1284,31 @@ class OidBridge {
         assert(client_ != nullptr);
 
         auto response = std::make_unique<PlotBufferRequestMessage>();
-        auto message_decoder = oid::MessageDecoder{*client_};
+        auto message_decoder = oid::MessageDecoder{*inbound_};
         message_decoder.read(response->buffer_name);
         return response;
     }
 
+    [[nodiscard]] RegionRequest decode_region_request() const {
+        assert(client_ != nullptr);
+
+        auto request = RegionRequest{};
+        oid::MessageDecoder{*inbound_}
+            .read(request.buffer_name)
+            .read(request.region.row)
+            .read(request.region.col)
+            .read(request.region.rows)
+            .read(request.region.cols);
+        return request;
+    }
+
     [[nodiscard]] std::unique_ptr<UiMessage>
     decode_get_observed_symbols_response() const {
         assert(client_ != nullptr);
 
         auto response = std::make_unique<GetObservedSymbolsResponseMessage>();
 
-        auto message_decoder = oid::MessageDecoder{*client_};
+        auto message_decoder = oid::MessageDecoder{*inbound_};
         message_decoder.read<std::deque<std::string>, std::string>(
             response->observed_symbols);
 
@@ -346,17 +1321,107 @@ class OidBridge {
             return result;
         }
 
-        // Try to fetch message
-        try_read_incoming_messages();
+        // Wait for it among whatever else the window sends meanwhile
+        const auto deadline =
+            std::chrono::steady_clock::now() + std::chrono::seconds{3};
+        while (io_thread_.joinable()) {
+            const auto left =
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now());
+            if (left.count() <= 0) {
+                break;
+            }
+            try_read_incoming_messages(static_cast<int>(left.count()));
+            if (auto result = try_get_stored_message(msg_type);
+                result != nullptr) {
+                return result;
+            }
+        }
+
+        return nullptr;
+    }
+
+    // Listens for the window, unless a previous start() already does, and
+    // tells it where on `command`. The window is always launched on this
+    // host, so a Unix-domain socket is preferred: it skips the TCP/IP stack
+    // on every transfer and listens on no port at all. TCP, on loopback
+    // only, is the fallback where one cannot be bound.
+    void listen(std::vector<std::string>& command) {
+#if defined(OID_HAS_LOCAL_SOCKET_TRANSPORT)
+        if (local_acceptor_ == nullptr && acceptor_ == nullptr) {
+            try {
+                local_acceptor_ = std::make_unique<oid::AsioLocalAcceptor>();
+            } catch (const std::runtime_error& error) {
+                std::cerr << "[OpenImageDebugger] Could not listen on a "
+                             "local socket, using TCP: "
+                          << error.what() << std::endl;
+            }
+        }
+        if (local_acceptor_ != nullptr) {
+            command.emplace_back("--socket");
+            command.emplace_back(local_acceptor_->path());
+            return;
+        }
+#endif
+        if (acceptor_ == nullptr) {
+            acceptor_ = std::make_unique<oid::AsioAcceptor>();
+        }
+        command.emplace_back("-p");
+        command.emplace_back(std::to_string(acceptor_->port()));
+    }
 
-        return try_get_stored_message(msg_type);
+    // Asks a window about to be launched for the data lanes set with
+    // set_plot_data_lanes(); returns how many.
+    [[nodiscard]] std::size_t
+    request_data_lanes(std::vector<std::string>& command) const {
+        if (client_ != nullptr || plot_data_lanes_ == 0) {
+            return 0;
+        }
+        command.emplace_back("--lanes");
+        command.emplace_back(std::to_string(plot_data_lanes_));
+        return plot_data_lanes_;
+    }
+
+    // The window connects its data lanes once the control connection is
+    // settled, on the same socket; they are taken until one fails to
+    // arrive. A window on the shared-memory ring connects none: the ring is
+    // already memory-speed, so lanes could only add copies.
+    void accept_data_lanes(const std::size_t count) {
+        if (client_ == nullptr || !lanes_.empty()) {
+            return;
+        }
+#if defined(OID_HAS_SHM_TRANSPORT)
+        if (shm_client_ != nullptr) {
+            return;
+        }
+#endif
+        while (lanes_.size() < count) {
+            try {
+                lanes_.push_back(std::make_unique<oid::AsioTransport>(
+                    accept_window(std::chrono::seconds{2})));
+            } catch (const std::runtime_error&) {
+                // oid::SocketTimeoutError, caught as the base as in
+                // wait_for_client(). Fewer lanes is fine.
+                break;
+            }
+        }
+    }
+
+    oid::AsioTransport accept_window(const std::chrono::milliseconds timeout) {
+#if defined(OID_HAS_LOCAL_SOCKET_TRANSPORT)
+        if (local_acceptor_ != nullptr) {
+            return local_acceptor_->accept(timeout);
+        }
+#endif
+        return acceptor_->accept(timeout);
     }
 
     void wait_for_client() {
         if (client_ == nullptr) {
             try {
                 client_ = std::make_unique<oid::AsioTransport>(
-                    acceptor_.accept(std::chrono::seconds{10}));
+                    accept_window(std::chrono::seconds{10}));
+                inbound_ = std::make_unique<oid::BufferedTransport>(*client_);
             } catch (const std::runtime_error&) {
                 // oid::SocketTimeoutError (accept timed out). Caught as the
                 // base std::runtime_error: it is thrown from liboidipc and
@@ -402,6 +1467,43 @@ oid_initialize_impl(std::function<int(const char*)> plot_callback,
         app->set_path(oid_path_str);
     }
 
+    // Row-strip size for chunked plots; absent keeps the default, and a
+    // non-positive value disables chunking.
+    if (const auto py_chunk_bytes =
+            PyDict_GetItemString(optional_parameters, "plot_chunk_bytes");
+        py_chunk_bytes != nullptr && PY_INT_CHECK_FUNC(py_chunk_bytes)) {
+        const auto chunk_bytes = oid::get_py_int(py_chunk_bytes);
+        app->set_plot_chunk_bytes(
+            chunk_bytes > 0 ? static_cast<std::size_t>(chunk_bytes) : 0);
+    }
+
+    // Compressed plot strips; absent keeps them on (for windows that
+    // support them), false turns them off.
+    if (const auto py_compression =
+            PyDict_GetItemString(optional_parameters, "plot_compression");
+        py_compression != nullptr && PyBool_Check(py_compression)) {
+        app->set_plot_compression(PyObject_IsTrue(py_compression) != 0);
+    }
+
+    // Data lanes for plot strips; absent keeps the default for this machine
+    // (see oid::default_data_lanes()), a non-positive value turns them off.
+    if (const auto py_lanes =
+            PyDict_GetItemString(optional_parameters, "plot_data_lanes");
+        py_lanes != nullptr && PY_INT_CHECK_FUNC(py_lanes)) {
+        const auto lanes = oid::get_py_int(py_lanes);
+        app->set_plot_data_lanes(lanes > 0 ? static_cast<std::size_t>(lanes)
+                                           : 0);
+    }
+
+    // Quick-look decimation; absent, or below 2, plots buffers in full.
+    if (const auto py_factor =
+            PyDict_GetItemString(optional_parameters, "quick_look_factor");
+        py_factor != nullptr && PY_INT_CHECK_FUNC(py_factor)) {
+        const auto factor = oid::get_py_int(py_factor);
+        app->set_quick_look_factor(static_cast<int>(
+            std::clamp<long>(factor, 1, oid::MAX_BUFFER_DIMENSION)));
+    }
+
     return app;
 }
 } // namespace
@@ -447,6 +1549,35 @@ void oid_exec(const AppHandler handler) {
     app->start();
 }
 
+void oid_launch(const AppHandler handler) {
+    const auto py_gil_raii = PyGILRAII{};
+
+    const auto app = static_cast<OidBridge*>(handler);
+
+    if (app == nullptr) [[unlikely]] {
+        RAISE_PY_EXCEPTION(PyExc_RuntimeError,
+                           "oid_launch received null application handler");
+        return;
+    }
+
+    app->launch();
+}
+
+void oid_end_session(const AppHandler handler) {
+    const auto py_gil_raii = PyGILRAII{};
+
+    const auto app = static_cast<OidBridge*>(handler);
+
+    if (app == nullptr) [[unlikely]] {
+        RAISE_PY_EXCEPTION(PyExc_RuntimeError,
+                           "oid_end_session received null application "
+                           "handler");
+        return;
+    }
+
+    app->end_session();
+}
+
 int oid_is_window_ready(const AppHandler handler) {
     const auto py_gil_raii = PyGILRAII{};
 
@@ -517,7 +1648,7 @@ void oid_set_available_symbols(const AppHandler handler,
         available_vars_stl.push_back(var_name_str);
     }
 
-    app->set_available_symbols(available_vars_stl);
+    app->set_available_symbols(std::move(available_vars_stl));
 }
 
 void oid_run_event_loop(const AppHandler handler) {
@@ -535,22 +1666,26 @@ void oid_run_event_loop(const AppHandler handler) {
     app->run_event_loop();
 }
 
-void oid_plot_buffer(AppHandler handler, PyObject* buffer_metadata) {
-    const auto py_gil_raii = PyGILRAII{};
-
-    const auto app = static_cast<OidBridge*>(handler);
-
-    if (app == nullptr) [[unlikely]] {
-        RAISE_PY_EXCEPTION(PyExc_RuntimeError,
-                           "oid_plot_buffer received null application handler");
-        return;
-    }
+namespace {
+// A plot parsed from its buffer_metadata dict. `params.buffer` points into
+// `view`, exported by the dict's [pointer]. A lazy plot (see
+// oid_region_fetch_min_bytes) has an address instead, and one for the
+// bridge to read itself the debuggee's pid as well.
+struct PlotRequest {
+    PlotBufferParams params;
+    oid::PyBufferView view{};
+    std::optional<std::uint64_t> address{};
+    std::optional<long> pid{};
+};
 
+// Raises a Python exception and returns std::nullopt if `buffer_metadata`
+// is not a valid plot.
+std::optional<PlotRequest> parse_plot_request(PyObject* buffer_metadata) {
     if (!PyDict_Check(buffer_metadata)) [[unlikely]] {
         RAISE_PY_EXCEPTION(PyExc_TypeError,
                            "Invalid object given to plot_buffer (was expecting"
                            " a dict).");
-        return;
+        return std::nullopt;
     }
 
     /*
@@ -577,48 +1712,73 @@ void oid_plot_buffer(AppHandler handler, PyObject* buffer_metadata) {
         PyDict_GetItemString(buffer_metadata, "transpose_buffer");
     auto transpose_buffer = false;
     if (py_transpose_buffer != nullptr) {
-        CHECK_FIELD_TYPE(transpose_buffer, PyBool_Check, "transpose_buffer");
+        CHECK_FIELD_TYPE_RET(
+            transpose_buffer, PyBool_Check, "transpose_buffer", std::nullopt);
         transpose_buffer = PyObject_IsTrue(py_transpose_buffer);
     }
 
     /*
      * Check if expected fields were provided
      */
-    CHECK_FIELD_PROVIDED(variable_name, "plot_buffer");
-    CHECK_FIELD_PROVIDED(display_name, "plot_buffer");
-    CHECK_FIELD_PROVIDED(pointer, "plot_buffer");
-    CHECK_FIELD_PROVIDED(width, "plot_buffer");
-    CHECK_FIELD_PROVIDED(height, "plot_buffer");
-    CHECK_FIELD_PROVIDED(channels, "plot_buffer");
-    CHECK_FIELD_PROVIDED(type, "plot_buffer");
-    CHECK_FIELD_PROVIDED(row_stride, "plot_buffer");
-    CHECK_FIELD_PROVIDED(pixel_layout, "plot_buffer");
+    CHECK_FIELD_PROVIDED_RET(variable_name, "plot_buffer", std::nullopt);
+    CHECK_FIELD_PROVIDED_RET(display_name, "plot_buffer", std::nullopt);
+    CHECK_FIELD_PROVIDED_RET(pointer, "plot_buffer", std::nullopt);
+    CHECK_FIELD_PROVIDED_RET(width, "plot_buffer", std::nullopt);
+    CHECK_FIELD_PROVIDED_RET(height, "plot_buffer", std::nullopt);
+    CHECK_FIELD_PROVIDED_RET(channels, "plot_buffer", std::nullopt);
+    CHECK_FIELD_PROVIDED_RET(type, "plot_buffer", std::nullopt);
+    CHECK_FIELD_PROVIDED_RET(row_stride, "plot_buffer", std::nullopt);
+    CHECK_FIELD_PROVIDED_RET(pixel_layout, "plot_buffer", std::nullopt);
 
     /*
      * Check if expected fields have the correct types
      */
-    CHECK_FIELD_TYPE(variable_name, oid::check_py_string_type, "plot_buffer");
-    CHECK_FIELD_TYPE(display_name, oid::check_py_string_type, "plot_buffer");
-    CHECK_FIELD_TYPE(width, PY_INT_CHECK_FUNC, "plot_buffer");
-    CHECK_FIELD_TYPE(height, PY_INT_CHECK_FUNC, "plot_buffer");
-    CHECK_FIELD_TYPE(channels, PY_INT_CHECK_FUNC, "plot_buffer");
-    CHECK_FIELD_TYPE(type, PY_INT_CHECK_FUNC, "plot_buffer");
-    CHECK_FIELD_TYPE(row_stride, PY_INT_CHECK_FUNC, "plot_buffer");
-    CHECK_FIELD_TYPE(pixel_layout, oid::check_py_string_type, "plot_buffer");
-
-    // Retrieve pointer to buffer
-    uint8_t* buff_ptr{nullptr};
-    auto buff_size = std::size_t{0};
-    if (PyMemoryView_Check(py_pointer) != 0) {
-        oid::get_c_ptr_from_py_buffer(py_pointer, buff_ptr, buff_size);
+    CHECK_FIELD_TYPE_RET(
+        variable_name, oid::check_py_string_type, "plot_buffer", std::nullopt);
+    CHECK_FIELD_TYPE_RET(
+        display_name, oid::check_py_string_type, "plot_buffer", std::nullopt);
+    CHECK_FIELD_TYPE_RET(width, PY_INT_CHECK_FUNC, "plot_buffer", std::nullopt);
+    CHECK_FIELD_TYPE_RET(
+        height, PY_INT_CHECK_FUNC, "plot_buffer", std::nullopt);
+    CHECK_FIELD_TYPE_RET(
+        channels, PY_INT_CHECK_FUNC, "plot_buffer", std::nullopt);
+    CHECK_FIELD_TYPE_RET(type, PY_INT_CHECK_FUNC, "plot_buffer", std::nullopt);
+    CHECK_FIELD_TYPE_RET(
+        row_stride, PY_INT_CHECK_FUNC, "plot_buffer", std::nullopt);
+    CHECK_FIELD_TYPE_RET(
+        pixel_layout, oid::check_py_string_type, "plot_buffer", std::nullopt);
+
+    // A lazy plot gives the buffer's address in the debuggee instead of its
+    // contents, and so does one the bridge is to read, along with the pid
+    const auto py_address = PyDict_GetItemString(buffer_metadata, "address");
+    const auto py_pid = PyDict_GetItemString(buffer_metadata, "pid");
+    const auto lazy = py_address != nullptr && py_pointer == Py_None;
+    if (lazy) {
+        CHECK_FIELD_TYPE_RET(
+            address, PY_INT_CHECK_FUNC, "plot_buffer", std::nullopt);
+        if (py_pid != nullptr) {
+            CHECK_FIELD_TYPE_RET(
+                pid, PY_INT_CHECK_FUNC, "plot_buffer", std::nullopt);
+        }
+    }
+
+    // Retrieve the buffer, without copying it
+    auto view = oid::PyBufferView{};
+    if (lazy) {
+        // Nothing to retrieve
+    } else if (PyObject_CheckBuffer(py_pointer) != 0) {
+        view = oid::get_py_buffer(py_pointer);
+        if (view == nullptr) [[unlikely]] {
+            return std::nullopt; // BufferError already raised
+        }
     } else [[unlikely]] {
         RAISE_PY_EXCEPTION(PyExc_TypeError,
                            "Could not retrieve C pointer to provided buffer");
-        return;
+        return std::nullopt;
     }
 
     /*
-     * Send buffer contents
+     * Collect buffer contents
      */
     auto variable_name_str = std::string{};
     auto display_name_str = std::string{};
@@ -636,20 +1796,46 @@ void oid_plot_buffer(AppHandler handler, PyObject* buffer_metadata) {
     const auto buff_type =
         static_cast<oid::BufferType>(oid::get_py_int(py_type));
 
+    auto request = PlotRequest{
+        .params = PlotBufferParams{.variable_name_str = variable_name_str,
+                                   .display_name_str = display_name_str,
+                                   .pixel_layout_str = pixel_layout_str,
+                                   .transpose_buffer = transpose_buffer,
+                                   .buff_width = buff_width,
+                                   .buff_height = buff_height,
+                                   .buff_channels = buff_channels,
+                                   .buff_stride = buff_stride,
+                                   .buff_type = buff_type,
+                                   .buffer = {}},
+        .view = nullptr,
+        .address = std::nullopt,
+        .pid = std::nullopt};
+
+    if (lazy) {
+        request.address = PyLong_AsUnsignedLongLong(py_address);
+        if (py_pid != nullptr) {
+            request.pid = PyLong_AsLong(py_pid);
+        }
+        if (PyErr_Occurred() != nullptr) [[unlikely]] {
+            return std::nullopt;
+        }
+        return request;
+    }
+
     const auto buff_size_expected = std::size_t{
         static_cast<size_t>(buff_stride * buff_height * buff_channels) *
         oid::type_size(buff_type)};
 
-    if (buff_ptr == nullptr) [[unlikely]] {
+    if (view->buf == nullptr) [[unlikely]] {
         RAISE_PY_EXCEPTION(
             PyExc_TypeError,
             "oid_plot_buffer received nullptr as buffer pointer");
-        return;
+        return std::nullopt;
     }
 
     // Create span from pointer+size for buffer storage
-    const auto buff_span =
-        std::span{reinterpret_cast<const std::byte*>(buff_ptr), buff_size};
+    const auto buff_span = std::span{static_cast<const std::byte*>(view->buf),
+                                     static_cast<std::size_t>(view->len)};
     if (buff_span.size() < buff_size_expected) [[unlikely]] {
         auto ss = std::stringstream{};
         ss << "oid_plot_buffer received shorter buffer then expected";
@@ -657,18 +1843,142 @@ void oid_plot_buffer(AppHandler handler, PyObject* buffer_metadata) {
         ss << ". Expected " << buff_size_expected << "bytes";
         ss << ". Received " << buff_span.size() << "bytes";
         RAISE_PY_EXCEPTION(PyExc_TypeError, ss.str().c_str());
+        return std::nullopt;
+    }
+
+    request.params.buffer = buff_span;
+    request.view = std::move(view);
+    return request;
+}
+
+// Plots one parsed buffer; a full one is queued without copying it.
+void plot(OidBridge& app, PlotRequest request) {
+    if (request.pid.has_value()) {
+        if (!app.plot_debuggee_buffer(
+                request.params, *request.pid, *request.address)) {
+            std::cerr << "[OpenImageDebugger] could not read '"
+                      << request.params.variable_name_str
+                      << "' from the debuggee; plot dropped" << std::endl;
+        }
+    } else if (request.address.has_value()) {
+        app.plot_lazy_buffer(request.params, *request.address);
+    } else {
+        app.plot_buffer(request.params, std::move(request.view));
+    }
+}
+} // namespace
+
+void oid_plot_buffer(AppHandler handler, PyObject* buffer_metadata) {
+    const auto py_gil_raii = PyGILRAII{};
+
+    const auto app = static_cast<OidBridge*>(handler);
+
+    if (app == nullptr) [[unlikely]] {
+        RAISE_PY_EXCEPTION(PyExc_RuntimeError,
+                           "oid_plot_buffer received null application handler");
+        return;
+    }
+
+    if (auto request = parse_plot_request(buffer_metadata);
+        request.has_value()) {
+        plot(*app, std::move(*request));
+    }
+}
+
+void oid_plot_buffers(AppHandler handler, PyObject* buffers_metadata) {
+    const auto py_gil_raii = PyGILRAII{};
+
+    const auto app = static_cast<OidBridge*>(handler);
+
+    if (app == nullptr) [[unlikely]] {
+        RAISE_PY_EXCEPTION(PyExc_RuntimeError,
+                           "oid_plot_buffers received null application "
+                           "handler");
         return;
     }
 
-    const PlotBufferParams params{.variable_name_str = variable_name_str,
-                                  .display_name_str = display_name_str,
-                                  .pixel_layout_str = pixel_layout_str,
-                                  .transpose_buffer = transpose_buffer,
-                                  .buff_width = buff_width,
-                                  .buff_height = buff_height,
-                                  .buff_channels = buff_channels,
-                                  .buff_stride = buff_stride,
-                                  .buff_type = buff_type,
-                                  .buffer = buff_span};
-    app->plot_buffer(params);
+    const auto iterator = PyObject_GetIter(buffers_metadata);
+    if (iterator == nullptr) [[unlikely]] {
+        return; // TypeError already raised
+    }
+
+    // Each buffer is sent by the I/O thread while the iterator reads the
+    // next one from the debuggee.
+    app->begin_plot_batch();
+    PyObject* metadata = nullptr;
+    while ((metadata = PyIter_Next(iterator)) != nullptr) {
+        auto request = parse_plot_request(metadata);
+        const auto parsed = request.has_value();
+        if (parsed) [[likely]] {
+            plot(*app, std::move(*request));
+        }
+        Py_DECREF(metadata);
+        if (!parsed) [[unlikely]] {
+            break;
+        }
+    }
+    Py_DECREF(iterator);
+    app->end_plot_batch();
+}
+
+// NOSONAR: C API requires function pointer (extern "C")
+void oid_set_memory_reader(const AppHandler handler,
+                           int (*reader)(unsigned long long address, // NOSONAR
+                                         size_t size,
+                                         void* destination)) {
+    const auto py_gil_raii = PyGILRAII{};
+
+    const auto app = static_cast<OidBridge*>(handler);
+
+    if (app == nullptr) [[unlikely]] {
+        RAISE_PY_EXCEPTION(PyExc_RuntimeError,
+                           "oid_set_memory_reader received null application "
+                           "handler");
+        return;
+    }
+
+    if (reader == nullptr) {
+        app->set_memory_reader({});
+        return;
+    }
+    app->set_memory_reader(
+        [reader](const std::uint64_t address, const std::span<std::byte> out) {
+            return reader(address, out.size(), out.data()) != 0;
+        });
+}
+
+// NOSONAR: C API requires function pointer (extern "C")
+void oid_set_request_notifier(const AppHandler handler,
+                              void (*notifier)()) { // NOSONAR
+    const auto py_gil_raii = PyGILRAII{};
+
+    const auto app = static_cast<OidBridge*>(handler);
+
+    if (app == nullptr) [[unlikely]] {
+        RAISE_PY_EXCEPTION(PyExc_RuntimeError,
+                           "oid_set_request_notifier received null "
+                           "application handler");
+        return;
+    }
+
+    if (notifier == nullptr) {
+        app->set_request_notifier({});
+        return;
+    }
+    app->set_request_notifier([notifier] { notifier(); });
+}
+
+size_t oid_region_fetch_min_bytes(const AppHandler handler) {
+    const auto py_gil_raii = PyGILRAII{};
+
+    const auto app = static_cast<OidBridge*>(handler);
+
+    if (app == nullptr) [[unlikely]] {
+        RAISE_PY_EXCEPTION(PyExc_RuntimeError,
+                           "oid_region_fetch_min_bytes received null "
+                           "application handler");
+        return 0;
+    }
+
+    return app->region_fetch_min_bytes();
 }
@@ -75,6 +75,32 @@ void oid_cleanup(AppHandler handler);
 OID_API
 void oid_exec(AppHandler handler);
 
+/**
+ * Launch the OID window without waiting for it
+ *
+ * The window starts up (GL context, fonts) and connects while the caller goes
+ * on; the next oid_exec() adopts it instead of launching another one, and
+ * returns as soon as the connection is settled. Does nothing if a window
+ * launched this way is still waiting to be adopted.
+ *
+ * @param handler  Application context
+ */
+OID_API
+void oid_launch(AppHandler handler);
+
+/**
+ * Forget the state of a debuggee that is gone, keeping the window
+ *
+ * For a window that stays open from one debug session to the next: plots
+ * whose regions were read from the old debuggee can no longer be served and
+ * are dropped. The buffers the window shows are kept, and refreshed by the
+ * next plots of the same names.
+ *
+ * @param handler  Application context
+ */
+OID_API
+void oid_end_session(AppHandler handler);
+
 /**
  * Check if the given window is open
  *
@@ -135,10 +161,81 @@ void oid_run_event_loop(AppHandler handler);
  *     - [type        ] Buffer type (see symbols.py for details)
  *     - [row_stride  ] Row stride, in pixels
  *     - [pixel_layout] String defining pixel channel layout (e.g. 'rgba')
+ *
+ *     A buffer of at least oid_region_fetch_min_bytes() bytes may instead be
+ *     plotted lazily, with [pointer] set to None and the extra element:
+ *     - [address     ] Address of the buffer in the debuggee, read through
+ *                      the reader given to oid_set_memory_reader()
+ *
+ *     A buffer in a live process on this machine may also be given that way,
+ *     whatever its size, for the bridge to read in full by itself (Linux
+ *     only; elsewhere, or where it may not, through the memory reader), with
+ *     the extra element:
+ *     - [pid         ] Process id of the debuggee
  * */
 OID_API
 void oid_plot_buffer(AppHandler handler, PyObject* buffer_metadata);
 
+/**
+ * Add several buffers to the plot list at once
+ *
+ * Meant for re-plotting every observed buffer when the debugger stops: the
+ * window takes them in together, and each buffer is sent while the next one
+ * is being fetched.
+ *
+ * @param handler  Handler of the window where the buffers should be plotted
+ * @param buffers_metadata  Python iterable of dictionaries as taken by
+ *     oid_plot_buffer(). It may be a generator that reads each buffer as it
+ *     is reached. Stops at the first invalid dictionary.
+ * */
+OID_API
+void oid_plot_buffers(AppHandler handler, PyObject* buffers_metadata);
+
+/**
+ * Set the function that reads debuggee memory for lazy plots
+ *
+ * The reader copies `size` bytes at `address` in the debuggee to
+ * `destination`, returning 1 on success and 0 if the memory cannot be read.
+ * It is called from oid_plot_buffer() and oid_run_event_loop().
+ *
+ * @param handler  Window handler, generated by oid_initialize()
+ * @param reader  Memory reader, or NULL to disable lazy plots
+ */
+OID_API
+void oid_set_memory_reader(AppHandler handler,
+                           int (*reader)(unsigned long long address,
+                                         size_t size,
+                                         void* destination));
+
+/**
+ * Set the function that asks the debugger to run oid_run_event_loop()
+ *
+ * The bridge watches the window's connection on threads of its own, and calls
+ * `notifier` (holding the GIL, from one of those threads) whenever the window
+ * sent something oid_run_event_loop() acts on: a plot or region request, or
+ * its capabilities. The notifier typically queues oid_run_event_loop() on the
+ * debugger's event queue. Without one, the caller has to poll
+ * oid_run_event_loop(), which then waits a moment for the window each time.
+ *
+ * @param handler  Window handler, generated by oid_initialize()
+ * @param notifier  Request notifier, or NULL to go back to polling
+ */
+OID_API
+void oid_set_request_notifier(AppHandler handler, void (*notifier)(void));
+
+/**
+ * Get the size from which buffers should be plotted lazily
+ *
+ * A lazily plotted buffer is not read whole: the window gets a decimated
+ * overview, and the full-resolution regions it shows are read on demand.
+ *
+ * @param handler  Window handler, generated by oid_initialize()
+ * @return  Minimum buffer size in bytes, or 0 if the window cannot show lazy
+ *     plots or no memory reader was set.
+ */
+OID_API
+size_t oid_region_fetch_min_bytes(AppHandler handler);
+
 #ifdef __cplusplus
 }
 #endif
@@ -25,16 +25,134 @@
 
 #include "platform/transport_factory.h"
 
+#include <algorithm>
+#include <utility>
+
 #include "ipc/asio_transport.h"
+#include "ipc/buffered_transport.h"
+#include "ipc/plot_buffer_sender.h"
+
+#if defined(OID_HAS_SHM_TRANSPORT)
+#include <stdexcept>
+
+#include "ipc/shm_transport.h"
+#endif
 
 namespace oid::platform {
 
-std::unique_ptr<ITransport> make_transport(const TransportDeps& deps) {
+namespace {
+
+// Owns the control socket alongside the layers reading through it -- the
+// read-ahead every message is decoded from, and the shared-memory transport
+// when one was negotiated -- so they can be handed out as a single
+// ITransport.
+class SocketClientTransport final : public ITransport {
+  public:
+    explicit SocketClientTransport(std::unique_ptr<AsioTransport> socket)
+        : socket_{std::move(socket)}, buffered_{*socket_}, top_{&buffered_} {}
+
+#if defined(OID_HAS_SHM_TRANSPORT)
+    SocketClientTransport(std::unique_ptr<AsioTransport> socket,
+                          SharedMemoryRing ring)
+        : SocketClientTransport{std::move(socket)} {
+        shm_ = std::make_unique<SharedMemoryTransport>(
+            buffered_, std::move(ring), SharedMemoryTransport::Role::READER);
+        top_ = shm_.get();
+    }
+#endif
+
+    SocketClientTransport(const SocketClientTransport&) = delete;
+    SocketClientTransport& operator=(const SocketClientTransport&) = delete;
+
+    void send(const std::span<const std::byte> data) override {
+        top_->send(data);
+    }
+    void send_gather(
+        const std::span<const std::span<const std::byte>> parts) override {
+        top_->send_gather(parts);
+    }
+    std::size_t receive(const std::span<std::byte> dst) override {
+        return top_->receive(dst);
+    }
+    [[nodiscard]] bool has_data() const override {
+        return top_->has_data();
+    }
+
+    [[nodiscard]] const AsioTransport& socket() const {
+        return *socket_;
+    }
+
+    [[nodiscard]] bool over_shared_memory() const {
+        return top_ != &buffered_;
+    }
+
+  private:
+    std::unique_ptr<AsioTransport> socket_;
+    BufferedTransport buffered_;
+#if defined(OID_HAS_SHM_TRANSPORT)
+    std::unique_ptr<SharedMemoryTransport> shm_{};
+#endif
+    // The outermost layer: shm_ if there is one, buffered_ otherwise.
+    ITransport* top_;
+};
+
+std::unique_ptr<AsioTransport> connect_socket(const TransportDeps& deps) {
+#if defined(OID_HAS_LOCAL_SOCKET_TRANSPORT)
+    if (!deps.socket_path.empty()) {
+        return std::make_unique<AsioTransport>(
+            asio::local::stream_protocol::endpoint{deps.socket_path});
+    }
+#endif
     return std::make_unique<AsioTransport>(deps.host, deps.port);
 }
 
+} // namespace
+
+std::unique_ptr<ITransport> make_transport(const TransportDeps& deps) {
+    auto socket = connect_socket(deps);
+#if defined(OID_HAS_SHM_TRANSPORT)
+    // The bridge waits for an answer to its offer before sending anything,
+    // so one is always sent once connected -- declining included. A failed
+    // answer leaves the socket to report the disconnect as usual.
+    if (!deps.shm_name.empty() && socket->is_connected()) {
+        try {
+            if (auto ring = answer_shared_memory_offer(*socket, deps.shm_name);
+                ring.has_value()) {
+                return std::make_unique<SocketClientTransport>(
+                    std::move(socket), std::move(*ring));
+            }
+        } catch (const std::runtime_error&) {
+            // Caught as the base: thrown from liboidipc, see
+            // SocketTimeoutError.
+        }
+    }
+#endif
+    return std::make_unique<SocketClientTransport>(std::move(socket));
+}
+
+std::vector<std::unique_ptr<ITransport>>
+connect_data_lanes(const TransportDeps& deps, const ITransport& transport) {
+    std::vector<std::unique_ptr<ITransport>> lanes;
+    if (dynamic_cast<const SocketClientTransport&>(transport)
+            .over_shared_memory()) {
+        return lanes;
+    }
+    const auto count = std::min(deps.lanes, MAX_DATA_LANES);
+    while (lanes.size() < count) {
+        auto socket = connect_socket(deps);
+        if (!socket->is_connected()) {
+            break;
+        }
+        lanes.push_back(
+            std::make_unique<SocketClientTransport>(std::move(socket)));
+    }
+    return lanes;
+}
+
 bool should_quit_on_disconnect(const ITransport& transport) {
-    return !dynamic_cast<const AsioTransport&>(transport).is_connected();
+    return !dynamic_cast<const SocketClientTransport&>(transport)
+                .socket()
+                .is_connected();
 }
 
 } // namespace oid::platform
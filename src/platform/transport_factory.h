@@ -26,8 +26,10 @@
 #ifndef PLATFORM_TRANSPORT_FACTORY_H_
 #define PLATFORM_TRANSPORT_FACTORY_H_
 
+#include <cstddef>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace oid {
 class ITransport;
@@ -36,10 +38,27 @@ namespace platform {
 struct TransportDeps {
     std::string host;    // ignored by the non-native transport, used natively
     unsigned short port; // ignored by the non-native transport, used natively
+    // Native only: name of the shared-memory ring the launching bridge
+    // offered (see ipc/shm_transport.h); empty for a plain socket.
+    std::string shm_name{};
+    // Native only: Unix-domain socket the launching bridge listens on; when
+    // set, it is connected to instead of host:port.
+    std::string socket_path{};
+    // Native only: data lanes the launching bridge asked for (see
+    // ipc/plot_buffer_sender.h); 0 for none.
+    std::size_t lanes{};
 };
 
 std::unique_ptr<ITransport> make_transport(const TransportDeps& deps);
 
+// Connects the data lanes `deps` asks for to where make_transport() went
+// for `transport`, stopping at the first that fails. None when `transport`
+// settled on shared memory, which the lanes could only slow down, and none
+// off native. The bridge accepts them once the control connection is
+// settled, so this comes after make_transport().
+std::vector<std::unique_ptr<ITransport>>
+connect_data_lanes(const TransportDeps& deps, const ITransport& transport);
+
 // True only on native when the transport has dropped; always false otherwise.
 bool should_quit_on_disconnect(const ITransport& transport);
 
@@ -0,0 +1,172 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "process_memory.h"
+
+#include <algorithm>
+#include <atomic>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/types.h>
+#include <sys/uio.h>
+#endif
+
+namespace oid::system {
+
+namespace {
+
+#if defined(__linux__)
+// One chunk, in as many calls as the kernel takes to hand it all over.
+bool read_chunk(const pid_t pid,
+                std::uint64_t address,
+                std::span<std::byte> out) {
+    while (!out.empty()) {
+        auto local = iovec{.iov_base = out.data(), .iov_len = out.size()};
+        // An address in the debuggee, never dereferenced here.
+        auto remote = iovec{.iov_base = reinterpret_cast<void*>(
+                                 static_cast<std::uintptr_t>(address)),
+                            .iov_len = out.size()};
+        const auto read = process_vm_readv(pid, &local, 1, &remote, 1, 0);
+        // A short read stops at the first page it could not read; 0 means
+        // that is the very next one.
+        if (read <= 0) {
+            return false;
+        }
+        const auto count = static_cast<std::size_t>(read);
+        address += count;
+        out = out.subspan(count);
+    }
+    return true;
+}
+#endif
+
+} // namespace
+
+bool can_read_process_memory() {
+#if defined(__linux__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool read_process_memory([[maybe_unused]] const long pid,
+                         [[maybe_unused]] const std::uint64_t address,
+                         [[maybe_unused]] const std::span<std::byte> out,
+                         [[maybe_unused]] const std::size_t threads) {
+#if defined(__linux__)
+    const auto chunks =
+        (out.size() + PROCESS_READ_CHUNK_BYTES - 1) / PROCESS_READ_CHUNK_BYTES;
+    // Each thread takes the next chunk nobody has, until they run out or
+    // one fails.
+    std::atomic<std::size_t> next_chunk{0};
+    std::atomic<bool> failed{false};
+    const auto read_chunks = [&] {
+        for (auto chunk = next_chunk++; chunk < chunks && !failed;
+             chunk = next_chunk++) {
+            const auto offset = chunk * PROCESS_READ_CHUNK_BYTES;
+            const auto size =
+                (std::min)(PROCESS_READ_CHUNK_BYTES, out.size() - offset);
+            const auto piece = out.subspan(offset, size);
+            if (!read_chunk(static_cast<pid_t>(pid), address + offset, piece)) {
+                failed = true;
+            }
+        }
+    };
+    {
+        std::vector<std::jthread> readers;
+        const auto helpers = (std::min)(threads, chunks);
+        readers.reserve(helpers);
+        for (std::size_t i = 1; i < helpers; ++i) {
+            try {
+                readers.emplace_back(read_chunks);
+            } catch (const std::system_error&) {
+                // Out of threads: the chunks left are read here instead.
+                break;
+            }
+        }
+        read_chunks();
+    }
+    return !failed;
+#else
+    return false;
+#endif
+}
+
+bool read_process_rows([[maybe_unused]] const long pid,
+                       [[maybe_unused]] const std::uint64_t address,
+                       [[maybe_unused]] const std::uint64_t row_step,
+                       [[maybe_unused]] const std::size_t row_bytes,
+                       [[maybe_unused]] const std::span<std::byte> out) {
+#if defined(__linux__)
+    if (row_bytes == 0 || out.size() % row_bytes != 0) {
+        return false;
+    }
+    const auto rows = out.size() / row_bytes;
+    std::vector<iovec> remote;
+    remote.reserve((std::min)(rows, PROCESS_READ_ROWS_PER_CALL));
+    for (std::size_t row = 0; row < rows;) {
+        const auto batch = (std::min)(PROCESS_READ_ROWS_PER_CALL, rows - row);
+        remote.clear();
+        for (std::size_t i = 0; i < batch; ++i) {
+            // Addresses in the debuggee, never dereferenced here.
+            const auto at = address + (row + i) * row_step;
+            remote.push_back(
+                {.iov_base = reinterpret_cast<void*>(
+                     static_cast<std::uintptr_t>(at)),
+                 .iov_len = row_bytes});
+        }
+        auto local = iovec{.iov_base = out.data() + row * row_bytes,
+                           .iov_len = batch * row_bytes};
+        const auto read = process_vm_readv(static_cast<pid_t>(pid),
+                                           &local,
+                                           1,
+                                           remote.data(),
+                                           batch,
+                                           0);
+        const auto whole_rows =
+            read > 0 ? static_cast<std::size_t>(read) / row_bytes : 0;
+        row += whole_rows;
+        if (whole_rows < batch) {
+            // The kernel stops at the first row it could not read in one
+            // go; that row, read on its own, tells whether it can be read.
+            if (!read_chunk(static_cast<pid_t>(pid),
+                            address + row * row_step,
+                            out.subspan(row * row_bytes, row_bytes))) {
+                return false;
+            }
+            ++row;
+        }
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+} // namespace oid::system
@@ -0,0 +1,90 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef SYSTEM_PROCESS_PROCESS_MEMORY_H_
+#define SYSTEM_PROCESS_PROCESS_MEMORY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace oid::system {
+
+/**
+ * Largest piece of a read_process_memory() call read in one go, and so the
+ * unit its threads share the read by.
+ */
+constexpr std::size_t PROCESS_READ_CHUNK_BYTES = std::size_t{4} << 20;
+
+/**
+ * Most threads a read_process_memory() call reads on.
+ */
+constexpr std::size_t MAX_PROCESS_READ_THREADS = 4;
+
+/**
+ * Most rows a read_process_rows() call reads per system call: one iovec
+ * each, and IOV_MAX on Linux.
+ */
+constexpr std::size_t PROCESS_READ_ROWS_PER_CALL = 1024;
+
+/**
+ * Whether read_process_memory() is implemented here (Linux, with
+ * process_vm_readv()). Elsewhere it always fails.
+ */
+[[nodiscard]] bool can_read_process_memory();
+
+/**
+ * Copies out.size() bytes at `address` in the address space of process
+ * `pid` into `out`, straight from the kernel rather than through a
+ * debugger. The caller must be allowed to trace `pid`, as the debugger the
+ * bridge is loaded in is with its debuggee. Reads larger than a chunk are
+ * shared among up to `threads` threads.
+ * @return false if any byte could not be read (`pid` gone, not permitted,
+ *     an unmapped page); `out` then holds whatever was read
+ */
+[[nodiscard]] bool read_process_memory(long pid,
+                                       std::uint64_t address,
+                                       std::span<std::byte> out,
+                                       std::size_t threads =
+                                           MAX_PROCESS_READ_THREADS);
+
+/**
+ * Copies rows of `row_bytes` each out of process `pid` into `out`, back to
+ * back: the first at `address`, each next one `row_step` bytes past the one
+ * before, as many as `out` holds. Scatter reads, each taking up to
+ * PROCESS_READ_ROWS_PER_CALL rows, so only the rows asked for are read,
+ * e.g. every Nth row of an image for a quick look.
+ * @return false if any row could not be read, or `out` is not a whole
+ *     number of rows; `out` then holds whatever was read
+ */
+[[nodiscard]] bool read_process_rows(long pid,
+                                     std::uint64_t address,
+                                     std::uint64_t row_step,
+                                     std::size_t row_bytes,
+                                     std::span<std::byte> out);
+
+} // namespace oid::system
+
+#endif // #ifndef SYSTEM_PROCESS_PROCESS_MEMORY_H_
@@ -117,13 +117,91 @@ Buffer::~Buffer() noexcept {
     if (const auto canvas = gl_canvas()) {
         const auto num_textures = num_textures_x_ * num_textures_y_;
         canvas->glDeleteTextures(num_textures, buff_tex_.data());
+        for (const auto& [corner, detail] : detail_tex_) {
+            canvas->glDeleteTextures(1, &detail.texture);
+        }
         canvas->glDeleteBuffers(1, &vbo_);
     }
 }
 
+void Buffer::update_rows(const int first_row,
+                         const int row_count,
+                         const RangeUpdate range) {
+    const auto buffer_width_i = static_cast<int>(buffer_width_f_);
+    const auto buffer_height_i = static_cast<int>(buffer_height_f_);
+    const auto end_row = (std::min)(first_row + row_count, buffer_height_i);
+    if (first_row < 0 || first_row >= end_row) {
+        return;
+    }
+
+    const auto [tex_type, tex_format] = texture_type_and_format();
+
+    gl_canvas_ref().glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    gl_canvas_ref().glPixelStorei(GL_UNPACK_ROW_LENGTH, step_);
+
+    // Only the tile rows the range crosses are touched, and within each only
+    // the rows in range: the textures keep their size, so this is a plain
+    // sub-image upload rather than the reallocation setup_gl_buffer() does.
+    for (int ty = first_row / MAX_TEXTURE_SIZE;
+         ty < num_textures_y_ && ty * MAX_TEXTURE_SIZE < end_row;
+         ++ty) {
+        const auto tile_top = ty * MAX_TEXTURE_SIZE;
+        const auto band_first = (std::max)(first_row, tile_top);
+        const auto band_end = (std::min)(end_row, tile_top + MAX_TEXTURE_SIZE);
+
+        auto remaining_w = buffer_width_i;
+        for (int tx = 0; tx < num_textures_x_; ++tx) {
+            const auto buff_w = (std::min)(remaining_w, MAX_TEXTURE_SIZE);
+            remaining_w -= buff_w;
+
+            const auto tex_id = ty * num_textures_x_ + tx;
+            gl_canvas_ref().glBindTexture(GL_TEXTURE_2D, buff_tex_[tex_id]);
+
+            gl_canvas_ref().glPixelStorei(GL_UNPACK_SKIP_ROWS, band_first);
+            gl_canvas_ref().glPixelStorei(GL_UNPACK_SKIP_PIXELS,
+                                          tx * MAX_TEXTURE_SIZE);
+
+            gl_canvas_ref().glTexSubImage2D(
+                GL_TEXTURE_2D,
+                0,
+                0,
+                band_first - tile_top,
+                buff_w,
+                band_end - band_first,
+                tex_format,
+                tex_type,
+                std::bit_cast<const GLvoid*>(buffer_.data()));
+        }
+    }
+
+    gl_canvas_ref().glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    gl_canvas_ref().glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+    gl_canvas_ref().glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+
+    // The changed rows may have moved the value range.
+    if (range == RangeUpdate::RESCAN) {
+        reset_contrast_brightness_parameters();
+        return;
+    }
+    auto lowest = min_buffer_values();
+    auto upper = max_buffer_values();
+    for (int y = first_row; y < end_row; ++y) {
+        for (int x = 0; x < buffer_width_i; ++x) {
+            const auto i = y * step_ + x;
+            for (int c = 0; c < channels_; ++c) {
+                update_min_color_value(lowest.data(), i, c);
+                update_max_color_value(upper.data(), i, c);
+            }
+        }
+    }
+    compute_contrast_brightness_parameters();
+}
+
 bool Buffer::buffer_update() {
     const auto num_textures = num_textures_x_ * num_textures_y_;
     gl_canvas_ref().glDeleteTextures(num_textures, buff_tex_.data());
+    // A re-plot brings its own tiles, if any.
+    release_detail_tiles();
 
     if (!create_shader_program()) {
         return false;
@@ -132,16 +210,23 @@ bool Buffer::buffer_update() {
     return true;
 }
 
+int Buffer::decimation() const {
+    return decimation_;
+}
+
 void Buffer::get_pixel_info(std::stringstream& message,
                             const int x,
                             const int y) const {
-    if (x < 0 || static_cast<float>(x) >= buffer_width_f_ || y < 0 ||
-        static_cast<float>(y) >= buffer_height_f_) {
+    // The pixel of this buffer covering (x, y).
+    const auto col = x / decimation_;
+    const auto row = y / decimation_;
+    if (x < 0 || static_cast<float>(col) >= buffer_width_f_ || y < 0 ||
+        static_cast<float>(row) >= buffer_height_f_) {
         message << "[out of bounds]";
         return;
     }
 
-    const auto pos = channels_ * (y * step_ + x);
+    const auto pos = channels_ * (row * step_ + col);
     const auto [start_ch, end_ch] = get_channel_range(
         display_channel_mode_, channels_, pixel_layout_.data());
 
@@ -433,6 +518,7 @@ void Buffer::configure(const BufferParams& params) {
     buffer_height_f_ = static_cast<float>(params.buffer_height_i);
     step_ = params.step;
     transpose_ = params.transpose_buffer;
+    decimation_ = (std::max)(1, params.decimation);
     // Only update pixel layout during initial setup, not on buffer updates
     // This preserves user-selected pixel formats when buffer updates
     if (buff_tex_.empty() && !params.pixel_layout.empty() &&
@@ -719,6 +805,50 @@ void Buffer::draw(const mat4& projection, const mat4& viewInv) {
 
         py += static_cast<float>(buff_h) / 2.0f;
     }
+
+    if (detail_tex_.empty()) {
+        return;
+    }
+
+    // The top-left corner of the first tile drawn above, from which every
+    // detail tile is offset by its position in overview pixels.
+    const auto first_w = (std::min)(buffer_width_i, MAX_TEXTURE_SIZE);
+    const auto first_h = (std::min)(buffer_height_i, MAX_TEXTURE_SIZE);
+    const auto origin_x = static_cast<float>(-buffer_width_i) / 2.0f -
+                          (buffer_width_i % 2 == 1 ? 0.5f : 0.0f) +
+                          (first_w % 2 == 1 ? 0.5f : 0.0f);
+    const auto origin_y = static_cast<float>(-buffer_height_i) / 2.0f -
+                          (buffer_height_i % 2 == 1 ? 0.5f : 0.0f) +
+                          (first_h % 2 == 1 ? 0.5f : 0.0f);
+    const auto scale = 1.0f / static_cast<float>(decimation_);
+
+    for (const auto& [corner, detail] : detail_tex_) {
+        const auto [row, col] = corner;
+        const auto w = static_cast<float>(detail.cols) * scale;
+        const auto h = static_cast<float>(detail.rows) * scale;
+
+        gl_canvas_ref().glBindTexture(GL_TEXTURE_2D, detail.texture);
+
+        auto tile_model = mat4{};
+        tile_model.set_from_st(w,
+                               h,
+                               1.0f,
+                               origin_x + static_cast<float>(col) * scale +
+                                   w / 2.0f,
+                               origin_y + static_cast<float>(row) * scale +
+                                   h / 2.0f,
+                               0.0f);
+        buff_prog_.uniform_matrix4fv(
+            "mvp", 1, GL_FALSE, (mvp * tile_model).data());
+        buff_prog_.uniform2f("buffer_dimension",
+                             static_cast<float>(detail.cols),
+                             static_cast<float>(detail.rows));
+
+        gl_canvas_ref().glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+        gl_canvas_ref().glVertexAttribPointer(
+            0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+        gl_canvas_ref().glDrawArrays(GL_TRIANGLES, 0, 6);
+    }
 }
 
 const std::vector<GLuint>& Buffer::buff_tex() const {
@@ -777,24 +907,7 @@ const float* Buffer::auto_buffer_contrast_brightness() const {
     return auto_buffer_contrast_brightness_.data();
 }
 
-void Buffer::setup_gl_buffer() {
-    const auto buffer_width_i = static_cast<int>(buffer_width_f_);
-    const auto buffer_height_i = static_cast<int>(buffer_height_f_);
-
-    // Initialize contrast parameters
-    reset_contrast_brightness_parameters();
-
-    // Buffer texture
-    constexpr auto max_texture_size_f = static_cast<float>(MAX_TEXTURE_SIZE);
-    num_textures_x_ = static_cast<int>(
-        std::ceil(static_cast<float>(buffer_width_i) / max_texture_size_f));
-    num_textures_y_ = static_cast<int>(
-        std::ceil(static_cast<float>(buffer_height_i) / max_texture_size_f));
-    const int num_textures = num_textures_x_ * num_textures_y_;
-
-    buff_tex_.resize(num_textures);
-    gl_canvas_ref().glGenTextures(num_textures, buff_tex_.data());
-
+std::pair<GLuint, GLuint> Buffer::texture_type_and_format() const {
     auto tex_type = GLuint{GL_UNSIGNED_BYTE};
     auto tex_format = GLuint{GL_RED};
 
@@ -820,8 +933,26 @@ void Buffer::setup_gl_buffer() {
         tex_format = GL_RGBA;
     }
 
-    const auto internal_format =
-        GlDialect::texture_internal_format(tex_type, tex_format);
+    return {tex_type, tex_format};
+}
+
+void Buffer::setup_gl_buffer() {
+    const auto buffer_width_i = static_cast<int>(buffer_width_f_);
+    const auto buffer_height_i = static_cast<int>(buffer_height_f_);
+
+    // Initialize contrast parameters
+    reset_contrast_brightness_parameters();
+
+    // Buffer texture
+    constexpr auto max_texture_size_f = static_cast<float>(MAX_TEXTURE_SIZE);
+    num_textures_x_ = static_cast<int>(
+        std::ceil(static_cast<float>(buffer_width_i) / max_texture_size_f));
+    num_textures_y_ = static_cast<int>(
+        std::ceil(static_cast<float>(buffer_height_i) / max_texture_size_f));
+    const int num_textures = num_textures_x_ * num_textures_y_;
+
+    buff_tex_.resize(num_textures);
+    gl_canvas_ref().glGenTextures(num_textures, buff_tex_.data());
 
     auto remaining_h = buffer_height_i;
 
@@ -845,39 +976,7 @@ void Buffer::setup_gl_buffer() {
             gl_canvas_ref().glPixelStorei(GL_UNPACK_SKIP_PIXELS,
                                           tx * MAX_TEXTURE_SIZE);
 
-            gl_canvas_ref().glTexImage2D(GL_TEXTURE_2D,
-                                         0,
-                                         static_cast<GLint>(internal_format),
-                                         buff_w,
-                                         buff_h,
-                                         0,
-                                         tex_format,
-                                         tex_type,
-                                         nullptr);
-
-            gl_canvas_ref().glTexSubImage2D(
-                GL_TEXTURE_2D,
-                0,
-                0,
-                0,
-                buff_w,
-                buff_h,
-                tex_format,
-                tex_type,
-                std::bit_cast<const GLvoid*>(buffer_.data()));
-
-            gl_canvas_ref().glTexParameteri(
-                GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-            gl_canvas_ref().glTexParameteri(
-                GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-            gl_canvas_ref().glTexParameteri(
-                GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-            gl_canvas_ref().glTexParameteri(
-                GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-            if (the_dialect().has_texture_wrap_r) {
-                gl_canvas_ref().glTexParameteri(
-                    GL_TEXTURE_2D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-            }
+            upload_texture(buff_w, buff_h, buffer_.data());
         }
     }
 
@@ -886,4 +985,75 @@ void Buffer::setup_gl_buffer() {
     gl_canvas_ref().glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
 }
 
+void Buffer::upload_texture(const int cols,
+                            const int rows,
+                            const std::byte* pixels) const {
+    const auto [tex_type, tex_format] = texture_type_and_format();
+
+    const auto internal_format =
+        GlDialect::texture_internal_format(tex_type, tex_format);
+
+    gl_canvas_ref().glTexImage2D(GL_TEXTURE_2D,
+                                 0,
+                                 static_cast<GLint>(internal_format),
+                                 cols,
+                                 rows,
+                                 0,
+                                 tex_format,
+                                 tex_type,
+                                 nullptr);
+
+    gl_canvas_ref().glTexSubImage2D(GL_TEXTURE_2D,
+                                    0,
+                                    0,
+                                    0,
+                                    cols,
+                                    rows,
+                                    tex_format,
+                                    tex_type,
+                                    std::bit_cast<const GLvoid*>(pixels));
+
+    gl_canvas_ref().glTexParameteri(
+        GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    gl_canvas_ref().glTexParameteri(
+        GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    gl_canvas_ref().glTexParameteri(
+        GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    gl_canvas_ref().glTexParameteri(
+        GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    if (the_dialect().has_texture_wrap_r) {
+        gl_canvas_ref().glTexParameteri(
+            GL_TEXTURE_2D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    }
+}
+
+void Buffer::set_detail_tiles(const std::span<const DetailTile> tiles) {
+    std::map<std::pair<int, int>, DetailTexture> kept;
+    gl_canvas_ref().glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for (const auto& tile : tiles) {
+        const auto corner = std::pair{tile.row, tile.col};
+        if (const auto it = detail_tex_.find(corner);
+            it != detail_tex_.end()) {
+            kept.insert(detail_tex_.extract(it));
+            continue;
+        }
+        auto detail = DetailTexture{.rows = tile.rows, .cols = tile.cols};
+        gl_canvas_ref().glGenTextures(1, &detail.texture);
+        gl_canvas_ref().glBindTexture(GL_TEXTURE_2D, detail.texture);
+        upload_texture(tile.cols, tile.rows, tile.bytes.data());
+        kept.emplace(corner, detail);
+    }
+
+    // Whatever is left was not listed this time.
+    release_detail_tiles();
+    detail_tex_ = std::move(kept);
+}
+
+void Buffer::release_detail_tiles() {
+    for (const auto& [corner, detail] : detail_tex_) {
+        gl_canvas_ref().glDeleteTextures(1, &detail.texture);
+    }
+    detail_tex_.clear();
+}
+
 } // namespace oid
@@ -28,9 +28,11 @@
 
 #include <array>
 #include <cstdint>
+#include <map>
 #include <span>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "component.h"
@@ -56,6 +58,9 @@ struct BufferParams {
     int step;
     std::string pixel_layout;
     bool transpose_buffer;
+    // Above 1 for a decimated overview: every `decimation`-th pixel of every
+    // `decimation`-th row of the buffer it stands for.
+    int decimation;
 };
 
 class Buffer final : public Component {
@@ -77,8 +82,43 @@ class Buffer final : public Component {
 
     static const std::array<float, 8> NO_AC_PARAMS;
 
+    // Full-resolution pixels of part of the buffer this one is a decimated
+    // overview of, in that buffer's pixels; `bytes` holds packed rows in
+    // this buffer's type and channel count.
+    struct DetailTile {
+        int row{};
+        int col{};
+        int rows{};
+        int cols{};
+        std::span<const std::byte> bytes{};
+    };
+
     [[nodiscard]] bool buffer_update() override;
 
+    // How update_rows() brings the value range behind the automatic
+    // contrast up to date.
+    enum class RangeUpdate : std::uint8_t {
+        // Rescans the whole buffer: exact whatever the rows held before.
+        RESCAN,
+        // Widens the range by the rows uploaded alone, for rows filled in
+        // on top of a stand-in (a buffer still arriving): the range never
+        // narrows, but the cost follows the rows, not the buffer.
+        WIDEN,
+    };
+
+    // Re-uploads rows [first_row, first_row + row_count) of the buffer to
+    // the textures already built for it, after they were rewritten in place.
+    // The geometry must be the one the textures were built from.
+    void update_rows(int first_row,
+                     int row_count,
+                     RangeUpdate range = RangeUpdate::RESCAN);
+
+    // Draws `tiles` over the buffer, each scaled down by decimation() to
+    // the overview pixels it replaces. Textures of tiles already on show
+    // are kept (tiles are identified by their top-left corner), those of
+    // tiles no longer listed released; an empty list drops them all.
+    void set_detail_tiles(std::span<const DetailTile> tiles);
+
     void recompute_min_color_values();
 
     void recompute_max_color_values();
@@ -136,6 +176,15 @@ class Buffer final : public Component {
 
     [[nodiscard]] const float* auto_buffer_contrast_brightness() const;
 
+    // How many pixels of the buffer this one stands for lie along each
+    // side of one of its own: 1 unless it is a decimated overview (see
+    // BufferParams::decimation). Pixel coordinates shown to the user are in
+    // that buffer's pixels, so they keep their meaning when it replaces
+    // the overview.
+    [[nodiscard]] int decimation() const;
+
+    // Appends the value of pixel (x, y) of the buffer this one stands for,
+    // that is of the overview pixel covering it, or "[out of bounds]".
     void get_pixel_info(std::stringstream& message, int x, int y) const;
 
     void rotate(float angle);
@@ -150,8 +199,17 @@ class Buffer final : public Component {
   private:
     bool create_shader_program();
 
+    // GL pixel type and format of the buffer's texels.
+    [[nodiscard]] std::pair<GLuint, GLuint> texture_type_and_format() const;
+
     void setup_gl_buffer();
 
+    // Defines the bound texture as `cols` x `rows` texels read from
+    // `pixels` under the current unpack state, and sets its sampling.
+    void upload_texture(int cols, int rows, const std::byte* pixels) const;
+
+    void release_detail_tiles();
+
     void update_object_pose() const;
 
     void update_min_color_value(float* lowest, int i, int c) const;
@@ -160,6 +218,15 @@ class Buffer final : public Component {
 
     std::vector<GLuint> buff_tex_{};
 
+    struct DetailTexture {
+        GLuint texture{};
+        int rows{};
+        int cols{};
+    };
+    // Keyed by (row, col) of the tile's corner; see set_detail_tiles().
+    std::map<std::pair<int, int>, DetailTexture> detail_tex_{};
+    int decimation_{1};
+
     float buffer_width_f_{};
     float buffer_height_f_{};
 
@@ -59,7 +59,7 @@ Camera::Camera(const Camera& cam)
       mouse_position_{cam.mouse_position_}, zoom_power_{cam.zoom_power_},
       camera_pos_x_{cam.camera_pos_x_}, camera_pos_y_{cam.camera_pos_y_},
       canvas_width_{cam.canvas_width_}, canvas_height_{cam.canvas_height_},
-      scale_{cam.scale_} {
+      scale_{cam.scale_}, decimation_{cam.decimation_} {
     update_object_pose();
 }
 
@@ -76,6 +76,7 @@ Camera& Camera::operator=(const Camera& cam) {
     canvas_width_ = cam.canvas_width_;
     canvas_height_ = cam.canvas_height_;
     scale_ = cam.scale_;
+    decimation_ = cam.decimation_;
 
     update_object_pose();
 
@@ -151,6 +152,7 @@ bool Camera::post_initialize() {
                    gl_canvas_ref().render_height());
     set_initial_zoom();
     update_object_pose();
+    decimation_ = buffer_decimation();
 
     return true;
 }
@@ -471,6 +473,19 @@ vec4 Camera::get_position() const {
            buffer_obj->get().get_pose().inv() * scale_ * pos_vec;
 }
 
+void Camera::move_to_source(const float x, const float y) {
+    const auto decimation = static_cast<float>(buffer_decimation());
+    move_to(x / decimation, y / decimation);
+}
+
+vec4 Camera::get_source_position() const {
+    const auto decimation = static_cast<float>(buffer_decimation());
+    auto position = get_position();
+    position.x() *= decimation;
+    position.y() *= decimation;
+    return position;
+}
+
 void Camera::recenter_camera() {
     camera_pos_x_ = 0.0f;
     camera_pos_y_ = 0.0f;
@@ -488,7 +503,36 @@ void Camera::mouse_drag_event(const int mouse_x, const int mouse_y) {
 }
 
 bool Camera::post_buffer_update() {
+    // A quick look replaced by its buffer in full (or the other way round):
+    // the same pixels stay on screen at the same size. camera_pos_ is the
+    // zoomed offset from the buffer's centre, which both share, so only
+    // the zoom changes, by the ratio of the decimations.
+    const auto decimation = buffer_decimation();
+    if (decimation != decimation_) {
+        zoom_power_ += std::log(static_cast<float>(decimation) /
+                                static_cast<float>(decimation_)) /
+                       std::log(ZOOM_FACTOR);
+        decimation_ = decimation;
+
+        const auto zoom{1.0f / compute_zoom()};
+        scale_ = mat4::scale(vec4(zoom, zoom, 1.0f, 1.0f));
+        update_object_pose();
+    }
     return true;
 }
 
+int Camera::buffer_decimation() const {
+    const auto stage = game_object_ref().get_stage();
+    if (!stage.has_value()) {
+        return 1;
+    }
+    const auto buffer_obj = stage->get().get_game_object("buffer");
+    if (!buffer_obj.has_value()) {
+        return 1;
+    }
+    const auto buff_opt =
+        buffer_obj->get().get_component<Buffer>("buffer_component");
+    return buff_opt.has_value() ? buff_opt->get().decimation() : 1;
+}
+
 } // namespace oid
@@ -78,10 +78,25 @@ class Camera final : public Component {
 
     [[nodiscard]] vec4 get_position() const;
 
+    // move_to() and get_position() in pixels of the buffer the one on show
+    // stands for (see Buffer::decimation()): the coordinates the user sees.
+    void move_to_source(float x, float y);
+
+    [[nodiscard]] vec4 get_source_position() const;
+
     [[nodiscard]] float get_zoom_power() const;
 
     void set_zoom_power(float zoom_power);
 
+    // Size of the canvas the camera projects onto, in screen pixels.
+    [[nodiscard]] int canvas_width() const noexcept {
+        return canvas_width_;
+    }
+
+    [[nodiscard]] int canvas_height() const noexcept {
+        return canvas_height_;
+    }
+
   private:
     void update_object_pose() const;
 
@@ -93,6 +108,9 @@ class Camera final : public Component {
 
     void handle_key_events();
 
+    // Buffer::decimation() of the buffer on show; 1 without one.
+    [[nodiscard]] int buffer_decimation() const;
+
     mat4 projection_{};
     vec4 mouse_position_{vec4::zero()};
     float zoom_power_{0.0f};
@@ -103,6 +121,10 @@ class Camera final : public Component {
     int canvas_height_{0};
 
     mat4 scale_{};
+
+    // buffer_decimation() when the buffer was last configured; see
+    // post_buffer_update().
+    int decimation_{1};
 };
 
 } // namespace oid
@@ -175,6 +175,32 @@ bool Stage::buffer_update(const BufferParams& params) {
     return true;
 }
 
+bool Stage::update_buffer_rows(const BufferParams& params,
+                               const int first_row,
+                               const int row_count,
+                               const Buffer::RangeUpdate range) {
+    const auto buffer_it = all_game_objects.find("buffer");
+    if (buffer_it == all_game_objects.end() || !buffer_it->second)
+        [[unlikely]] {
+        std::cerr << "[Error] Buffer game object not found" << std::endl;
+        return false;
+    }
+
+    const auto buffer_component_opt =
+        buffer_it->second->get_component<Buffer>("buffer_component");
+
+    if (!buffer_component_opt.has_value()) [[unlikely]] {
+        std::cerr << "[Error] Buffer component not found" << std::endl;
+        return false;
+    }
+
+    auto& buffer_component = buffer_component_opt->get();
+    buffer_component.configure(params);
+    buffer_component.update_rows(first_row, row_count, range);
+
+    return true;
+}
+
 std::optional<std::reference_wrapper<GameObject>>
 Stage::get_game_object(const std::string& tag) {
     if (!all_game_objects.contains(tag)) {
@@ -286,7 +312,7 @@ void Stage::go_to_pixel(const float x, const float y) const {
     }
 
     auto& camera_component = camera_component_opt->get();
-    camera_component.move_to(x, y);
+    camera_component.move_to_source(x, y);
 }
 
 void Stage::set_icon_drawing_mode(const bool is_enabled) {
@@ -50,6 +50,15 @@ class Stage {
 
     [[nodiscard]] bool buffer_update(const BufferParams& params);
 
+    // Cheaper buffer_update() for a buffer whose geometry is unchanged and
+    // whose rows [first_row, first_row + row_count) alone were rewritten:
+    // re-uploads just those rows, leaving every other component untouched.
+    [[nodiscard]] bool update_buffer_rows(
+        const BufferParams& params,
+        int first_row,
+        int row_count,
+        Buffer::RangeUpdate range = Buffer::RangeUpdate::RESCAN);
+
     [[nodiscard]] std::optional<std::reference_wrapper<GameObject>>
     get_game_object(const std::string& tag);
 
@@ -67,6 +76,8 @@ class Stage {
 
     [[nodiscard]] EventProcessCode key_press_event(int key_code) const;
 
+    // Centres the view on (x, y), in pixels of the buffer a decimated
+    // overview stands for (see Camera::move_to_source()).
     void go_to_pixel(float x, float y) const;
 
     void set_icon_drawing_mode(bool is_enabled);
@@ -0,0 +1,200 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+// Decoding small-field traffic off a loopback AsioTransport pair, read
+// straight from the socket and through a BufferedTransport:
+//   - one SET_AVAILABLE_SYMBOLS carrying every symbol name, and
+//   - a run of PLOT_BUFFER_UNCHANGED messages (a type and a name each), the
+//     bulk of a debugger stop where nothing changed.
+//
+//   decode_bench [--messages N] [SYMBOLS...]
+//                          (defaults: 10000 messages, 50000 symbols)
+//
+// Each row is the best of three runs. The receives column counts the calls
+// that reached the socket.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "ipc/asio_transport.h"
+#include "ipc/buffered_transport.h"
+#include "ipc/message_exchange.h"
+
+namespace {
+
+using namespace oid;
+
+constexpr int RUNS = 3;
+
+// Counts the receives that reach `inner`.
+class CountingTransport final : public ITransport {
+  public:
+    explicit CountingTransport(ITransport& inner) : inner_{inner} {}
+
+    void send(const std::span<const std::byte> data) override {
+        inner_.send(data);
+    }
+    std::size_t receive(const std::span<std::byte> dst) override {
+        ++receives;
+        return inner_.receive(dst);
+    }
+    bool has_data() const override {
+        return inner_.has_data();
+    }
+
+    std::size_t receives{0};
+
+  private:
+    ITransport& inner_;
+};
+
+struct Workload {
+    std::deque<std::string> symbols;
+    std::size_t messages;
+};
+
+void send_workload(ITransport& transport, const Workload& workload) {
+    MessageComposer{}
+        .push(MessageType::SET_AVAILABLE_SYMBOLS)
+        .push(workload.symbols)
+        .send(transport);
+    for (std::size_t i = 0; i < workload.messages; ++i) {
+        MessageComposer{}
+            .push(MessageType::PLOT_BUFFER_UNCHANGED)
+            .push(workload.symbols[i % workload.symbols.size()])
+            .send(transport);
+    }
+}
+
+void receive_workload(ITransport& transport, const Workload& workload) {
+    auto type = MessageType{};
+    auto symbols = std::deque<std::string>{};
+    MessageDecoder{transport}.read(type).read<std::deque<std::string>,
+                                              std::string>(symbols);
+    auto name = std::string{};
+    for (std::size_t i = 0; i < workload.messages; ++i) {
+        MessageDecoder{transport}.read(type).read(name);
+    }
+    if (symbols.size() != workload.symbols.size()) {
+        std::fprintf(stderr, "transfer incomplete\n");
+        std::exit(1);
+    }
+}
+
+struct Result {
+    double seconds;
+    std::size_t receives;
+};
+
+Result run(ITransport& sender,
+           ITransport& receiver,
+           const Workload& workload,
+           const bool buffered) {
+    auto best = Result{.seconds = 1e9, .receives = 0};
+    for (int i = 0; i < RUNS; ++i) {
+        CountingTransport counted{receiver};
+        BufferedTransport read_ahead{counted};
+        ITransport& decode_from =
+            buffered ? static_cast<ITransport&>(read_ahead) : counted;
+
+        const auto start = std::chrono::steady_clock::now();
+        std::jthread bridge(
+            [&sender, &workload] { send_workload(sender, workload); });
+        receive_workload(decode_from, workload);
+        bridge.join();
+        const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start;
+        if (elapsed.count() < best.seconds) {
+            best = {.seconds = elapsed.count(), .receives = counted.receives};
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+int main(const int argc, char** argv) {
+    std::size_t messages = 10000;
+    std::vector<std::size_t> symbol_counts;
+    for (int i = 1; i < argc; ++i) {
+        if (const std::string_view arg{argv[i]};
+            arg == "--messages" && i + 1 < argc) {
+            messages = std::strtoull(argv[++i], nullptr, 10);
+        } else {
+            symbol_counts.push_back(std::strtoull(argv[i], nullptr, 10));
+        }
+    }
+    if (symbol_counts.empty()) {
+        symbol_counts = {50000};
+    }
+
+    AsioAcceptor acceptor;
+    std::optional<AsioTransport> receiver;
+    std::jthread accept_thread([&acceptor, &receiver] {
+        receiver.emplace(acceptor.accept(std::chrono::seconds{5}));
+    });
+    AsioTransport sender{"127.0.0.1", acceptor.port()};
+    accept_thread.join();
+    if (!receiver.has_value() || !sender.is_connected()) {
+        std::fprintf(stderr, "could not set up the loopback connection\n");
+        return 1;
+    }
+
+    std::printf("%10s %10s %12s %12s %14s %14s\n",
+                "symbols",
+                "messages",
+                "direct_s",
+                "buffered_s",
+                "direct_recvs",
+                "buffered_recvs");
+    for (const auto count : symbol_counts) {
+        auto workload = Workload{.symbols = {}, .messages = messages};
+        for (std::size_t i = 0; i < std::max<std::size_t>(count, 1); ++i) {
+            workload.symbols.push_back("frame.layers[" + std::to_string(i) +
+                                       "].activation");
+        }
+
+        const auto direct = run(sender, *receiver, workload, false);
+        const auto buffered = run(sender, *receiver, workload, true);
+        std::printf("%10zu %10zu %12.4f %12.4f %14zu %14zu\n",
+                    count,
+                    messages,
+                    direct.seconds,
+                    buffered.seconds,
+                    direct.receives,
+                    buffered.receives);
+    }
+    return 0;
+}
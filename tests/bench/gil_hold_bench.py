@@ -0,0 +1,148 @@
+#!/usr/bin/python3
+
+# -*- coding: utf-8 -*-
+
+"""
+How long oid_plot_buffer holds the GIL, that is keeps the debugger's other
+Python threads (pretty-printers, the agent endpoint) from running, per plot
+of one RGBA float buffer.
+
+    gil_hold_bench.py OID_DIR [--plots N] [WIDTHxHEIGHT...]
+                                          (default size: 4096x4096)
+
+OID_DIR is the OpenImageDebugger installation (liboidbridge.so and
+oidwindow); a window is launched from it. Each size is plotted N times
+(default 20), from a fresh buffer every time, as the debugger bridges do.
+A second thread ticks as fast as the GIL lets it: its longest pause during
+a call is how long the call held the GIL, to about the switch interval set
+below. ctypes releases the GIL around the call itself, so that pause is
+the bridge's own.
+"""
+
+import argparse
+import ctypes
+import os
+import statistics
+import sys
+import threading
+import time
+
+FETCH_BUFFER_CBK_TYPE = ctypes.CFUNCTYPE(ctypes.c_int, ctypes.c_char_p)
+
+OID_TYPES_FLOAT32 = 5
+CHANNELS = 4
+SWITCH_INTERVAL_S = 50e-6
+
+
+class GilWatch(threading.Thread):
+    """
+    Ticks while it gets the GIL, keeping the longest pause since reset().
+    """
+    def __init__(self):
+        super().__init__(daemon=True)
+        self.running = True
+        self.reset()
+
+    def reset(self):
+        self.last = time.perf_counter()
+        self.longest = 0.0
+
+    def run(self):
+        while self.running:
+            now = time.perf_counter()
+            self.longest = max(self.longest, now - self.last)
+            self.last = now
+
+
+def load_bridge(oid_dir):
+    lib = ctypes.cdll.LoadLibrary(os.path.join(oid_dir, 'liboidbridge.so'))
+    lib.oid_initialize.argtypes = [FETCH_BUFFER_CBK_TYPE, ctypes.py_object]
+    lib.oid_initialize.restype = ctypes.c_void_p
+    lib.oid_exec.argtypes = [ctypes.c_void_p]
+    lib.oid_exec.restype = None
+    lib.oid_is_window_ready.argtypes = [ctypes.c_void_p]
+    lib.oid_is_window_ready.restype = ctypes.c_bool
+    lib.oid_run_event_loop.argtypes = [ctypes.c_void_p]
+    lib.oid_run_event_loop.restype = None
+    lib.oid_plot_buffer.argtypes = [ctypes.c_void_p, ctypes.py_object]
+    lib.oid_plot_buffer.restype = None
+    lib.oid_cleanup.argtypes = [ctypes.c_void_p]
+    lib.oid_cleanup.restype = None
+    return lib
+
+
+def parse_size(text):
+    width, height = text.lower().split('x')
+    return int(width), int(height)
+
+
+def bench_size(lib, handler, watch, width, height, plots):
+    byte_size = width * height * CHANNELS * 4
+    held_ms = []
+    call_ms = []
+    for plot in range(plots):
+        pixels = bytearray(byte_size)
+        pixels[0] = plot % 256
+        metadata = {
+            'variable_name': 'bench',
+            'display_name': 'float* bench',
+            'pointer': memoryview(pixels),
+            'width': width,
+            'height': height,
+            'channels': CHANNELS,
+            'type': OID_TYPES_FLOAT32,
+            'row_stride': width,
+            'pixel_layout': 'rgba',
+            'transpose_buffer': False
+        }
+
+        watch.reset()
+        start = time.perf_counter()
+        lib.oid_plot_buffer(handler, metadata)
+        end = time.perf_counter()
+        held_ms.append(max(watch.longest, end - watch.last) * 1e3)
+        call_ms.append((end - start) * 1e3)
+
+        lib.oid_run_event_loop(handler)
+
+    print('%5dx%-5d %8.1f MiB  GIL held: median %8.3f ms, max %8.3f ms'
+          '  call: median %8.3f ms' %
+          (width, height, byte_size / (1024.0 * 1024.0),
+           statistics.median(held_ms), max(held_ms),
+           statistics.median(call_ms)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n')[0])
+    parser.add_argument('oid_dir')
+    parser.add_argument('--plots', type=int, default=20)
+    parser.add_argument('sizes', nargs='*', type=parse_size,
+                        default=[(4096, 4096)])
+    args = parser.parse_args()
+
+    lib = load_bridge(args.oid_dir)
+    plot_callback = FETCH_BUFFER_CBK_TYPE(lambda name: 1)
+    handler = lib.oid_initialize(plot_callback, {'oid_path': args.oid_dir})
+    lib.oid_exec(handler)
+    deadline = time.monotonic() + 10.0
+    while not lib.oid_is_window_ready(handler):
+        if time.monotonic() > deadline:
+            sys.exit('gil_hold_bench: the window did not start')
+        time.sleep(0.1)
+    # Takes in the window's capabilities
+    lib.oid_run_event_loop(handler)
+
+    sys.setswitchinterval(SWITCH_INTERVAL_S)
+    watch = GilWatch()
+    watch.start()
+    try:
+        for width, height in args.sizes:
+            bench_size(lib, handler, watch, width, height, args.plots)
+    finally:
+        watch.running = False
+        watch.join()
+        lib.oid_cleanup(handler)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,229 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+// Peak memory and wall time of shipping one PLOT_BUFFER_CONTENTS-shaped
+// message over a loopback AsioTransport pair, for a range of payload sizes.
+//
+//   ipc_send_bench [--flatten | --shm] [--unix] [SIZE_MB...]
+//                                   (default sizes: 100 512 1024 2048 4096)
+//
+// By default MessageComposer::send() hands the payload to the transport as a
+// gathered write; --flatten routes the same message through ITransport's
+// default send_gather(), which first copies everything into one frame -- the
+// path every send took before the gathered write existed. --shm moves the
+// payload through a SharedMemoryTransport ring instead, with the socket
+// carrying only the record headers. --unix connects the pair over a
+// Unix-domain socket, as the bridge and a window on the same host do,
+// rather than TCP loopback; run once with and once without it to compare
+// the two sockets' throughput. Run each mode in
+// its own process: peak RSS is per process and only ever grows, so sizes
+// are measured in ascending order and each row reports the high-water mark
+// reached by that size. The receiving side drains into a fixed 1 MiB buffer
+// and keeps nothing, so the numbers are the sending side's.
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "ipc/asio_transport.h"
+#include "ipc/message_exchange.h"
+#include "ipc/shm_transport.h"
+
+namespace {
+
+using namespace oid;
+
+// Forwards send() and nothing else, so MessageComposer falls back to the
+// flattening send_gather() ITransport provides by default.
+struct FlatteningTransport final : ITransport {
+    explicit FlatteningTransport(ITransport& inner) : inner_{inner} {}
+    void send(const std::span<const std::byte> data) override {
+        inner_.send(data);
+    }
+    std::size_t receive(const std::span<std::byte> dst) override {
+        return inner_.receive(dst);
+    }
+    bool has_data() const override {
+        return inner_.has_data();
+    }
+
+  private:
+    ITransport& inner_;
+};
+
+double peak_rss_mib() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    const auto bytes = static_cast<double>(usage.ru_maxrss);
+#else
+    const auto bytes = static_cast<double>(usage.ru_maxrss) * 1024.0;
+#endif
+    return bytes / (1024.0 * 1024.0);
+}
+
+struct Result {
+    double seconds;
+    double peak_mib;
+};
+
+Result run_one(ITransport& sender,
+               ITransport& receiver,
+               const std::size_t payload_bytes,
+               const bool flatten) {
+    // Touched up front, like an inferior's memory that gdb has already read:
+    // the payload itself is resident before the clock starts.
+    const auto payload = std::make_unique<std::byte[]>(payload_bytes);
+    std::memset(payload.get(), 0x5a, payload_bytes);
+
+    const auto header_bytes = sizeof(MessageType) + sizeof(std::size_t);
+    const auto expected = header_bytes + payload_bytes;
+    std::jthread drain([&receiver, expected] {
+        std::vector<std::byte> sink(1024 * 1024);
+        std::size_t got = 0;
+        while (got < expected) {
+            got += receiver.receive(std::span{sink}.first(
+                (std::min)(sink.size(), expected - got)));
+        }
+    });
+
+    const auto start = std::chrono::steady_clock::now();
+    MessageComposer composer;
+    composer.push(MessageType::PLOT_BUFFER_CONTENTS)
+        .push(std::span<const std::byte>{payload.get(), payload_bytes});
+    if (flatten) {
+        FlatteningTransport flattening{sender};
+        composer.send(flattening);
+    } else {
+        composer.send(sender);
+    }
+    drain.join();
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return {elapsed.count(), peak_rss_mib()};
+}
+
+} // namespace
+
+int main(const int argc, char** argv) {
+    bool flatten = false;
+    bool shm = false;
+    bool unix_socket = false;
+    std::vector<std::size_t> sizes_mib;
+    for (int i = 1; i < argc; ++i) {
+        if (const std::string_view arg{argv[i]}; arg == "--flatten") {
+            flatten = true;
+        } else if (arg == "--shm") {
+            shm = true;
+        } else if (arg == "--unix") {
+            unix_socket = true;
+        } else {
+            sizes_mib.push_back(std::strtoull(argv[i], nullptr, 10));
+        }
+    }
+    if (sizes_mib.empty()) {
+        sizes_mib = {100, 512, 1024, 2048, 4096};
+    }
+    std::ranges::sort(sizes_mib);
+
+    // Both outlive the transports; the accepted one references its acceptor.
+    std::optional<AsioAcceptor> acceptor;
+    std::optional<AsioLocalAcceptor> local_acceptor;
+    std::optional<AsioTransport> receiver;
+    std::optional<AsioTransport> sender;
+    if (unix_socket) {
+        local_acceptor.emplace();
+        std::jthread accept_thread([&local_acceptor, &receiver] {
+            receiver.emplace(local_acceptor->accept(std::chrono::seconds{5}));
+        });
+        sender.emplace(
+            asio::local::stream_protocol::endpoint{local_acceptor->path()});
+    } else {
+        acceptor.emplace();
+        std::jthread accept_thread([&acceptor, &receiver] {
+            receiver.emplace(acceptor->accept(std::chrono::seconds{5}));
+        });
+        sender.emplace("127.0.0.1", acceptor->port());
+    }
+    if (!receiver.has_value() || !sender->is_connected()) {
+        std::fprintf(stderr, "could not set up the loopback connection\n");
+        return 1;
+    }
+    // A multi-GB flattening send can spend seconds in the copy before the
+    // first byte is written; don't let the drain side time out meanwhile.
+    receiver->set_timeout(std::chrono::minutes{5});
+
+    // Both ends of the ring live in this process; the segment is unlinked
+    // right away, as the bridge does once the viewer has accepted it.
+    std::optional<SharedMemoryTransport> shm_sender;
+    std::optional<SharedMemoryTransport> shm_receiver;
+    if (shm) {
+        auto ring = SharedMemoryRing::create();
+        auto reader_ring = SharedMemoryRing::open(ring.name());
+        ring.unlink();
+        shm_sender.emplace(
+            *sender, std::move(ring), SharedMemoryTransport::Role::WRITER);
+        shm_receiver.emplace(*receiver,
+                             std::move(reader_ring),
+                             SharedMemoryTransport::Role::READER);
+    }
+    ITransport& send_side =
+        shm ? static_cast<ITransport&>(*shm_sender) : *sender;
+    ITransport& receive_side =
+        shm ? static_cast<ITransport&>(*shm_receiver) : *receiver;
+
+    std::printf("mode: %s over %s\n",
+                shm       ? "shm"
+                : flatten ? "flatten"
+                          : "gather",
+                unix_socket ? "unix socket" : "tcp loopback");
+    std::printf("%10s %12s %12s %14s\n",
+                "size_mib",
+                "wall_s",
+                "mib_per_s",
+                "peak_rss_mib");
+    for (const auto mib : sizes_mib) {
+        const auto [seconds, peak] =
+            run_one(send_side, receive_side, mib * 1024 * 1024, flatten);
+        std::printf("%10zu %12.3f %12.1f %14.1f\n",
+                    mib,
+                    seconds,
+                    static_cast<double>(mib) / seconds,
+                    peak);
+    }
+    return 0;
+}
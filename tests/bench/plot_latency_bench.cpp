@@ -0,0 +1,263 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+// End-to-end latency of plotting one RGBA float buffer over a loopback
+// AsioTransport pair: from the bridge starting send_plot_buffer() until the
+// viewer side holds the complete buffer, decoded the way IpcClient decodes
+// it (PLOT_BUFFER_CONTENTS read straight into its PayloadBytes, or row strips
+// fed through a BufferAssembler).
+//
+//   plot_latency_bench [--shm] [--chunk-mib N] [WIDTHxHEIGHT...]
+//                                            (default size: 16384x16384)
+//
+// Each size is sent twice, first as one PLOT_BUFFER_CONTENTS message and
+// then as row strips of --chunk-mib (default: the bridge's default). --shm
+// puts a SharedMemoryTransport ring under both. Both ends live in this
+// process, so a size needs roughly twice its payload in RAM.
+
+#include <sys/resource.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ipc/asio_transport.h"
+#include "ipc/buffer_assembler.h"
+#include "ipc/message_exchange.h"
+#include "ipc/payload_bytes.h"
+#include "ipc/plot_buffer_sender.h"
+#include "ipc/shm_transport.h"
+
+namespace {
+
+using namespace oid;
+
+struct Size {
+    int width;
+    int height;
+};
+
+double peak_rss_mib() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    const auto bytes = static_cast<double>(usage.ru_maxrss);
+#else
+    const auto bytes = static_cast<double>(usage.ru_maxrss) * 1024.0;
+#endif
+    return bytes / (1024.0 * 1024.0);
+}
+
+// Reads one plot off `transport`, in either form, and returns its pixels.
+PayloadBytes receive_plot(ITransport& transport) {
+    BufferAssembler assembler;
+    while (true) {
+        MessageDecoder decoder{transport};
+        auto type = MessageType{};
+        decoder.read(type);
+        if (type == MessageType::PLOT_BUFFER_CONTENTS) {
+            std::string name;
+            std::string display;
+            std::string layout;
+            bool transpose{};
+            int width{};
+            int height{};
+            int channels{};
+            int stride{};
+            auto buffer_type = BufferType{};
+            PayloadBytes bytes;
+            decoder.read(name)
+                .read(display)
+                .read(layout)
+                .read(transpose)
+                .read(width)
+                .read(height)
+                .read(channels)
+                .read(stride)
+                .read(buffer_type)
+                .read(bytes);
+            return bytes;
+        }
+        if (type == MessageType::PLOT_BUFFER_BEGIN) {
+            BufferAssembler::BeginParams params;
+            decoder.read(params.variable_name)
+                .read(params.display_name)
+                .read(params.pixel_layout)
+                .read(params.transpose)
+                .read(params.width)
+                .read(params.height)
+                .read(params.channels)
+                .read(params.stride)
+                .read(params.type)
+                .read(params.total_byte_size);
+            if (!assembler.begin(std::move(params))) {
+                return {};
+            }
+        } else if (type == MessageType::PLOT_BUFFER_CHUNK) {
+            std::string name;
+            std::size_t row_offset{};
+            std::size_t row_count{};
+            PayloadBytes bytes;
+            decoder.read(name).read(row_offset).read(row_count).read(bytes);
+            if (!assembler.chunk(name, row_offset, row_count, bytes)) {
+                return {};
+            }
+        } else if (type == MessageType::PLOT_BUFFER_END) {
+            std::string name;
+            decoder.read(name);
+            auto assembled = assembler.end(name);
+            return assembled ? std::move(assembled->bytes) : PayloadBytes{};
+        } else {
+            return {};
+        }
+    }
+}
+
+double run_one(ITransport& sender,
+               ITransport& receiver,
+               const Size size,
+               const std::span<const std::byte> pixels,
+               const std::size_t chunk_bytes) {
+    std::size_t received_bytes = 0;
+    const auto start = std::chrono::steady_clock::now();
+    std::jthread viewer([&receiver, &received_bytes] {
+        received_bytes = receive_plot(receiver).size();
+    });
+    send_plot_buffer(sender,
+                     {.variable_name = "img",
+                      .display_name = "img",
+                      .pixel_layout = "rgba",
+                      .transpose = false,
+                      .width = size.width,
+                      .height = size.height,
+                      .channels = 4,
+                      .stride = size.width,
+                      .type = BufferType::FLOAT32},
+                     pixels,
+                     chunk_bytes);
+    viewer.join();
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (received_bytes != pixels.size()) {
+        std::fprintf(stderr, "transfer incomplete\n");
+        std::exit(1);
+    }
+    return elapsed.count();
+}
+
+} // namespace
+
+int main(const int argc, char** argv) {
+    bool shm = false;
+    std::size_t chunk_bytes = DEFAULT_PLOT_CHUNK_BYTES;
+    std::vector<Size> sizes;
+    for (int i = 1; i < argc; ++i) {
+        if (const std::string_view arg{argv[i]}; arg == "--shm") {
+            shm = true;
+        } else if (arg == "--chunk-mib" && i + 1 < argc) {
+            chunk_bytes = std::strtoull(argv[++i], nullptr, 10) * 1024 * 1024;
+        } else {
+            char* end = nullptr;
+            const auto width = std::strtol(argv[i], &end, 10);
+            const auto height = std::strtol(end + 1, nullptr, 10);
+            sizes.push_back(
+                {static_cast<int>(width), static_cast<int>(height)});
+        }
+    }
+    if (sizes.empty()) {
+        sizes = {{16384, 16384}};
+    }
+
+    AsioAcceptor acceptor;
+    std::optional<AsioTransport> receiver;
+    std::jthread accept_thread([&acceptor, &receiver] {
+        receiver.emplace(acceptor.accept(std::chrono::seconds{5}));
+    });
+    AsioTransport sender{"127.0.0.1", acceptor.port()};
+    accept_thread.join();
+    if (!receiver.has_value() || !sender.is_connected()) {
+        std::fprintf(stderr, "could not set up the loopback connection\n");
+        return 1;
+    }
+    receiver->set_timeout(std::chrono::minutes{5});
+
+    std::optional<SharedMemoryTransport> shm_sender;
+    std::optional<SharedMemoryTransport> shm_receiver;
+    if (shm) {
+        auto ring = SharedMemoryRing::create();
+        auto reader_ring = SharedMemoryRing::open(ring.name());
+        ring.unlink();
+        shm_sender.emplace(
+            sender, std::move(ring), SharedMemoryTransport::Role::WRITER);
+        shm_receiver.emplace(*receiver,
+                             std::move(reader_ring),
+                             SharedMemoryTransport::Role::READER);
+    }
+    ITransport& send_side =
+        shm ? static_cast<ITransport&>(*shm_sender) : sender;
+    ITransport& receive_side =
+        shm ? static_cast<ITransport&>(*shm_receiver) : *receiver;
+
+    std::printf("transport: %s, strip: %zu MiB\n",
+                shm ? "shm" : "tcp",
+                chunk_bytes / (1024 * 1024));
+    std::printf("%14s %10s %12s %12s %14s\n",
+                "size",
+                "mib",
+                "whole_s",
+                "strips_s",
+                "peak_rss_mib");
+    for (const auto size : sizes) {
+        const auto bytes = static_cast<std::size_t>(size.width) *
+                           static_cast<std::size_t>(size.height) * 4 *
+                           sizeof(float);
+        const auto pixels = std::make_unique<std::byte[]>(bytes);
+        std::memset(pixels.get(), 0x3f, bytes);
+        const std::span<const std::byte> view{pixels.get(), bytes};
+
+        const auto whole = run_one(send_side, receive_side, size, view, 0);
+        const auto strips =
+            run_one(send_side, receive_side, size, view, chunk_bytes);
+        const auto label =
+            std::to_string(size.width) + "x" + std::to_string(size.height);
+        std::printf("%14s %10zu %12.3f %12.3f %14.1f\n",
+                    label.c_str(),
+                    bytes / (1024 * 1024),
+                    whole,
+                    strips,
+                    peak_rss_mib());
+    }
+    return 0;
+}
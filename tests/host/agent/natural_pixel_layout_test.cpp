@@ -52,7 +52,7 @@ TEST(NaturalPixelLayout, ValidLayoutIsReturnedAsIs) {
 // documented default onto the live buffer unconditionally whenever the
 // record's layout failed validation, even for a multi-channel buffer: the
 // exact mechanism that turns a model-level corruption (see
-// IpcClient::handle_plot_buffer_contents) into a permanent, wrong render
+// IpcClient::apply_buffer) into a permanent, wrong render
 // (Buffer::set_pixel_layout() has no buff_tex_ guard of its own). This is
 // corruption only for a DEBUGGER_SYMBOL record whose current layout is not
 // itself an isolation swizzle (see the isolation-clearing test below for the
@@ -130,3 +130,23 @@ TEST(CliOptionsTest, NonNumericAgentDebuggerPidIsIgnored) {
         parse({"oidwindow", "--agent-debugger-pid", "notanumber"});
     EXPECT_EQ(options.agent_debugger_pid, std::nullopt);
 }
+
+TEST(CliOptionsTest, ParsesSharedMemoryName) {
+    EXPECT_TRUE(parse({"oidwindow"}).shm_name.empty());
+    const CliOptions options = parse({"oidwindow", "--shm", "/oid-42-0"});
+    EXPECT_EQ(options.shm_name, "/oid-42-0");
+}
+
+TEST(CliOptionsTest, ParsesSocketPath) {
+    EXPECT_TRUE(parse({"oidwindow"}).socket_path.empty());
+    const CliOptions options =
+        parse({"oidwindow", "--socket", "/tmp/oid-a1b2c3/window.sock"});
+    EXPECT_EQ(options.socket_path, "/tmp/oid-a1b2c3/window.sock");
+}
+
+TEST(CliOptionsTest, ParsesDataLanes) {
+    EXPECT_EQ(parse({"oidwindow"}).data_lanes, 0);
+    EXPECT_EQ(parse({"oidwindow", "--lanes", "4"}).data_lanes, 4);
+    EXPECT_EQ(parse({"oidwindow", "--lanes", "-2"}).data_lanes, 0);
+    EXPECT_EQ(parse({"oidwindow", "--lanes", "four"}).data_lanes, 0);
+}
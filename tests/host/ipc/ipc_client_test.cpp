@@ -25,17 +25,22 @@
 
 #include "host/ipc/buffer_decode.h"
 #include "host/ipc/ipc_client.h"
+#include "ipc/block_codec.h"
 #include "ipc/message_exchange.h"
+#include "ipc/symbol_list_delta.h"
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstring>
 #include <deque>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <string_view>
+#include <thread>
 
 #include <gtest/gtest.h>
 
@@ -52,7 +57,7 @@ TEST(BufferDecode, MapsFieldsAndStepEqualsStride) {
                                          .channels = 3,
                                          .stride = 6,
                                          .type = BufferType::UNSIGNED_BYTE,
-                                         .bytes = std::move(bytes)});
+                                         .bytes = PayloadBytes{bytes}});
     EXPECT_EQ(r.variable_name, "v");
     EXPECT_EQ(r.display_name, "disp");
     EXPECT_EQ(r.pixel_layout, "rgb");
@@ -79,7 +84,7 @@ TEST(BufferDecode, Float64ConvertsToFloatBytes) {
                                          .channels = 1,
                                          .stride = 1,
                                          .type = BufferType::FLOAT64,
-                                         .bytes = std::move(bytes)});
+                                         .bytes = PayloadBytes{bytes}});
 
     // FLOAT64 payload of 1 double must convert down to 1 float (4 bytes).
     ASSERT_EQ(r.bytes.size(), sizeof(float));
@@ -308,7 +313,7 @@ TEST(IpcClient, PlotBufferContentsUpsertsModel) {
 
 // The single-shot sibling of the chunked-path fix: PLOT_BUFFER_CONTENTS
 // carries its whole payload in one message, with no BufferAssembler::begin()
-// to reject it, so handle_plot_buffer_contents() must apply the same check
+// to reject it, so decode_plot_buffer_contents() must apply the same check
 // itself.
 TEST(IpcClient, PlotBufferContentsRejectsPayloadTooSmallForGeometry) {
     FakeTransport t;
@@ -893,8 +898,8 @@ TEST(IpcClient, ChunkedRoundTripReassemblesBuffer) {
 
 // The BEGIN/CHUNK/END assembly path's sibling of
 // ReplotWithInvalidLayoutKeepsExistingValidLayout above:
-// handle_plot_buffer_end() upserts from the assembled transfer via its own call
-// site, independent of handle_plot_buffer_contents(), so it needs its own guard
+// decode_plot_buffer_end() builds its record from the assembled transfer,
+// independent of decode_plot_buffer_contents(), so it needs its own check
 // against the same corruption.
 TEST(IpcClient, ChunkedReplotWithInvalidLayoutKeepsExistingValidLayout) {
     FakeTransport t;
@@ -1212,7 +1217,7 @@ TEST(IpcClient, BeginRejectsChannelsAboveDisplayLimit) {
 
 // The single-shot sibling of BeginRejectsGeometryOutsideDisplayLimits: same
 // geometry, but via PLOT_BUFFER_CONTENTS, which has no BufferAssembler::begin
-// to reject it, so handle_plot_buffer_contents() must apply the same check
+// to reject it, so decode_plot_buffer_contents() must apply the same check
 // itself.
 TEST(IpcClient, PlotBufferContentsRejectsGeometryOutsideDisplayLimits) {
     FakeTransport t;
@@ -1626,7 +1631,7 @@ TEST(IpcClient, PollDoesNotThrowOnTruncatedMessage) {
 }
 
 // MessageDecoder's own size guards keep it from throwing std::length_error,
-// but other peer-size-driven allocations reachable from dispatch() (e.g.
+// but other peer-size-driven allocations reachable from decode() (e.g.
 // BufferAssembler::begin()'s vector construction, on a 32-bit size_t) are not
 // guarded that way, and poll() backstops those. The throw is driven straight
 // from the transport so the test does not depend on any of them being
@@ -1711,6 +1716,38 @@ TEST(IpcClient, RestoreRequestsOnlyOnceAcrossRepeatedSetAvailableSymbols) {
     EXPECT_EQ(plot_reqs, 1); // already requested_, second round is a no-op
 }
 
+// A SET_AVAILABLE_SYMBOLS_DELTA edits the list held, which then drives the
+// restore the way a full list does; one that does not fit is dropped.
+TEST(IpcClient, SymbolDeltasEditTheAvailableList) {
+    FakeTransport t;
+    host::IpcBufferModel model;
+    host::IpcClient client(t, model);
+    constexpr std::int64_t future = 4102444800; // year 2100
+    client.set_restore_buffers({{"want", future}});
+
+    MessageComposer c;
+    c.push(MessageType::SET_AVAILABLE_SYMBOLS)
+        .push(std::deque<std::string>{"a", "b", "c"});
+    t.feed(frame(c));
+    FakeTransport encode_t;
+    oid::send_available_symbols_delta(
+        encode_t,
+        {.removed = {"b"}, .added = {{0, "want"}, {3, "d"}}});
+    oid::send_available_symbols_delta(encode_t,
+                                      {.removed = {}, .added = {{9, "x"}}});
+    for (const auto& f : encode_t.sends) {
+        t.feed(f);
+    }
+    client.poll();
+
+    EXPECT_EQ(client.available_symbols(),
+              (std::vector<std::string>{"want", "a", "c", "d"}));
+    ASSERT_EQ(t.sends.size(), 1u);
+    MessageType h{};
+    std::memcpy(&h, t.sends[0].data(), sizeof(h));
+    EXPECT_EQ(h, MessageType::PLOT_BUFFER_REQUEST);
+}
+
 TEST(IpcClient, ApplySessionStateInvokesCallbackWithJsonVerbatim) {
     FakeTransport t;
     host::IpcBufferModel model;
@@ -1867,3 +1904,746 @@ TEST(IpcClient, RestoreSkipsBufferAlreadyInModel) {
     }
     EXPECT_EQ(plot_reqs, 0); // "want" already in model, restore skips it
 }
+
+// Polls until `done` holds or a generous deadline passes, for the tests
+// that hand decoding to the receiver thread.
+template <typename Pred>
+static bool poll_until(host::IpcClient& client, Pred done) {
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    while (std::chrono::steady_clock::now() < deadline) {
+        client.poll();
+        if (done()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    return false;
+}
+
+// With the receiver running, the chunked transfer is read and assembled off
+// the polling thread, and poll() only applies the finished record. The
+// transport is fed before start_receiver(): from then on only the receiver
+// thread touches it.
+TEST(IpcClient, ReceiverThreadDecodesWhilePollApplies) {
+    FakeTransport t;
+    host::IpcBufferModel model;
+    constexpr int w = 4;
+    constexpr int h = 3;
+    const std::vector row(static_cast<std::size_t>(w), std::byte{7});
+    t.feed(begin_frame("v", w, h, static_cast<std::size_t>(w * h)));
+    for (int y = 0; y < h; ++y) {
+        t.feed(chunk_frame("v", static_cast<std::size_t>(y), 1, row));
+    }
+    t.feed(end_frame("v"));
+
+    host::IpcClient client(t, model);
+    client.start_receiver();
+    ASSERT_TRUE(poll_until(client, [&model] { return model.size() == 1; }));
+    client.stop_receiver();
+
+    EXPECT_EQ(model.at(0).variable_name, "v");
+    EXPECT_EQ(model.at(0).bytes.size(), static_cast<std::size_t>(w * h));
+}
+
+// Replies and requests made while the receiver runs are queued for it
+// rather than sent from the polling thread; stop_receiver() sends whatever
+// it had not got to yet, in order.
+TEST(IpcClient, ReceiverThreadSendsQueuedOutboundMessages) {
+    FakeTransport t;
+    host::IpcBufferModel model;
+    MessageComposer query;
+    query.push(MessageType::GET_OBSERVED_SYMBOLS);
+    t.feed(frame(query));
+    MessageComposer state;
+    state.push(MessageType::APPLY_SESSION_STATE).push(std::string("{}"));
+    t.feed(frame(state));
+
+    host::IpcClient client(t, model);
+    bool state_applied = false;
+    client.set_session_state_callback(
+        [&state_applied](const std::string&) { state_applied = true; });
+    client.start_receiver();
+    // Messages apply in arrival order, so once the session state is in the
+    // query before it has been answered.
+    ASSERT_TRUE(poll_until(client, [&state_applied] { return state_applied; }));
+    client.request_plot("next");
+    client.stop_receiver();
+
+    ASSERT_EQ(t.sends.size(), 2u);
+    MessageType h{};
+    std::memcpy(&h, t.sends[0].data(), sizeof(h));
+    EXPECT_EQ(h, MessageType::GET_OBSERVED_SYMBOLS_RESPONSE);
+    std::memcpy(&h, t.sends[1].data(), sizeof(h));
+    EXPECT_EQ(h, MessageType::PLOT_BUFFER_REQUEST);
+}
+
+// After stop_receiver() the client is back to decoding on the calling
+// thread.
+TEST(IpcClient, PollDecodesItselfAgainAfterStopReceiver) {
+    FakeTransport t;
+    host::IpcBufferModel model;
+    host::IpcClient client(t, model);
+    client.start_receiver();
+    client.stop_receiver();
+
+    MessageComposer c;
+    c.push(MessageType::EXPORT_SELECTED_BUFFER);
+    t.feed(frame(c));
+    int calls = 0;
+    client.set_export_selected_callback([&calls] { ++calls; });
+    client.poll();
+
+    EXPECT_EQ(calls, 1);
+}
+
+// An unchanged re-plot leaves the record -- and every revision consumers key
+// texture uploads and contrast passes on -- untouched.
+TEST(IpcClient, PlotBufferUnchangedKeepsTheRecordAndRevisions) {
+    FakeTransport t;
+    host::IpcBufferModel model;
+    std::vector bytes(4, std::byte{5});
+    t.feed(begin_frame("v", 2, 2, bytes.size()));
+    t.feed(chunk_frame("v", 0, 2, bytes));
+    t.feed(end_frame("v"));
+    host::IpcClient client(t, model);
+    client.poll();
+    ASSERT_EQ(model.size(), 1u);
+    const auto revision = model.revision();
+    const auto slot_revision = model.revision_of(0);
+
+    MessageComposer c;
+    c.push(MessageType::PLOT_BUFFER_UNCHANGED).push(std::string("v"));
+    t.feed(frame(c));
+    client.poll();
+
+    EXPECT_EQ(model.revision(), revision);
+    EXPECT_EQ(model.revision_of(0), slot_revision);
+    EXPECT_EQ(model.at(0).bytes, bytes);
+    EXPECT_TRUE(t.sends.empty());
+}
+
+// If the buffer is no longer here, the viewer asks for it again rather than
+// showing nothing.
+TEST(IpcClient, PlotBufferUnchangedForAMissingBufferRequestsIt) {
+    FakeTransport t;
+    host::IpcBufferModel model;
+    MessageComposer c;
+    c.push(MessageType::PLOT_BUFFER_UNCHANGED).push(std::string("gone"));
+    t.feed(frame(c));
+
+    host::IpcClient client(t, model);
+    client.poll();
+
+    EXPECT_EQ(model.size(), 0u);
+    ASSERT_EQ(t.sends.size(), 1u);
+    FakeTransport decode_t;
+    decode_t.feed(t.sends[0]);
+    MessageType h{};
+    std::string name;
+    MessageDecoder{decode_t}.read(h).read(name);
+    EXPECT_EQ(h, MessageType::PLOT_BUFFER_REQUEST);
+    EXPECT_EQ(name, "gone");
+}
+
+// Builds a PLOT_BUFFER_PATCH_BEGIN frame with begin_frame's geometry.
+static std::vector<std::byte> patch_begin_frame(const std::string& name,
+                                                const int width,
+                                                const int height,
+                                                const std::size_t total) {
+    MessageComposer c;
+    c.push(MessageType::PLOT_BUFFER_PATCH_BEGIN)
+        .push(name)
+        .push(width)
+        .push(height)
+        .push(1)
+        .push(width)
+        .push(static_cast<int>(BufferType::UNSIGNED_BYTE))
+        .push(total);
+    return frame(c);
+}
+
+// Decodes the single PLOT_BUFFER_REQUEST the client is expected to have sent.
+static std::string requested_name(const FakeTransport& t) {
+    EXPECT_EQ(t.sends.size(), 1u);
+    if (t.sends.empty()) {
+        return {};
+    }
+    FakeTransport decode_t;
+    decode_t.feed(t.sends[0]);
+    MessageType h{};
+    std::string name;
+    MessageDecoder{decode_t}.read(h).read(name);
+    EXPECT_EQ(h, MessageType::PLOT_BUFFER_REQUEST);
+    return name;
+}
+
+// A patch rewrites just the rows it carries, in the record already held, so
+// the Stage can re-upload those rows instead of the whole buffer.
+TEST(IpcClient, PlotBufferPatchRewritesRowsInPlace) {
+    FakeTransport t;
+    host::IpcBufferModel model;
+    std::vector bytes(6, std::byte{5});
+    t.feed(begin_frame("v", 2, 3, bytes.size()));
+    t.feed(chunk_frame("v", 0, 3, bytes));
+    t.feed(end_frame("v"));
+    host::IpcClient client(t, model);
+    client.poll();
+    ASSERT_EQ(model.size(), 1u);
+    const std::byte* const data = model.at(0).bytes.data();
+    const auto slot_revision = model.revision_of(0);
+
+    const std::vector row{std::byte{1}, std::byte{2}};
+    t.feed(patch_begin_frame("v", 2, 3, bytes.size()));
+    t.feed(chunk_frame("v", 1, 1, row));
+    t.feed(end_frame("v"));
+    client.poll();
+
+    EXPECT_EQ(model.at(0).bytes.data(), data);
+    EXPECT_EQ(model.at(0).bytes,
+              (std::vector{std::byte{5},
+                           std::byte{5},
+                           std::byte{1},
+                           std::byte{2},
+                           std::byte{5},
+                           std::byte{5}}));
+    EXPECT_GT(model.revision_of(0), slot_revision);
+    const auto rows = model.changed_rows_since(0, slot_revision);
+    ASSERT_TRUE(rows.has_value());
+    EXPECT_EQ(*rows, (std::vector{host::RowRange{1, 1}}));
+    EXPECT_TRUE(t.sends.empty());
+}
+
+// A patch against a copy this side no longer holds in that shape cannot be
+// placed; the whole buffer is asked for instead.
+TEST(IpcClient, PlotBufferPatchForADifferentShapeRequestsTheBuffer) {
+    FakeTransport t;
+    host::IpcBufferModel model;
+    std::vector bytes(4, std::byte{5});
+    t.feed(begin_frame("v", 2, 2, bytes.size()));
+    t.feed(chunk_frame("v", 0, 2, bytes));
+    t.feed(end_frame("v"));
+    const std::vector row{std::byte{1}, std::byte{2}};
+    t.feed(patch_begin_frame("v", 2, 3, 6));
+    t.feed(chunk_frame("v", 2, 1, row));
+    t.feed(end_frame("v"));
+
+    host::IpcClient client(t, model);
+    client.poll();
+
+    ASSERT_EQ(model.size(), 1u);
+    EXPECT_EQ(model.at(0).bytes, bytes);
+    EXPECT_EQ(requested_name(t), "v");
+}
+
+// The bridge counts a patch as delivered once sent, so one that goes wrong
+// in transit must not be dropped silently either.
+TEST(IpcClient, PlotBufferPatchWithABadChunkRequestsTheBuffer) {
+    FakeTransport t;
+    host::IpcBufferModel model;
+    std::vector bytes(4, std::byte{5});
+    t.feed(begin_frame("v", 2, 2, bytes.size()));
+    t.feed(chunk_frame("v", 0, 2, bytes));
+    t.feed(end_frame("v"));
+    const std::vector row{std::byte{1}, std::byte{2}};
+    t.feed(patch_begin_frame("v", 2, 2, bytes.size()));
+    t.feed(chunk_frame("v", 2, 1, row)); // past the last row
+    t.feed(end_frame("v"));
+
+    host::IpcClient client(t, model);
+    client.poll();
+
+    EXPECT_EQ(model.at(0).bytes, bytes);
+    EXPECT_EQ(requested_name(t), "v");
+}
+
+TEST(IpcClient, CompressedChunkAssemblesLikeARawOne) {
+    FakeTransport t;
+    host::IpcBufferModel model;
+    std::vector bytes(64 * 4, std::byte{7});
+    const auto block = compress_block(std::span{bytes}.first(64 * 3));
+    t.feed(begin_frame("v", 64, 4, bytes.size()));
+    {
+        MessageComposer c;
+        c.push(MessageType::PLOT_BUFFER_CHUNK_COMPRESSED)
+            .push(std::string("v"))
+            .push(std::size_t{0})
+            .push(std::size_t{3})
+            .push(std::span<const std::byte>(block));
+        t.feed(frame(c));
+    }
+    t.feed(chunk_frame("v", 3, 1, std::span{bytes}.last(64)));
+    t.feed(end_frame("v"));
+
+    host::IpcClient client(t, model);
+    client.poll();
+
+    ASSERT_EQ(model.size(), 1u);
+    EXPECT_EQ(model.at(0).bytes, bytes);
+}
+
+// The bridge only compresses, or sends previews, for a viewer that said it
+// can decode them.
+TEST(IpcClient, AnnounceCapabilitiesOffersTheOptionalMessages) {
+    FakeTransport t;
+    host::IpcBufferModel model;
+    const host::IpcClient client(t, model);
+    client.announce_capabilities();
+
+    ASSERT_EQ(t.sends.size(), 1u);
+    FakeTransport decode_t;
+    decode_t.feed(t.sends[0]);
+    MessageType h{};
+    int capabilities{};
+    MessageDecoder{decode_t}.read(h).read(capabilities);
+    EXPECT_EQ(h, MessageType::VIEWER_CAPABILITIES);
+    EXPECT_EQ(capabilities,
+              CAPABILITY_COMPRESSED_CHUNKS | CAPABILITY_PROGRESSIVE_PREVIEW |
+                  CAPABILITY_REGION_FETCH | CAPABILITY_PLOT_BATCHES |
+                  CAPABILITY_QUICK_LOOK | CAPABILITY_SYMBOL_DELTAS);
+}
+
+static std::vector<std::byte>
+preview_frame(const std::string& name,
+              const int factor,
+              const std::span<const std::byte> bytes) {
+    MessageComposer c;
+    c.push(MessageType::PLOT_BUFFER_PREVIEW)
+        .push(name)
+        .push(factor)
+        .push(bytes);
+    return frame(c);
+}
+
+// A preview stands in for the buffer while its rows are still arriving, and
+// the finished transfer replaces it exactly.
+TEST(IpcClient, PreviewIsShownUntilTheFullBufferArrives) {
+    FakeTransport t;
+    host::IpcBufferModel model;
+    const std::vector<std::byte> samples{std::byte{1}, std::byte{2}};
+    t.feed(begin_frame("v", 4, 2, 8));
+    t.feed(preview_frame("v", 2, samples));
+    host::IpcClient client(t, model);
+    client.poll();
+
+    // Shown decimated, as an overview is, rather than blown up to 4x2.
+    ASSERT_EQ(model.size(), 1u);
+    EXPECT_TRUE(model.at(0).provisional);
+    EXPECT_EQ(model.at(0).width, 2);
+    EXPECT_EQ(model.at(0).height, 1);
+    EXPECT_EQ(model.at(0).decimation, 2);
+    EXPECT_EQ(model.at(0).source_width, 4);
+    EXPECT_EQ(model.at(0).source_height, 2);
+    EXPECT_FALSE(host::is_quick_look(model.at(0)));
+    EXPECT_EQ(model.at(0).bytes, samples);
+
+    const std::vector bytes(8, std::byte{9});
+    t.feed(chunk_frame("v", 0, 2, bytes));
+    t.feed(end_frame("v"));
+    client.poll();
+
+    ASSERT_EQ(model.size(), 1u);
+    EXPECT_FALSE(model.at(0).provisional);
+    EXPECT_EQ(model.at(0).decimation, 1);
+    EXPECT_EQ(model.at(0).width, 4);
+    EXPECT_EQ(model.at(0).bytes, bytes);
+    EXPECT_TRUE(t.sends.empty());
+}
+
+// Once a preview is on show, a transfer that fails must not leave it there
+// passing for the buffer.
+TEST(IpcClient, FailedTransferAfterAPreviewRequestsTheBuffer) {
+    FakeTransport t;
+    host::IpcBufferModel model;
+    const std::vector<std::byte> samples{std::byte{1}, std::byte{2}};
+    t.feed(begin_frame("v", 4, 2, 8));
+    t.feed(preview_frame("v", 2, samples));
+    t.feed(chunk_frame("v", 0, 1, std::vector(4, std::byte{9})));
+    t.feed(end_frame("v"));
+
+    host::IpcClient client(t, model);
+    client.poll();
+
+    ASSERT_EQ(model.size(), 1u);
+    EXPECT_TRUE(model.at(0).provisional);
+    EXPECT_EQ(requested_name(t), "v");
+}
+
+// A transfer still arriving shows its rows so far, then the rows that land
+// after them, patched in place, until the finished buffer replaces it.
+TEST(IpcClient, TransferStillArrivingFillsInAsItLands) {
+    FakeTransport t;
+    host::IpcBufferModel model;
+    host::IpcClient client(t, model);
+    client.set_progress_interval(std::chrono::milliseconds{0});
+    t.feed(begin_frame("v", 2, 4, 8));
+    client.poll();
+    EXPECT_EQ(model.size(), 0u); // no rows to show yet
+
+    const std::vector rows(4, std::byte{7});
+    t.feed(chunk_frame("v", 0, 2, rows));
+    client.poll();
+    ASSERT_EQ(model.size(), 1u);
+    EXPECT_TRUE(model.at(0).provisional);
+    EXPECT_EQ(model.at(0).bytes,
+              (std::vector{std::byte{7},
+                           std::byte{7},
+                           std::byte{7},
+                           std::byte{7},
+                           std::byte{0},
+                           std::byte{0},
+                           std::byte{0},
+                           std::byte{0}}));
+
+    const auto shown = model.revision_of(0);
+    t.feed(chunk_frame("v", 3, 1, std::vector(2, std::byte{8})));
+    client.poll();
+    ASSERT_EQ(model.size(), 1u);
+    EXPECT_TRUE(model.at(0).provisional);
+    const auto changed = model.changed_rows_since(0, shown);
+    ASSERT_TRUE(changed.has_value());
+    EXPECT_EQ(*changed, (std::vector{host::RowRange{3, 1}}));
+    EXPECT_EQ(model.at(0).bytes[6], std::byte{8});
+
+    t.feed(chunk_frame("v", 2, 1, std::vector(2, std::byte{9})));
+    t.feed(end_frame("v"));
+    client.poll();
+    ASSERT_EQ(model.size(), 1u);
+    EXPECT_FALSE(model.at(0).provisional);
+    EXPECT_EQ(model.at(0).bytes[4], std::byte{9});
+    EXPECT_TRUE(t.sends.empty());
+}
+
+// A preview already shows every pixel it samples and has no room for the
+// others, so rows arriving after it leave it as it is until the end.
+TEST(IpcClient, ArrivedRowsLeaveThePreviewAsItIs) {
+    FakeTransport t;
+    host::IpcBufferModel model;
+    host::IpcClient client(t, model);
+    client.set_progress_interval(std::chrono::milliseconds{0});
+    const std::vector<std::byte> samples{std::byte{1}, std::byte{2}};
+    t.feed(begin_frame("v", 4, 2, 8));
+    t.feed(preview_frame("v", 2, samples));
+    client.poll();
+    ASSERT_EQ(model.size(), 1u);
+    const auto shown = model.revision_of(0);
+
+    t.feed(chunk_frame("v", 1, 1, std::vector(4, std::byte{9})));
+    client.poll();
+    ASSERT_EQ(model.size(), 1u);
+    EXPECT_TRUE(model.at(0).provisional);
+    EXPECT_EQ(model.revision_of(0), shown);
+    EXPECT_EQ(model.at(0).bytes, samples);
+}
+
+// By default a transfer that completes within the interval is never shown
+// part way.
+TEST(IpcClient, QuickTransferIsNotShownPartWay) {
+    FakeTransport t;
+    host::IpcBufferModel model;
+    host::IpcClient client(t, model);
+    t.feed(begin_frame("v", 2, 2, 4));
+    t.feed(chunk_frame("v", 0, 1, std::vector(2, std::byte{7})));
+    client.poll();
+    EXPECT_EQ(model.size(), 0u);
+}
+
+static std::vector<std::byte> batch_frame(const MessageType header) {
+    MessageComposer c;
+    c.push(header);
+    return frame(c);
+}
+
+// The plots of one stop reach the model together, however the socket
+// splits them.
+TEST(IpcClient, BatchedPlotsAreAppliedTogether) {
+    FakeTransport t;
+    host::IpcBufferModel model;
+    const std::vector bytes(4, std::byte{5});
+    t.feed(batch_frame(MessageType::PLOT_BUFFER_BATCH_BEGIN));
+    for (const std::string name : {"a", "b"}) {
+        t.feed(begin_frame(name, 2, 2, bytes.size()));
+        t.feed(chunk_frame(name, 0, 2, bytes));
+        t.feed(end_frame(name));
+    }
+    host::IpcClient client(t, model);
+    client.poll();
+    EXPECT_EQ(model.size(), 0u);
+
+    t.feed(batch_frame(MessageType::PLOT_BUFFER_BATCH_END));
+    client.poll();
+    ASSERT_EQ(model.size(), 2u);
+    EXPECT_EQ(model.variable_name_of(0), "a");
+    EXPECT_EQ(model.variable_name_of(1), "b");
+}
+
+// Previews are not held back with the rest of a batch, and a batch whose
+// end never came is given up at the next one rather than lost.
+TEST(IpcClient, BatchShowsPreviewsAndSurvivesALostEnd) {
+    FakeTransport t;
+    host::IpcBufferModel model;
+    const std::vector<std::byte> samples{std::byte{1}, std::byte{2}};
+    t.feed(batch_frame(MessageType::PLOT_BUFFER_BATCH_BEGIN));
+    t.feed(begin_frame("v", 4, 2, 8));
+    t.feed(preview_frame("v", 2, samples));
+    host::IpcClient client(t, model);
+    client.poll();
+    ASSERT_EQ(model.size(), 1u);
+    EXPECT_TRUE(model.at(0).provisional);
+
+    t.feed(chunk_frame("v", 0, 2, std::vector(8, std::byte{9})));
+    t.feed(end_frame("v"));
+    t.feed(batch_frame(MessageType::PLOT_BUFFER_BATCH_BEGIN));
+    client.poll();
+    ASSERT_EQ(model.size(), 1u);
+    EXPECT_FALSE(model.at(0).provisional);
+}
+
+// PLOT_BUFFER_OVERVIEW of a single-channel uint8 `width` x `height` source,
+// decimated by `factor` into `bytes`; of a quick look if `quick_look`.
+static std::vector<std::byte>
+overview_frame(const std::string& name,
+               const int width,
+               const int height,
+               const int factor,
+               const std::span<const std::byte> bytes,
+               const bool quick_look = false) {
+    MessageComposer c;
+    c.push(MessageType::PLOT_BUFFER_OVERVIEW)
+        .push(name)
+        .push(name)
+        .push(std::string{})
+        .push(false)
+        .push(width)
+        .push(height)
+        .push(1)
+        .push(width)
+        .push(static_cast<int>(BufferType::UNSIGNED_BYTE))
+        .push(factor)
+        .push(quick_look)
+        .push(bytes);
+    return frame(c);
+}
+
+static std::vector<std::byte>
+region_frame(const std::string& name,
+             const PixelRegion& region,
+             const std::span<const std::byte> bytes) {
+    MessageComposer c;
+    c.push(MessageType::PLOT_BUFFER_REGION)
+        .push(name)
+        .push(region.row)
+        .push(region.col)
+        .push(region.rows)
+        .push(region.cols)
+        .push(1)
+        .push(static_cast<int>(BufferType::UNSIGNED_BYTE))
+        .push(bytes);
+    return frame(c);
+}
+
+// An overview is listed at its own size and remembers the source it
+// stands for; regions of that source land in the model's tile cache.
+TEST(IpcClient, OverviewAndItsRegionsReachTheModel) {
+    FakeTransport t;
+    host::IpcBufferModel model;
+    t.feed(overview_frame("v", 5, 3, 2, std::vector(6, std::byte{1})));
+    const auto region = PixelRegion{.row = 1, .col = 2, .rows = 2, .cols = 3};
+    t.feed(region_frame("v", region, std::vector(6, std::byte{7})));
+    host::IpcClient client(t, model);
+    client.poll();
+
+    ASSERT_EQ(model.size(), 1u);
+    EXPECT_EQ(model.at(0).width, 3);
+    EXPECT_EQ(model.at(0).height, 2);
+    EXPECT_EQ(model.at(0).decimation, 2);
+    EXPECT_EQ(model.at(0).source_width, 5);
+    EXPECT_EQ(model.at(0).source_height, 3);
+    const auto* tile = model.region_tiles().find("v", 1, 2);
+    ASSERT_NE(tile, nullptr);
+    EXPECT_EQ(tile->region, region);
+    EXPECT_EQ(tile->bytes, std::vector(6, std::byte{7}));
+}
+
+// Regions that do not fit the record held -- outside its source, or for a
+// name with no overview -- are dropped, as is an overview whose payload
+// does not match its geometry.
+TEST(IpcClient, RegionsAndOverviewsThatDoNotFitAreDropped) {
+    FakeTransport t;
+    host::IpcBufferModel model;
+    const CerrCapture cerr;
+    t.feed(overview_frame("bad", 5, 3, 2, std::vector(5, std::byte{1})));
+    t.feed(overview_frame("v", 5, 3, 2, std::vector(6, std::byte{1})));
+    t.feed(region_frame("v",
+                        {.row = 2, .col = 0, .rows = 2, .cols = 1},
+                        std::vector(2, std::byte{7})));
+    t.feed(region_frame("w",
+                        {.row = 0, .col = 0, .rows = 1, .cols = 1},
+                        std::vector(1, std::byte{7})));
+    host::IpcClient client(t, model);
+    client.poll();
+
+    ASSERT_EQ(model.size(), 1u);
+    EXPECT_EQ(model.variable_name_of(0), "v");
+    EXPECT_EQ(model.region_tiles().byte_size(), 0u);
+    EXPECT_NE(cerr.out.str().find("rejected PLOT_BUFFER_OVERVIEW for 'bad'"),
+              std::string::npos);
+}
+
+TEST(IpcClient, RequestRegionSends) {
+    FakeTransport t;
+    host::IpcBufferModel model;
+    const host::IpcClient client(t, model);
+    client.request_region("v", {.row = 512, .col = 0, .rows = 512, .cols = 7});
+
+    ASSERT_EQ(t.sends.size(), 1u);
+    FakeTransport decode_t;
+    decode_t.feed(t.sends[0]);
+    MessageType h{};
+    std::string name;
+    PixelRegion region;
+    MessageDecoder{decode_t}
+        .read(h)
+        .read(name)
+        .read(region.row)
+        .read(region.col)
+        .read(region.rows)
+        .read(region.cols);
+    EXPECT_EQ(h, MessageType::PLOT_BUFFER_REGION_REQUEST);
+    EXPECT_EQ(name, "v");
+    EXPECT_EQ(region,
+              (PixelRegion{.row = 512, .col = 0, .rows = 512, .cols = 7}));
+}
+
+TEST(IpcClient, RequestFullPlotSends) {
+    FakeTransport t;
+    host::IpcBufferModel model;
+    const host::IpcClient client(t, model);
+    client.request_full_plot("v");
+
+    ASSERT_EQ(t.sends.size(), 1u);
+    FakeTransport decode_t;
+    decode_t.feed(t.sends[0]);
+    MessageType h{};
+    std::string name;
+    MessageDecoder{decode_t}.read(h).read(name);
+    EXPECT_EQ(h, MessageType::PLOT_BUFFER_FULL_REQUEST);
+    EXPECT_EQ(name, "v");
+}
+
+// Whether an overview is a quick look, which the user can upgrade, is what
+// the bridge said: only it knows the source's stride, and so whether it
+// plotted it lazily. A small source's overview can still be of a lazy plot.
+TEST(IpcClient, OverviewIsAQuickLookOnlyWhenTheBridgeSaysSo) {
+    FakeTransport t;
+    host::IpcBufferModel model;
+    t.feed(
+        overview_frame("quick", 5, 3, 2, std::vector(6, std::byte{1}), true));
+    t.feed(overview_frame("lazy", 5, 3, 2, std::vector(6, std::byte{1})));
+    host::IpcClient client(t, model);
+    client.poll();
+
+    ASSERT_EQ(model.size(), 2u);
+    EXPECT_TRUE(host::is_quick_look(model.at(0)));
+    EXPECT_FALSE(host::is_quick_look(model.at(1)));
+
+    auto full = model.at(0);
+    full.decimation = 1;
+    EXPECT_FALSE(host::is_quick_look(full));
+}
+
+static std::vector<std::byte> lanes_frame(const std::string& name,
+                                          const std::uint64_t fence,
+                                          const std::size_t count) {
+    MessageComposer c;
+    c.push(MessageType::PLOT_BUFFER_LANES).push(name).push(fence).push(count);
+    return frame(c);
+}
+
+static std::vector<std::byte> lane_fence_frame(const std::uint64_t fence) {
+    MessageComposer c;
+    c.push(MessageType::PLOT_BUFFER_LANE_FENCE).push(fence);
+    return frame(c);
+}
+
+// One data lane per entry of `shares`, holding what the bridge sent on it.
+static std::vector<std::unique_ptr<ITransport>>
+make_lanes(const std::vector<std::vector<std::byte>>& shares) {
+    std::vector<std::unique_ptr<ITransport>> lanes;
+    for (const auto& share : shares) {
+        auto lane = std::make_unique<FakeTransport>();
+        lane->feed(share);
+        lanes.push_back(std::move(lane));
+    }
+    return lanes;
+}
+
+static std::vector<std::byte> concat(std::vector<std::byte> a,
+                                     const std::vector<std::byte>& b) {
+    a.insert(a.end(), b.begin(), b.end());
+    return a;
+}
+
+// Strips already waiting on the lanes are only taken once the control
+// stream has begun their transfer, and END waits for every lane's fence.
+TEST(IpcClient, StripsOnTheDataLanesAssembleWithTheControlStream) {
+    const std::vector bytes(64 * 3, std::byte{5});
+    const auto rows = std::span{bytes};
+    FakeTransport t;
+    host::IpcBufferModel model;
+    host::IpcClient client(
+        t,
+        model,
+        make_lanes({concat(concat(chunk_frame("v", 0, 1, rows.first(64)),
+                                  chunk_frame("v", 2, 1, rows.last(64))),
+                           lane_fence_frame(1)),
+                    concat(chunk_frame("v", 1, 1, rows.subspan(64, 64)),
+                           lane_fence_frame(1))}));
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+
+    t.feed(begin_frame("v", 64, 3, bytes.size()));
+    t.feed(lanes_frame("v", 1, 2));
+    t.feed(end_frame("v"));
+    client.poll();
+
+    ASSERT_EQ(model.size(), 1u);
+    EXPECT_EQ(model.at(0).bytes, bytes);
+}
+
+TEST(IpcClient, ABrokenDataLaneLeavesItsTransferIncomplete) {
+    const std::vector bytes(64 * 2, std::byte{5});
+    FakeTransport t;
+    host::IpcBufferModel model;
+    CerrCapture cerr;
+    // The second lane carries something that is no strip.
+    host::IpcClient client(
+        t,
+        model,
+        make_lanes({concat(chunk_frame("v", 0, 1, std::span{bytes}.first(64)),
+                           lane_fence_frame(1)),
+                    end_frame("v")}));
+    t.feed(begin_frame("v", 64, 2, bytes.size()));
+    t.feed(lanes_frame("v", 1, 2));
+    t.feed(end_frame("v"));
+    client.poll();
+
+    EXPECT_EQ(model.size(), 0u);
+    const auto log = cerr.out.str();
+    EXPECT_NE(log.find("on a data lane; lane dropped"), std::string::npos);
+    EXPECT_NE(log.find("incomplete transfer"), std::string::npos);
+}
+
+TEST(IpcClient, AnnounceCapabilitiesOffersDataLanesOnlyWithLanes) {
+    FakeTransport t;
+    host::IpcBufferModel model;
+    const host::IpcClient client(t, model, make_lanes({{}}));
+    client.announce_capabilities();
+
+    ASSERT_EQ(t.sends.size(), 1u);
+    FakeTransport decode_t;
+    decode_t.feed(t.sends[0]);
+    MessageType h{};
+    int capabilities{};
+    MessageDecoder{decode_t}.read(h).read(capabilities);
+    EXPECT_NE(capabilities & CAPABILITY_DATA_LANES, 0);
+}
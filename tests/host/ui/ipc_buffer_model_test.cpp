@@ -25,7 +25,10 @@
 
 #include "host/ui/ipc_buffer_model.h"
 
+#include <array>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -43,7 +46,7 @@ static BufferRecord rec(const std::string_view name,
     r.channels = 1;
     r.step = 2;
     r.type = oid::BufferType::UNSIGNED_BYTE;
-    r.bytes.assign(n, fill);
+    r.bytes = oid::PayloadBytes{std::vector<std::byte>(n, fill)};
     return r;
 }
 
@@ -91,3 +94,97 @@ TEST(IpcBufferModel, RemoveErasesByName) {
     m.remove("nope"); // absent -> no-op, no crash
     EXPECT_EQ(m.size(), 1u);
 }
+
+TEST(IpcBufferModel, PatchRowsRewritesInPlaceAndReportsTheRows) {
+    IpcBufferModel m;
+    m.upsert(rec("a", std::byte{1}));
+    const std::byte* const data = m.at(0).bytes.data();
+    const std::uint64_t rev = m.revision_of(0);
+    const std::uint64_t model_rev = m.revision();
+    EXPECT_TRUE(m.changed_rows_since(0, rev)->empty());
+
+    const std::array row{std::byte{7}, std::byte{8}};
+    const std::array patches{IpcBufferModel::RowPatch{1, row}};
+    ASSERT_TRUE(m.patch_rows("a", patches));
+
+    EXPECT_EQ(m.at(0).bytes.data(), data);
+    EXPECT_EQ(m.at(0).bytes[1], std::byte{1});
+    EXPECT_EQ(m.at(0).bytes[2], std::byte{7});
+    EXPECT_EQ(m.at(0).bytes[3], std::byte{8});
+    EXPECT_GT(m.revision_of(0), rev);
+    EXPECT_GT(m.revision(), model_rev);
+
+    const auto rows = m.changed_rows_since(0, rev);
+    ASSERT_TRUE(rows.has_value());
+    EXPECT_EQ(*rows, (std::vector{RowRange{1, 1}}));
+    // Already caught up: nothing since.
+    EXPECT_TRUE(m.changed_rows_since(0, m.revision_of(0))->empty());
+
+    // A replacement is not a patch: the consumer must rebuild from scratch.
+    m.upsert(rec("a", std::byte{3}));
+    EXPECT_FALSE(m.changed_rows_since(0, rev).has_value());
+}
+
+// Strips far apart stay apart, so a consumer re-uploads only those rows and
+// not everything in between; ones that meet are joined.
+TEST(IpcBufferModel, ChangedRowsKeepSeparateStripsApart) {
+    IpcBufferModel m;
+    auto tall = rec("a", std::byte{1}, 16);
+    tall.height = 8;
+    m.upsert(std::move(tall));
+    const std::uint64_t rev = m.revision_of(0);
+
+    const std::array row{std::byte{7}, std::byte{8}};
+    const std::array ends{IpcBufferModel::RowPatch{0, row},
+                          IpcBufferModel::RowPatch{7, row}};
+    ASSERT_TRUE(m.patch_rows("a", ends));
+    const std::array next{IpcBufferModel::RowPatch{1, row},
+                          IpcBufferModel::RowPatch{4, row}};
+    ASSERT_TRUE(m.patch_rows("a", next));
+
+    const auto rows = m.changed_rows_since(0, rev);
+    ASSERT_TRUE(rows.has_value());
+    EXPECT_EQ(*rows,
+              (std::vector{RowRange{0, 2}, RowRange{4, 1}, RowRange{7, 1}}));
+}
+
+TEST(IpcBufferModel, PatchRowsRefusesWhatDoesNotLandOnWholeRows) {
+    IpcBufferModel m;
+    m.upsert(rec("a", std::byte{1}));
+    const std::uint64_t rev = m.revision_of(0);
+
+    const std::array row{std::byte{7}, std::byte{8}};
+    const std::array partial{std::byte{7}};
+    const std::array past_end{IpcBufferModel::RowPatch{2, row}};
+    const std::array uneven{IpcBufferModel::RowPatch{0, partial}};
+    // The first patch is fine, but the second sinks the whole call.
+    const std::array mixed{IpcBufferModel::RowPatch{0, row},
+                           IpcBufferModel::RowPatch{2, row}};
+    EXPECT_FALSE(m.patch_rows("a", past_end));
+    EXPECT_FALSE(m.patch_rows("a", uneven));
+    EXPECT_FALSE(m.patch_rows("a", mixed));
+    const std::array whole{IpcBufferModel::RowPatch{0, row}};
+    EXPECT_FALSE(m.patch_rows("nope", whole));
+
+    EXPECT_EQ(m.at(0).bytes, std::vector<std::byte>(4, std::byte{1}));
+    EXPECT_EQ(m.revision_of(0), rev);
+}
+
+TEST(IpcBufferModel, ReplotOrRemoveDropsTheRegionTiles) {
+    IpcBufferModel m;
+    m.upsert(rec("a", std::byte{1}));
+    m.upsert(rec("b", std::byte{2}));
+    const auto tile = [] {
+        return RegionTile{.region = {.row = 0, .col = 0, .rows = 1, .cols = 1},
+                          .bytes = std::vector<std::byte>(1)};
+    };
+    m.region_tiles().insert("a", tile());
+    m.region_tiles().insert("b", tile());
+    const std::uint64_t rev = m.revision();
+
+    m.upsert(rec("a", std::byte{3}));
+    EXPECT_TRUE(m.region_tiles().tiles_of("a").empty());
+    m.remove("b");
+    EXPECT_TRUE(m.region_tiles().tiles_of("b").empty());
+    EXPECT_EQ(m.revision(), rev + 2);
+}
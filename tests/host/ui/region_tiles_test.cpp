@@ -0,0 +1,135 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "host/ui/region_plan.h"
+#include "host/ui/region_tile_cache.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace oid;
+using namespace oid::host;
+
+namespace {
+
+RegionTile tile_at(const int row, const int col, const std::size_t bytes) {
+    return {.region = {.row = row, .col = col, .rows = 1, .cols = 1},
+            .bytes = std::vector<std::byte>(bytes)};
+}
+
+// Overview of a 10000 x 6000 source at factor 5: 2000 x 1200.
+BufferRecord overview() {
+    BufferRecord record;
+    record.variable_name = "sat";
+    record.width = 2000;
+    record.height = 1200;
+    record.channels = 1;
+    record.step = 2000;
+    record.decimation = 5;
+    record.source_width = 10000;
+    record.source_height = 6000;
+    return record;
+}
+
+} // namespace
+
+TEST(RegionTileCache, EvictsTheLeastRecentlyUsedTilesOverBudget) {
+    RegionTileCache cache{300};
+    cache.insert("a", tile_at(0, 0, 100));
+    cache.insert("a", tile_at(0, 512, 100));
+    cache.insert("b", tile_at(0, 0, 100));
+    ASSERT_NE(cache.find("a", 0, 0), nullptr); // now the most recent
+
+    cache.insert("b", tile_at(512, 0, 100));
+    EXPECT_NE(cache.find("a", 0, 0), nullptr);
+    EXPECT_EQ(cache.find("a", 0, 512), nullptr);
+    EXPECT_EQ(cache.byte_size(), 300U);
+}
+
+TEST(RegionTileCache, ReplacingATileKeepsOneCopy) {
+    RegionTileCache cache{1000};
+    cache.insert("a", tile_at(0, 0, 100));
+    cache.insert("a", tile_at(0, 0, 200));
+    EXPECT_EQ(cache.tiles_of("a").size(), 1U);
+    EXPECT_EQ(cache.byte_size(), 200U);
+}
+
+TEST(RegionTileCache, TileLargerThanTheBudgetIsNotKept) {
+    RegionTileCache cache{100};
+    cache.insert("a", tile_at(0, 0, 50));
+    cache.insert("a", tile_at(0, 512, 101));
+    EXPECT_EQ(cache.find("a", 0, 512), nullptr);
+    EXPECT_NE(cache.find("a", 0, 0), nullptr);
+}
+
+TEST(RegionTileCache, DropForgetsOnlyThatBuffer) {
+    RegionTileCache cache{1000};
+    cache.insert("a", tile_at(0, 0, 10));
+    cache.insert("ab", tile_at(0, 0, 10));
+    cache.insert("a", tile_at(512, 0, 10));
+    const auto before = cache.revision();
+
+    cache.drop("a");
+    EXPECT_TRUE(cache.tiles_of("a").empty());
+    EXPECT_EQ(cache.tiles_of("ab").size(), 1U);
+    EXPECT_EQ(cache.byte_size(), 10U);
+    EXPECT_GT(cache.revision(), before);
+}
+
+TEST(RegionPlan, NothingForAnOrdinaryRecordOrAnUnmagnifiedView) {
+    auto record = overview();
+    const auto view =
+        VisibleRect{.left = 0, .top = 0, .right = 10, .bottom = 10};
+    EXPECT_TRUE(tiles_in_view(record, view, 1.0f).empty());
+    record.decimation = 1;
+    EXPECT_TRUE(tiles_in_view(record, view, 4.0f).empty());
+}
+
+TEST(RegionPlan, CoversTheViewMiddleFirstAndClipsToTheSource) {
+    // Overview pixels [1900, 2010) x [0, 150): source columns 9500 up to
+    // the edge at 10000, rows 0 to 750.
+    const auto tiles = tiles_in_view(
+        overview(),
+        VisibleRect{.left = 1900, .top = 0, .right = 2010, .bottom = 150},
+        8.0f);
+    ASSERT_EQ(tiles.size(), 4U);
+    EXPECT_EQ(tiles[0],
+              (PixelRegion{.row = 0, .col = 9728, .rows = 512, .cols = 272}));
+    EXPECT_EQ(tiles[3],
+              (PixelRegion{.row = 512, .col = 9216, .rows = 512, .cols = 512}));
+}
+
+TEST(RegionPlan, TooWideAViewIsLeftToTheOverview) {
+    EXPECT_TRUE(tiles_in_view(overview(),
+                              VisibleRect{.left = 0,
+                                          .top = 0,
+                                          .right = 1000,
+                                          .bottom = 1000},
+                              2.0f)
+                    .empty());
+}
@@ -0,0 +1,95 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "host/util/spsc_queue.h"
+
+#include <memory>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+using oid::host::SpscQueue;
+
+TEST(SpscQueue, PopsInPushOrderAndReportsEmpty) {
+    SpscQueue<int> q(4);
+    EXPECT_FALSE(q.try_pop().has_value());
+    ASSERT_TRUE(q.try_push(1));
+    ASSERT_TRUE(q.try_push(2));
+    EXPECT_EQ(q.try_pop(), 1);
+    EXPECT_EQ(q.try_pop(), 2);
+    EXPECT_FALSE(q.try_pop().has_value());
+}
+
+TEST(SpscQueue, RefusesPushWhenFullAndKeepsTheValue) {
+    SpscQueue<std::unique_ptr<int>> q(2);
+    ASSERT_TRUE(q.try_push(std::make_unique<int>(1)));
+    ASSERT_TRUE(q.try_push(std::make_unique<int>(2)));
+
+    auto third = std::make_unique<int>(3);
+    EXPECT_FALSE(q.try_push(std::move(third)));
+    ASSERT_NE(third, nullptr); // NOLINT(bugprone-use-after-move): not moved
+    EXPECT_EQ(*third, 3);
+
+    EXPECT_EQ(**q.try_pop(), 1);
+    EXPECT_TRUE(q.try_push(std::move(third)));
+    EXPECT_EQ(**q.try_pop(), 2);
+    EXPECT_EQ(**q.try_pop(), 3);
+}
+
+TEST(SpscQueue, WrapsAroundManyTimes) {
+    SpscQueue<int> q(3);
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(q.try_push(int{i}));
+        ASSERT_TRUE(q.try_push(int{-i}));
+        EXPECT_EQ(q.try_pop(), i);
+        EXPECT_EQ(q.try_pop(), -i);
+    }
+}
+
+// One producer thread against the consumer on this one, through a queue far
+// smaller than the stream: every value arrives, once, in order.
+TEST(SpscQueue, HandsOffAcrossThreadsInOrder) {
+    constexpr int count = 100000;
+    SpscQueue<int> q(8);
+    std::thread producer([&q] {
+        for (int i = 0; i < count; ++i) {
+            while (!q.try_push(int{i})) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    while (expected < count) {
+        if (auto value = q.try_pop()) {
+            EXPECT_EQ(*value, expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_FALSE(q.try_pop().has_value());
+}
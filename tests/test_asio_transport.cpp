@@ -29,6 +29,7 @@
 #include <array>
 #include <chrono>
 #include <cstddef>
+#include <filesystem>
 #include <memory>
 #include <optional>
 #include <thread>
@@ -81,6 +82,46 @@ TEST(AsioTransport, HasDataFalseBeforeSend) {
     EXPECT_FALSE(client.has_data()); // nothing sent by peer yet
 }
 
+TEST(AsioTransport, WaitForDataReturnsWhenBytesArrive) {
+    asio::io_context server_ctx;
+    asio::ip::tcp::acceptor acceptor(
+        server_ctx,
+        asio::ip::tcp::endpoint(asio::ip::make_address("127.0.0.1"), 0));
+    const unsigned short port = acceptor.local_endpoint().port();
+    asio::ip::tcp::socket server_sock(server_ctx);
+    std::jthread server([&acceptor, &server_sock] {
+        acceptor.accept(server_sock);
+        std::this_thread::sleep_for(std::chrono::milliseconds{20});
+        constexpr std::array out{std::byte{1}};
+        asio::write(server_sock, asio::buffer(out));
+    });
+    AsioTransport client("127.0.0.1", port);
+    EXPECT_TRUE(client.wait_for_data());
+    server.join();
+    EXPECT_TRUE(client.has_data());
+}
+
+TEST(AsioTransport, InterruptWaitEndsAWaitForData) {
+    AsioAcceptor acceptor;
+    std::optional<AsioTransport> server;
+    std::jthread accept_thread(
+        [&] { server.emplace(acceptor.accept(std::chrono::seconds{5})); });
+    AsioTransport client("127.0.0.1", acceptor.port());
+    accept_thread.join();
+    ASSERT_TRUE(server.has_value());
+
+    // Posted before the wait: the wait returns at once.
+    client.interrupt_wait();
+    EXPECT_FALSE(client.wait_for_data());
+
+    std::jthread interrupter([&client] {
+        std::this_thread::sleep_for(std::chrono::milliseconds{20});
+        client.interrupt_wait();
+    });
+    EXPECT_FALSE(client.wait_for_data());
+    EXPECT_FALSE(client.has_data());
+}
+
 TEST(AsioCodec, RoundTripPlotBufferRequest) {
     asio::io_context server_ctx;
     asio::ip::tcp::acceptor acceptor(
@@ -205,3 +246,81 @@ TEST(AsioTransport, IsConnectedFalseAfterPeerClose) {
     std::this_thread::sleep_for(std::chrono::milliseconds{50});
     EXPECT_FALSE(client.is_connected());
 }
+
+#if defined(OID_HAS_LOCAL_SOCKET_TRANSPORT)
+TEST(AsioLocalAcceptor, AcceptThenRoundTrip) {
+    AsioLocalAcceptor acceptor;
+    std::optional<AsioTransport> server_side;
+    std::jthread server([&server_side, &acceptor] {
+        server_side.emplace(acceptor.accept(std::chrono::seconds{5}));
+    });
+    AsioTransport client(
+        asio::local::stream_protocol::endpoint{acceptor.path()});
+    server.join();
+    ASSERT_TRUE(client.is_connected());
+
+    constexpr std::array out{std::byte{7}, std::byte{8}, std::byte{9}};
+    client.send(out);
+    std::array<std::byte, 3> in{};
+    std::size_t got = 0;
+    while (got < in.size()) {
+        got += server_side->receive(std::span{in}.subspan(got));
+    }
+    EXPECT_EQ(in, out);
+
+    server_side->send(in);
+    std::array<std::byte, 3> back{};
+    got = 0;
+    while (got < back.size()) {
+        got += client.receive(std::span{back}.subspan(got));
+    }
+    EXPECT_EQ(back, out);
+}
+
+TEST(AsioLocalAcceptor, SocketIsPrivateAndRemovedOnDestruction) {
+    std::filesystem::path path;
+    {
+        const AsioLocalAcceptor acceptor;
+        path = acceptor.path();
+        EXPECT_TRUE(std::filesystem::is_socket(path));
+        const auto perms =
+            std::filesystem::status(path.parent_path()).permissions();
+        EXPECT_EQ(perms & (std::filesystem::perms::group_all |
+                           std::filesystem::perms::others_all),
+                  std::filesystem::perms::none);
+    }
+    EXPECT_FALSE(std::filesystem::exists(path));
+    EXPECT_FALSE(std::filesystem::exists(path.parent_path()));
+}
+
+TEST(AsioTransport, LocalConnectToMissingSocketDoesNotThrow) {
+    std::filesystem::path path;
+    {
+        const AsioLocalAcceptor acceptor;
+        path = acceptor.path();
+    }
+
+    std::optional<AsioTransport> client;
+    EXPECT_NO_THROW(
+        client.emplace(asio::local::stream_protocol::endpoint{path.string()},
+                       std::chrono::milliseconds{300}));
+    EXPECT_FALSE(client->is_connected());
+}
+
+TEST(AsioTransport, LocalIsConnectedFalseAfterPeerClose) {
+    AsioLocalAcceptor acceptor;
+    std::optional<AsioTransport> server_side;
+    std::jthread server([&server_side, &acceptor] {
+        server_side.emplace(acceptor.accept(std::chrono::seconds{5}));
+    });
+    const AsioTransport client(
+        asio::local::stream_protocol::endpoint{acceptor.path()});
+    server.join();
+    EXPECT_TRUE(client.is_connected());
+
+    server_side.reset();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    EXPECT_FALSE(client.is_connected());
+}
+#endif
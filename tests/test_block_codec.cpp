@@ -0,0 +1,145 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "ipc/block_codec.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using oid::compress_block;
+using oid::compress_bound;
+using oid::decompress_block;
+
+namespace {
+
+std::vector<std::byte> random_bytes(const std::size_t size,
+                                    const std::uint32_t seed = 7) {
+    auto engine = std::mt19937{seed};
+    auto bytes  = std::vector<std::byte>(size);
+    for (auto& byte : bytes) {
+        byte = static_cast<std::byte>(engine() & 0xFFU);
+    }
+    return bytes;
+}
+
+// Mostly-constant rows with a short repeating run, like a label image.
+std::vector<std::byte> mask_bytes(const std::size_t size) {
+    auto bytes = std::vector<std::byte>(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        bytes[i] = (i % 997 < 40) ? std::byte{0xFF} : std::byte{0};
+    }
+    return bytes;
+}
+
+std::vector<std::byte> round_trip(const std::vector<std::byte>& bytes) {
+    const auto block = compress_block(bytes);
+    EXPECT_LE(block.size(), compress_bound(bytes.size()));
+    auto out = std::vector<std::byte>(bytes.size());
+    EXPECT_TRUE(decompress_block(block, out));
+    return out;
+}
+
+} // namespace
+
+TEST(BlockCodec, RoundTripsShortInputs) {
+    for (std::size_t size = 1; size <= 32; ++size) {
+        const auto bytes = random_bytes(size, static_cast<std::uint32_t>(size));
+        EXPECT_EQ(round_trip(bytes), bytes) << "size " << size;
+    }
+}
+
+TEST(BlockCodec, RoundTripsCompressibleAndNoisyInputs) {
+    const auto mask = mask_bytes(1U << 20U);
+    EXPECT_EQ(round_trip(mask), mask);
+
+    const auto noise = random_bytes(300'000);
+    EXPECT_EQ(round_trip(noise), noise);
+}
+
+TEST(BlockCodec, ShrinksMostlyConstantData) {
+    const auto mask  = mask_bytes(1U << 20U);
+    const auto block = compress_block(mask);
+    EXPECT_LT(block.size(), mask.size() / 20);
+}
+
+// A block written by hand in the LZ4 block format: one literal 'a', a
+// 14-byte match at offset 1, then the five trailing literals.
+TEST(BlockCodec, DecodesReferenceBlock) {
+    const auto block = std::vector<std::byte>{std::byte{0x1A},
+                                              std::byte{'a'},
+                                              std::byte{0x01},
+                                              std::byte{0x00},
+                                              std::byte{0x50},
+                                              std::byte{'a'},
+                                              std::byte{'a'},
+                                              std::byte{'a'},
+                                              std::byte{'a'},
+                                              std::byte{'a'}};
+    auto out         = std::vector<std::byte>(20);
+    ASSERT_TRUE(decompress_block(block, out));
+    EXPECT_EQ(out, std::vector<std::byte>(20, std::byte{'a'}));
+}
+
+TEST(BlockCodec, RefusesTruncatedBlocks) {
+    const auto mask  = mask_bytes(64 * 1024);
+    const auto block = compress_block(mask);
+    auto out         = std::vector<std::byte>(mask.size());
+    for (const auto cut : {std::size_t{0}, std::size_t{1}, block.size() / 2}) {
+        EXPECT_FALSE(decompress_block(std::span{block}.first(cut), out))
+            << "cut at " << cut;
+    }
+}
+
+TEST(BlockCodec, RefusesTheWrongOutputSize) {
+    const auto mask  = mask_bytes(64 * 1024);
+    const auto block = compress_block(mask);
+
+    auto shorter = std::vector<std::byte>(mask.size() - 1);
+    EXPECT_FALSE(decompress_block(block, shorter));
+    auto longer = std::vector<std::byte>(mask.size() + 1);
+    EXPECT_FALSE(decompress_block(block, longer));
+}
+
+// An offset reaching back before the start of the output must be refused
+// rather than read out of bounds.
+TEST(BlockCodec, RefusesOffsetsBeforeTheOutput) {
+    const auto block = std::vector<std::byte>{std::byte{0x10},
+                                              std::byte{'a'},
+                                              std::byte{0x08},
+                                              std::byte{0x00},
+                                              std::byte{0x50},
+                                              std::byte{'a'},
+                                              std::byte{'a'},
+                                              std::byte{'a'},
+                                              std::byte{'a'},
+                                              std::byte{'a'}};
+    auto out         = std::vector<std::byte>(10);
+    EXPECT_FALSE(decompress_block(block, out));
+}
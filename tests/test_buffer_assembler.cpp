@@ -23,9 +23,17 @@
  * IN THE SOFTWARE.
  */
 
+#include "ipc/block_codec.h"
 #include "ipc/buffer_assembler.h"
 #include "ipc/raw_data_decode.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 using namespace oid;
@@ -51,6 +59,21 @@ make_begin(const std::string& name,
                                         .total_byte_size = total};
 }
 
+BufferAssembler::PatchParams make_patch(const std::string& name,
+                                       const int width,
+                                       const int height,
+                                       const int stride,
+                                       const std::size_t total) {
+    return BufferAssembler::PatchParams{
+        .variable_name = name,
+        .width = width,
+        .height = height,
+        .channels = 1,
+        .stride = stride,
+        .type = static_cast<int>(BufferType::UNSIGNED_BYTE),
+        .total_byte_size = total};
+}
+
 std::vector<std::byte> iota_bytes(const std::size_t n) {
     std::vector<std::byte> v(n);
     for (std::size_t i = 0; i < n; ++i) {
@@ -342,3 +365,417 @@ TEST(BufferAssemblerTests, AbortOnUnknownNameIsHarmless) {
     EXPECT_NO_FATAL_FAILURE(a.abort("missing"));
     EXPECT_FALSE(a.end("missing").has_value());
 }
+
+TEST(BufferAssemblerTests, PatchHandsBackOnlyTheRowsSent) {
+    constexpr int stride = 4;
+    constexpr int height = 6;
+    constexpr std::size_t total = stride * height;
+    BufferAssembler a;
+    ASSERT_TRUE(a.begin_patch(make_patch("buf", 4, height, stride, total)));
+    EXPECT_TRUE(a.has_patch_in_progress("buf"));
+
+    const auto rows = iota_bytes(2 * stride);
+    ASSERT_TRUE(a.chunk("buf", 3, 2, std::span{rows.data(), rows.size()}));
+    ASSERT_TRUE(a.chunk("buf", 0, 1, std::span{rows.data(), stride}));
+
+    // Rows never sent are not missing: a patch leaves them as they are.
+    const auto patch = a.end_patch("buf");
+    ASSERT_TRUE(patch.has_value());
+    EXPECT_EQ(patch->variable_name, "buf");
+    EXPECT_EQ(patch->height, height);
+    ASSERT_EQ(patch->strips.size(), 2U);
+    EXPECT_EQ(patch->strips[0].row_offset, 3U);
+    EXPECT_EQ(patch->strips[0].row_count, 2U);
+    EXPECT_EQ(patch->strips[0].bytes, rows);
+    EXPECT_EQ(patch->strips[1].row_offset, 0U);
+    EXPECT_EQ(patch->strips[1].bytes.size(), std::size_t{stride});
+    EXPECT_FALSE(a.has_in_progress("buf"));
+}
+
+TEST(BufferAssemblerTests, PatchIsRefusedByTheFullTransferCalls) {
+    constexpr int stride = 4;
+    constexpr int height = 2;
+    constexpr std::size_t total = stride * height;
+    BufferAssembler a;
+    ASSERT_TRUE(a.begin_patch(make_patch("buf", 4, height, stride, total)));
+    // end() cannot turn a patch into a whole buffer; the transfer is gone.
+    EXPECT_FALSE(a.end("buf").has_value());
+    EXPECT_FALSE(a.end_patch("buf").has_value());
+
+    ASSERT_TRUE(a.begin(make_begin("buf", 4, height, stride, total)));
+    EXPECT_FALSE(a.has_patch_in_progress("buf"));
+    EXPECT_FALSE(a.end_patch("buf").has_value());
+}
+
+TEST(BufferAssemblerTests, PatchGeometryIsCheckedLikeBegin) {
+    BufferAssembler a;
+    EXPECT_FALSE(a.begin_patch(make_patch("buf", 4, 2, 4, 9)));
+    EXPECT_FALSE(a.begin_patch(make_patch("buf", 4, -1, 4, 8)));
+    EXPECT_FALSE(a.has_in_progress("buf"));
+
+    ASSERT_TRUE(a.begin_patch(make_patch("buf", 4, 2, 4, 8)));
+    const auto strip = iota_bytes(4);
+    EXPECT_FALSE(a.chunk("buf", 2, 1, std::span{strip.data(), strip.size()}));
+}
+
+TEST(BufferAssemblerTests, CompressedChunksFillTheirRows) {
+    constexpr int stride = 64;
+    constexpr int height = 4;
+    constexpr std::size_t total = stride * height;
+    BufferAssembler a;
+    ASSERT_TRUE(a.begin(make_begin("buf", stride, height, stride, total)));
+
+    const auto full = std::vector<std::byte>(total, std::byte{9});
+    const auto block =
+        compress_block(std::span{full.data(), 3 * std::size_t{stride}});
+    ASSERT_TRUE(a.compressed_chunk("buf", 0, 3, block));
+    ASSERT_TRUE(a.chunk("buf",
+                        3,
+                        1,
+                        std::span{full.data() + 3 * std::size_t{stride},
+                                  std::size_t{stride}}));
+
+    const auto result = a.end("buf");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->bytes, full);
+}
+
+TEST(BufferAssemblerTests, CompressedChunkThatDoesNotFitItsRowsIsRefused) {
+    constexpr int stride = 64;
+    constexpr int height = 2;
+    constexpr std::size_t total = stride * height;
+    BufferAssembler a;
+    ASSERT_TRUE(a.begin(make_begin("buf", stride, height, stride, total)));
+
+    // Decodes to a single row, but claims two.
+    const auto row = std::vector<std::byte>(stride, std::byte{1});
+    EXPECT_FALSE(a.compressed_chunk("buf", 0, 2, compress_block(row)));
+    const auto garbage = iota_bytes(16);
+    EXPECT_FALSE(a.compressed_chunk("buf", 0, 1, garbage));
+
+    // Neither counts as coverage.
+    EXPECT_FALSE(a.end("buf").has_value());
+}
+
+TEST(BufferAssemblerTests, PreviewKeepsItsSamplesDecimated) {
+    // 5x3, one byte per pixel, one byte of stride padding; every 2nd row and
+    // column makes a 3x2 preview.
+    constexpr int width = 5;
+    constexpr int height = 3;
+    constexpr int stride = 6;
+    constexpr std::size_t total = stride * height;
+    BufferAssembler a;
+    ASSERT_TRUE(a.begin(make_begin("buf", width, height, stride, total)));
+    EXPECT_FALSE(a.has_preview("buf"));
+
+    const auto samples = iota_bytes(6);
+    const auto preview = a.preview("buf", 2, PayloadBytes{samples});
+    ASSERT_TRUE(preview.has_value());
+    EXPECT_TRUE(a.has_preview("buf"));
+    // Nothing the size of the full buffer: the samples as they came.
+    EXPECT_EQ(preview->width, 3);
+    EXPECT_EQ(preview->height, 2);
+    EXPECT_EQ(preview->stride, 3);
+    EXPECT_EQ(preview->decimation, 2);
+    EXPECT_EQ(preview->source_width, width);
+    EXPECT_EQ(preview->source_height, height);
+    EXPECT_EQ(preview->bytes, samples);
+
+    // The transfer itself still needs every row.
+    EXPECT_TRUE(a.has_in_progress("buf"));
+    EXPECT_FALSE(a.end("buf").has_value());
+}
+
+TEST(BufferAssemblerTests, PreviewOfTheWrongSizeIsRefused) {
+    BufferAssembler a;
+    ASSERT_TRUE(a.begin(make_begin("buf", 4, 4, 4, 16)));
+    const PayloadBytes samples{iota_bytes(4)};
+    EXPECT_FALSE(a.preview("buf", 2, PayloadBytes{iota_bytes(3)}));
+    EXPECT_FALSE(a.preview("buf", 0, samples));
+    EXPECT_FALSE(a.preview("missing", 2, samples));
+    EXPECT_FALSE(a.has_preview("buf"));
+
+    ASSERT_TRUE(a.begin_patch(make_patch("buf", 4, 4, 4, 16)));
+    EXPECT_FALSE(a.preview("buf", 2, samples));
+}
+
+TEST(BufferAssemblerTests, PartialCopiesTheRowsSoFarAndZeroesTheRest) {
+    // 4 rows of 4 bytes; rows 1 and 3 arrive.
+    BufferAssembler a;
+    ASSERT_TRUE(a.begin(make_begin("buf", 4, 4, 4, 16)));
+    EXPECT_FALSE(a.partial("buf").has_value()); // nothing to show yet
+    const auto data = iota_bytes(16);
+    ASSERT_TRUE(a.chunk("buf", 1, 1, std::span{data}.subspan(4, 4)));
+    ASSERT_TRUE(a.chunk("buf", 3, 1, std::span{data}.subspan(12, 4)));
+
+    const auto partial = a.partial("buf");
+    ASSERT_TRUE(partial.has_value());
+    EXPECT_TRUE(a.has_preview("buf"));
+    EXPECT_EQ(partial->height, 4);
+    for (std::size_t i = 0; i < 16; ++i) {
+        const bool arrived = (i / 4) % 2 == 1;
+        EXPECT_EQ(partial->bytes[i], arrived ? data[i] : std::byte{})
+            << "byte " << i;
+    }
+
+    // The transfer carries on and completes as usual.
+    ASSERT_TRUE(a.chunk("buf", 0, 1, std::span{data}.first(4)));
+    ASSERT_TRUE(a.chunk("buf", 2, 1, std::span{data}.subspan(8, 4)));
+    const auto out = a.end("buf");
+    ASSERT_TRUE(out.has_value());
+    EXPECT_TRUE(std::ranges::equal(out->bytes, data));
+}
+
+TEST(BufferAssemblerTests, ArrivedRowsAreTheRowsSinceTheLastHandedOut) {
+    BufferAssembler a;
+    ASSERT_TRUE(a.begin(make_begin("buf", 4, 4, 4, 16)));
+    const auto data = iota_bytes(16);
+    ASSERT_TRUE(a.chunk("buf", 0, 1, std::span{data}.first(4)));
+    // Nothing on show to patch yet.
+    EXPECT_FALSE(a.arrived_rows("buf").has_value());
+    ASSERT_TRUE(a.partial("buf").has_value());
+
+    const auto none = a.arrived_rows("buf");
+    ASSERT_TRUE(none.has_value());
+    EXPECT_TRUE(none->strips.empty());
+
+    ASSERT_TRUE(a.chunk("buf", 2, 2, std::span{data}.subspan(8, 8)));
+    ASSERT_TRUE(a.chunk("buf", 1, 1, std::span{data}.subspan(4, 4)));
+    const auto rows = a.arrived_rows("buf");
+    ASSERT_TRUE(rows.has_value());
+    ASSERT_EQ(rows->strips.size(), 1u);
+    EXPECT_EQ(rows->strips[0].row_offset, 1u);
+    EXPECT_EQ(rows->strips[0].row_count, 3u);
+    EXPECT_TRUE(std::ranges::equal(rows->strips[0].bytes,
+                                   std::span{data}.subspan(4)));
+    EXPECT_TRUE(a.arrived_rows("buf")->strips.empty());
+}
+
+// A decimated preview on show has no room for full rows: once one replaces
+// what partial() showed, there is nothing to patch until the transfer ends.
+TEST(BufferAssemblerTests, NoArrivedRowsOnceAPreviewIsOnShow) {
+    BufferAssembler a;
+    ASSERT_TRUE(a.begin(make_begin("buf", 4, 4, 4, 16)));
+    const auto data = iota_bytes(16);
+    ASSERT_TRUE(a.chunk("buf", 0, 2, std::span{data}.first(8)));
+    ASSERT_TRUE(a.partial("buf").has_value());
+    ASSERT_TRUE(a.preview("buf", 2, PayloadBytes{iota_bytes(4)}).has_value());
+    ASSERT_TRUE(a.chunk("buf", 2, 1, std::span{data}.subspan(8, 4)));
+    EXPECT_TRUE(a.has_preview("buf"));
+    EXPECT_FALSE(a.arrived_rows("buf").has_value());
+
+    ASSERT_TRUE(a.begin_patch(make_patch("buf", 4, 4, 4, 16)));
+    EXPECT_FALSE(a.partial("buf").has_value());
+    EXPECT_FALSE(a.arrived_rows("buf").has_value());
+}
+
+namespace {
+
+// `count` doubles 0.5, 1.5, 2.5, ... as wire bytes, and the floats they
+// narrow to.
+std::pair<std::vector<std::byte>, std::vector<std::byte>>
+doubles_and_floats(const std::size_t count) {
+    std::vector<std::byte> doubles(count * sizeof(double));
+    std::vector<std::byte> floats(count * sizeof(float));
+    for (std::size_t i = 0; i < count; ++i) {
+        const double wide = static_cast<double>(i) + 0.5;
+        const auto narrow = static_cast<float>(wide);
+        std::memcpy(doubles.data() + i * sizeof(double), &wide, sizeof(wide));
+        std::memcpy(floats.data() + i * sizeof(float), &narrow, sizeof(narrow));
+    }
+    return {doubles, floats};
+}
+
+} // namespace
+
+TEST(BufferAssemblerTests, NarrowsFloat64RowsAsTheyArrive) {
+    constexpr int width = 3;
+    constexpr int height = 4;
+    constexpr std::size_t bytes_per_row = width * sizeof(double);
+    constexpr std::size_t total = bytes_per_row * height;
+    BufferAssembler a{BufferAssembler::Float64Rows::NARROWED};
+    ASSERT_TRUE(a.begin(
+        make_begin("buf", width, height, width, total, BufferType::FLOAT64)));
+
+    const auto [doubles, floats] = doubles_and_floats(width * height);
+    ASSERT_TRUE(
+        a.chunk("buf", 0, 1, std::span{doubles.data(), bytes_per_row}));
+    ASSERT_TRUE(a.compressed_chunk(
+        "buf",
+        1,
+        3,
+        compress_block(
+            std::span{doubles.data() + bytes_per_row, 3 * bytes_per_row})));
+
+    const auto result = a.end("buf");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_TRUE(result->narrowed);
+    EXPECT_EQ(result->type, static_cast<int>(BufferType::FLOAT64));
+    EXPECT_EQ(result->bytes, floats);
+}
+
+TEST(BufferAssemblerTests, NarrowsFloat64PatchStripsAsTheyArrive) {
+    constexpr int width = 2;
+    constexpr int height = 3;
+    constexpr std::size_t bytes_per_row = width * sizeof(double);
+    BufferAssembler a{BufferAssembler::Float64Rows::NARROWED};
+    ASSERT_TRUE(a.begin_patch(BufferAssembler::PatchParams{
+        .variable_name = "buf",
+        .width = width,
+        .height = height,
+        .channels = 1,
+        .stride = width,
+        .type = static_cast<int>(BufferType::FLOAT64),
+        .total_byte_size = bytes_per_row * height}));
+
+    const auto [doubles, floats] = doubles_and_floats(width);
+    ASSERT_TRUE(a.chunk("buf", 1, 1, doubles));
+
+    const auto patch = a.end_patch("buf");
+    ASSERT_TRUE(patch.has_value());
+    ASSERT_EQ(patch->strips.size(), 1U);
+    EXPECT_EQ(patch->strips[0].bytes, floats);
+}
+
+TEST(BufferAssemblerTests, KeepsFloat64RowsAsReceivedByDefault) {
+    constexpr std::size_t total = 2 * sizeof(double);
+    BufferAssembler a;
+    ASSERT_TRUE(
+        a.begin(make_begin("buf", 2, 1, 2, total, BufferType::FLOAT64)));
+    const auto [doubles, floats] = doubles_and_floats(2);
+    ASSERT_TRUE(a.chunk("buf", 0, 1, doubles));
+
+    const auto result = a.end("buf");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_FALSE(result->narrowed);
+    EXPECT_EQ(result->bytes, doubles);
+}
+
+TEST(BufferAssemblerTests, ChunkRowsAreTheRowsPlaceInTheBuffer) {
+    constexpr int stride = 4;
+    constexpr int height = 3;
+    constexpr std::size_t total = stride * height;
+    BufferAssembler a;
+    ASSERT_TRUE(a.begin(make_begin("buf", stride, height, stride, total)));
+    const auto full = iota_bytes(total);
+
+    // Filled in reverse, and committed only once written.
+    for (std::size_t row = height; row-- > 0;) {
+        auto pending = a.chunk_rows("buf", row, 1);
+        ASSERT_TRUE(pending.has_value());
+        ASSERT_EQ(pending->rows().size(), std::size_t{stride});
+        std::ranges::copy(std::span{full}.subspan(row * stride, stride),
+                          pending->rows().begin());
+        ASSERT_TRUE(a.commit_rows(std::move(*pending)));
+    }
+
+    const auto result = a.end("buf");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->bytes, full);
+}
+
+TEST(BufferAssemblerTests, UncommittedChunkRowsDoNotCountAsCoverage) {
+    constexpr std::size_t total = 8;
+    BufferAssembler a;
+    ASSERT_TRUE(a.begin(make_begin("buf", 4, 2, 4, total)));
+    ASSERT_TRUE(a.chunk_rows("buf", 0, 2).has_value());
+
+    EXPECT_FALSE(a.end("buf").has_value());
+}
+
+TEST(BufferAssemblerTests, EndRefusesWhileChunkRowsAreBeingFilled) {
+    constexpr std::size_t total = 8;
+    BufferAssembler a;
+    ASSERT_TRUE(a.begin(make_begin("buf", 4, 2, 4, total)));
+    const auto full = iota_bytes(total);
+    ASSERT_TRUE(a.chunk("buf", 0, 2, full));
+    auto pending = a.chunk_rows("buf", 1, 1);
+    ASSERT_TRUE(pending.has_value());
+
+    // Every row has arrived once, but row 1 is being written again.
+    EXPECT_FALSE(a.end("buf").has_value());
+    EXPECT_FALSE(a.commit_rows(std::move(*pending)));
+}
+
+TEST(BufferAssemblerTests, ChunkRowsOfAReplacedTransferAreNotCommitted) {
+    constexpr std::size_t total = 8;
+    BufferAssembler a;
+    ASSERT_TRUE(a.begin(make_begin("buf", 4, 2, 4, total)));
+    auto stale = a.chunk_rows("buf", 0, 2);
+    ASSERT_TRUE(stale.has_value());
+    ASSERT_TRUE(a.begin(make_begin("buf", 4, 2, 4, total)));
+
+    // Still writable, but lands in the replaced transfer's allocation.
+    std::ranges::fill(stale->rows(), std::byte{1});
+    EXPECT_FALSE(a.commit_rows(std::move(*stale)));
+    EXPECT_FALSE(a.end("buf").has_value());
+}
+
+TEST(BufferAssemblerTests, ChunkRowsRefusesWhatChunkRefuses) {
+    BufferAssembler a;
+    EXPECT_FALSE(a.chunk_rows("buf", 0, 1).has_value());
+    ASSERT_TRUE(a.begin(make_begin("buf", 4, 2, 4, 8)));
+    EXPECT_FALSE(a.chunk_rows("buf", 1, 2).has_value());
+    EXPECT_FALSE(a.chunk_rows("buf", 3, 0).has_value());
+}
+
+TEST(BufferAssemblerTests, AssemblesStripsFilledOnSeveralThreads) {
+    // Rows 61 bytes wide, so no two of them hold the same bytes.
+    constexpr int stride = 61;
+    constexpr int height = 256;
+    constexpr std::size_t total = std::size_t{stride} * height;
+    constexpr std::size_t lanes = 4;
+    BufferAssembler a;
+    ASSERT_TRUE(a.begin(make_begin("buf", stride, height, stride, total)));
+    const auto full = iota_bytes(total);
+
+    // Each thread takes every lanes-th row, as the data lanes stripe them.
+    std::atomic<int> refused{0};
+    {
+        std::vector<std::jthread> threads;
+        for (std::size_t lane = 0; lane < lanes; ++lane) {
+            threads.emplace_back([&, lane] {
+                for (auto row = lane; row < height; row += lanes) {
+                    const auto bytes =
+                        std::span{full}.subspan(row * stride, stride);
+                    if (!a.chunk("buf", row, 1, bytes)) {
+                        ++refused;
+                    }
+                }
+            });
+        }
+    }
+
+    EXPECT_EQ(refused.load(), 0);
+    const auto result = a.end("buf");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->bytes, full);
+}
+
+TEST(BufferAssemblerTests, ChunkRowsNarrowFloat64OnCommit) {
+    constexpr int width = 2;
+    constexpr int height = 2;
+    constexpr std::size_t bytes_per_row = width * sizeof(double);
+    BufferAssembler a{BufferAssembler::Float64Rows::NARROWED};
+    ASSERT_TRUE(a.begin(make_begin("buf",
+                                   width,
+                                   height,
+                                   width,
+                                   bytes_per_row * height,
+                                   BufferType::FLOAT64)));
+    const auto [doubles, floats] = doubles_and_floats(width * height);
+
+    for (std::size_t row = 0; row < height; ++row) {
+        auto pending = a.chunk_rows("buf", row, 1);
+        ASSERT_TRUE(pending.has_value());
+        ASSERT_EQ(pending->rows().size(), bytes_per_row);
+        std::ranges::copy(
+            std::span{doubles}.subspan(row * bytes_per_row, bytes_per_row),
+            pending->rows().begin());
+        ASSERT_TRUE(a.commit_rows(std::move(*pending)));
+    }
+
+    const auto result = a.end("buf");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(result->bytes, floats);
+}
@@ -0,0 +1,166 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "ipc/buffered_transport.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ipc/message_exchange.h"
+
+using oid::BufferedTransport;
+using oid::MessageComposer;
+using oid::MessageDecoder;
+
+namespace {
+
+constexpr std::size_t READ_AHEAD = 256;
+
+// Receives what was sent to it, at most `max_receive` bytes at a time,
+// recording the size of every receive asked of it.
+struct LoopbackTransport final : oid::ITransport {
+    std::vector<std::byte> stream;
+    std::size_t offset{0};
+    std::size_t max_receive{SIZE_MAX};
+    std::vector<std::size_t> receives;
+
+    void send(const std::span<const std::byte> data) override {
+        stream.insert(stream.end(), data.begin(), data.end());
+    }
+    std::size_t receive(const std::span<std::byte> dst) override {
+        receives.push_back(dst.size());
+        const auto n =
+            std::min({dst.size(), stream.size() - offset, max_receive});
+        std::copy_n(stream.begin() + static_cast<std::ptrdiff_t>(offset),
+                    n,
+                    dst.begin());
+        offset += n;
+        return n;
+    }
+    bool has_data() const override {
+        return offset < stream.size();
+    }
+};
+
+std::deque<std::string> symbols(const std::size_t count) {
+    auto names = std::deque<std::string>{};
+    for (std::size_t i = 0; i < count; ++i) {
+        names.push_back("symbol_" + std::to_string(i));
+    }
+    return names;
+}
+
+} // namespace
+
+TEST(BufferedTransport, SmallFieldsShareReceives) {
+    LoopbackTransport inner;
+    const auto sent = symbols(1000);
+    MessageComposer{}.push(sent).send(inner);
+
+    BufferedTransport buffered{inner, READ_AHEAD};
+    auto received = std::deque<std::string>{};
+    MessageDecoder{buffered}.read<std::deque<std::string>, std::string>(
+        received);
+
+    EXPECT_EQ(received, sent);
+    // Two fields per name, read unbuffered, would take two receives each.
+    EXPECT_LE(inner.receives.size(), inner.stream.size() / READ_AHEAD + 1);
+    EXPECT_EQ(buffered.buffered_bytes(), 0u);
+}
+
+TEST(BufferedTransport, LargeReadGoesStraightToTheDestination) {
+    LoopbackTransport inner;
+    const auto payload = std::vector<std::byte>(4 * READ_AHEAD, std::byte{7});
+    MessageComposer{}.push(std::size_t{42}).push(payload).send(inner);
+
+    BufferedTransport buffered{inner, READ_AHEAD};
+    auto tag = std::size_t{};
+    auto received = std::vector<std::byte>{};
+    MessageDecoder{buffered}.read(tag).read(received);
+
+    EXPECT_EQ(tag, 42u);
+    EXPECT_EQ(received, payload);
+    // One read ahead for the header and the start of the payload, then one
+    // straight into the rest of it.
+    ASSERT_EQ(inner.receives.size(), 2u);
+    EXPECT_EQ(inner.receives[0], READ_AHEAD);
+    EXPECT_EQ(inner.receives[1],
+              payload.size() - (READ_AHEAD - 2 * sizeof(std::size_t)));
+}
+
+TEST(BufferedTransport, ShortReceivesAreReassembled) {
+    LoopbackTransport inner;
+    inner.max_receive = 3;
+    const auto sent = symbols(10);
+    MessageComposer{}.push(sent).send(inner);
+
+    BufferedTransport buffered{inner, READ_AHEAD};
+    auto received = std::deque<std::string>{};
+    MessageDecoder{buffered}.read<std::deque<std::string>, std::string>(
+        received);
+
+    EXPECT_EQ(received, sent);
+}
+
+TEST(BufferedTransport, HasDataWhileBytesAreBuffered) {
+    LoopbackTransport inner;
+    MessageComposer{}.push(1).push(2).send(inner);
+
+    BufferedTransport buffered{inner, READ_AHEAD};
+    auto first = 0;
+    MessageDecoder{buffered}.read(first);
+
+    EXPECT_FALSE(inner.has_data());
+    EXPECT_TRUE(buffered.has_data());
+    auto second = 0;
+    MessageDecoder{buffered}.read(second);
+    EXPECT_EQ(first + second, 3);
+    EXPECT_FALSE(buffered.has_data());
+}
+
+TEST(BufferedTransport, EndOfStreamStillTimesOut) {
+    LoopbackTransport inner;
+    MessageComposer{}.push(1).send(inner);
+
+    BufferedTransport buffered{inner, READ_AHEAD};
+    auto value = std::size_t{};
+    EXPECT_THROW(MessageDecoder{buffered}.read(value), std::runtime_error);
+}
+
+TEST(BufferedTransport, SendsPassThrough) {
+    LoopbackTransport inner;
+    BufferedTransport buffered{inner, READ_AHEAD};
+    MessageComposer{}.push(std::string{"name"}).send(buffered);
+
+    auto name = std::string{};
+    MessageDecoder{inner}.read(name);
+    EXPECT_EQ(name, "name");
+}
@@ -0,0 +1,78 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "ipc/content_hash.h"
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using oid::content_hash;
+
+namespace {
+
+std::uint64_t hash_of(const std::string_view text,
+                      const std::uint64_t seed = 0) {
+    return content_hash(std::as_bytes(std::span{text.data(), text.size()}),
+                        seed);
+}
+
+} // namespace
+
+// Reference XXH64 digests. Together they cover every tail path (byte, word,
+// quad) and, from 32 bytes on, the striped main loop.
+TEST(ContentHash, MatchesReferenceXxh64) {
+    EXPECT_EQ(hash_of(""), 0xEF46DB3751D8E999ULL);
+    EXPECT_EQ(hash_of("a"), 0xD24EC4F1A98C6E5BULL);
+    EXPECT_EQ(hash_of("abc"), 0x44BC2CF5AD770999ULL);
+    EXPECT_EQ(hash_of("Nobody inspects the spammish repetition"),
+              0xFBCEA83C8A378BF1ULL);
+}
+
+TEST(ContentHash, SeedChangesTheDigest) {
+    EXPECT_NE(hash_of("abc", 1), hash_of("abc"));
+    EXPECT_EQ(hash_of("abc", 1), hash_of("abc", 1));
+}
+
+// Every length across a couple of stripes, with one byte flipped in turn:
+// the flip must always show.
+TEST(ContentHash, EveryByteContributes) {
+    std::vector<std::byte> bytes(100);
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<std::byte>(i * 7);
+    }
+    for (std::size_t size = 1; size <= bytes.size(); ++size) {
+        const std::span<const std::byte> view{bytes.data(), size};
+        const auto base = content_hash(view);
+        for (std::size_t i = 0; i < size; ++i) {
+            bytes[i] ^= std::byte{0x40};
+            EXPECT_NE(content_hash(view), base) << size << " " << i;
+            bytes[i] ^= std::byte{0x40};
+        }
+    }
+}
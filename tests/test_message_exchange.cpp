@@ -54,6 +54,28 @@ struct RecordingTransport final : ITransport {
     }
 };
 
+// Records the gather list as handed over, without flattening it, so a test
+// can tell which parts were referenced in place and which were staged.
+struct GatherRecordingTransport final : ITransport {
+    std::vector<std::span<const std::byte>> parts;
+    std::vector<std::byte> flattened;
+    void send(std::span<const std::byte> data) override {
+        parts.push_back(data);
+        flattened.insert(flattened.end(), data.begin(), data.end());
+    }
+    void send_gather(std::span<const std::span<const std::byte>> ps) override {
+        for (const auto part : ps) {
+            send(part);
+        }
+    }
+    std::size_t receive(std::span<std::byte>) override {
+        return 0;
+    }
+    bool has_data() const override {
+        return false;
+    }
+};
+
 namespace {
 constexpr int TEST_VALUE_42 = 42;
 constexpr int TEST_VALUE_100 = 100;
@@ -303,6 +325,43 @@ TEST_F(MessageExchangeTest, MessageDecoderReadVector) {
     EXPECT_EQ(std::memcmp(result.data(), test_vector.data(), result.size()), 0);
 }
 
+// The two-step read a caller uses to place a payload itself: the length
+// first, then exactly that many bytes into storage it already holds.
+TEST_F(MessageExchangeTest, MessageDecoderReadsPayloadIntoCallerStorage) {
+    ConnectSockets();
+
+    const std::vector test_vector(TEST_BUFFER_VALUES,
+                                  TEST_BUFFER_VALUES + TEST_BUFFER_SIZE);
+    const auto size = test_vector.size();
+
+    std::array<char, sizeof(std::size_t)> buffer;
+    std::memcpy(buffer.data(), &size, sizeof(std::size_t));
+    client_transport_->send(as_bytes_span(buffer));
+    client_transport_->send(as_bytes_span(test_vector));
+
+    MessageDecoder decoder(*server_transport_);
+    const auto length = decoder.read_length();
+    ASSERT_EQ(length, size);
+    std::vector<std::byte> result(length + 2, std::byte{0xee});
+    decoder.read_payload(std::span{result}.subspan(1, length));
+
+    EXPECT_EQ(result.front(), std::byte{0xee});
+    EXPECT_EQ(result.back(), std::byte{0xee});
+    EXPECT_EQ(std::memcmp(result.data() + 1, test_vector.data(), length), 0);
+}
+
+TEST_F(MessageExchangeTest, MessageDecoderRejectsOversizedPayloadLength) {
+    ConnectSockets();
+
+    const auto absurd = static_cast<std::size_t>(MAX_BUFFER_BYTES) + 1;
+    std::array<char, sizeof(std::size_t)> buffer{};
+    std::memcpy(buffer.data(), &absurd, sizeof(std::size_t));
+    client_transport_->send(as_bytes_span(buffer));
+
+    MessageDecoder decoder(*server_transport_);
+    EXPECT_THROW(static_cast<void>(decoder.read_length()), MessageDecodeError);
+}
+
 // A peer-supplied length drives the resize, so an impossible one must be
 // refused rather than handed to the allocator: a bad_alloc there would leave
 // the payload unread and every later message decoding from the wrong offset.
@@ -417,3 +476,79 @@ TEST_F(MessageExchangeTest, RoundTripComplexMessage) {
     EXPECT_EQ(flag, test_bool_value);
     EXPECT_EQ(name, test_buffer_name);
 }
+
+// The pixel payload must reach the transport as the caller's own storage, not
+// as a copy: that is what keeps a multi-GB plot from doubling the debugger's
+// peak memory. The small header blocks around it are packed together.
+TEST_F(MessageExchangeTest, SendReferencesLargePayloadInPlace) {
+    const std::vector payload(GATHER_MIN_BYTES * 2, std::byte{0x5a});
+    GatherRecordingTransport transport;
+    MessageComposer composer;
+    composer.push(MessageType::PLOT_BUFFER_CONTENTS)
+        .push(std::string(TEST_STRING_BUFFER))
+        .push(TEST_VALUE_42)
+        .push(std::span<const std::byte>{payload})
+        .push(TEST_VALUE_100);
+    composer.send(transport);
+
+    // [type | name length | name | int | payload length], payload, [int]
+    ASSERT_EQ(transport.parts.size(), 3u);
+    EXPECT_EQ(transport.parts[0].size(),
+              sizeof(MessageType) + sizeof(std::size_t) +
+                  std::string_view{TEST_STRING_BUFFER}.size() + sizeof(int) +
+                  sizeof(std::size_t));
+    EXPECT_EQ(transport.parts[1].data(), payload.data());
+    EXPECT_EQ(transport.parts[1].size(), payload.size());
+    EXPECT_EQ(transport.parts[2].size(), sizeof(int));
+}
+
+// The gathered wire bytes must be exactly what the flattening default would
+// have produced, or the receiving decoder would lose framing.
+TEST_F(MessageExchangeTest, GatheredSendMatchesFlattenedSend) {
+    std::vector<std::byte> payload(GATHER_MIN_BYTES + 3);
+    for (std::size_t i = 0; i < payload.size(); ++i) {
+        payload[i] = static_cast<std::byte>(i * 31U);
+    }
+    MessageComposer composer;
+    composer.push(MessageType::PLOT_BUFFER_CONTENTS)
+        .push(std::string(TEST_STRING_BUFFER))
+        .push(std::span<const std::byte>{payload})
+        .push(true);
+
+    RecordingTransport flattened;
+    composer.send(flattened);
+    GatherRecordingTransport gathered;
+    composer.send(gathered);
+
+    ASSERT_EQ(flattened.sends.size(), 1u);
+    EXPECT_EQ(gathered.flattened, flattened.sends[0]);
+}
+
+TEST_F(MessageExchangeTest, RoundTripLargeBufferOverGatheredWrite) {
+    ConnectSockets();
+
+    std::vector<std::byte> payload(4 * GATHER_MIN_BYTES + 17);
+    for (std::size_t i = 0; i < payload.size(); ++i) {
+        payload[i] = static_cast<std::byte>(i ^ (i >> 8U));
+    }
+    // The socket buffer cannot hold the whole message, so the write has to
+    // run concurrently with the read that drains it.
+    std::jthread writer([this, &payload] {
+        MessageComposer composer;
+        composer.push(MessageType::PLOT_BUFFER_CONTENTS)
+            .push(std::span<const std::byte>{payload})
+            .push(TEST_VALUE_12345);
+        composer.send(*client_transport_);
+    });
+
+    MessageDecoder decoder(*server_transport_);
+    MessageType type{};
+    std::vector<std::byte> received;
+    int trailer = 0;
+    decoder.read(type).read(received).read(trailer);
+    writer.join();
+
+    EXPECT_EQ(type, MessageType::PLOT_BUFFER_CONTENTS);
+    EXPECT_EQ(received, payload);
+    EXPECT_EQ(trailer, TEST_VALUE_12345);
+}
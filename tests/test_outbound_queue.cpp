@@ -0,0 +1,158 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "ipc/outbound_queue.h"
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using oid::OutboundQueue;
+
+namespace {
+
+constexpr auto NO_WAIT = std::chrono::milliseconds{0};
+
+// A message that records `label` in `sent` when the writer sends it.
+OutboundQueue::Send record(std::vector<std::string>& sent,
+                           const std::string& label) {
+    return [&sent, label] { sent.push_back(label); };
+}
+
+} // namespace
+
+TEST(OutboundQueue, SendsInOrderAndReleasesTheBudget) {
+    OutboundQueue queue{100};
+    std::vector<std::string> sent;
+    ASSERT_TRUE(queue.push(record(sent, "a"), 10));
+    ASSERT_TRUE(queue.push(record(sent, "b"), 20));
+    EXPECT_EQ(queue.byte_size(), 30u);
+
+    EXPECT_TRUE(queue.run_next(NO_WAIT));
+    EXPECT_TRUE(queue.run_next(NO_WAIT));
+    EXPECT_FALSE(queue.run_next(NO_WAIT));
+    EXPECT_EQ(sent, (std::vector<std::string>{"a", "b"}));
+    EXPECT_EQ(queue.byte_size(), 0u);
+}
+
+// Only the newest version of a keyed message is sent, where the first one
+// was queued.
+TEST(OutboundQueue, SameKeyKeepsOnlyTheLatestInPlace) {
+    OutboundQueue queue{100};
+    std::vector<std::string> sent;
+    queue.push(record(sent, "img v1"), 40, "img");
+    queue.push(record(sent, "other"), 10);
+    queue.push(record(sent, "img v2"), 30, "img");
+    EXPECT_EQ(queue.byte_size(), 40u);
+
+    while (queue.run_next(NO_WAIT)) {
+    }
+    EXPECT_EQ(sent, (std::vector<std::string>{"img v2", "other"}));
+}
+
+TEST(OutboundQueue, OverBudgetWaitsForTheWriter) {
+    OutboundQueue queue{100};
+    std::vector<std::string> sent;
+    ASSERT_TRUE(queue.push(record(sent, "a"), 80));
+    EXPECT_FALSE(queue.try_push(record(sent, "b"), 30));
+    // Replacing a keyed message only weighs the difference.
+    EXPECT_TRUE(queue.try_push(record(sent, "c"), 10, "c"));
+    EXPECT_TRUE(queue.try_push(record(sent, "c2"), 20, "c"));
+
+    std::atomic<bool> pushed{false};
+    std::thread producer{[&] {
+        pushed = queue.push(record(sent, "b"), 30);
+    }};
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    EXPECT_FALSE(pushed);
+
+    EXPECT_TRUE(queue.run_next(NO_WAIT));
+    producer.join();
+    EXPECT_TRUE(pushed);
+    while (queue.run_next(NO_WAIT)) {
+    }
+    EXPECT_EQ(sent, (std::vector<std::string>{"a", "c2", "b"}));
+}
+
+// A message larger than the whole budget goes once it has the queue to
+// itself, rather than never.
+TEST(OutboundQueue, OversizedMessageGoesAlone) {
+    OutboundQueue queue{100};
+    std::vector<std::string> sent;
+    EXPECT_TRUE(queue.try_push(record(sent, "huge"), 500));
+    EXPECT_FALSE(queue.try_push(record(sent, "small"), 1));
+    EXPECT_TRUE(queue.run_next(NO_WAIT));
+    EXPECT_TRUE(queue.try_push(record(sent, "small"), 1));
+}
+
+TEST(OutboundQueue, CloseDropsWaitingMessagesAndWakesProducers) {
+    OutboundQueue queue{100};
+    std::vector<std::string> sent;
+    queue.push(record(sent, "a"), 100);
+
+    std::atomic<bool> pushed{true};
+    std::thread producer{[&] {
+        pushed = queue.push(record(sent, "b"), 10);
+    }};
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    queue.close();
+    producer.join();
+
+    EXPECT_FALSE(pushed);
+    EXPECT_FALSE(queue.run_next(NO_WAIT));
+    EXPECT_TRUE(sent.empty());
+    EXPECT_EQ(queue.byte_size(), 0u);
+}
+
+TEST(OutboundQueue, TellsTheWriterAboutNewWork) {
+    std::atomic<int> woken{0};
+    OutboundQueue queue{100, [&woken] { ++woken; }};
+    std::vector<std::string> sent;
+    ASSERT_TRUE(queue.push(record(sent, "a"), 10));
+    ASSERT_TRUE(queue.try_push(record(sent, "b"), 10));
+    EXPECT_EQ(woken, 2);
+    EXPECT_FALSE(queue.try_push(record(sent, "c"), 100));
+    EXPECT_EQ(woken, 2);
+
+    queue.close();
+    EXPECT_EQ(woken, 3);
+}
+
+TEST(OutboundQueue, CloseWakesAWaitingWriter) {
+    OutboundQueue queue{100};
+    std::thread closer{[&queue] {
+        std::this_thread::sleep_for(std::chrono::milliseconds{20});
+        queue.close();
+    }};
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(queue.run_next(std::chrono::seconds{10}));
+    EXPECT_LT(std::chrono::steady_clock::now() - start,
+              std::chrono::seconds{5});
+    closer.join();
+}
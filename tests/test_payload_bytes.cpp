@@ -0,0 +1,148 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "ipc/payload_bytes.h"
+
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using oid::PayloadBytes;
+
+TEST(PayloadBytes, UninitializedHasTheRequestedSize) {
+    const auto bytes = PayloadBytes::uninitialized(1000);
+    EXPECT_EQ(bytes.size(), 1000u);
+    EXPECT_FALSE(bytes.empty());
+    EXPECT_TRUE(PayloadBytes::uninitialized(0).empty());
+    EXPECT_EQ(PayloadBytes{}.data(), nullptr);
+}
+
+TEST(PayloadBytes, BlocksAreAligned) {
+    for (const std::size_t size : {1u, 100u, 4096u, 3u * 1024u * 1024u}) {
+        const auto bytes = PayloadBytes::uninitialized(size);
+        EXPECT_EQ(std::bit_cast<std::uintptr_t>(bytes.data()) %
+                      oid::PAYLOAD_ALIGNMENT,
+                  0u)
+            << size;
+    }
+}
+
+TEST(PayloadBytes, CopiesCompareEqual) {
+    const std::vector<std::byte> pixels{
+        std::byte{1}, std::byte{2}, std::byte{3}};
+    const PayloadBytes bytes{pixels};
+    EXPECT_EQ(bytes, pixels);
+
+    const PayloadBytes copy = bytes;
+    EXPECT_NE(copy.data(), bytes.data());
+    EXPECT_EQ(copy, std::span<const std::byte>{bytes});
+
+    PayloadBytes moved = PayloadBytes::uninitialized(8);
+    moved = PayloadBytes{copy};
+    EXPECT_EQ(moved, pixels);
+}
+
+// What a re-plot of the same geometry relies on: the block the previous
+// version freed comes back instead of a fresh one.
+TEST(PayloadBytes, SameSizeClassReusesTheFreedBlock) {
+    constexpr std::size_t size = 5u * 1024u * 1024u;
+    const std::byte* freed = nullptr;
+    {
+        const auto bytes = PayloadBytes::uninitialized(size);
+        freed = bytes.data();
+    }
+    const auto again = PayloadBytes::uninitialized(size - 100);
+    EXPECT_EQ(again.data(), freed);
+
+    const auto other_class = PayloadBytes::uninitialized(size * 2);
+    EXPECT_NE(other_class.data(), freed);
+}
+
+TEST(PayloadBytes, ShrinkKeepsTheFrontOfTheBlock) {
+    constexpr std::size_t size = 9u * 1024u * 1024u;
+    auto bytes = PayloadBytes::uninitialized(size);
+    bytes[0] = std::byte{42};
+    const auto* const data = bytes.data();
+
+    bytes.shrink(size / 2);
+    EXPECT_EQ(bytes.size(), size / 2);
+    EXPECT_EQ(bytes.data(), data);
+    EXPECT_EQ(bytes[0], std::byte{42});
+
+    bytes.shrink(size);
+    EXPECT_EQ(bytes.size(), size / 2);
+}
+
+// Only the most recently freed block of a class is kept: freeing a second
+// one of it gives the first back to the system.
+TEST(PayloadBytes, PoolKeepsOneBlockPerSizeClass) {
+    constexpr std::size_t size = 7u * 1024u * 1024u;
+    oid::trim_payload_pool();
+    const std::byte* last_freed = nullptr;
+    {
+        auto first_freed = PayloadBytes::uninitialized(size);
+        const auto second = PayloadBytes::uninitialized(size);
+        last_freed = second.data();
+        first_freed = PayloadBytes{};
+    }
+    const auto again = PayloadBytes::uninitialized(size);
+    EXPECT_EQ(again.data(), last_freed);
+    const auto fresh = PayloadBytes::uninitialized(size);
+    EXPECT_NE(fresh.data(), last_freed);
+}
+
+// An unpooled block is not given back to the pool: it does not displace the
+// block of its class the pool already holds.
+TEST(PayloadBytes, UnpooledBlocksBypassThePool) {
+    constexpr std::size_t size = 11u * 1024u * 1024u;
+    oid::trim_payload_pool();
+    const std::byte* pooled = nullptr;
+    {
+        const auto bytes = PayloadBytes::uninitialized(size);
+        pooled = bytes.data();
+    }
+    {
+        auto bytes = PayloadBytes::unpooled(size);
+        EXPECT_EQ(bytes.size(), size);
+        EXPECT_NE(bytes.data(), pooled);
+        bytes[size - 1] = std::byte{7};
+    }
+    EXPECT_EQ(PayloadBytes::uninitialized(size).data(), pooled);
+}
+
+TEST(PayloadBytes, SmallSizeClassesWasteAtMostAQuarter) {
+    // 4097 bytes used to take an 8 KiB block; a class of its own now.
+    oid::trim_payload_pool();
+    const std::byte* freed = nullptr;
+    {
+        const auto bytes = PayloadBytes::uninitialized(4097);
+        freed = bytes.data();
+    }
+    const auto larger = PayloadBytes::uninitialized(6000);
+    EXPECT_NE(larger.data(), freed);
+}
@@ -0,0 +1,773 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "ipc/buffer_assembler.h"
+#include "ipc/message_exchange.h"
+#include "ipc/plot_buffer_sender.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace oid;
+
+namespace {
+
+// In-memory pipe: whatever is sent is handed back out by receive().
+struct LoopbackTransport final : ITransport {
+    std::vector<std::byte> bytes;
+    std::size_t pos = 0;
+
+    void send(std::span<const std::byte> data) override {
+        bytes.insert(bytes.end(), data.begin(), data.end());
+    }
+    std::size_t receive(std::span<std::byte> dst) override {
+        const auto n = (std::min)(dst.size(), bytes.size() - pos);
+        std::memcpy(dst.data(), bytes.data() + pos, n);
+        pos += n;
+        return n;
+    }
+    bool has_data() const override {
+        return pos < bytes.size();
+    }
+};
+
+// A data lane whose peer is gone.
+struct DeadTransport final : ITransport {
+    [[noreturn]] void send(std::span<const std::byte> /*data*/) override {
+        throw std::runtime_error("lane is dead");
+    }
+    std::size_t receive(std::span<std::byte> /*dst*/) override {
+        return 0;
+    }
+    bool has_data() const override {
+        return false;
+    }
+};
+
+// What the viewer made of the stream: the reassembled (or single-message)
+// buffer and how many messages of each kind carried it.
+struct Received {
+    std::optional<AssembledBuffer> buffer;
+    std::optional<AssembledPatch> patch;
+    std::optional<AssembledBuffer> preview;
+    int contents_messages = 0;
+    int chunk_messages = 0;
+    int compressed_messages = 0;
+    // From PLOT_BUFFER_LANES, and each lane's PLOT_BUFFER_LANE_FENCE.
+    std::optional<std::uint64_t> lane_fence;
+    std::size_t lane_count = 0;
+    std::vector<std::optional<std::uint64_t>> lane_fences;
+    // Strips each lane carried.
+    std::vector<int> lane_strips;
+};
+
+// Decodes one data lane's share of a transfer into `assembler`.
+void drain_lane(LoopbackTransport& lane,
+                BufferAssembler& assembler,
+                Received& received) {
+    auto& fence = received.lane_fences.emplace_back();
+    auto& strips = received.lane_strips.emplace_back();
+    while (lane.has_data()) {
+        MessageDecoder decoder{lane};
+        auto type = MessageType{};
+        decoder.read(type);
+        if (type == MessageType::PLOT_BUFFER_LANE_FENCE) {
+            decoder.read(fence.emplace());
+            continue;
+        }
+        std::string name;
+        std::size_t row_offset{};
+        std::size_t row_count{};
+        std::vector<std::byte> bytes;
+        decoder.read(name).read(row_offset).read(row_count).read(bytes);
+        if (type == MessageType::PLOT_BUFFER_CHUNK_COMPRESSED) {
+            EXPECT_TRUE(
+                assembler.compressed_chunk(name, row_offset, row_count, bytes));
+            ++received.compressed_messages;
+        } else {
+            ASSERT_EQ(type, MessageType::PLOT_BUFFER_CHUNK);
+            EXPECT_TRUE(assembler.chunk(name, row_offset, row_count, bytes));
+            ++received.chunk_messages;
+        }
+        ++strips;
+    }
+}
+
+// Decodes the stream the way IpcClient does, feeding chunked transfers
+// through a BufferAssembler, and reading `lanes` once they are announced.
+Received drain(LoopbackTransport& transport,
+               const std::span<LoopbackTransport> lanes = {}) {
+    Received received;
+    BufferAssembler assembler;
+    while (transport.has_data()) {
+        MessageDecoder decoder{transport};
+        auto type = MessageType{};
+        decoder.read(type);
+        switch (type) {
+        case MessageType::PLOT_BUFFER_CONTENTS: {
+            AssembledBuffer buffer;
+            auto wire_type = BufferType{};
+            decoder.read(buffer.variable_name)
+                .read(buffer.display_name)
+                .read(buffer.pixel_layout)
+                .read(buffer.transpose)
+                .read(buffer.width)
+                .read(buffer.height)
+                .read(buffer.channels)
+                .read(buffer.stride)
+                .read(wire_type)
+                .read(buffer.bytes);
+            buffer.type = static_cast<int>(wire_type);
+            received.buffer = std::move(buffer);
+            ++received.contents_messages;
+            break;
+        }
+        case MessageType::PLOT_BUFFER_BEGIN: {
+            BufferAssembler::BeginParams params;
+            decoder.read(params.variable_name)
+                .read(params.display_name)
+                .read(params.pixel_layout)
+                .read(params.transpose)
+                .read(params.width)
+                .read(params.height)
+                .read(params.channels)
+                .read(params.stride)
+                .read(params.type)
+                .read(params.total_byte_size);
+            EXPECT_TRUE(assembler.begin(std::move(params)));
+            break;
+        }
+        case MessageType::PLOT_BUFFER_PATCH_BEGIN: {
+            BufferAssembler::PatchParams params;
+            decoder.read(params.variable_name)
+                .read(params.width)
+                .read(params.height)
+                .read(params.channels)
+                .read(params.stride)
+                .read(params.type)
+                .read(params.total_byte_size);
+            EXPECT_TRUE(assembler.begin_patch(std::move(params)));
+            break;
+        }
+        case MessageType::PLOT_BUFFER_CHUNK: {
+            std::string name;
+            std::size_t row_offset{};
+            std::size_t row_count{};
+            std::vector<std::byte> bytes;
+            decoder.read(name).read(row_offset).read(row_count).read(bytes);
+            EXPECT_TRUE(assembler.chunk(name, row_offset, row_count, bytes));
+            ++received.chunk_messages;
+            break;
+        }
+        case MessageType::PLOT_BUFFER_CHUNK_COMPRESSED: {
+            std::string name;
+            std::size_t row_offset{};
+            std::size_t row_count{};
+            std::vector<std::byte> block;
+            decoder.read(name).read(row_offset).read(row_count).read(block);
+            EXPECT_TRUE(
+                assembler.compressed_chunk(name, row_offset, row_count, block));
+            ++received.compressed_messages;
+            break;
+        }
+        case MessageType::PLOT_BUFFER_PREVIEW: {
+            std::string name;
+            int factor{};
+            PayloadBytes bytes;
+            decoder.read(name).read(factor).read(bytes);
+            received.preview =
+                assembler.preview(name, factor, std::move(bytes));
+            EXPECT_TRUE(received.preview.has_value());
+            break;
+        }
+        case MessageType::PLOT_BUFFER_LANES: {
+            std::string name;
+            decoder.read(name).read(received.lane_fence.emplace());
+            decoder.read(received.lane_count);
+            for (auto& lane : lanes) {
+                drain_lane(lane, assembler, received);
+            }
+            break;
+        }
+        case MessageType::PLOT_BUFFER_END: {
+            std::string name;
+            decoder.read(name);
+            if (assembler.has_patch_in_progress(name)) {
+                received.patch = assembler.end_patch(name);
+            } else {
+                received.buffer = assembler.end(name);
+            }
+            break;
+        }
+        default:
+            ADD_FAILURE() << "unexpected message type "
+                          << static_cast<int>(type);
+            return received;
+        }
+    }
+    return received;
+}
+
+std::vector<std::byte> iota_bytes(const std::size_t n) {
+    std::vector<std::byte> v(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        v[i] = static_cast<std::byte>(i & 0xff);
+    }
+    return v;
+}
+
+// 3x7 rgba8 with one pixel of stride padding: 16 bytes per row, 112 total.
+PlotBufferHeader make_header() {
+    return PlotBufferHeader{.variable_name = "img",
+                            .display_name = "disp",
+                            .pixel_layout = "rgba",
+                            .transpose = false,
+                            .width = 3,
+                            .height = 7,
+                            .channels = 4,
+                            .stride = 4,
+                            .type = BufferType::UNSIGNED_BYTE};
+}
+
+// Serves reads out of `pixels`, the way the bridge serves them out of the
+// debuggee, counting them.
+PixelReader reader_over(const std::vector<std::byte>& pixels, int& reads) {
+    return [&pixels, &reads](const std::size_t offset,
+                             const std::span<std::byte> out) {
+        if (offset + out.size() > pixels.size()) {
+            return false;
+        }
+        ++reads;
+        std::memcpy(out.data(), pixels.data() + offset, out.size());
+        return true;
+    };
+}
+
+// 256x256 rgba8: 1 KiB rows, so DELTA_STRIP_BYTES makes four strips of 64
+// rows each.
+PlotBufferHeader make_large_header() {
+    return PlotBufferHeader{.variable_name = "big",
+                            .display_name = "big",
+                            .pixel_layout = "rgba",
+                            .transpose = false,
+                            .width = 256,
+                            .height = 256,
+                            .channels = 4,
+                            .stride = 256,
+                            .type = BufferType::UNSIGNED_BYTE};
+}
+
+} // namespace
+
+TEST(PlotBufferSender, StreamsWholeRowStripsThatReassemble) {
+    LoopbackTransport transport;
+    const auto pixels = iota_bytes(112);
+    // 40 bytes fit two 16-byte rows: strips of rows 0-1, 2-3, 4-5 and 6.
+    send_plot_buffer(transport, make_header(), pixels, 40);
+
+    const auto received = drain(transport);
+    EXPECT_EQ(received.contents_messages, 0);
+    EXPECT_EQ(received.chunk_messages, 4);
+    ASSERT_TRUE(received.buffer.has_value());
+    EXPECT_EQ(received.buffer->variable_name, "img");
+    EXPECT_EQ(received.buffer->display_name, "disp");
+    EXPECT_EQ(received.buffer->width, 3);
+    EXPECT_EQ(received.buffer->height, 7);
+    EXPECT_EQ(received.buffer->stride, 4);
+    EXPECT_EQ(received.buffer->bytes, pixels);
+}
+
+TEST(PlotBufferSender, StripNarrowerThanARowStillSendsOneRow) {
+    LoopbackTransport transport;
+    const auto pixels = iota_bytes(112);
+    send_plot_buffer(transport, make_header(), pixels, 1);
+
+    const auto received = drain(transport);
+    EXPECT_EQ(received.chunk_messages, 7);
+    ASSERT_TRUE(received.buffer.has_value());
+    EXPECT_EQ(received.buffer->bytes, pixels);
+}
+
+TEST(PlotBufferSender, BufferWithinOneStripIsSentWhole) {
+    LoopbackTransport transport;
+    const auto pixels = iota_bytes(112);
+    send_plot_buffer(transport, make_header(), pixels, 112);
+
+    const auto received = drain(transport);
+    EXPECT_EQ(received.contents_messages, 1);
+    EXPECT_EQ(received.chunk_messages, 0);
+    ASSERT_TRUE(received.buffer.has_value());
+    EXPECT_EQ(received.buffer->bytes, pixels);
+}
+
+TEST(PlotBufferSender, ZeroChunkBytesDisablesStreaming) {
+    LoopbackTransport transport;
+    const auto pixels = iota_bytes(112);
+    send_plot_buffer(transport, make_header(), pixels, 0);
+
+    const auto received = drain(transport);
+    EXPECT_EQ(received.contents_messages, 1);
+    EXPECT_EQ(received.chunk_messages, 0);
+}
+
+TEST(PlotBufferSender, TrimmedFinalRowFallsBackToSingleMessage) {
+    // The last row lacks its 4 bytes of stride padding, which the row-strip
+    // path cannot represent.
+    LoopbackTransport transport;
+    const auto pixels = iota_bytes(108);
+    send_plot_buffer(transport, make_header(), pixels, 16);
+
+    const auto received = drain(transport);
+    EXPECT_EQ(received.contents_messages, 1);
+    EXPECT_EQ(received.chunk_messages, 0);
+    ASSERT_TRUE(received.buffer.has_value());
+    EXPECT_EQ(received.buffer->bytes, pixels);
+}
+
+TEST(PlotBufferSender, CompressibleStripsAreSentCompressed) {
+    LoopbackTransport transport;
+    const auto header = make_large_header();
+    const auto pixels = std::vector<std::byte>(256 * 1024, std::byte{3});
+    send_plot_buffer(transport, header, pixels, 64 * 1024, true);
+
+    // Well below the 256 KiB of pixels, even with four strips' framing.
+    EXPECT_LT(transport.bytes.size(), 4096U);
+    const auto received = drain(transport);
+    EXPECT_EQ(received.compressed_messages, 4);
+    EXPECT_EQ(received.chunk_messages, 0);
+    ASSERT_TRUE(received.buffer.has_value());
+    EXPECT_EQ(received.buffer->bytes, pixels);
+}
+
+TEST(PlotBufferSender, CompressingStreamsEvenASingleStrip) {
+    LoopbackTransport transport;
+    const auto pixels = std::vector<std::byte>(112, std::byte{0});
+    send_plot_buffer(transport, make_header(), pixels, 112, true);
+
+    const auto received = drain(transport);
+    EXPECT_EQ(received.contents_messages, 0);
+    EXPECT_EQ(received.compressed_messages, 1);
+    ASSERT_TRUE(received.buffer.has_value());
+    EXPECT_EQ(received.buffer->bytes, pixels);
+}
+
+TEST(PlotBufferSender, StripsThatDoNotShrinkAreSentRaw) {
+    LoopbackTransport transport;
+    // Too short to hold a match: compressing only adds framing.
+    const auto pixels = iota_bytes(112);
+    send_plot_buffer(transport, make_header(), pixels, 16, true);
+
+    const auto received = drain(transport);
+    EXPECT_EQ(received.compressed_messages, 0);
+    EXPECT_EQ(received.chunk_messages, 7);
+    ASSERT_TRUE(received.buffer.has_value());
+    EXPECT_EQ(received.buffer->bytes, pixels);
+}
+
+TEST(PlotBufferSender, PreviewComesFirstAndTheStripsStayExact) {
+    LoopbackTransport transport;
+    const auto pixels = iota_bytes(112);
+    send_plot_buffer(transport, make_header(), pixels, 32, false, 2);
+
+    const auto received = drain(transport);
+    ASSERT_TRUE(received.preview.has_value());
+    EXPECT_EQ(received.preview->width, 2);
+    EXPECT_EQ(received.preview->height, 4);
+    EXPECT_EQ(received.preview->decimation, 2);
+    EXPECT_EQ(received.preview->source_width, 3);
+    EXPECT_EQ(received.preview->source_height, 7);
+    // Pixel 0 of preview row 1 is pixel 0 of row 2.
+    EXPECT_TRUE(std::equal(received.preview->bytes.begin() + 8,
+                           received.preview->bytes.begin() + 12,
+                           pixels.begin() + 32));
+    EXPECT_EQ(received.chunk_messages, 4);
+    ASSERT_TRUE(received.buffer.has_value());
+    EXPECT_EQ(received.buffer->bytes, pixels);
+}
+
+TEST(PlotBufferSender, NoPreviewUnlessAsked) {
+    LoopbackTransport transport;
+    send_plot_buffer(transport, make_header(), iota_bytes(112), 32);
+    EXPECT_FALSE(drain(transport).preview.has_value());
+}
+
+TEST(PlotBufferSender, StripesStripsRoundRobinOverTheDataLanes) {
+    LoopbackTransport transport;
+    std::vector<LoopbackTransport> lanes(3);
+    std::vector<ITransport*> lane_views{&lanes[0], &lanes[1], &lanes[2]};
+    const auto pixels = iota_bytes(112);
+    send_plot_buffer(transport,
+                     make_header(),
+                     pixels,
+                     16,
+                     false,
+                     0,
+                     {.lanes = lane_views, .fence = 5});
+
+    const auto received = drain(transport, lanes);
+    ASSERT_EQ(received.lane_fence, 5U);
+    EXPECT_EQ(received.lane_count, 3U);
+    // Seven one-row strips: rows 0, 3 and 6 on the first lane, and so on.
+    EXPECT_EQ(received.lane_strips, (std::vector<int>{3, 2, 2}));
+    for (const auto& fence : received.lane_fences) {
+        EXPECT_EQ(fence, 5U);
+    }
+    ASSERT_TRUE(received.buffer.has_value());
+    EXPECT_EQ(received.buffer->bytes, pixels);
+}
+
+TEST(PlotBufferSender, DataLanesCompressTheirOwnStrips) {
+    LoopbackTransport transport;
+    std::vector<LoopbackTransport> lanes(2);
+    std::vector<ITransport*> lane_views{&lanes[0], &lanes[1]};
+    const auto header = make_large_header();
+    const auto pixels = std::vector<std::byte>(256 * 1024, std::byte{3});
+    send_plot_buffer(transport,
+                     header,
+                     pixels,
+                     64 * 1024,
+                     true,
+                     0,
+                     {.lanes = lane_views, .fence = 1});
+
+    const auto received = drain(transport, lanes);
+    EXPECT_EQ(received.compressed_messages, 4);
+    EXPECT_EQ(received.lane_strips, (std::vector<int>{2, 2}));
+    ASSERT_TRUE(received.buffer.has_value());
+    EXPECT_EQ(received.buffer->bytes, pixels);
+}
+
+TEST(PlotBufferSender, ASingleMessageNeverUsesTheDataLanes) {
+    LoopbackTransport transport;
+    LoopbackTransport lane;
+    std::vector<ITransport*> lane_views{&lane};
+    send_plot_buffer(transport,
+                     make_header(),
+                     iota_bytes(112),
+                     0,
+                     false,
+                     0,
+                     {.lanes = lane_views, .fence = 1});
+
+    EXPECT_TRUE(lane.bytes.empty());
+    EXPECT_EQ(drain(transport).contents_messages, 1);
+}
+
+// The other lanes still finish their share; END is never sent.
+TEST(PlotBufferSender, ADeadDataLaneFailsTheTransferOnceTheOthersAreDone) {
+    LoopbackTransport transport;
+    LoopbackTransport live;
+    DeadTransport dead;
+    std::vector<ITransport*> lane_views{&live, &dead};
+    EXPECT_THROW(send_plot_buffer(transport,
+                                  make_header(),
+                                  iota_bytes(112),
+                                  16,
+                                  false,
+                                  0,
+                                  {.lanes = lane_views, .fence = 1}),
+                 std::runtime_error);
+
+    const auto received = drain(transport, std::span{&live, 1});
+    EXPECT_EQ(received.lane_strips, (std::vector<int>{4}));
+    EXPECT_EQ(received.lane_fences.front(), 1U);
+    EXPECT_FALSE(received.buffer.has_value());
+}
+
+TEST(PlotBufferSender, FingerprintIsStableForTheSamePlot) {
+    const auto pixels = iota_bytes(112);
+    const auto before = fingerprint_plot_buffer(make_header(), pixels);
+    const auto now = fingerprint_plot_buffer(make_header(), iota_bytes(112));
+    EXPECT_EQ(before, now);
+    const auto changed = changed_strips(before, now);
+    ASSERT_TRUE(changed.has_value());
+    EXPECT_TRUE(changed->empty());
+}
+
+TEST(PlotBufferSender, FingerprintFindsTheStripsThatChanged) {
+    const auto pixels = iota_bytes(256 * 1024);
+    const auto before = fingerprint_plot_buffer(make_large_header(), pixels);
+    ASSERT_EQ(before.rows_per_strip, 64U);
+    ASSERT_EQ(before.strip_hashes.size(), 4U);
+
+    auto edited = pixels;
+    edited[70 * 1024 + 5] ^= std::byte{1};  // row 70: strip 1
+    edited[255 * 1024 + 9] ^= std::byte{1}; // row 255: strip 3
+    const auto changed = changed_strips(
+        before, fingerprint_plot_buffer(make_large_header(), edited));
+    ASSERT_TRUE(changed.has_value());
+    EXPECT_EQ(*changed, (std::vector<std::size_t>{1, 3}));
+}
+
+// Same bytes under a different shape or type are a different plot, which
+// only a full send can replace.
+TEST(PlotBufferSender, FingerprintsWithDifferentHeadersDoNotCompare) {
+    const auto pixels = iota_bytes(112);
+    const auto base = fingerprint_plot_buffer(make_header(), pixels);
+
+    auto reshaped = make_header();
+    reshaped.width = 4;
+    reshaped.height = 7;
+    reshaped.stride = 4;
+    EXPECT_FALSE(
+        changed_strips(base, fingerprint_plot_buffer(reshaped, pixels)));
+
+    auto retyped = make_header();
+    retyped.type = BufferType::SHORT;
+    EXPECT_FALSE(
+        changed_strips(base, fingerprint_plot_buffer(retyped, pixels)));
+
+    auto relaid = make_header();
+    relaid.pixel_layout = "bgra";
+    EXPECT_FALSE(changed_strips(base, fingerprint_plot_buffer(relaid, pixels)));
+
+    auto transposed = make_header();
+    transposed.transpose = true;
+    EXPECT_FALSE(
+        changed_strips(base, fingerprint_plot_buffer(transposed, pixels)));
+}
+
+// A payload without whole padded rows is hashed whole: it can be found
+// unchanged, but any change means resending all of it.
+TEST(PlotBufferSender, TrimmedPayloadChangesOnlyAsAWhole) {
+    const auto pixels = iota_bytes(108);
+    const auto before = fingerprint_plot_buffer(make_header(), pixels);
+    EXPECT_EQ(before.rows_per_strip, 0U);
+
+    const auto same =
+        changed_strips(before, fingerprint_plot_buffer(make_header(), pixels));
+    ASSERT_TRUE(same.has_value());
+    EXPECT_TRUE(same->empty());
+
+    auto edited = pixels;
+    edited[3] ^= std::byte{1};
+    EXPECT_FALSE(changed_strips(
+        before, fingerprint_plot_buffer(make_header(), edited)));
+}
+
+TEST(PlotBufferSender, PatchCarriesOnlyTheChangedRows) {
+    LoopbackTransport transport;
+    const auto pixels = iota_bytes(256 * 1024);
+    const auto fingerprint =
+        fingerprint_plot_buffer(make_large_header(), pixels);
+    // Strips 1 and 2 are adjacent and go out as one run of rows 64-191,
+    // split at 48 KiB; strip 0 is untouched.
+    const std::vector<std::size_t> strips{1, 2};
+    send_plot_buffer_patch(
+        transport, make_large_header(), pixels, fingerprint, strips, 48 * 1024);
+
+    const auto received = drain(transport);
+    EXPECT_FALSE(received.buffer.has_value());
+    EXPECT_EQ(received.chunk_messages, 3);
+    ASSERT_TRUE(received.patch.has_value());
+    EXPECT_EQ(received.patch->variable_name, "big");
+    EXPECT_EQ(received.patch->width, 256);
+    EXPECT_EQ(received.patch->height, 256);
+    EXPECT_EQ(received.patch->stride, 256);
+    ASSERT_EQ(received.patch->strips.size(), 3U);
+    std::size_t next_row = 64;
+    for (const auto& strip : received.patch->strips) {
+        EXPECT_EQ(strip.row_offset, next_row);
+        const auto from = pixels.begin() +
+                          static_cast<std::ptrdiff_t>(strip.row_offset * 1024);
+        EXPECT_TRUE(std::equal(strip.bytes.begin(), strip.bytes.end(), from));
+        next_row += strip.row_count;
+    }
+    EXPECT_EQ(next_row, 192U);
+}
+
+TEST(PlotBufferSender, UnchangedMessageCarriesOnlyTheName) {
+    LoopbackTransport transport;
+    send_plot_buffer_unchanged(transport, "img");
+
+    MessageDecoder decoder{transport};
+    auto type = MessageType{};
+    std::string name;
+    decoder.read(type).read(name);
+    EXPECT_EQ(type, MessageType::PLOT_BUFFER_UNCHANGED);
+    EXPECT_EQ(name, "img");
+    EXPECT_FALSE(transport.has_data());
+}
+
+TEST(PlotBufferSender, BatchIsFramedByBareMarkers) {
+    LoopbackTransport transport;
+    send_plot_batch_begin(transport);
+    send_plot_buffer_unchanged(transport, "img");
+    send_plot_batch_end(transport);
+
+    MessageDecoder decoder{transport};
+    auto begin = MessageType{};
+    auto unchanged = MessageType{};
+    auto end = MessageType{};
+    std::string name;
+    decoder.read(begin).read(unchanged).read(name).read(end);
+    EXPECT_EQ(begin, MessageType::PLOT_BUFFER_BATCH_BEGIN);
+    EXPECT_EQ(unchanged, MessageType::PLOT_BUFFER_UNCHANGED);
+    EXPECT_EQ(end, MessageType::PLOT_BUFFER_BATCH_END);
+    EXPECT_FALSE(transport.has_data());
+}
+
+TEST(PlotBufferSender, OverviewReadsOnlyTheSampledRows) {
+    LoopbackTransport transport;
+    const auto pixels = iota_bytes(112);
+    int reads = 0;
+    ASSERT_TRUE(send_plot_buffer_overview(
+        transport, make_header(), 2, true, reader_over(pixels, reads)));
+    EXPECT_EQ(reads, 4);
+
+    MessageDecoder decoder{transport};
+    auto type = MessageType{};
+    PlotBufferHeader header;
+    int wire_type{};
+    int factor{};
+    bool quick_look{};
+    std::vector<std::byte> overview;
+    decoder.read(type)
+        .read(header.variable_name)
+        .read(header.display_name)
+        .read(header.pixel_layout)
+        .read(header.transpose)
+        .read(header.width)
+        .read(header.height)
+        .read(header.channels)
+        .read(header.stride)
+        .read(wire_type)
+        .read(factor)
+        .read(quick_look)
+        .read(overview);
+    EXPECT_EQ(type, MessageType::PLOT_BUFFER_OVERVIEW);
+    EXPECT_EQ(header.width, 3);
+    EXPECT_EQ(header.height, 7);
+    EXPECT_EQ(header.stride, 4);
+    EXPECT_EQ(factor, 2);
+    EXPECT_TRUE(quick_look);
+    // Columns 0 and 2 of rows 0, 2, 4 and 6, packed.
+    ASSERT_EQ(overview.size(), 2U * 4U * 4U);
+    EXPECT_TRUE(std::equal(overview.begin() + 8,
+                           overview.begin() + 12,
+                           pixels.begin() + 32));
+    EXPECT_TRUE(std::equal(overview.begin() + 12,
+                           overview.begin() + 16,
+                           pixels.begin() + 40));
+    EXPECT_FALSE(transport.has_data());
+}
+
+TEST(PlotBufferSender, OverviewFromSampledRowsMatchesTheReadOne) {
+    const auto pixels = iota_bytes(112);
+    int reads = 0;
+    LoopbackTransport read_one;
+    ASSERT_TRUE(send_plot_buffer_overview(
+        read_one, make_header(), 2, false, reader_over(pixels, reads)));
+
+    // Rows 0, 2, 4 and 6, three pixels each: no stride padding.
+    std::vector<std::byte> rows;
+    for (std::size_t row = 0; row < 7; row += 2) {
+        rows.insert(rows.end(),
+                    pixels.begin() + row * 16,
+                    pixels.begin() + row * 16 + 12);
+    }
+    LoopbackTransport from_rows;
+    ASSERT_TRUE(send_plot_buffer_overview_rows(
+        from_rows, make_header(), 2, false, rows));
+
+    EXPECT_EQ(from_rows.bytes, read_one.bytes);
+
+    // One row short.
+    LoopbackTransport short_rows;
+    rows.resize(rows.size() - 12);
+    EXPECT_FALSE(send_plot_buffer_overview_rows(
+        short_rows, make_header(), 2, false, rows));
+    EXPECT_FALSE(short_rows.has_data());
+}
+
+TEST(PlotBufferSender, RegionCarriesItsPixelsWithoutStridePadding) {
+    LoopbackTransport transport;
+    const auto pixels = iota_bytes(112);
+    int reads = 0;
+    const auto region = PixelRegion{.row = 2, .col = 1, .rows = 3, .cols = 2};
+    ASSERT_TRUE(send_plot_buffer_region(
+        transport, make_header(), region, reader_over(pixels, reads)));
+    EXPECT_EQ(reads, 3);
+
+    MessageDecoder decoder{transport};
+    auto type = MessageType{};
+    std::string name;
+    PixelRegion received;
+    int channels{};
+    int wire_type{};
+    std::vector<std::byte> bytes;
+    decoder.read(type)
+        .read(name)
+        .read(received.row)
+        .read(received.col)
+        .read(received.rows)
+        .read(received.cols)
+        .read(channels)
+        .read(wire_type)
+        .read(bytes);
+    EXPECT_EQ(type, MessageType::PLOT_BUFFER_REGION);
+    EXPECT_EQ(name, "img");
+    EXPECT_EQ(received, region);
+    EXPECT_EQ(channels, 4);
+    EXPECT_EQ(wire_type, static_cast<int>(BufferType::UNSIGNED_BYTE));
+    ASSERT_EQ(bytes.size(), 3U * 8U);
+    for (std::size_t r = 0; r < 3; ++r) {
+        EXPECT_TRUE(std::equal(bytes.begin() + r * 8,
+                               bytes.begin() + r * 8 + 8,
+                               pixels.begin() + (2 + r) * 16 + 4));
+    }
+}
+
+TEST(PlotBufferSender, RegionOutsideTheBufferOrUnreadableSendsNothing) {
+    LoopbackTransport transport;
+    const auto pixels = iota_bytes(112);
+    int reads = 0;
+    EXPECT_FALSE(send_plot_buffer_region(
+        transport,
+        make_header(),
+        PixelRegion{.row = 6, .col = 0, .rows = 2, .cols = 3},
+        reader_over(pixels, reads)));
+    EXPECT_FALSE(send_plot_buffer_region(
+        transport,
+        make_header(),
+        PixelRegion{.row = 0, .col = 0, .rows = 1, .cols = 1},
+        [](std::size_t, std::span<std::byte>) { return false; }));
+    EXPECT_EQ(reads, 0);
+    EXPECT_FALSE(transport.has_data());
+}
+
+TEST(PlotBufferSender, OverviewFactorFitsTheLongerSide) {
+    EXPECT_EQ(overview_factor(2048, 100), 1);
+    EXPECT_EQ(overview_factor(2049, 100), 2);
+    EXPECT_EQ(overview_factor(100, 100000), 49);
+}
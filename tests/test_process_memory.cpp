@@ -0,0 +1,178 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "system/process/process_memory.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+using namespace oid::system;
+
+namespace {
+
+std::vector<std::byte> make_pattern(const std::size_t size) {
+    std::vector<std::byte> bytes(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        bytes[i] = static_cast<std::byte>(i ^ (i >> 9U));
+    }
+    return bytes;
+}
+
+// A forked child holding make_pattern(size) at address(), until destroyed.
+// Its parent may read it, as a debugger may its debuggee.
+class PatternChild {
+  public:
+    explicit PatternChild(const std::size_t size) {
+        int to_parent[2]{};
+        int to_child[2]{};
+        if (pipe(to_parent) != 0 || pipe(to_child) != 0) {
+            return;
+        }
+        pid_ = fork();
+        if (pid_ == 0) {
+            close(to_parent[0]);
+            close(to_child[1]);
+            const auto pattern = make_pattern(size);
+            const auto where = reinterpret_cast<std::uintptr_t>(pattern.data());
+            if (write(to_parent[1], &where, sizeof(where)) != sizeof(where)) {
+                _exit(1);
+            }
+            // Until the parent closes its end.
+            char done{};
+            while (read(to_child[0], &done, 1) > 0) {
+            }
+            _exit(0);
+        }
+        close(to_parent[1]);
+        close(to_child[0]);
+        release_ = to_child[1];
+        std::uintptr_t where{};
+        if (pid_ > 0 &&
+            read(to_parent[0], &where, sizeof(where)) == sizeof(where)) {
+            address_ = where;
+        }
+        close(to_parent[0]);
+    }
+
+    PatternChild(const PatternChild&) = delete;
+    PatternChild& operator=(const PatternChild&) = delete;
+
+    ~PatternChild() {
+        close(release_);
+        if (pid_ > 0) {
+            waitpid(pid_, nullptr, 0);
+        }
+    }
+
+    [[nodiscard]] long pid() const {
+        return pid_;
+    }
+    [[nodiscard]] std::uint64_t address() const {
+        return address_;
+    }
+
+  private:
+    pid_t pid_{-1};
+    int release_{-1};
+    std::uint64_t address_{};
+};
+
+} // namespace
+
+TEST(ProcessMemory, ReadsAChildsPatternInParallelChunks) {
+    if (!can_read_process_memory()) {
+        GTEST_SKIP() << "no process memory reads on this platform";
+    }
+    // Not a whole number of chunks, so the last one is short.
+    constexpr auto size = PROCESS_READ_CHUNK_BYTES * 2 + 12345;
+    const PatternChild child(size);
+    ASSERT_NE(child.address(), 0U);
+
+    std::vector<std::byte> out(size);
+    ASSERT_TRUE(read_process_memory(child.pid(), child.address(), out, 3));
+    EXPECT_EQ(out, make_pattern(size));
+
+    // A read from the middle, on one thread.
+    std::vector<std::byte> middle(100);
+    ASSERT_TRUE(read_process_memory(child.pid(), child.address() + 1000,
+                                    middle, 1));
+    const auto pattern = make_pattern(size);
+    EXPECT_TRUE(std::equal(middle.begin(), middle.end(),
+                           pattern.begin() + 1000));
+}
+
+TEST(ProcessMemory, UnreadableMemoryFails) {
+    if (!can_read_process_memory()) {
+        GTEST_SKIP() << "no process memory reads on this platform";
+    }
+    const PatternChild child(16);
+    ASSERT_NE(child.address(), 0U);
+
+    std::vector<std::byte> out(16);
+    // Page 0 is never mapped.
+    EXPECT_FALSE(read_process_memory(child.pid(), 0, out));
+    // Nor is there a process -1 to read.
+    EXPECT_FALSE(read_process_memory(-1, child.address(), out));
+}
+
+TEST(ProcessMemory, ReadsEveryNthRowOfAChild) {
+    if (!can_read_process_memory()) {
+        GTEST_SKIP() << "no process memory reads on this platform";
+    }
+    // More rows than one call takes.
+    constexpr std::size_t rows = PROCESS_READ_ROWS_PER_CALL * 2 + 7;
+    constexpr std::size_t row_bytes = 16;
+    constexpr std::size_t row_step = 48;
+    const PatternChild child(rows * row_step);
+    ASSERT_NE(child.address(), 0U);
+
+    std::vector<std::byte> out(rows * row_bytes);
+    ASSERT_TRUE(read_process_rows(
+        child.pid(), child.address(), row_step, row_bytes, out));
+    const auto pattern = make_pattern(rows * row_step);
+    for (std::size_t row = 0; row < rows; ++row) {
+        ASSERT_TRUE(std::equal(out.begin() + row * row_bytes,
+                               out.begin() + (row + 1) * row_bytes,
+                               pattern.begin() + row * row_step))
+            << "row " << row;
+    }
+
+    // Not a whole number of rows.
+    std::vector<std::byte> ragged(row_bytes + 1);
+    EXPECT_FALSE(read_process_rows(
+        child.pid(), child.address(), row_step, row_bytes, ragged));
+    // Rows running off the end of what the child mapped.
+    std::vector<std::byte> past_end(4 * row_bytes);
+    EXPECT_FALSE(read_process_rows(
+        child.pid(), child.address(), std::uint64_t{1} << 40, row_bytes,
+        past_end));
+}
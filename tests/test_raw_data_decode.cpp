@@ -27,6 +27,7 @@
 #include <gtest/gtest.h>
 #include <limits>
 #include <numbers>
+#include <span>
 #include <vector>
 
 #include "ipc/raw_data_decode.h"
@@ -117,6 +118,59 @@ TEST(RawDataDecodeTest, MakeFloatBufferFromDouble_Zero) {
     TestSingleDoubleValue(0.0);
 }
 
+namespace {
+// Enough doubles for several workers and several in-place doublings, and an
+// odd count so the vector loops leave a scalar tail.
+constexpr std::size_t MANY_DOUBLES = (std::size_t{1} << 22) + 13;
+
+std::vector<std::byte> many_doubles_bytes() {
+    std::vector<std::byte> bytes(MANY_DOUBLES * sizeof(double));
+    for (std::size_t i = 0; i < MANY_DOUBLES; ++i) {
+        const auto value = static_cast<double>(i) * TEST_PI - 1e6;
+        std::memcpy(bytes.data() + i * sizeof(double), &value, sizeof(double));
+    }
+    return bytes;
+}
+
+void ExpectNarrowedManyDoubles(const std::span<const std::byte> floats) {
+    ASSERT_EQ(floats.size(), MANY_DOUBLES * sizeof(float));
+    for (std::size_t i = 0; i < MANY_DOUBLES; ++i) {
+        float result = 0.0f;
+        std::memcpy(&result, floats.data() + i * sizeof(float), sizeof(float));
+        const auto value = static_cast<double>(i) * TEST_PI - 1e6;
+        ASSERT_EQ(result, static_cast<float>(value)) << "element " << i;
+    }
+}
+} // namespace
+
+TEST(RawDataDecodeTest, NarrowDoublesToFloats_ManyValues) {
+    const auto doubles = many_doubles_bytes();
+    std::vector<std::byte> floats(MANY_DOUBLES * sizeof(float));
+    narrow_doubles_to_floats(doubles, floats);
+    ExpectNarrowedManyDoubles(floats);
+}
+
+TEST(RawDataDecodeTest, NarrowDoublesToFloatsInPlace_ManyValues) {
+    auto bytes = many_doubles_bytes();
+    const auto floats = narrow_doubles_to_floats_in_place(bytes);
+    EXPECT_EQ(floats.data(), bytes.data());
+    ExpectNarrowedManyDoubles(floats);
+}
+
+TEST(RawDataDecodeTest, NarrowDoublesToFloatsInPlace_FewValues) {
+    const std::vector values = {TEST_VALUE_1, TEST_VALUE_2_5, TEST_PI};
+    std::vector<std::byte> bytes(values.size() * sizeof(double));
+    std::memcpy(bytes.data(), values.data(), bytes.size());
+    const auto floats = narrow_doubles_to_floats_in_place(bytes);
+
+    ASSERT_EQ(floats.size(), values.size() * sizeof(float));
+    for (auto i = 0U; i < values.size(); ++i) {
+        float result = 0.0f;
+        std::memcpy(&result, floats.data() + i * sizeof(float), sizeof(float));
+        EXPECT_FLOAT_EQ(result, static_cast<float>(values[i]));
+    }
+}
+
 TEST(RawDataDecodeTest, GeometryFitsPayloadAcceptsExactLowerBound) {
     // width=4, height=3, channels=2, stride=6 (pixels/row), FLOAT32:
     // pixels_needed = (height-1)*stride + width = 2*6+4 = 16 pixels,
@@ -0,0 +1,120 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "ipc/row_intervals.h"
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using oid::RowIntervals;
+
+TEST(RowIntervals, EmptyCoversOnlyEmptyRanges) {
+    const RowIntervals rows;
+    EXPECT_EQ(rows.runs(), 0u);
+    EXPECT_TRUE(rows.covers(5, 5));
+    EXPECT_FALSE(rows.covers(0, 1));
+}
+
+TEST(RowIntervals, EmptyInsertAddsNothing) {
+    RowIntervals rows;
+    rows.insert(4, 4);
+    rows.insert(7, 3);
+    EXPECT_EQ(rows.runs(), 0u);
+}
+
+TEST(RowIntervals, DisjointRunsStaySeparate) {
+    RowIntervals rows;
+    rows.insert(0, 2);
+    rows.insert(5, 8);
+    EXPECT_EQ(rows.runs(), 2u);
+    EXPECT_TRUE(rows.covers(0, 2));
+    EXPECT_TRUE(rows.covers(6, 8));
+    EXPECT_FALSE(rows.covers(0, 3));
+    EXPECT_FALSE(rows.covers(1, 6));
+    EXPECT_FALSE(rows.covers(2, 5));
+}
+
+TEST(RowIntervals, AdjacentRunsMerge) {
+    RowIntervals rows;
+    rows.insert(2, 4);
+    rows.insert(0, 2);
+    rows.insert(4, 6);
+    EXPECT_EQ(rows.runs(), 1u);
+    EXPECT_TRUE(rows.covers(0, 6));
+}
+
+TEST(RowIntervals, FillingAGapJoinsBothSides) {
+    RowIntervals rows;
+    rows.insert(0, 3);
+    rows.insert(6, 9);
+    rows.insert(12, 15);
+    rows.insert(2, 13);
+    EXPECT_EQ(rows.runs(), 1u);
+    EXPECT_TRUE(rows.covers(0, 15));
+    EXPECT_FALSE(rows.covers(0, 16));
+}
+
+TEST(RowIntervals, OverlapsAndRepeatsAreAbsorbed) {
+    RowIntervals rows;
+    rows.insert(10, 20);
+    rows.insert(12, 15);
+    rows.insert(10, 20);
+    rows.insert(18, 25);
+    EXPECT_EQ(rows.runs(), 1u);
+    EXPECT_TRUE(rows.covers(10, 25));
+    EXPECT_FALSE(rows.covers(9, 25));
+}
+
+// Strips of a tall buffer arriving in reverse: every strip touches the run
+// before it, so there is never more than one.
+TEST(RowIntervals, ManyStripsKeepOneRun) {
+    constexpr std::size_t height = 1'000'000;
+    constexpr std::size_t strip = 7;
+    RowIntervals rows;
+    for (std::size_t end = height; end > 0;) {
+        const auto begin = end > strip ? end - strip : 0;
+        rows.insert(begin, end);
+        end = begin;
+        ASSERT_EQ(rows.runs(), 1u);
+    }
+    EXPECT_TRUE(rows.covers(0, height));
+}
+
+TEST(RowIntervals, WithoutLeavesTheRowsTheOtherLacks) {
+    RowIntervals rows;
+    rows.insert(0, 10);
+    rows.insert(20, 30);
+    RowIntervals seen;
+    seen.insert(2, 4);
+    seen.insert(8, 22);
+    seen.insert(25, 40);
+    using Runs = std::vector<std::pair<std::size_t, std::size_t>>;
+    EXPECT_EQ(rows.without(seen), (Runs{{0, 2}, {4, 8}, {22, 25}}));
+    EXPECT_EQ(rows.without(RowIntervals{}), (Runs{{0, 10}, {20, 30}}));
+    EXPECT_TRUE(seen.without(seen).empty());
+}
@@ -0,0 +1,193 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "ipc/asio_transport.h"
+#include "ipc/message_exchange.h"
+#include "ipc/shm_transport.h"
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace oid;
+
+namespace {
+
+std::vector<std::byte> make_pattern(const std::size_t size) {
+    std::vector<std::byte> bytes(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        bytes[i] = static_cast<std::byte>(i ^ (i >> 9U));
+    }
+    return bytes;
+}
+
+// A connected bridge-side/viewer-side socket pair over loopback.
+class SharedMemoryTransportTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        std::jthread server([this] {
+            bridge_socket_.emplace(acceptor_.accept(std::chrono::seconds{5}));
+        });
+        viewer_socket_.emplace("127.0.0.1", acceptor_.port());
+        server.join();
+    }
+
+    AsioAcceptor acceptor_;
+    std::optional<AsioTransport> bridge_socket_;
+    std::optional<AsioTransport> viewer_socket_;
+};
+
+} // namespace
+
+TEST(SharedMemoryRing, PushPopWrapsAround) {
+    auto writer = SharedMemoryRing::create(64);
+    auto reader = SharedMemoryRing::open(writer.name());
+    ASSERT_EQ(reader.capacity(), 64U);
+
+    // Three 40-byte rounds through a 64-byte ring: the second and third
+    // straddle the end of the data region.
+    for (std::size_t round = 0; round < 3; ++round) {
+        auto in = make_pattern(40);
+        in[0] = static_cast<std::byte>(round);
+        ASSERT_GE(writer.free_bytes(), in.size());
+        writer.push(in);
+        EXPECT_EQ(reader.readable_bytes(), in.size());
+        std::vector<std::byte> out(in.size());
+        reader.pop(out);
+        EXPECT_EQ(out, in);
+        EXPECT_EQ(writer.free_bytes(), 64U);
+    }
+}
+
+TEST(SharedMemoryRing, UnlinkedSegmentCannotBeOpened) {
+    auto writer = SharedMemoryRing::create(64);
+    const auto name = writer.name();
+    writer.unlink();
+    EXPECT_THROW(SharedMemoryRing::open(name), std::runtime_error);
+}
+
+TEST_F(SharedMemoryTransportTest, OfferAcceptedForLiveSegment) {
+    auto ring = SharedMemoryRing::create(1024);
+    const auto mapped =
+        answer_shared_memory_offer(*viewer_socket_, ring.name());
+    ASSERT_TRUE(mapped.has_value());
+    EXPECT_TRUE(read_shared_memory_answer(*bridge_socket_));
+    EXPECT_EQ(mapped->capacity(), ring.capacity());
+}
+
+TEST_F(SharedMemoryTransportTest, OfferDeclinedForMissingSegment) {
+    const auto mapped =
+        answer_shared_memory_offer(*viewer_socket_, "/oid-no-such-segment");
+    EXPECT_FALSE(mapped.has_value());
+    EXPECT_FALSE(read_shared_memory_answer(*bridge_socket_));
+}
+
+TEST_F(SharedMemoryTransportTest, LargeMessageStreamsThroughSmallRing) {
+    // The payload is many times the ring, so the writer has to block on the
+    // reader draining it; the small fields around it travel inline.
+    auto ring = SharedMemoryRing::create(256 * 1024);
+    auto reader_ring = answer_shared_memory_offer(*viewer_socket_, ring.name());
+    ASSERT_TRUE(reader_ring.has_value());
+    ASSERT_TRUE(read_shared_memory_answer(*bridge_socket_));
+
+    SharedMemoryTransport writer{*bridge_socket_,
+                                 std::move(ring),
+                                 SharedMemoryTransport::Role::WRITER};
+    SharedMemoryTransport reader{*viewer_socket_,
+                                 std::move(*reader_ring),
+                                 SharedMemoryTransport::Role::READER};
+
+    const auto payload = make_pattern(8 * 1024 * 1024 + 5);
+    std::jthread sender([&writer, &payload] {
+        MessageComposer composer;
+        composer.push(MessageType::PLOT_BUFFER_CONTENTS)
+            .push(std::string{"img"})
+            .push(std::span<const std::byte>{payload})
+            .push(42);
+        composer.send(writer);
+        MessageComposer{}
+            .push(MessageType::SET_AVAILABLE_SYMBOLS)
+            .push(std::string{"next"})
+            .send(writer);
+    });
+
+    MessageDecoder decoder{reader};
+    auto type = MessageType{};
+    std::string name;
+    std::vector<std::byte> received;
+    int trailer = 0;
+    decoder.read(type).read(name).read(received).read(trailer);
+    EXPECT_EQ(type, MessageType::PLOT_BUFFER_CONTENTS);
+    EXPECT_EQ(name, "img");
+    EXPECT_EQ(received, payload);
+    EXPECT_EQ(trailer, 42);
+
+    decoder.read(type).read(name);
+    EXPECT_EQ(type, MessageType::SET_AVAILABLE_SYMBOLS);
+    EXPECT_EQ(name, "next");
+    sender.join();
+}
+
+TEST_F(SharedMemoryTransportTest, ReverseDirectionPassesThrough) {
+    auto ring = SharedMemoryRing::create(1024);
+    auto reader_ring = SharedMemoryRing::open(ring.name());
+    SharedMemoryTransport writer{*bridge_socket_,
+                                 std::move(ring),
+                                 SharedMemoryTransport::Role::WRITER};
+    SharedMemoryTransport reader{*viewer_socket_,
+                                 std::move(reader_ring),
+                                 SharedMemoryTransport::Role::READER};
+
+    MessageComposer{}
+        .push(MessageType::PLOT_BUFFER_REQUEST)
+        .push(std::string{"myVar"})
+        .send(reader);
+
+    // Raw on the bridge's socket: the viewer's replies carry no records.
+    auto type = MessageType{};
+    std::string name;
+    MessageDecoder{*bridge_socket_}.read(type).read(name);
+    EXPECT_EQ(type, MessageType::PLOT_BUFFER_REQUEST);
+    EXPECT_EQ(name, "myVar");
+}
+
+TEST_F(SharedMemoryTransportTest, WriterTimesOutWhenReaderStalls) {
+    auto ring = SharedMemoryRing::create(GATHER_MIN_BYTES);
+    SharedMemoryTransport writer{*bridge_socket_,
+                                 std::move(ring),
+                                 SharedMemoryTransport::Role::WRITER,
+                                 std::chrono::milliseconds{100}};
+
+    const auto payload = make_pattern(4 * GATHER_MIN_BYTES);
+    MessageComposer composer;
+    composer.push(std::span<const std::byte>{payload});
+    EXPECT_THROW(composer.send(writer), SocketTimeoutError);
+}
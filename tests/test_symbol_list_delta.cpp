@@ -0,0 +1,104 @@
+/*
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2026 OpenImageDebugger contributors
+ * (https://github.com/OpenImageDebugger/OpenImageDebugger)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "ipc/symbol_list_delta.h"
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using oid::SymbolListDelta;
+
+namespace {
+
+// `before` edited by its delta to `after`, which must exist.
+std::vector<std::string> round_trip(const std::deque<std::string>& before,
+                                    const std::deque<std::string>& after) {
+    const auto delta = oid::diff_symbol_lists(before, after);
+    EXPECT_TRUE(delta.has_value());
+    std::vector<std::string> symbols{before.begin(), before.end()};
+    if (delta.has_value()) {
+        EXPECT_TRUE(oid::apply_symbol_list_delta(symbols, *delta));
+    }
+    return symbols;
+}
+
+} // namespace
+
+TEST(SymbolListDelta, EqualListsGiveAnEmptyDelta) {
+    const std::deque<std::string> symbols{"a", "b", "this.image"};
+    const auto delta = oid::diff_symbol_lists(symbols, symbols);
+    ASSERT_TRUE(delta.has_value());
+    EXPECT_TRUE(delta->empty());
+}
+
+TEST(SymbolListDelta, ListsRemovalsAndInsertionsAtTheirNewIndex) {
+    const std::deque<std::string> before{"a", "b", "c", "d", "e", "f"};
+    const std::deque<std::string> after{"a", "x", "c", "d", "e", "f", "y"};
+    const auto delta = oid::diff_symbol_lists(before, after);
+    ASSERT_TRUE(delta.has_value());
+    EXPECT_EQ(*delta,
+              (SymbolListDelta{.removed = {"b"},
+                               .added = {{1, "x"}, {6, "y"}}}));
+    EXPECT_EQ(round_trip(before, after),
+              (std::vector<std::string>{after.begin(), after.end()}));
+}
+
+TEST(SymbolListDelta, InsertionsAtTheFrontAndEndApply) {
+    const std::deque<std::string> before{"b", "c", "d", "e"};
+    const std::deque<std::string> after{"a", "b", "c", "d", "e", "z"};
+    EXPECT_EQ(round_trip(before, after),
+              (std::vector<std::string>{after.begin(), after.end()}));
+}
+
+// Only the whole list can say that the names kept changed order, or that
+// one is listed twice; nor is a delta worth it once it lists as many names
+// as the new list holds.
+TEST(SymbolListDelta, NoDeltaWhenTheWholeListIsBetter) {
+    EXPECT_FALSE(oid::diff_symbol_lists({"a", "b", "c"}, {"b", "a", "c"})
+                     .has_value());
+    EXPECT_FALSE(
+        oid::diff_symbol_lists({"a", "a", "b"}, {"a", "b"}).has_value());
+    EXPECT_FALSE(
+        oid::diff_symbol_lists({"a", "b"}, {"a", "c", "c"}).has_value());
+    EXPECT_FALSE(oid::diff_symbol_lists({"a", "b"}, {"c", "d"}).has_value());
+    EXPECT_FALSE(oid::diff_symbol_lists({"a"}, {}).has_value());
+}
+
+TEST(SymbolListDelta, DeltaThatDoesNotFitLeavesTheListAlone) {
+    std::vector<std::string> symbols{"a", "b"};
+    const SymbolListDelta delta{.removed = {"a"}, .added = {{3, "x"}}};
+    EXPECT_FALSE(oid::apply_symbol_list_delta(symbols, delta));
+    EXPECT_EQ(symbols, (std::vector<std::string>{"a", "b"}));
+}
+
+TEST(SymbolListDelta, AdditionsOutOfIndexOrderDoNotApply) {
+    std::vector<std::string> symbols{"a", "b"};
+    const SymbolListDelta delta{.added = {{2, "y"}, {0, "x"}}};
+    EXPECT_FALSE(oid::apply_symbol_list_delta(symbols, delta));
+    EXPECT_EQ(symbols, (std::vector<std::string>{"a", "b"}));
+}